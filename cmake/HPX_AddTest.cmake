@@ -35,7 +35,7 @@ macro(add_hpx_test category name)
 
   set(args)
 
-  foreach(arg ${${name}_UNPARSED_ARGUMENTS})
+  foreach(arg ${${name}_UNPARSED_ARGUMENTS} ${${name}_ARGS})
     set(args ${args} "${arg}")
   endforeach()
   set(args "-v" "--" ${args})
@@ -20,6 +20,7 @@
 #include <hpx/util/lazy_enable_if.hpp>
 
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -236,6 +237,32 @@ namespace hpx { namespace detail
         }
     };
 
+    // the shared state of the returned future is allocated using the given
+    // allocator
+    template <>
+    struct async_dispatch<std::allocator_arg_t>
+    {
+        template <typename Allocator, typename F, typename ...Ts>
+        HPX_FORCEINLINE static
+        typename std::enable_if<
+            traits::detail::is_deferred_callable<F&&(Ts&&...)>::value,
+            hpx::future<
+                typename util::detail::deferred_result_of<F&&(Ts&&...)>::type
+            >
+        >::type
+        call(std::allocator_arg_t, Allocator const& a, F&& f, Ts&&... ts)
+        {
+            typedef typename util::detail::deferred_result_of<
+                    F(Ts&&...)
+                >::type result_type;
+
+            lcos::local::futures_factory<result_type()> p(std::allocator_arg, a,
+                util::deferred_call(std::forward<F>(f), std::forward<Ts>(ts)...));
+            p.apply(launch::async);
+            return p.retrieve_future();
+        }
+    };
+
     // threads::executor
     template <typename Executor>
     struct async_dispatch<Executor,
@@ -10,12 +10,14 @@
 
 #include <hpx/config.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
 #include <hpx/traits/is_component.hpp>
 
 #include <hpx/components/component_storage/server/migrate_from_storage.hpp>
 
 #include <type_traits>
+#include <vector>
 
 namespace hpx { namespace components
 {
@@ -55,6 +57,62 @@ namespace hpx { namespace components
         return async<action_type>(naming::get_locality_from_id(to_resurrect),
             to_resurrect, target);
     }
+
+    /// Migrate the components with the given ids from the storage facilities
+    /// they are currently stored on (resurrect the objects)
+    ///
+    /// The function \a migrate_from_storage<Component> will migrate all
+    /// components referenced by \a to_resurrect from the storage facilities
+    /// they are currently stored on. The components are migrated
+    /// concurrently. It returns a future which becomes ready once all
+    /// components have been resurrected.
+    ///
+    /// \param to_resurrect    [in] The global ids of the components to
+    ///                        migrate.
+    /// \param target          [in] The optional locality to resurrect the
+    ///                        objects on. By default each object is
+    ///                        resurrected on the locality it was located on
+    ///                        last.
+    ///
+    /// \tparam  The only template argument specifies the component type of the
+    ///          components to migrate from the storage facilities.
+    ///
+    /// \returns A future representing the global ids of the migrated
+    ///          component instances.
+    ///
+    template <typename Component>
+#if defined(DOXYGEN)
+    future<std::vector<naming::id_type> >
+#else
+    inline typename std::enable_if<
+        traits::is_component<Component>::value,
+        future<std::vector<naming::id_type> >
+    >::type
+#endif
+    migrate_from_storage(std::vector<naming::id_type> const& to_resurrect,
+        naming::id_type const& target = naming::invalid_id)
+    {
+        std::vector<future<naming::id_type> > resurrected;
+        resurrected.reserve(to_resurrect.size());
+
+        for (naming::id_type const& id : to_resurrect)
+        {
+            resurrected.push_back(
+                migrate_from_storage<Component>(id, target));
+        }
+
+        return when_all(resurrected).then(
+            [](future<std::vector<future<naming::id_type> > > && f)
+            {
+                std::vector<future<naming::id_type> > resurrected = f.get();
+
+                std::vector<naming::id_type> result;
+                result.reserve(resurrected.size());
+                for (future<naming::id_type>& id : resurrected)
+                    result.push_back(id.get());
+                return result;
+            });
+    }
 }}
 
 #endif
@@ -0,0 +1,81 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COMPONENT_STORAGE_FILE_STORAGE_HPP)
+#define HPX_COMPONENT_STORAGE_FILE_STORAGE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <hpx/components/component_storage/export_definitions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace components { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Stores the serialized state of migrated components in an append-only
+    // log file. Each record consists of the stripped global id of the
+    // component, the size of the data, and the data itself. Erasing a
+    // component appends a record without data (a tombstone). The index
+    // mapping the global ids to the position of their data in the file is
+    // kept in memory and is rebuilt from the log if an existing file is
+    // opened.
+    //
+    // All functions block on file I/O, they are meant to be executed on an
+    // OS thread (see hpx::threads::run_as_os_thread).
+    class HPX_MIGRATE_TO_STORAGE_EXPORT file_storage
+    {
+        typedef std::mutex mutex_type;
+
+    public:
+        explicit file_storage(std::string const& filename);
+        ~file_storage();
+
+        file_storage(file_storage const&) = delete;
+        file_storage& operator=(file_storage const&) = delete;
+
+        // append the data of the given components to the log, all records
+        // are written in one go
+        void store(std::vector<std::pair<
+            naming::gid_type, std::vector<char> > > const& data);
+
+        // read the data of the given component, optionally erase it
+        std::vector<char> load(naming::gid_type const& gid, bool erase);
+
+        std::size_t size() const;
+
+        std::string const& filename() const
+        {
+            return filename_;
+        }
+
+    private:
+        void open();
+        std::uint64_t recover();
+        void append_record(std::vector<char>& buffer,
+            naming::gid_type const& gid, std::uint64_t size,
+            char const* data);
+
+        mutable mutex_type mtx_;
+        std::string filename_;
+        std::fstream file_;
+        std::uint64_t end_;
+
+        // gid --> position and size of the stored data
+        std::map<naming::gid_type,
+            std::pair<std::uint64_t, std::uint64_t> > index_;
+    };
+}}}
+
+#endif
@@ -242,6 +242,9 @@ namespace hpx
         friend class const_segment_vector_iterator<
             T, Data, typename partitions_vector_type::const_iterator>;
 
+        friend class partitioned_vector_view<T, Data>;
+        friend class partitioned_vector_aggregator<T, Data>;
+
         std::size_t get_partition_size() const
         {
             std::size_t num_parts = partitions_.size();
@@ -1445,6 +1448,158 @@ namespace hpx
         }
 #endif
 
+        /// Asynchronously returns the elements in the range [first, last) of
+        /// the vector container. The elements of each of the partitions
+        /// touched by the range are retrieved using a single operation.
+        ///
+        /// \param first Global position of the first element in the vector
+        /// \param last  Global position one past the last element in the
+        ///              vector
+        ///
+        /// \return Returns the hpx::future to the values of the elements in
+        ///         the given range.
+        ///
+        future<std::vector<T> >
+        get_range(size_type first, size_type last) const
+        {
+            HPX_ASSERT(first <= last && last <= size_);
+
+            if (first == last)
+                return make_ready_future(std::vector<T>());
+
+            size_type const size = last - first;
+            std::vector<future<std::vector<T> > > part_values_future;
+
+            size_type part = get_partition(first);
+            size_type local_first = get_local_index(first);
+            while (first != last)
+            {
+                partition_data const& part_data = partitions_[part];
+                size_type count = (std::min)(
+                    part_data.size_ - local_first, last - first);
+
+                if (part_data.local_data_)
+                {
+                    part_values_future.push_back(make_ready_future(
+                        part_data.local_data_->get_range(local_first, count)));
+                }
+                else
+                {
+                    part_values_future.push_back(
+                        partitioned_vector_partition_client(
+                            part_data.partition_).get_range(local_first, count));
+                }
+
+                first += count;
+                local_first = 0;
+                ++part;
+            }
+
+            if (part_values_future.size() == 1)
+                return std::move(part_values_future.front());
+
+            return dataflow(launch::async,
+                [size](std::vector<future<std::vector<T> > > && part_values_f)
+                    -> std::vector<T>
+                {
+                    std::vector<T> values;
+                    values.reserve(size);
+
+                    for (future<std::vector<T> >& part_f: part_values_f)
+                    {
+                        std::vector<T> part_values = part_f.get();
+                        std::move(part_values.begin(), part_values.end(),
+                            std::back_inserter(values));
+                    }
+                    return values;
+                },
+                std::move(part_values_future));
+        }
+
+        /// Returns the elements in the range [first, last) of the vector
+        /// container.
+        ///
+        /// \param first Global position of the first element in the vector
+        /// \param last  Global position one past the last element in the
+        ///              vector
+        ///
+        /// \return Returns the values of the elements in the given range.
+        ///
+        std::vector<T>
+        get_range(launch::sync_policy, size_type first, size_type last) const
+        {
+            return get_range(first, last).get();
+        }
+
+        /// Asynchronously copy the values of \a val to the elements in the
+        /// range [first, first + val.size()) of the vector container. The
+        /// elements of each of the partitions touched by the range are
+        /// written using a single operation.
+        ///
+        /// \param first Global position of the first element in the vector
+        /// \param val   The values to be copied
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void> set_range(size_type first, std::vector<T> const& val)
+        {
+            HPX_ASSERT(first + val.size() <= size_);
+
+            if (val.empty())
+                return make_ready_future();
+
+            std::vector<future<void> > part_futures;
+
+            size_type part = get_partition(first);
+            size_type local_first = get_local_index(first);
+
+            typename std::vector<T>::const_iterator val_it = val.begin();
+            while (val_it != val.end())
+            {
+                partition_data const& part_data = partitions_[part];
+                size_type count = (std::min)(
+                    part_data.size_ - local_first,
+                    size_type(std::distance(val_it, val.end())));
+
+                if (part_data.local_data_ && count == val.size())
+                {
+                    // avoid copying the values if all of them go to a local
+                    // partition
+                    part_data.local_data_->set_range(local_first, val);
+                }
+                else if (part_data.local_data_)
+                {
+                    part_data.local_data_->set_range(local_first,
+                        std::vector<T>(val_it, val_it + count));
+                }
+                else
+                {
+                    part_futures.push_back(partitioned_vector_partition_client(
+                        part_data.partition_).set_range(local_first,
+                            std::vector<T>(val_it, val_it + count)));
+                }
+
+                val_it += count;
+                local_first = 0;
+                ++part;
+            }
+
+            return when_all(part_futures);
+        }
+
+        /// Copy the values of \a val to the elements in the range
+        /// [first, first + val.size()) of the vector container.
+        ///
+        /// \param first Global position of the first element in the vector
+        /// \param val   The values to be copied
+        ///
+        void set_range(launch::sync_policy, size_type first,
+            std::vector<T> const& val)
+        {
+            set_range(first, val).get();
+        }
+
 //   //CLEAR
 //   //TODO if number of partitions is kept constant every time then
 //   // clear should modified (clear each partitioned_vector_partition one by one).
@@ -0,0 +1,301 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/partitioned_vector/partitioned_vector_aggregator.hpp
+
+#ifndef HPX_PARTITIONED_VECTOR_AGGREGATOR_HPP
+#define HPX_PARTITIONED_VECTOR_AGGREGATOR_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
+
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_fwd.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_vector.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx
+{
+    /// hpx::partitioned_vector_aggregator combines single element accesses
+    /// to remote partitions of a hpx::partitioned_vector into batched
+    /// operations.
+    ///
+    /// Each access is queued for the partition it refers to. A queue is
+    /// flushed by a low priority HPX thread scheduled by the first access
+    /// queued after the previous flush, or as soon as it holds
+    /// \a max_batch_size accesses, whichever happens first. All reads and
+    /// all writes waiting in a queue are sent as one get_values and one
+    /// set_values operation, respectively. Elements stored on the calling
+    /// locality are accessed directly.
+    ///
+    /// \note The relative order of reads and writes which are outstanding
+    ///       at the same time is not defined, just as for the corresponding
+    ///       asynchronous functions of hpx::partitioned_vector.
+    ///
+    /// \note The vector has to outlive the aggregator and all of the
+    ///       operations it has started.
+    ///
+    template <typename T, typename Data = std::vector<T> >
+    class partitioned_vector_aggregator
+    {
+    private:
+        typedef lcos::local::spinlock mutex_type;
+        typedef typename Data::size_type size_type;
+
+        struct partition_queue
+        {
+            partition_queue()
+              : flush_scheduled_(false)
+            {}
+
+            std::vector<size_type> get_positions_;
+            std::vector<lcos::local::promise<T> > get_promises_;
+
+            std::vector<size_type> set_positions_;
+            std::vector<T> set_values_;
+            std::vector<lcos::local::promise<void> > set_promises_;
+
+            bool flush_scheduled_;
+        };
+
+        struct shared_state
+        {
+            shared_state(partitioned_vector<T, Data>& v,
+                    std::size_t max_batch_size)
+              : vector_(v),
+                queues_(v.partitions_.size()),
+                max_batch_size_(max_batch_size)
+            {}
+
+            mutex_type mtx_;
+            partitioned_vector<T, Data>& vector_;
+            std::vector<partition_queue> queues_;
+            std::size_t const max_batch_size_;
+        };
+
+        template <typename Promises>
+        static void set_exception(Promises& promises)
+        {
+            boost::exception_ptr e = boost::current_exception();
+            for (auto& p : promises)
+                p.set_exception(e);
+        }
+
+        static void flush_partition(std::shared_ptr<shared_state> const& state,
+            std::size_t part)
+        {
+            partition_queue q;
+
+            {
+                std::lock_guard<mutex_type> l(state->mtx_);
+                partition_queue& pq = state->queues_[part];
+
+                std::swap(q.get_positions_, pq.get_positions_);
+                std::swap(q.get_promises_, pq.get_promises_);
+                std::swap(q.set_positions_, pq.set_positions_);
+                std::swap(q.set_values_, pq.set_values_);
+                std::swap(q.set_promises_, pq.set_promises_);
+                pq.flush_scheduled_ = false;
+            }
+
+            if (!q.get_positions_.empty())
+            {
+                typedef std::vector<lcos::local::promise<T> > promises_type;
+                std::shared_ptr<promises_type> promises =
+                    std::make_shared<promises_type>(
+                        std::move(q.get_promises_));
+
+                state->vector_.get_values(part, q.get_positions_).then(
+                    [promises](future<std::vector<T> > && f)
+                    {
+                        try {
+                            std::vector<T> values = f.get();
+                            HPX_ASSERT(values.size() == promises->size());
+
+                            for (std::size_t i = 0; i != values.size(); ++i)
+                                (*promises)[i].set_value(std::move(values[i]));
+                        }
+                        catch (...) {
+                            set_exception(*promises);
+                        }
+                    });
+            }
+
+            if (!q.set_positions_.empty())
+            {
+                typedef std::vector<lcos::local::promise<void> > promises_type;
+                std::shared_ptr<promises_type> promises =
+                    std::make_shared<promises_type>(
+                        std::move(q.set_promises_));
+
+                state->vector_.set_values(
+                    part, q.set_positions_, q.set_values_).then(
+                        [promises](future<void> && f)
+                        {
+                            try {
+                                f.get();
+                                for (auto& p : *promises)
+                                    p.set_value();
+                            }
+                            catch (...) {
+                                set_exception(*promises);
+                            }
+                        });
+            }
+        }
+
+        // Decide what to do after an access has been queued for the given
+        // partition, the lock has to be held.
+        bool enqueued(partition_queue& q, bool& schedule) const
+        {
+            std::size_t size = q.get_positions_.size() +
+                q.set_positions_.size();
+            if (size >= state_->max_batch_size_)
+                return true;
+
+            if (!q.flush_scheduled_)
+                schedule = q.flush_scheduled_ = true;
+            return false;
+        }
+
+        void flush(std::size_t part, bool flush_now, bool schedule) const
+        {
+            if (flush_now)
+            {
+                flush_partition(state_, part);
+            }
+            else if (schedule)
+            {
+                hpx::applier::register_thread_nullary(
+                    util::bind(&partitioned_vector_aggregator::flush_partition,
+                        state_, part),
+                    "partitioned_vector_aggregator::flush",
+                    threads::pending, true, threads::thread_priority_low);
+            }
+        }
+
+    public:
+        /// Create an aggregator for the accesses to the given vector.
+        ///
+        /// \param v              The vector to access
+        /// \param max_batch_size The number of queued accesses to a single
+        ///                       partition which triggers an immediate
+        ///                       flush of its queue
+        ///
+        explicit partitioned_vector_aggregator(partitioned_vector<T, Data>& v,
+                std::size_t max_batch_size = 1024)
+          : state_(std::make_shared<shared_state>(v, max_batch_size))
+        {
+            HPX_ASSERT(max_batch_size != 0);
+        }
+
+        /// Asynchronously returns the element at position \a pos in the
+        /// vector.
+        ///
+        /// \param pos Global position of the element in the vector
+        ///
+        /// \return Returns the hpx::future to the value of the element.
+        ///
+        future<T> get_value(size_type pos) const
+        {
+            partitioned_vector<T, Data>& v = state_->vector_;
+
+            std::size_t part = v.get_partition(pos);
+            size_type local_index = v.get_local_index(pos);
+            HPX_ASSERT(part < v.partitions_.size());
+
+            auto const& part_data = v.partitions_[part];
+            if (part_data.local_data_)
+            {
+                return make_ready_future(
+                    part_data.local_data_->get_value(local_index));
+            }
+
+            lcos::local::promise<T> p;
+            future<T> f = p.get_future();
+
+            bool flush_now = false, schedule = false;
+            {
+                std::lock_guard<mutex_type> l(state_->mtx_);
+                partition_queue& q = state_->queues_[part];
+
+                q.get_positions_.push_back(local_index);
+                q.get_promises_.push_back(std::move(p));
+                flush_now = enqueued(q, schedule);
+            }
+
+            flush(part, flush_now, schedule);
+            return f;
+        }
+
+        /// Asynchronously sets the element at position \a pos in the vector
+        /// to the given value \a val.
+        ///
+        /// \param pos   Global position of the element in the vector
+        /// \param val   The value to be copied
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        template <typename T_>
+        future<void> set_value(size_type pos, T_ && val) const
+        {
+            partitioned_vector<T, Data>& v = state_->vector_;
+
+            std::size_t part = v.get_partition(pos);
+            size_type local_index = v.get_local_index(pos);
+            HPX_ASSERT(part < v.partitions_.size());
+
+            auto const& part_data = v.partitions_[part];
+            if (part_data.local_data_)
+            {
+                part_data.local_data_->set_value(local_index,
+                    std::forward<T_>(val));
+                return make_ready_future();
+            }
+
+            lcos::local::promise<void> p;
+            future<void> f = p.get_future();
+
+            bool flush_now = false, schedule = false;
+            {
+                std::lock_guard<mutex_type> l(state_->mtx_);
+                partition_queue& q = state_->queues_[part];
+
+                q.set_positions_.push_back(local_index);
+                q.set_values_.push_back(std::forward<T_>(val));
+                q.set_promises_.push_back(std::move(p));
+                flush_now = enqueued(q, schedule);
+            }
+
+            flush(part, flush_now, schedule);
+            return f;
+        }
+
+        /// Send all queued accesses without waiting for the scheduled
+        /// flushes.
+        void flush() const
+        {
+            for (std::size_t part = 0; part != state_->queues_.size(); ++part)
+                flush_partition(state_, part);
+        }
+
+    private:
+        std::shared_ptr<shared_state> state_;
+    };
+}
+
+#endif
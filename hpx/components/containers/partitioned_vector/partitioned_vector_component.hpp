@@ -29,6 +29,7 @@
 
 #include <boost/preprocessor/cat.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <memory>
@@ -272,6 +273,22 @@ namespace hpx { namespace server
             return result;
         }
 
+        /// Return the elements in the range [first, first + count) of the
+        /// partitioned_vector_partition container.
+        ///
+        /// \param first Position of the first element in the
+        ///              partitioned_vector_partition
+        /// \param count Number of elements to return
+        ///
+        /// \return Return the values of the elements in the given range.
+        ///
+        std::vector<T> get_range(size_type first, size_type count) const
+        {
+            HPX_ASSERT(first + count <= partitioned_vector_partition_.size());
+
+            auto beg = partitioned_vector_partition_.begin() + first;
+            return std::vector<T>(beg, beg + count);
+        }
 
         /// Access the value of first element in the partitioned_vector_partition.
         ///
@@ -364,6 +381,22 @@ namespace hpx { namespace server
                 partitioned_vector_partition_[pos[i]] = val[i];
         }
 
+        /// Copy the values of \a val to the elements in the range
+        /// [first, first + val.size()) of the partitioned_vector_partition
+        /// container.
+        ///
+        /// \param first Position of the first element in the
+        ///              partitioned_vector_partition
+        /// \param val   The values to be copied
+        ///
+        void set_range(size_type first, std::vector<T> const& val)
+        {
+            HPX_ASSERT(first + val.size() <= partitioned_vector_partition_.size());
+
+            std::copy(val.begin(), val.end(),
+                partitioned_vector_partition_.begin() + first);
+        }
+
         /// Remove all elements from the vector leaving the
         /// partitioned_vector_partition with size 0.
         ///
@@ -385,6 +418,7 @@ namespace hpx { namespace server
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, get_value);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, get_values);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, get_range);
 
 //         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector_partition, front);
 //         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector_partition, back);
@@ -394,6 +428,7 @@ namespace hpx { namespace server
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_value);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_values);
+        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_range);
 
 //         HPX_DEFINE_COMPONENT_ACTION(partitioned_vector_partition, clear);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, get_copied_data);
@@ -420,6 +455,10 @@ namespace hpx { namespace server
         BOOST_PP_CAT(__vector_set_value_action_, name));                      \
     HPX_REGISTER_ACTION_DECLARATION(type::set_values_action,                  \
         BOOST_PP_CAT(__vector_set_values_action_, name));                     \
+    HPX_REGISTER_ACTION_DECLARATION(type::get_range_action,                   \
+        BOOST_PP_CAT(__vector_get_range_action_, name));                      \
+    HPX_REGISTER_ACTION_DECLARATION(type::set_range_action,                   \
+        BOOST_PP_CAT(__vector_set_range_action_, name));                      \
     HPX_REGISTER_ACTION_DECLARATION(type::size_action,                        \
         BOOST_PP_CAT(__vector_size_action_, name));                           \
     HPX_REGISTER_ACTION_DECLARATION(type::resize_action,                      \
@@ -461,6 +500,10 @@ namespace hpx { namespace server
         BOOST_PP_CAT(__vector_set_value_action_, name));                      \
     HPX_REGISTER_ACTION(type::set_values_action,                              \
         BOOST_PP_CAT(__vector_set_values_action_, name));                     \
+    HPX_REGISTER_ACTION(type::get_range_action,                               \
+        BOOST_PP_CAT(__vector_get_range_action_, name));                      \
+    HPX_REGISTER_ACTION(type::set_range_action,                               \
+        BOOST_PP_CAT(__vector_set_range_action_, name));                      \
     HPX_REGISTER_ACTION(type::size_action,                                    \
         BOOST_PP_CAT(__vector_size_action_, name));                           \
     HPX_REGISTER_ACTION(type::resize_action,                                  \
@@ -682,6 +725,38 @@ namespace hpx
                 this->get_id(), pos);
         }
 
+        /// Returns the elements in the range [first, first + count) of the
+        /// partitioned_vector_partition component.
+        ///
+        /// \param first Position of the first element in the
+        ///              partitioned_vector_partition
+        /// \param count Number of elements to return
+        ///
+        /// \return Returns the values of the elements in the given range
+        ///
+        std::vector<T> get_range(launch::sync_policy, std::size_t first,
+            std::size_t count) const
+        {
+            return get_range(first, count).get();
+        }
+
+        /// Returns the elements in the range [first, first + count) of the
+        /// partitioned_vector_partition component.
+        ///
+        /// \param first Position of the first element in the
+        ///              partitioned_vector_partition
+        /// \param count Number of elements to return
+        ///
+        /// \return This returns the values as the hpx::future
+        ///
+        future<std::vector<T> >
+        get_range(std::size_t first, std::size_t count) const
+        {
+            HPX_ASSERT(this->get_id());
+            return hpx::async<typename server_type::get_range_action>(
+                this->get_id(), first, count);
+        }
+
 //         future<T> front_async() const
 //         {
 //             HPX_ASSERT(this->get_id());
@@ -796,6 +871,37 @@ namespace hpx
                 this->get_id(), pos, val);
         }
 
+        /// Copy the values of \a val to the elements in the range
+        /// [first, first + val.size()) of the partitioned_vector_partition
+        /// component.
+        ///
+        /// \param first Position of the first element in the
+        ///              partitioned_vector_partition
+        /// \param val   The values to be copied
+        ///
+        void set_range(launch::sync_policy, std::size_t first,
+            std::vector<T> const& val)
+        {
+            set_range(first, val).get();
+        }
+
+        /// Copy the values of \a val to the elements in the range
+        /// [first, first + val.size()) of the partitioned_vector_partition
+        /// component.
+        ///
+        /// \param first Position of the first element in the
+        ///              partitioned_vector_partition
+        /// \param val   The values to be copied
+        ///
+        /// \return This returns the hpx::future of type void
+        ///
+        future<void> set_range(std::size_t first, std::vector<T> const& val)
+        {
+            HPX_ASSERT(this->get_id());
+            return hpx::async<typename server_type::set_range_action>(
+                this->get_id(), first, val);
+        }
+
 //         void clear()
 //         {
 //             HPX_ASSERT(this->get_id());
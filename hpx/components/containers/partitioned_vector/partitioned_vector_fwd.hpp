@@ -36,6 +36,9 @@ namespace hpx
     template <typename T, typename Data, typename BaseIter>
     class local_segment_vector_iterator;
 
+    template <typename T, typename Data> class partitioned_vector_view;
+    template <typename T, typename Data> class partitioned_vector_aggregator;
+
     namespace server
     {
         template <typename T, typename Data = std::vector<T> >
@@ -0,0 +1,192 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/partitioned_vector/partitioned_vector_view.hpp
+
+#ifndef HPX_PARTITIONED_VECTOR_VIEW_HPP
+#define HPX_PARTITIONED_VECTOR_VIEW_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_fwd.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace hpx
+{
+    /// hpx::partitioned_vector_view gives direct access to the partitions of
+    /// a hpx::partitioned_vector which are located on the calling locality.
+    ///
+    /// No data is copied, the view refers to the elements stored in the
+    /// partitions themselves. The partitions are kept alive (pinned) for as
+    /// long as the view exists. Elements are addressed using their global
+    /// index in the vector.
+    ///
+    /// \note The view does not synchronize accesses to the elements. It is
+    ///       the responsibility of the user to avoid concurrent modifications
+    ///       through other means (e.g. remote accesses or algorithms).
+    ///
+    template <typename T, typename Data = std::vector<T> >
+    class partitioned_vector_view
+    {
+    private:
+        typedef server::partitioned_vector<T, Data> partition_server;
+
+    public:
+        typedef typename Data::size_type size_type;
+        typedef typename Data::reference reference;
+        typedef typename Data::const_reference const_reference;
+        typedef typename Data::iterator iterator;
+        typedef typename Data::const_iterator const_iterator;
+
+        /// A partition of the vector which is located on this locality.
+        class segment
+        {
+        public:
+            segment(std::shared_ptr<partition_server> const& data,
+                    size_type offset)
+              : data_(data), offset_(offset)
+            {}
+
+            /// Return the global index of the first element of the segment
+            size_type global_offset() const { return offset_; }
+
+            /// Return the number of elements in the segment
+            size_type size() const { return data_->size(); }
+
+            /// Return whether the element with the given global index is
+            /// stored in this segment
+            bool contains(size_type global_index) const
+            {
+                return global_index >= offset_ &&
+                    global_index - offset_ < size();
+            }
+
+            iterator begin() { return data_->begin(); }
+            const_iterator begin() const { return data_->cbegin(); }
+            iterator end() { return data_->end(); }
+            const_iterator end() const { return data_->cend(); }
+
+            /// Return the underlying data of the partition
+            Data& data() { return data_->get_data(); }
+            Data const& data() const { return data_->get_data(); }
+
+        private:
+            std::shared_ptr<partition_server> data_;
+            size_type offset_;
+        };
+
+        typedef typename std::vector<segment>::iterator segment_iterator;
+        typedef typename std::vector<segment>::const_iterator
+            const_segment_iterator;
+
+        /// Create a view of all partitions of the given vector which are
+        /// located on this locality.
+        explicit partitioned_vector_view(partitioned_vector<T, Data>& v)
+          : size_(0)
+        {
+            std::size_t offset = 0;
+            for (auto const& part : v.partitions_)
+            {
+                if (part.local_data_)
+                {
+                    segments_.push_back(segment(part.local_data_, offset));
+                    size_ += part.size_;
+                }
+                offset += part.size_;
+            }
+        }
+
+        /// Return the overall number of elements located on this locality
+        size_type size() const { return size_; }
+
+        /// Return whether no elements of the vector are located on this
+        /// locality
+        bool empty() const { return size_ == 0; }
+
+        /// Return whether the element with the given global index is
+        /// located on this locality
+        bool is_local(size_type global_index) const
+        {
+            return find_segment(global_index) != segments_.end();
+        }
+
+        /// Access the element with the given global index, the element has
+        /// to be located on this locality.
+        reference operator[](size_type global_index)
+        {
+            segment_iterator it = find_segment(global_index);
+            HPX_ASSERT(it != segments_.end());
+            return it->data()[global_index - it->global_offset()];
+        }
+        const_reference operator[](size_type global_index) const
+        {
+            const_segment_iterator it = find_segment(global_index);
+            HPX_ASSERT(it != segments_.end());
+            return it->data()[global_index - it->global_offset()];
+        }
+
+        /// Return the segment holding the element with the given global
+        /// index or segment_end() if this element is not located on this
+        /// locality.
+        segment_iterator find_segment(size_type global_index)
+        {
+            segment_iterator it = std::upper_bound(
+                segments_.begin(), segments_.end(), global_index,
+                [](size_type index, segment const& s)
+                {
+                    return index < s.global_offset();
+                });
+
+            if (it == segments_.begin() || !(--it)->contains(global_index))
+                return segments_.end();
+            return it;
+        }
+        const_segment_iterator find_segment(size_type global_index) const
+        {
+            const_segment_iterator it = std::upper_bound(
+                segments_.begin(), segments_.end(), global_index,
+                [](size_type index, segment const& s)
+                {
+                    return index < s.global_offset();
+                });
+
+            if (it == segments_.begin() || !(--it)->contains(global_index))
+                return segments_.end();
+            return it;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        segment_iterator segment_begin() { return segments_.begin(); }
+        const_segment_iterator segment_begin() const
+        {
+            return segments_.begin();
+        }
+        const_segment_iterator segment_cbegin() const
+        {
+            return segments_.cbegin();
+        }
+
+        segment_iterator segment_end() { return segments_.end(); }
+        const_segment_iterator segment_end() const { return segments_.end(); }
+        const_segment_iterator segment_cend() const
+        {
+            return segments_.cend();
+        }
+
+        std::size_t num_segments() const { return segments_.size(); }
+
+    private:
+        std::vector<segment> segments_;
+        size_type size_;
+    };
+}
+
+#endif
@@ -0,0 +1,416 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/unordered/concurrent_unordered_map.hpp
+
+#ifndef HPX_CONCURRENT_UNORDERED_MAP_HPP
+#define HPX_CONCURRENT_UNORDERED_MAP_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace detail
+{
+    /// The concurrent_unordered_map is the hash table storing the elements
+    /// of a single partition of a hpx::unordered_map.
+    ///
+    /// The table uses open addressing with linear probing. Each slot refers
+    /// to an immutable node holding a key and its value, modifications
+    /// replace the whole node. Lookups never acquire a lock, they atomically
+    /// load the current table and the nodes along the probe sequence.
+    /// Modifications are serialized per key by one of a fixed number of
+    /// striped locks selected by the hash of the key, modifications of keys
+    /// guarded by different stripes proceed concurrently. A slot which was
+    /// claimed once stays claimed until the table is rebuilt, erased
+    /// elements leave a tombstone behind. The table is rebuilt while holding
+    /// all stripe locks whenever the number of claimed slots would exceed
+    /// half of its capacity.
+    ///
+    /// Nodes and tables are reference counted, a concurrent lookup keeps
+    /// the data it is looking at alive even if it is replaced meanwhile.
+    ///
+    template <typename Key, typename T, typename Hash = std::hash<Key>,
+        typename KeyEqual = std::equal_to<Key> >
+    class concurrent_unordered_map
+    {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef Hash hasher;
+        typedef KeyEqual key_equal;
+        typedef std::size_t size_type;
+
+        typedef std::unordered_map<Key, T, Hash, KeyEqual> snapshot_type;
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        static HPX_CONSTEXPR_OR_CONST std::size_t num_stripes = 64;
+        static HPX_CONSTEXPR_OR_CONST std::size_t min_capacity = 16;
+
+        struct node
+        {
+            node(std::size_t hash, Key const& key, T const& value,
+                    bool erased = false)
+              : hash_(hash), key_(key), value_(value), erased_(erased)
+            {}
+
+            std::size_t const hash_;
+            Key const key_;
+            T const value_;
+            bool const erased_;
+        };
+        typedef std::shared_ptr<node const> node_ptr;
+
+        struct table
+        {
+            explicit table(std::size_t capacity)
+              : slots_(capacity), used_(0)
+            {
+                HPX_ASSERT(capacity != 0 && (capacity & (capacity - 1)) == 0);
+            }
+
+            std::size_t mask() const { return slots_.size() - 1; }
+
+            // The maximum number of slots which may be claimed before the
+            // table has to be rebuilt. This guarantees that every probe
+            // sequence runs into an empty slot.
+            std::size_t max_used() const { return slots_.size() / 2; }
+
+            std::vector<node_ptr> slots_;
+            std::atomic<std::size_t> used_;
+        };
+        typedef std::shared_ptr<table> table_ptr;
+
+        // avoid false sharing between the stripe locks
+        struct stripe
+        {
+            mutex_type mtx_;
+            char pad_[64];
+        };
+
+        static std::size_t capacity_for(std::size_t count)
+        {
+            std::size_t capacity = min_capacity;
+            while (capacity < 2 * count)
+                capacity *= 2;
+            return capacity;
+        }
+
+        mutex_type& stripe_for(std::size_t hash) const
+        {
+            return stripes_[hash % num_stripes].mtx_;
+        }
+
+        void lock_all() const
+        {
+            for (std::size_t i = 0; i != num_stripes; ++i)
+                stripes_[i].mtx_.lock();
+        }
+
+        void unlock_all() const
+        {
+            for (std::size_t i = num_stripes; i != 0; --i)
+                stripes_[i - 1].mtx_.unlock();
+        }
+
+        // Return the slot holding the node for the given key, or the first
+        // empty slot of its probe sequence.
+        std::size_t probe(table const& t, std::size_t hash, Key const& key,
+            node_ptr& n) const
+        {
+            std::size_t const mask = t.mask();
+            for (std::size_t i = hash & mask; /**/; i = (i + 1) & mask)
+            {
+                n = std::atomic_load(&t.slots_[i]);
+                if (!n || (n->hash_ == hash && equal_(n->key_, key)))
+                    return i;
+            }
+        }
+
+        node_ptr find_node(Key const& key) const
+        {
+            std::size_t const hash = hash_(key);
+            table_ptr t = std::atomic_load(&table_);
+
+            node_ptr n;
+            probe(*t, hash, key, n);
+            if (n && !n->erased_)
+                return n;
+            return node_ptr();
+        }
+
+        // Rebuild the table if it was not replaced since it was found to be
+        // full, tombstones are dropped.
+        void rebuild(table_ptr const& full)
+        {
+            lock_all();
+            try {
+                if (std::atomic_load(&table_) == full)
+                {
+                    table_ptr t = std::make_shared<table>(
+                        capacity_for(2 * size_.load()));
+
+                    std::size_t const mask = t->mask();
+                    for (node_ptr const& slot : full->slots_)
+                    {
+                        node_ptr n = std::atomic_load(&slot);
+                        if (!n || n->erased_)
+                            continue;
+
+                        std::size_t i = n->hash_ & mask;
+                        while (t->slots_[i])
+                            i = (i + 1) & mask;
+                        t->slots_[i] = std::move(n);
+                        ++t->used_;
+                    }
+
+                    std::atomic_store(&table_, std::move(t));
+                }
+            }
+            catch (...) {
+                unlock_all();
+                throw;
+            }
+            unlock_all();
+        }
+
+        // Store the given value for the given key, replacing the node
+        // stored for this key before (if any).
+        void store(Key const& key, T const& value)
+        {
+            std::size_t const hash = hash_(key);
+            while (true)
+            {
+                std::unique_lock<mutex_type> l(stripe_for(hash));
+                table_ptr t = std::atomic_load(&table_);
+
+                node_ptr n;
+                std::size_t i = probe(*t, hash, key, n);
+                if (n)
+                {
+                    // the key is known, nobody else may modify this slot as
+                    // we hold the lock for this key
+                    bool was_erased = n->erased_;
+                    std::atomic_store(&t->slots_[i],
+                        std::make_shared<node const>(hash, key, value));
+                    if (was_erased)
+                        ++size_;
+                    return;
+                }
+
+                // reserve a slot
+                if (t->used_.fetch_add(1) >= t->max_used())
+                {
+                    --t->used_;
+                    l.unlock();
+                    rebuild(t);
+                    continue;
+                }
+
+                node_ptr new_node =
+                    std::make_shared<node const>(hash, key, value);
+                std::size_t const mask = t->mask();
+                while (true)
+                {
+                    // keys of other stripes may claim empty slots
+                    // concurrently
+                    node_ptr expected;
+                    if (std::atomic_compare_exchange_strong(
+                            &t->slots_[i], &expected, new_node))
+                    {
+                        break;
+                    }
+                    i = (i + 1) & mask;
+                    while (std::atomic_load(&t->slots_[i]))
+                        i = (i + 1) & mask;
+                }
+                ++size_;
+                return;
+            }
+        }
+
+    public:
+        explicit concurrent_unordered_map(size_type bucket_count = 0,
+                Hash const& hash = Hash(), KeyEqual const& equal = KeyEqual())
+          : table_(std::make_shared<table>(capacity_for(bucket_count))),
+            size_(0), hash_(hash), equal_(equal)
+        {}
+
+        concurrent_unordered_map(concurrent_unordered_map const& rhs)
+          : table_(std::make_shared<table>(capacity_for(0))),
+            size_(0), hash_(rhs.hash_), equal_(rhs.equal_)
+        {
+            assign(rhs.snapshot());
+        }
+
+        concurrent_unordered_map& operator=(
+            concurrent_unordered_map const& rhs)
+        {
+            if (this != &rhs)
+                assign(rhs.snapshot());
+            return *this;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Return the number of elements
+        size_type size() const
+        {
+            return size_.load();
+        }
+
+        /// Return the maximum possible number of elements
+        size_type max_size() const
+        {
+            return (std::numeric_limits<size_type>::max)() / 2;
+        }
+
+        /// Return whether the map holds no elements
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Copy the value stored for the given key into \a value, return
+        /// whether the key was found.
+        bool find(Key const& key, T& value) const
+        {
+            node_ptr n = find_node(key);
+            if (!n)
+                return false;
+
+            value = n->value_;
+            return true;
+        }
+
+        /// Return whether the given key is stored in the map
+        bool contains(Key const& key) const
+        {
+            return !!find_node(key);
+        }
+
+        /// Store the given value for the given key, replacing the value
+        /// stored before.
+        void insert_or_assign(Key const& key, T const& value)
+        {
+            store(key, value);
+        }
+
+        /// Erase the element with the given key, return the number of
+        /// elements erased.
+        size_type erase(Key const& key)
+        {
+            T value;
+            return extract(key, value) ? 1 : 0;
+        }
+
+        /// Erase the element with the given key and move its value to
+        /// \a value, return whether the key was found.
+        bool extract(Key const& key, T& value)
+        {
+            std::size_t const hash = hash_(key);
+
+            std::lock_guard<mutex_type> l(stripe_for(hash));
+            table_ptr t = std::atomic_load(&table_);
+
+            node_ptr n;
+            std::size_t i = probe(*t, hash, key, n);
+            if (!n || n->erased_)
+                return false;
+
+            std::atomic_store(&t->slots_[i], std::make_shared<node const>(
+                hash, key, T(), true));
+            --size_;
+
+            value = n->value_;
+            return true;
+        }
+
+        /// Remove all elements
+        void clear()
+        {
+            lock_all();
+            std::atomic_store(&table_,
+                std::make_shared<table>(capacity_for(0)));
+            size_.store(0);
+            unlock_all();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Call the given function for each element, modifications which
+        /// happen concurrently may or may not be visible.
+        template <typename F>
+        void for_each(F && f) const
+        {
+            table_ptr t = std::atomic_load(&table_);
+            for (node_ptr const& slot : t->slots_)
+            {
+                node_ptr n = std::atomic_load(&slot);
+                if (n && !n->erased_)
+                    f(n->key_, n->value_);
+            }
+        }
+
+        /// Return a copy of all elements as a std::unordered_map, the copy
+        /// is consistent if no modifications happen concurrently.
+        snapshot_type snapshot() const
+        {
+            snapshot_type result(size(), hash_, equal_);
+            for_each(
+                [&result](Key const& key, T const& value)
+                {
+                    result.emplace(key, value);
+                });
+            return result;
+        }
+
+        /// Replace all elements with the ones from the given map
+        void assign(snapshot_type const& data)
+        {
+            table_ptr t = std::make_shared<table>(capacity_for(data.size()));
+
+            std::size_t const mask = t->mask();
+            for (auto const& v : data)
+            {
+                std::size_t const hash = hash_(v.first);
+                std::size_t i = hash & mask;
+                while (t->slots_[i])
+                    i = (i + 1) & mask;
+
+                t->slots_[i] = std::make_shared<node const>(
+                    hash, v.first, v.second);
+                ++t->used_;
+            }
+
+            lock_all();
+            std::atomic_store(&table_, std::move(t));
+            size_.store(data.size());
+            unlock_all();
+        }
+
+    private:
+        table_ptr table_;
+        std::atomic<size_type> size_;
+
+        Hash hash_;
+        KeyEqual equal_;
+
+        mutable stripe stripes_[num_stripes];
+    };
+}}
+
+#endif
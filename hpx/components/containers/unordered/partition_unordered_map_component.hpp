@@ -12,26 +12,30 @@
 ///
 /// \brief The partition_unordered_map as the hpx component is defined here.
 ///
-/// The partition_unordered_map is the wrapper to the stl unordered_map class
+/// The partition_unordered_map is the wrapper to a concurrent hash map
 /// except all API'are defined as component action. All the API's in client
 /// classes are asynchronous API which return the futures.
 
 #include <hpx/config.hpp>
 #include <hpx/lcos/reduce.hpp>
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <hpx/parallel/execution_policy.hpp>
 #include <hpx/runtime/actions/basic_action.hpp>
 #include <hpx/runtime/actions/component_action.hpp>
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
-#include <hpx/runtime/components/server/locking_hook.hpp>
 #include <hpx/runtime/components/server/simple_component_base.hpp>
 #include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 
+#include <hpx/components/containers/unordered/concurrent_unordered_map.hpp>
+
 #include <boost/preprocessor/cat.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <iostream>
 #include <memory>
@@ -43,31 +47,38 @@
 
 namespace hpx { namespace server
 {
-    /// \brief This is the basic wrapper class for stl unordered_map.
+    /// \brief This is the basic wrapper class for a concurrent hash map.
     ///
     /// This contain the implementation of the partition_unordered_map's
-    /// component functionality.
+    /// component functionality. The elements are stored in a
+    /// hpx::detail::concurrent_unordered_map, which allows for the actions
+    /// invoked on a partition to run concurrently. Lookups do not acquire
+    /// any locks, modifications of different keys rarely contend.
     template <typename Key, typename T, typename Hash = std::hash<Key>,
         typename KeyEqual = std::equal_to<Key> >
     class partition_unordered_map
-      : public components::locking_hook<
-            hpx::components::simple_component_base<
-                partition_unordered_map<Key, T, Hash, KeyEqual> > >
+      : public hpx::components::simple_component_base<
+            partition_unordered_map<Key, T, Hash, KeyEqual> >
     {
     public:
+        typedef hpx::detail::concurrent_unordered_map<Key, T, Hash, KeyEqual>
+            storage_type;
+
+        // the type used to copy all data of a partition at once
         typedef std::unordered_map<Key, T, Hash, KeyEqual> data_type;
 
-        typedef typename data_type::size_type size_type;
-        typedef typename data_type::iterator iterator_type;
-        typedef typename data_type::const_iterator const_iterator_type;
+        typedef typename storage_type::size_type size_type;
 
-        typedef components::locking_hook<
-                hpx::components::simple_component_base<
-                    partition_unordered_map<Key, T, Hash, KeyEqual> > >
+        typedef hpx::components::simple_component_base<
+                partition_unordered_map<Key, T, Hash, KeyEqual> >
             base_type;
 
     private:
-        data_type partition_unordered_map_;
+        // Batches of at least this many keys are handled in parallel by
+        // get_values and set_values.
+        static HPX_CONSTEXPR_OR_CONST std::size_t parallel_threshold = 512;
+
+        storage_type partition_unordered_map_;
 
     public:
         ///////////////////////////////////////////////////////////////////////
@@ -105,56 +116,14 @@ namespace hpx { namespace server
             return *this;
         }
 
-        partition_unordered_map(partition_unordered_map && rhs)
-          : base_type(std::move(rhs)),
-            partition_unordered_map_(std::move(rhs.partition_unordered_map_))
-        {}
-
-        partition_unordered_map& operator=(partition_unordered_map && rhs)
-        {
-            if (this != &rhs)
-            {
-                this->base_type::operator=(std::move(rhs));
-                partition_unordered_map_ = std::move(rhs.partition_unordered_map_);
-            }
-            return *this;
-        }
-
         /// Duplicate the copy method for action naming
         data_type get_copied_data() const
         {
-            return partition_unordered_map_;
+            return partition_unordered_map_.snapshot();
         }
         void set_copied_data(data_type && d)
         {
-            partition_unordered_map_ = std::move(d);
-        }
-
-        ///////////////////////////////////////////////////////////////////////
-        iterator_type begin()
-        {
-            return partition_unordered_map_.begin();
-        }
-        const_iterator_type begin() const
-        {
-            return partition_unordered_map_.begin();
-        }
-        const_iterator_type cbegin() const
-        {
-            return partition_unordered_map_.cbegin();
-        }
-
-        iterator_type end()
-        {
-            return partition_unordered_map_.end();
-        }
-        const_iterator_type end() const
-        {
-            return partition_unordered_map_.end();
-        }
-        const_iterator_type cend() const
-        {
-            return partition_unordered_map_.cend();
+            partition_unordered_map_.assign(d);
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -173,15 +142,7 @@ namespace hpx { namespace server
             return partition_unordered_map_.max_size();
         }
 
-        /// Returns the number of elements that the container has currently
-        /// allocated space for.
-        size_type capacity() const
-        {
-            return partition_unordered_map_.capacity();
-        }
-
-        /// Checks if the container has no elements, i.e. whether
-        /// begin() == end().
+        /// Checks if the container has no elements.
         bool empty() const
         {
             return partition_unordered_map_.empty();
@@ -191,72 +152,68 @@ namespace hpx { namespace server
         // Element access API's
         ///////////////////////////////////////////////////////////////////////
 
-        /// Return the element at the position \a pos in the partition_unordered_map
-        /// container.
+        /// Return the element with the given key in the
+        /// partition_unordered_map container.
         ///
-        /// \param pos Position of the element in the partition_unordered_map
+        /// \param key   Key of the element in the partition_unordered_map
+        /// \param erase Erase the element after retrieving its value
         ///
-        /// \return Return the value of the element at position represented
-        ///         by \a pos.
+        /// \return Return the value of the element with the given key.
         ///
-        struct erase_on_exit
-        {
-            erase_on_exit(data_type& m, typename data_type::iterator& it)
-              : m_(m), it_(it)
-            {}
-            ~erase_on_exit()
-            {
-                m_.erase(it_);
-            }
-
-            data_type& m_;
-            typename data_type::iterator& it_;
-        };
-
         T get_value(Key const& key, bool erase)
         {
-            typename data_type::iterator it = partition_unordered_map_.find(key);
-            if (it == partition_unordered_map_.end())
+            T value;
+            bool found = erase ?
+                partition_unordered_map_.extract(key, value) :
+                partition_unordered_map_.find(key, value);
+
+            if (!found)
             {
                 HPX_THROW_EXCEPTION(bad_parameter,
                     "partition_unordered_map::get_value",
                     "unable to find requested key in this partition of the "
                     "unordered_map");
             }
-
-            if (!erase)
-                return it->second;
-
-            erase_on_exit t(partition_unordered_map_, it);
-            return it->second;
+            return value;
         }
 
-        /// Return the element at the position \a pos in the partition_unordered_map
-        /// container.
+        /// Return the elements with the given keys in the
+        /// partition_unordered_map container. Large batches are looked up
+        /// in parallel.
         ///
-        /// \param pos Positions of the elements in the partition_unordered_map
+        /// \param keys Keys of the elements in the partition_unordered_map
         ///
-        /// \return Return the values of the elements at position represented
-        ///         by \a pos.
+        /// \return Return the values of the elements with the given keys.
         ///
         std::vector<T> get_values(std::vector<Key> const& keys)
         {
-            std::vector<T> result;
-            result.reserve(keys.size());
+            std::vector<T> result(keys.size());
+            std::atomic<bool> missing(false);
 
-            for (std::size_t i = 0; i != keys.size(); ++i)
-            {
-                typename data_type::iterator it =
-                    partition_unordered_map_.find(keys[i]);
-                if (it == partition_unordered_map_.end())
+            auto f =
+                [&](std::size_t i)
                 {
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "partition_unordered_map::get_values",
-                        "unable to find requested key in this partition of the "
-                        "unordered_map");
-                    break;
-                }
-                result.push_back(it->second);
+                    if (!partition_unordered_map_.find(keys[i], result[i]))
+                        missing.store(true);
+                };
+
+            if (keys.size() >= parallel_threshold)
+            {
+                parallel::for_loop(parallel::execution::par,
+                    std::size_t(0), keys.size(), f);
+            }
+            else
+            {
+                for (std::size_t i = 0; i != keys.size(); ++i)
+                    f(i);
+            }
+
+            if (missing.load())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "partition_unordered_map::get_values",
+                    "unable to find requested key in this partition of the "
+                    "unordered_map");
             }
             return result;
         }
@@ -265,37 +222,54 @@ namespace hpx { namespace server
         // Modifiers API's in server class
         ///////////////////////////////////////////////////////////////////////
 
-        /// Copy the value of \a val in the element at position \a pos in the
+        /// Copy the value of \a val in the element with the given key in the
         /// partition_unordered_map container.
         ///
-        /// \param pos   Position of the element in the partition_unordered_map
+        /// \param key   Key of the element in the partition_unordered_map
         ///
         /// \param val   The value to be copied
         ///
-        void set_value(Key const& pos, T const& val)
+        void set_value(Key const& key, T const& val)
         {
-            partition_unordered_map_[pos] = val;
+            partition_unordered_map_.insert_or_assign(key, val);
         }
 
-        /// Copy the value of \a val for the elements at positions \a pos in
-        /// the partition_unordered_map container.
+        /// Copy the value of \a val for the elements with the given keys in
+        /// the partition_unordered_map container. Large batches are stored
+        /// in parallel.
         ///
-        /// \param pos   Positions of the elements in the partition_unordered_map
+        /// \param keys  Keys of the elements in the partition_unordered_map
         ///
-        /// \param val   The value to be copied
+        /// \param val   The values to be copied
+        ///
+        /// \note If a key appears more than once in a batch, it is not
+        ///       specified which of the corresponding values is stored.
         ///
         void set_values(std::vector<Key> const& keys,
             std::vector<T> const& val)
         {
             HPX_ASSERT(keys.size() == val.size());
-            HPX_ASSERT(keys.size() <= partition_unordered_map_.size());
 
-            for (std::size_t i = 0; i != keys.size(); ++i)
-                partition_unordered_map_[keys[i]] = val[i];
+            auto f =
+                [&](std::size_t i)
+                {
+                    partition_unordered_map_.insert_or_assign(keys[i], val[i]);
+                };
+
+            if (keys.size() >= parallel_threshold)
+            {
+                parallel::for_loop(parallel::execution::par,
+                    std::size_t(0), keys.size(), f);
+            }
+            else
+            {
+                for (std::size_t i = 0; i != keys.size(); ++i)
+                    f(i);
+            }
         }
 
-        /// Remove all elements from the vector leaving the
-        /// partition_unordered_map with size 0.
+        /// Remove all elements from the partition_unordered_map leaving it
+        /// with size 0.
         ///
         void clear()
         {
@@ -312,10 +286,10 @@ namespace hpx { namespace server
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, size);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, get_value);
-        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, get_values);
+        HPX_DEFINE_COMPONENT_ACTION(partition_unordered_map, get_values);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, set_value);
-        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, set_values);
+        HPX_DEFINE_COMPONENT_ACTION(partition_unordered_map, set_values);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, erase);
 
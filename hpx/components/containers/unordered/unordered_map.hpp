@@ -9,7 +9,9 @@
 #define HPX_UNORDERED_MAP_NOV_11_2014_0852PM
 
 #include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/components/copy_component.hpp>
@@ -789,6 +791,177 @@ namespace hpx
                 .set_value(pos, std::forward<T_>(val));
         }
 
+        /// Asynchronously returns the elements with the given keys in the
+        /// unordered_map container.
+        ///
+        /// The keys are grouped by the partition they belong to, each group
+        /// is looked up using a single (possibly remote) operation, all
+        /// groups are handled concurrently.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        ///
+        /// \return Returns the hpx::future to the values of the elements,
+        ///         in the same order as the given keys.
+        ///
+        future<std::vector<T> > get_values(std::vector<Key> const& keys) const
+        {
+            std::vector<std::vector<Key> > part_keys(partitions_.size());
+            std::vector<std::vector<std::size_t> > part_index(
+                partitions_.size());
+
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                size_type part = get_partition(keys[i]);
+                part_keys[part].push_back(keys[i]);
+                part_index[part].push_back(i);
+            }
+
+            std::vector<future<std::vector<T> > > results;
+            std::vector<std::vector<std::size_t> > indices;
+            for (std::size_t part = 0; part != partitions_.size(); ++part)
+            {
+                if (part_keys[part].empty())
+                    continue;
+
+                results.push_back(get_values(part, part_keys[part]));
+                indices.push_back(std::move(part_index[part]));
+            }
+
+            std::size_t const size = keys.size();
+            return dataflow(
+                [size, indices](std::vector<future<std::vector<T> > > && r)
+                ->  std::vector<T>
+                {
+                    std::vector<T> values(size);
+                    for (std::size_t i = 0; i != r.size(); ++i)
+                    {
+                        std::vector<T> part_values = r[i].get();
+                        HPX_ASSERT(part_values.size() == indices[i].size());
+
+                        for (std::size_t j = 0; j != part_values.size(); ++j)
+                            values[indices[i][j]] = std::move(part_values[j]);
+                    }
+                    return values;
+                },
+                std::move(results));
+        }
+
+        /// Returns the elements with the given keys in the unordered_map
+        /// container.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        ///
+        /// \return Returns the values of the elements, in the same order
+        ///         as the given keys.
+        ///
+        std::vector<T> get_values(launch::sync_policy,
+            std::vector<Key> const& keys) const
+        {
+            return get_values(keys).get();
+        }
+
+        /// Asynchronously returns the elements with the given keys in the
+        /// given partition of the unordered_map container.
+        ///
+        /// \param part  Sequence number of the partition
+        /// \param keys  Keys of the elements in the partition
+        ///
+        /// \return Returns the hpx::future to the values of the elements.
+        ///
+        future<std::vector<T> >
+        get_values(size_type part, std::vector<Key> const& keys) const
+        {
+            HPX_ASSERT(part < partitions_.size());
+
+            partition_data const& part_data = partitions_[part];
+            if (part_data.local_data_)
+            {
+                return make_ready_future(
+                    part_data.local_data_->get_values(keys));
+            }
+
+            return partition_unordered_map_client(part_data.partition_)
+                .get_values(keys);
+        }
+
+        /// Asynchronously sets the elements with the given keys in the
+        /// unordered_map container to the given values.
+        ///
+        /// The keys are grouped by the partition they belong to, each group
+        /// is stored using a single (possibly remote) operation, all groups
+        /// are handled concurrently.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        /// \param vals  The values to be copied
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void> set_values(std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            HPX_ASSERT(keys.size() == vals.size());
+
+            std::vector<std::vector<Key> > part_keys(partitions_.size());
+            std::vector<std::vector<T> > part_vals(partitions_.size());
+
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                size_type part = get_partition(keys[i]);
+                part_keys[part].push_back(keys[i]);
+                part_vals[part].push_back(vals[i]);
+            }
+
+            std::vector<future<void> > results;
+            for (std::size_t part = 0; part != partitions_.size(); ++part)
+            {
+                if (part_keys[part].empty())
+                    continue;
+
+                results.push_back(
+                    set_values(part, part_keys[part], part_vals[part]));
+            }
+            return when_all(results);
+        }
+
+        /// Sets the elements with the given keys in the unordered_map
+        /// container to the given values.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        /// \param vals  The values to be copied
+        ///
+        void set_values(launch::sync_policy, std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            set_values(keys, vals).get();
+        }
+
+        /// Asynchronously sets the elements with the given keys in the given
+        /// partition of the unordered_map container to the given values.
+        ///
+        /// \param part  Sequence number of the partition
+        /// \param keys  Keys of the elements in the partition
+        /// \param vals  The values to be copied
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void> set_values(size_type part, std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            HPX_ASSERT(part < partitions_.size());
+
+            partition_data const& part_data = partitions_[part];
+            if (part_data.local_data_)
+            {
+                part_data.local_data_->set_values(keys, vals);
+                return make_ready_future();
+            }
+
+            return partition_unordered_map_client(part_data.partition_)
+                .set_values(keys, vals);
+        }
+
         /// Asynchronously compute the size of the unordered_map.
         ///
         /// \return Return the number of elements in the unordered_map
@@ -116,6 +116,32 @@
 #  define HPX_PARCEL_IPC_DATA_BUFFER_CACHE_SIZE 512
 #endif
 
+/// This defines the size (in bytes) of the shared memory ring buffer each
+/// locality uses to receive messages from other localities on the same node.
+/// This value can be changed at runtime by setting the configuration
+/// parameter:
+///
+///   hpx.parcel.ipc.ring_buffer_size = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_IPC_RING_BUFFER_SIZE).
+#if !defined(HPX_PARCEL_IPC_RING_BUFFER_SIZE)
+#  define HPX_PARCEL_IPC_RING_BUFFER_SIZE 4194304
+#endif
+
+/// This defines the size (in bytes) above which parts of a message are
+/// handed off to the receiving locality through a separate shared memory
+/// segment instead of being copied through the ring buffer. This value can
+/// be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.ipc.zero_copy_threshold = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_IPC_ZERO_COPY_THRESHOLD).
+#if !defined(HPX_PARCEL_IPC_ZERO_COPY_THRESHOLD)
+#  define HPX_PARCEL_IPC_ZERO_COPY_THRESHOLD 65536
+#endif
+
 /// This defines the number of MPI requests in flight
 /// This value can be changed at runtime by setting the configuration parameter:
 ///
@@ -394,6 +420,18 @@
 #  define HPX_BUSY_LOOP_COUNT_MAX 2000
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// Count number of empty thread manager loop executions before an idle worker
+// thread is parked (if idle parking is enabled)
+#if !defined(HPX_IDLE_PARKING_SPIN_COUNT)
+#  define HPX_IDLE_PARKING_SPIN_COUNT 1000
+#endif
+
+// Maximal time (in microseconds) an idle worker thread stays parked
+#if !defined(HPX_IDLE_PARKING_MAX_TIME)
+#  define HPX_IDLE_PARKING_MAX_TIME 1000
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // Count number of terminated threads before forcefully cleaning up all of
 // them. Note: terminated threads are cleaned up either when this number is
@@ -0,0 +1,12 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COMPRESSION_LZ4_HPP)
+#define HPX_COMPRESSION_LZ4_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter.hpp>
+
+#endif
@@ -15,12 +15,17 @@
 
 #include <hpx/lcos/packaged_action.hpp>
 
+#include <hpx/lcos/all_gather.hpp>
+#include <hpx/lcos/all_reduce.hpp>
+#include <hpx/lcos/all_to_all.hpp>
 #include <hpx/lcos/barrier.hpp>
 #include <hpx/lcos/channel.hpp>
+#include <hpx/lcos/communicator.hpp>
 #include <hpx/lcos/gather.hpp>
 #include <hpx/lcos/latch.hpp>
 #include <hpx/lcos/queue.hpp>
 #include <hpx/lcos/reduce.hpp>
+#include <hpx/lcos/scatter.hpp>
 
 #include <hpx/include/async.hpp>
 #include <hpx/include/dataflow.hpp>
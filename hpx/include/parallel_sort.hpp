@@ -8,7 +8,9 @@
 
 #include <hpx/parallel/algorithms/sort.hpp>
 #include <hpx/parallel/algorithms/sort_by_key.hpp>
+#include <hpx/parallel/algorithms/stable_sort.hpp>
 #include <hpx/parallel/container_algorithms/sort.hpp>
+#include <hpx/parallel/segmented_algorithms/sort.hpp>
 
 #endif
 
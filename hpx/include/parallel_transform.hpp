@@ -9,6 +9,7 @@
 
 #include <hpx/parallel/algorithms/transform.hpp>
 #include <hpx/parallel/container_algorithms/transform.hpp>
+#include <hpx/parallel/segmented_algorithms/transform.hpp>
 
 #endif
 
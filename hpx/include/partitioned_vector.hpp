@@ -7,6 +7,8 @@
 #define HPX_PARTITIONED_VECTOR_NOV_02_2014_0636PM
 
 #include <hpx/components/containers/partitioned_vector/partitioned_vector.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_aggregator.hpp>
+#include <hpx/components/containers/partitioned_vector/partitioned_vector_view.hpp>
 
 #endif
 
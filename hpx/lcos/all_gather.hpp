@@ -0,0 +1,194 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_gather.hpp
+
+#if !defined(HPX_LCOS_ALL_GATHER_HPP)
+#define HPX_LCOS_ALL_GATHER_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// AllGather a set of values from different call sites
+    ///
+    /// This function collects the values contributed by all sites of the
+    /// given communicator and makes them available on all sites.
+    ///
+    /// \param  comm        The communicator connecting the participating
+    ///                     sites.
+    /// \param  value       The value contributed by this call site.
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     communicator. This is optional, by default the
+    ///                     operations are numbered in the order they are
+    ///                     invoked on each site.
+    /// \param  message_size The number of bytes of a value, used for selecting
+    ///                     the algorithm. This is optional, by default
+    ///                     sizeof(T) is used. All sites have to pass the same
+    ///                     message size, otherwise they would execute
+    ///                     different algorithms and never complete.
+    ///
+    /// \returns    This function returns a future holding a vector with all
+    ///             values ordered by the site which contributed them. It will
+    ///             become ready once the all_gather operation has been
+    ///             completed.
+    ///
+    /// \note       If the number of sites is a power of two and the gathered
+    ///             data is small, the values are exchanged using recursive
+    ///             doubling, which needs log2(num_sites) communication steps.
+    ///             Otherwise the values are passed around a ring, which sends
+    ///             every value over the network only once per site.
+    ///
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_gather(communicator<T> const& comm, T value,
+        std::size_t generation = std::size_t(-1),
+        std::size_t message_size = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/communicator.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        struct all_gather_data
+        {
+            all_gather_data(communicator<T> const& comm,
+                    std::size_t generation)
+              : comm_(comm), generation_(generation)
+            {}
+
+            communicator<T> comm_;
+            std::size_t generation_;
+            std::vector<T> values_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // After each step a site holds the values of a contiguous block of
+        // sites, the blocks of both partners are concatenated.
+        template <typename T>
+        hpx::future<std::vector<T> > all_gather_recursive_doubling(
+            std::shared_ptr<all_gather_data<T> > const& data,
+            std::size_t mask, std::size_t step)
+        {
+            std::size_t const this_site = data->comm_.this_site();
+            if (mask >= data->comm_.num_sites())
+                return hpx::make_ready_future(std::move(data->values_));
+
+            std::size_t partner = this_site ^ mask;
+
+            return hpx::when_all(
+                    data->comm_.set(partner, data->generation_, step,
+                        std::vector<T>(data->values_)),
+                    data->comm_.get(data->generation_, step)
+                ).then(hpx::launch::sync,
+                    [=](hpx::future<hpx::util::tuple<
+                            hpx::future<void>, hpx::future<std::vector<T> >
+                        > > && f) -> hpx::future<std::vector<T> >
+                    {
+                        std::vector<T> received = exchanged_data(std::move(f));
+                        HPX_ASSERT(received.size() == mask);
+
+                        std::vector<T>& values = data->values_;
+                        if (partner < this_site)
+                            std::swap(values, received);
+
+                        values.insert(values.end(),
+                            std::make_move_iterator(received.begin()),
+                            std::make_move_iterator(received.end()));
+
+                        return all_gather_recursive_doubling(
+                            data, mask << 1, step + 1);
+                    });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // In step s each site forwards the value it received in the previous
+        // step to its right neighbor.
+        template <typename T>
+        hpx::future<std::vector<T> > all_gather_ring(
+            std::shared_ptr<all_gather_data<T> > const& data, std::size_t step)
+        {
+            std::size_t const num_sites = data->comm_.num_sites();
+            std::size_t const this_site = data->comm_.this_site();
+
+            if (step + 1 == num_sites)
+                return hpx::make_ready_future(std::move(data->values_));
+
+            std::size_t send_index = (this_site + num_sites - step) % num_sites;
+            std::size_t recv_index =
+                (this_site + num_sites - step - 1) % num_sites;
+
+            return hpx::when_all(
+                    data->comm_.set((this_site + 1) % num_sites,
+                        data->generation_, step + 1,
+                        std::vector<T>(1, data->values_[send_index])),
+                    data->comm_.get(data->generation_, step + 1)
+                ).then(
+                    [=](hpx::future<hpx::util::tuple<
+                            hpx::future<void>, hpx::future<std::vector<T> >
+                        > > && f) -> hpx::future<std::vector<T> >
+                    {
+                        std::vector<T> received = exchanged_data(std::move(f));
+                        HPX_ASSERT(received.size() == 1);
+
+                        data->values_[recv_index] = std::move(received[0]);
+                        return all_gather_ring(data, step + 1);
+                    });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_gather(communicator<T> const& comm, T value,
+        std::size_t generation = std::size_t(-1),
+        std::size_t message_size = std::size_t(-1))
+    {
+        HPX_ASSERT(comm);
+
+        if (generation == std::size_t(-1))
+            generation = comm.next_generation();
+
+        std::size_t const num_sites = comm.num_sites();
+        bool small_message =
+            detail::agreed_message_size<T>(message_size) * num_sites <=
+                HPX_COLLECTIVES_LARGE_MESSAGE_SIZE;
+
+        typedef detail::all_gather_data<T> data_type;
+        std::shared_ptr<data_type> data =
+            std::make_shared<data_type>(comm, generation);
+
+        if (small_message && detail::is_power_of_two(num_sites))
+        {
+            data->values_.reserve(num_sites);
+            data->values_.push_back(std::move(value));
+            return detail::all_gather_recursive_doubling(data, 1, 1);
+        }
+
+        data->values_.resize(num_sites);
+        data->values_[comm.this_site()] = std::move(value);
+        return detail::all_gather_ring(data, 0);
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,321 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_reduce.hpp
+
+#if !defined(HPX_LCOS_ALL_REDUCE_HPP)
+#define HPX_LCOS_ALL_REDUCE_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// AllReduce a set of values from different call sites
+    ///
+    /// This function combines the values contributed by all sites of the
+    /// given communicator and makes the result available on all sites.
+    ///
+    /// \param  comm        The communicator connecting the participating
+    ///                     sites.
+    /// \param  value       The value contributed by this call site.
+    /// \param  op          The binary reduction operation, it has to be
+    ///                     associative and commutative.
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     communicator. This is optional, by default the
+    ///                     operations are numbered in the order they are
+    ///                     invoked on each site.
+    /// \param  message_size The number of bytes of a value, used for selecting
+    ///                     the algorithm. This is optional, by default
+    ///                     sizeof(T) is used. All sites have to pass the same
+    ///                     message size, otherwise they would execute
+    ///                     different algorithms and never complete.
+    ///
+    /// \returns    This function returns a future holding the combined value.
+    ///             It will become ready once the all_reduce operation has
+    ///             been completed.
+    ///
+    /// \note       Small values are combined using recursive doubling, which
+    ///             needs log2(num_sites) communication steps. Large values
+    ///             are reduced along a binomial tree and broadcast back, which
+    ///             reduces the amount of data sent over the network. All
+    ///             sites compute the result by evaluating the same expression,
+    ///             which makes the result identical on all sites even for
+    ///             floating point values.
+    ///
+    template <typename T, typename F>
+    hpx::future<T>
+    all_reduce(communicator<T> const& comm, T value, F op,
+        std::size_t generation = std::size_t(-1),
+        std::size_t message_size = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/communicator.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The state of an all_reduce operation on one site, value_ holds the
+        // partial result computed so far.
+        template <typename T, typename F>
+        struct all_reduce_data
+        {
+            all_reduce_data(communicator<T> const& comm,
+                    std::size_t generation, T && value, F && op)
+              : comm_(comm), generation_(generation), value_(std::move(value)),
+                op_(std::move(op))
+            {
+                std::size_t num_sites = comm_.num_sites();
+                pof2_ = floor_power_of_two(num_sites);
+                rem_ = num_sites - pof2_;
+            }
+
+            // map a rank used during recursive doubling back to its site
+            std::size_t site(std::size_t rank) const
+            {
+                return rank < rem_ ? 2 * rank + 1 : rank + rem_;
+            }
+
+            // combine the partial result with the given value, the value
+            // contributed by the lower site goes first
+            void combine(std::vector<T> && received, bool received_first)
+            {
+                HPX_ASSERT(received.size() == 1);
+                if (received_first)
+                    value_ = op_(std::move(received[0]), std::move(value_));
+                else
+                    value_ = op_(std::move(value_), std::move(received[0]));
+            }
+
+            hpx::future<void> send(std::size_t site, std::size_t tag)
+            {
+                return comm_.set(site, generation_, tag,
+                    std::vector<T>(1, value_));
+            }
+
+            hpx::future<std::vector<T> > receive(std::size_t tag)
+            {
+                return comm_.get(generation_, tag);
+            }
+
+            communicator<T> comm_;
+            std::size_t generation_;
+            T value_;
+            F op_;
+            std::size_t pof2_;
+            std::size_t rem_;
+        };
+
+        template <typename T>
+        T single_value(std::vector<T> && received)
+        {
+            HPX_ASSERT(received.size() == 1);
+            return std::move(received[0]);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // recursive doubling between the ranks 0 ... pof2-1
+        template <typename T, typename F>
+        hpx::future<void> all_reduce_recursive_doubling(
+            std::shared_ptr<all_reduce_data<T, F> > const& data,
+            std::size_t rank, std::size_t mask, std::size_t step)
+        {
+            if (mask >= data->pof2_)
+                return hpx::make_ready_future();
+
+            std::size_t partner = rank ^ mask;
+
+            return hpx::when_all(
+                    data->send(data->site(partner), step),
+                    data->receive(step)
+                ).then(
+                    [=](hpx::future<hpx::util::tuple<
+                            hpx::future<void>, hpx::future<std::vector<T> >
+                        > > && f) -> hpx::future<void>
+                    {
+                        data->combine(exchanged_data(std::move(f)),
+                            partner < rank);
+
+                        return all_reduce_recursive_doubling(
+                            data, rank, mask << 1, step + 1);
+                    });
+        }
+
+        template <typename T, typename F>
+        hpx::future<T> all_reduce_recursive_doubling(
+            std::shared_ptr<all_reduce_data<T, F> > const& data)
+        {
+            std::size_t const this_site = data->comm_.this_site();
+            std::size_t const rem = data->rem_;
+
+            if (this_site >= 2 * rem)
+            {
+                return all_reduce_recursive_doubling(
+                        data, this_site - rem, 1, 1
+                    ).then(hpx::launch::sync,
+                        [data](hpx::future<void> && f) -> T
+                        {
+                            f.get();        // propagate errors
+                            return std::move(data->value_);
+                        });
+            }
+
+            // If the number of sites is not a power of two the first 2*rem
+            // sites pair up, the even sites hand their value to the next
+            // site and receive the result once it is available.
+            if (this_site % 2 == 0)
+            {
+                return hpx::when_all(
+                        data->send(this_site + 1, 0), data->receive(0)
+                    ).then(hpx::launch::sync,
+                        [](hpx::future<hpx::util::tuple<
+                                hpx::future<void>,
+                                hpx::future<std::vector<T> >
+                            > > && f)
+                        {
+                            return single_value(exchanged_data(std::move(f)));
+                        });
+            }
+
+            return data->receive(0).then(
+                [=](hpx::future<std::vector<T> > && f) -> hpx::future<void>
+                {
+                    data->combine(f.get(), true);
+
+                    return all_reduce_recursive_doubling(
+                            data, this_site / 2, 1, 1
+                        ).then(hpx::launch::sync,
+                            [=](hpx::future<void> && f) -> hpx::future<void>
+                            {
+                                f.get();        // propagate errors
+                                return data->send(this_site - 1, 0);
+                            });
+                }
+            ).then(hpx::launch::sync,
+                [data](hpx::future<void> && f) -> T
+                {
+                    f.get();                // propagate errors
+                    return std::move(data->value_);
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // broadcast the final value from site 0 along a binomial tree
+        template <typename T, typename F>
+        hpx::future<T> all_reduce_broadcast(
+            std::shared_ptr<all_reduce_data<T, F> > const& data)
+        {
+            std::size_t const num_sites = data->comm_.num_sites();
+            std::size_t const this_site = data->comm_.this_site();
+
+            std::size_t mask = this_site == 0 ?
+                floor_power_of_two(num_sites) : lowest_set_bit(this_site) >> 1;
+
+            std::vector<hpx::future<void> > sent;
+            for (/**/; mask != 0; mask >>= 1)
+            {
+                if (this_site + mask < num_sites)
+                    sent.push_back(data->send(this_site + mask, 0));
+            }
+
+            return hpx::when_all(sent).then(hpx::launch::sync,
+                [data](hpx::future<std::vector<hpx::future<void> > > && f)
+                    -> T
+                {
+                    for (hpx::future<void>& s : f.get())
+                        s.get();                // propagate errors
+                    return std::move(data->value_);
+                });
+        }
+
+        // reduce all values to site 0 along a binomial tree
+        template <typename T, typename F>
+        hpx::future<T> all_reduce_tree(
+            std::shared_ptr<all_reduce_data<T, F> > const& data,
+            std::size_t mask, std::size_t step)
+        {
+            std::size_t const num_sites = data->comm_.num_sites();
+            std::size_t const this_site = data->comm_.this_site();
+
+            if (mask >= num_sites)
+            {
+                HPX_ASSERT(this_site == 0);
+                return all_reduce_broadcast(data);
+            }
+
+            if (this_site & mask)
+            {
+                // hand the partial result to the parent and wait for the
+                // final value to be broadcast
+                return hpx::when_all(
+                        data->send(this_site - mask, step), data->receive(0)
+                    ).then(hpx::launch::sync,
+                        [data](hpx::future<hpx::util::tuple<
+                                hpx::future<void>,
+                                hpx::future<std::vector<T> >
+                            > > && f)
+                        {
+                            data->value_ =
+                                single_value(exchanged_data(std::move(f)));
+                            return all_reduce_broadcast(data);
+                        });
+            }
+
+            if (this_site + mask >= num_sites)
+                return all_reduce_tree(data, mask << 1, step + 1);
+
+            return data->receive(step).then(
+                [=](hpx::future<std::vector<T> > && f) -> hpx::future<T>
+                {
+                    data->combine(f.get(), false);
+                    return all_reduce_tree(data, mask << 1, step + 1);
+                });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename F>
+    hpx::future<T>
+    all_reduce(communicator<T> const& comm, T value, F op,
+        std::size_t generation = std::size_t(-1),
+        std::size_t message_size = std::size_t(-1))
+    {
+        HPX_ASSERT(comm);
+
+        if (generation == std::size_t(-1))
+            generation = comm.next_generation();
+
+        if (comm.num_sites() == 1)
+            return hpx::make_ready_future(std::move(value));
+
+        bool small_message = detail::agreed_message_size<T>(message_size) <=
+            HPX_COLLECTIVES_LARGE_MESSAGE_SIZE;
+
+        typedef detail::all_reduce_data<T, F> data_type;
+        std::shared_ptr<data_type> data = std::make_shared<data_type>(
+            comm, generation, std::move(value), std::move(op));
+
+        if (small_message)
+            return detail::all_reduce_recursive_doubling(data);
+
+        return detail::all_reduce_tree(data, 1, 1);
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,212 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_to_all.hpp
+
+#if !defined(HPX_LCOS_ALL_TO_ALL_HPP)
+#define HPX_LCOS_ALL_TO_ALL_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// AllToAll a set of values from different call sites
+    ///
+    /// This function sends the i-th of the given values to the i-th site of
+    /// the given communicator and receives one value from every site.
+    ///
+    /// \param  comm        The communicator connecting the participating
+    ///                     sites.
+    /// \param  values      The values to send, one for each site.
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     communicator. This is optional, by default the
+    ///                     operations are numbered in the order they are
+    ///                     invoked on each site.
+    /// \param  message_size The number of bytes of a value, used for selecting
+    ///                     the algorithm. This is optional, by default
+    ///                     sizeof(T) is used. All sites have to pass the same
+    ///                     message size, otherwise they would execute
+    ///                     different algorithms and never complete.
+    ///
+    /// \returns    This function returns a future holding a vector with the
+    ///             values received from all sites, ordered by the site which
+    ///             sent them. It will become ready once the all_to_all
+    ///             operation has been completed.
+    ///
+    /// \note       Small values are sent to all sites at once. Large values
+    ///             are exchanged pairwise in num_sites-1 steps, which limits
+    ///             the number of messages in flight at any time.
+    ///
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(communicator<T> const& comm, std::vector<T> values,
+        std::size_t generation = std::size_t(-1),
+        std::size_t message_size = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/communicator.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        struct all_to_all_data
+        {
+            all_to_all_data(communicator<T> const& comm,
+                    std::size_t generation, std::vector<T> && values)
+              : comm_(comm), generation_(generation), values_(std::move(values)),
+                results_(values_.size())
+            {
+                std::size_t this_site = comm_.this_site();
+                results_[this_site] = std::move(values_[this_site]);
+            }
+
+            // the message tag identifies the sending site
+            hpx::future<void> send(std::size_t site)
+            {
+                return comm_.set(site, generation_, comm_.this_site(),
+                    std::vector<T>(1, std::move(values_[site])));
+            }
+
+            hpx::future<std::vector<T> > receive(std::size_t site)
+            {
+                return comm_.get(generation_, site);
+            }
+
+            void store(std::size_t site, std::vector<T> && received)
+            {
+                HPX_ASSERT(received.size() == 1);
+                results_[site] = std::move(received[0]);
+            }
+
+            communicator<T> comm_;
+            std::size_t generation_;
+            std::vector<T> values_;
+            std::vector<T> results_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // send all values at once
+        template <typename T>
+        hpx::future<std::vector<T> > all_to_all_direct(
+            std::shared_ptr<all_to_all_data<T> > const& data)
+        {
+            std::size_t const num_sites = data->comm_.num_sites();
+            std::size_t const this_site = data->comm_.this_site();
+
+            std::vector<hpx::future<void> > sent;
+            std::vector<hpx::future<std::vector<T> > > received;
+            sent.reserve(num_sites - 1);
+            received.reserve(num_sites - 1);
+
+            for (std::size_t i = 1; i != num_sites; ++i)
+            {
+                std::size_t site = (this_site + i) % num_sites;
+                sent.push_back(data->send(site));
+                received.push_back(data->receive(site));
+            }
+
+            return hpx::when_all(sent, received).then(hpx::launch::sync,
+                [data](hpx::future<hpx::util::tuple<
+                        std::vector<hpx::future<void> >,
+                        std::vector<hpx::future<std::vector<T> > >
+                    > > && f) -> std::vector<T>
+                {
+                    std::size_t const num_sites = data->comm_.num_sites();
+                    std::size_t const this_site = data->comm_.this_site();
+
+                    auto results = f.get();
+                    for (hpx::future<void>& s : hpx::util::get<0>(results))
+                        s.get();                // propagate errors
+
+                    std::vector<hpx::future<std::vector<T> > >& received =
+                        hpx::util::get<1>(results);
+                    for (std::size_t i = 1; i != num_sites; ++i)
+                    {
+                        data->store((this_site + i) % num_sites,
+                            received[i - 1].get());
+                    }
+                    return std::move(data->results_);
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // in step s each site sends to the site s positions to its right and
+        // receives from the site s positions to its left
+        template <typename T>
+        hpx::future<std::vector<T> > all_to_all_pairwise(
+            std::shared_ptr<all_to_all_data<T> > const& data, std::size_t step)
+        {
+            std::size_t const num_sites = data->comm_.num_sites();
+            std::size_t const this_site = data->comm_.this_site();
+
+            if (step == num_sites)
+                return hpx::make_ready_future(std::move(data->results_));
+
+            std::size_t to = (this_site + step) % num_sites;
+            std::size_t from = (this_site + num_sites - step) % num_sites;
+
+            return hpx::when_all(data->send(to), data->receive(from)).then(
+                [=](hpx::future<hpx::util::tuple<
+                        hpx::future<void>, hpx::future<std::vector<T> >
+                    > > && f) -> hpx::future<std::vector<T> >
+                {
+                    data->store(from, exchanged_data(std::move(f)));
+                    return all_to_all_pairwise(data, step + 1);
+                });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(communicator<T> const& comm, std::vector<T> values,
+        std::size_t generation = std::size_t(-1),
+        std::size_t message_size = std::size_t(-1))
+    {
+        HPX_ASSERT(comm);
+
+        std::size_t const num_sites = comm.num_sites();
+        if (values.size() != num_sites)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "hpx::lcos::all_to_all",
+                "the number of values has to be equal to the number of "
+                "participating sites");
+        }
+
+        if (generation == std::size_t(-1))
+            generation = comm.next_generation();
+
+        typedef detail::all_to_all_data<T> data_type;
+        std::shared_ptr<data_type> data =
+            std::make_shared<data_type>(comm, generation, std::move(values));
+
+        if (detail::agreed_message_size<T>(message_size) * num_sites <=
+                HPX_COLLECTIVES_LARGE_MESSAGE_SIZE)
+        {
+            return detail::all_to_all_direct(data);
+        }
+
+        return detail::all_to_all_pairwise(data, 1);
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,342 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file communicator.hpp
+
+#if !defined(HPX_LCOS_COMMUNICATOR_HPP)
+#define HPX_LCOS_COMMUNICATOR_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// A communicator connects a fixed set of call sites (usually one per
+    /// locality) which participate in the collective operations
+    /// \a all_reduce, \a all_gather, \a all_to_all, and \a scatter_to /
+    /// \a scatter_from. All participating sites have to keep their
+    /// communicator alive until all collective operations using it have
+    /// completed.
+    template <typename T>
+    class communicator;
+
+    /// Create a communicator connecting all sites using the same base name
+    ///
+    /// \param  basename    The base name identifying the communicator
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \returns    This function returns a future holding the new
+    ///             communicator. It will become ready once all participating
+    ///             sites have created their communicator.
+    ///
+    template <typename T>
+    hpx::future<communicator<T> >
+    create_communicator(char const* basename,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/receive_buffer.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/unmanaged.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/preprocessor/cat.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// This defines the accumulated size (in bytes) of the values contributed by
+/// one site above which the collective operations switch from latency
+/// optimized to bandwidth optimized algorithms.
+#if !defined(HPX_COLLECTIVES_LARGE_MESSAGE_SIZE)
+#  define HPX_COLLECTIVES_LARGE_MESSAGE_SIZE 8192
+#endif
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Each site owns one instance of this component, all messages sent
+        // to this site during any of the collective operations end up here.
+        template <typename T>
+        class communicator_server
+          : public hpx::components::simple_component_base<
+                communicator_server<T> >
+        {
+        public:
+            communicator_server() //-V730
+            {
+                HPX_ASSERT(false);  // shouldn't ever be called
+            }
+
+            communicator_server(std::size_t num_sites)
+              : num_sites_(num_sites), generation_(0)
+            {}
+
+            // store the data sent by another site
+            void set(std::size_t which, std::vector<T> && data)
+            {
+                buffer_.store_received(which, std::move(data));
+            }
+
+            HPX_DEFINE_COMPONENT_ACTION(communicator_server, set, set_action);
+
+            // retrieve the data sent by another site
+            hpx::future<std::vector<T> > get(std::size_t which)
+            {
+                return buffer_.receive(which);
+            }
+
+            std::size_t next_generation()
+            {
+                return ++generation_;
+            }
+
+        private:
+            std::size_t num_sites_;
+            boost::atomic<std::size_t> generation_;
+            lcos::local::receive_buffer<std::vector<T> > buffer_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Estimate the number of bytes a value contributes to a message, this
+        // is used for selecting the algorithm of a collective operation only.
+        // The estimate depends on the local value, it may be used only where
+        // a single site selects the algorithm (like the root of a scatter).
+        template <typename T>
+        std::size_t collective_message_size(T const&)
+        {
+            return sizeof(T);
+        }
+
+        template <typename T, typename Allocator>
+        std::size_t collective_message_size(std::vector<T, Allocator> const& v)
+        {
+            return v.size() * sizeof(T);
+        }
+
+        // All sites of a symmetric collective operation have to select the
+        // same algorithm. The sizes of the local values may differ between
+        // the sites, so the selection is based on the message size given by
+        // the caller (which has to be the same on all sites) or on the type
+        // of the values only.
+        template <typename T>
+        std::size_t agreed_message_size(std::size_t message_size)
+        {
+            return message_size != std::size_t(-1) ? message_size : sizeof(T);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inline bool is_power_of_two(std::size_t n)
+        {
+            return n != 0 && (n & (n - 1)) == 0;
+        }
+
+        // largest power of two not larger than n
+        inline std::size_t floor_power_of_two(std::size_t n)
+        {
+            HPX_ASSERT(n != 0);
+            std::size_t result = 1;
+            while ((result << 1) <= n)
+                result <<= 1;
+            return result;
+        }
+
+        inline std::size_t lowest_set_bit(std::size_t n)
+        {
+            return n & (~n + 1);
+        }
+
+        // wait for a send and a receive operation to complete, returns the
+        // received data
+        template <typename T>
+        std::vector<T> exchanged_data(
+            hpx::future<hpx::util::tuple<
+                hpx::future<void>, hpx::future<std::vector<T> >
+            > > && f)
+        {
+            auto data = f.get();
+            hpx::util::get<0>(data).get();     // propagate errors
+            return hpx::util::get<1>(data).get();
+        }
+
+        // number of tags a collective operation may use on a site, every
+        // collective operation uses less than num_sites + 64 tags
+        inline std::size_t tags_per_generation(std::size_t num_sites)
+        {
+            return num_sites + 64;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    class communicator
+    {
+        typedef detail::communicator_server<T> server_type;
+
+    public:
+        communicator()
+          : this_site_(std::size_t(-1))
+        {}
+
+        communicator(std::size_t this_site, hpx::id_type const& here,
+                std::shared_ptr<server_type> const& server,
+                std::vector<hpx::id_type> && sites)
+          : this_site_(this_site), here_(here), server_(server),
+            sites_(std::move(sites))
+        {}
+
+        std::size_t num_sites() const
+        {
+            return sites_.size();
+        }
+
+        std::size_t this_site() const
+        {
+            return this_site_;
+        }
+
+        explicit operator bool() const HPX_NOEXCEPT
+        {
+            return server_ != nullptr;
+        }
+
+        /// \cond NOINTERNAL
+        std::size_t next_generation() const
+        {
+            HPX_ASSERT(server_);
+            return server_->next_generation();
+        }
+
+        // send the given data to the given site
+        hpx::future<void> set(std::size_t site, std::size_t generation,
+            std::size_t tag, std::vector<T> && data) const
+        {
+            HPX_ASSERT(site < sites_.size());
+
+            typedef typename server_type::set_action action_type;
+            return hpx::async(action_type(), sites_[site],
+                key(generation, tag), std::move(data));
+        }
+
+        // receive the data sent to this site
+        hpx::future<std::vector<T> > get(std::size_t generation,
+            std::size_t tag) const
+        {
+            HPX_ASSERT(server_);
+            return server_->get(key(generation, tag));
+        }
+        /// \endcond
+
+    private:
+        std::size_t key(std::size_t generation, std::size_t tag) const
+        {
+            std::size_t const num_tags =
+                detail::tags_per_generation(sites_.size());
+            HPX_ASSERT(tag < num_tags);
+            return generation * num_tags + tag;
+        }
+
+        std::size_t this_site_;
+        hpx::id_type here_;                 // keeps the server alive
+        std::shared_ptr<server_type> server_;
+        std::vector<hpx::id_type> sites_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<communicator<T> >
+    create_communicator(char const* basename,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        if (num_sites == std::size_t(-1))
+            num_sites = hpx::get_num_localities(hpx::launch::sync);
+        if (this_site == std::size_t(-1))
+            this_site = static_cast<std::size_t>(hpx::get_locality_id());
+
+        typedef detail::communicator_server<T> server_type;
+
+        std::string name(basename);
+        hpx::future<hpx::id_type> id =
+            hpx::new_<server_type>(hpx::find_here(), num_sites);
+
+        return id.then(
+            [name, num_sites, this_site](hpx::future<hpx::id_type> && f)
+            {
+                hpx::id_type here = f.get();
+
+                // the server is kept alive by the communicator of this site
+                hpx::register_with_basename(
+                    name, hpx::unmanaged(here), this_site).get();
+
+                return hpx::when_all(
+                        hpx::get_ptr<server_type>(here),
+                        hpx::when_all(
+                            hpx::find_all_from_basename(name, num_sites))
+                    ).then(hpx::launch::sync,
+                        [this_site, here](hpx::future<hpx::util::tuple<
+                                hpx::future<std::shared_ptr<server_type> >,
+                                hpx::future<std::vector<
+                                    hpx::future<hpx::id_type> > >
+                            > > && f)
+                        {
+                            auto data = f.get();
+
+                            std::vector<hpx::future<hpx::id_type> > ids =
+                                hpx::util::get<1>(data).get();
+
+                            std::vector<hpx::id_type> sites;
+                            sites.reserve(ids.size());
+                            for (hpx::future<hpx::id_type>& id : ids)
+                                sites.push_back(id.get());
+
+                            return communicator<T>(this_site, here,
+                                hpx::util::get<0>(data).get(),
+                                std::move(sites));
+                        });
+            });
+    }
+}}
+
+#define HPX_REGISTER_COMMUNICATOR_DECLARATION(type, name)                     \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::detail::communicator_server<type>::set_action,             \
+        BOOST_PP_CAT(communicator_set_action_, name))                         \
+    /**/
+
+#define HPX_REGISTER_COMMUNICATOR(type, name)                                 \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::detail::communicator_server<type>::set_action,             \
+        BOOST_PP_CAT(communicator_set_action_, name));                        \
+    typedef hpx::components::simple_component<                                \
+        hpx::lcos::detail::communicator_server<type>                          \
+    > BOOST_PP_CAT(communicator_, name);                                      \
+    HPX_REGISTER_COMPONENT(BOOST_PP_CAT(communicator_, name))                 \
+    /**/
+
+#endif // DOXYGEN
+#endif
@@ -23,6 +23,7 @@
 #include <hpx/util/bind.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/deferred_call.hpp>
+#include <hpx/util/pooled_allocator.hpp>
 #include <hpx/util/steady_clock.hpp>
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/unused.hpp>
@@ -188,70 +189,130 @@ namespace detail
     };
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename F1, typename F2>
-    class compose_cb_impl
+    // The continuations attached to a shared state. The first one is stored
+    // in place, all others are kept in an intrusive list in the order they
+    // were attached. This avoids having to create a new composed callback
+    // (and the related allocation) for each additional continuation.
+    class completed_callbacks
     {
-        HPX_MOVABLE_ONLY(compose_cb_impl);
+        HPX_MOVABLE_ONLY(completed_callbacks);
 
     public:
-        template <typename A1, typename A2>
-        compose_cb_impl(A1 && f1, A2 && f2)
-          : f1_(std::forward<A1>(f1))
-          , f2_(std::forward<A2>(f2))
-        {}
+        typedef util::unique_function_nonser<void()> callback_type;
+
+    private:
+        struct node
+        {
+            node(callback_type && f)
+              : f_(std::move(f)), next_(nullptr)
+            {}
+
+            callback_type f_;
+            node* next_;
+        };
+
+        typedef util::pooled_allocator<node> allocator_type;
+        typedef std::allocator_traits<allocator_type> traits;
 
-        compose_cb_impl(compose_cb_impl&& other)
-          : f1_(std::move(other.f1_))
-          , f2_(std::move(other.f2_))
+    public:
+        completed_callbacks()
+          : head_(nullptr), tail_(nullptr)
         {}
 
-        void operator()()
+        completed_callbacks(completed_callbacks && other)
+          : first_(std::move(other.first_))
+          , head_(other.head_), tail_(other.tail_)
         {
-            bool recurse_asynchronously = hpx::threads::get_self_ptr() == nullptr;
-#if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
-            recurse_asynchronously =
-                !this_thread::has_sufficient_stack_space();
-#else
-            handle_continuation_recursion_count cnt;
-            recurse_asynchronously = recurse_asynchronously ||
-                cnt.count_ > HPX_CONTINUATION_MAX_RECURSION_DEPTH;
-#endif
-            if (recurse_asynchronously)
+            other.head_ = other.tail_ = nullptr;
+        }
+
+        completed_callbacks& operator=(completed_callbacks && other)
+        {
+            if (this != &other)
             {
-                error_code ec;
-                threads::thread_id_type id = threads::register_thread_nullary(
-                    compose_cb_impl(std::move(f1_), std::move(f2_)),
-                    "compose_cb",
-                    threads::pending, true, threads::thread_priority_boost,
-                    std::size_t(-1), threads::thread_stacksize_current, ec);
+                clear();
+
+                first_ = std::move(other.first_);
+                head_ = other.head_;
+                tail_ = other.tail_;
+                other.head_ = other.tail_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~completed_callbacks()
+        {
+            clear();
+        }
+
+        bool empty() const
+        {
+            return first_.empty();
+        }
+
+        void push_back(callback_type && f)
+        {
+            if (first_.empty())
+            {
+                first_ = std::move(f);
                 return;
             }
 
-            f1_();
-            f2_();
+            allocator_type alloc;
+            node* n = traits::allocate(alloc, 1);
+            try {
+                traits::construct(alloc, n, std::move(f));
+            }
+            catch (...) {
+                traits::deallocate(alloc, n, 1);
+                throw;
+            }
+
+            if (tail_ != nullptr)
+                tail_->next_ = n;
+            else
+                head_ = n;
+            tail_ = n;
+        }
+
+        void clear()
+        {
+            allocator_type alloc;
+            while (node* n = head_)
+            {
+                head_ = n->next_;
+                traits::destroy(alloc, n);
+                traits::deallocate(alloc, n, 1);
+            }
+            tail_ = nullptr;
+            first_.reset();
+        }
+
+        // Remove and return the continuation which was attached first
+        callback_type pop_front()
+        {
+            callback_type f(std::move(first_));
+            if (node* n = head_)
+            {
+                first_ = std::move(n->f_);
+
+                head_ = n->next_;
+                if (head_ == nullptr)
+                    tail_ = nullptr;
+
+                allocator_type alloc;
+                traits::destroy(alloc, n);
+                traits::deallocate(alloc, n, 1);
+            }
+            return f;
         }
 
     private:
-        F1 f1_;
-        F2 f2_;
+        callback_type first_;
+        node* head_;
+        node* tail_;
     };
 
-    template <typename F1, typename F2>
-    static HPX_FORCEINLINE util::unique_function_nonser<void()>
-    compose_cb(F1 && f1, F2 && f2)
-    {
-        if (!f1)
-            return std::forward<F2>(f2);
-        else if (!f2)
-            return std::forward<F1>(f1);
-
-        // otherwise create a combined callback
-        typedef compose_cb_impl<
-            typename util::decay<F1>::type, typename util::decay<F2>::type
-        > result_type;
-        return result_type(std::forward<F1>(f1), std::forward<F2>(f2));
-    }
-
     ///////////////////////////////////////////////////////////////////////////
     struct handle_continuation_recursion_count
     {
@@ -539,9 +600,22 @@ namespace detail
             return true;
         }
 
+        // deferred execution of all given continuations
+        bool run_on_completed(completed_callbacks && on_completed,
+            boost::exception_ptr& ptr)
+        {
+            while (!on_completed.empty())
+            {
+                if (!run_on_completed(on_completed.pop_front(), ptr))
+                    return false;
+            }
+            return true;
+        }
+
         // make sure continuation invocation does not recurse deeper than
         // allowed
-        void handle_on_completed(completed_callback_type && on_completed)
+        template <typename Callback>
+        void handle_on_completed(Callback && on_completed)
         {
             // We need to run the completion on a new thread if we are on a
             // non HPX thread.
@@ -569,12 +643,15 @@ namespace detail
                 // re-spawn continuation on a new thread
                 boost::intrusive_ptr<future_data> this_(this);
 
+                typedef typename util::decay<Callback>::type callback_type;
+                bool (future_data::*run)(callback_type&&, boost::exception_ptr&) =
+                    &future_data::run_on_completed;
+
                 error_code ec(lightweight);
                 boost::exception_ptr ptr;
                 if (!run_on_completed_on_new_thread(
-                        util::deferred_call(&future_data::run_on_completed,
-                            std::move(this_), std::move(on_completed),
-                            std::ref(ptr)),
+                        util::deferred_call(run, std::move(this_),
+                            std::move(on_completed), std::ref(ptr)),
                         ec))
                 {
                     // thread creation went wrong
@@ -605,7 +682,7 @@ namespace detail
                 return;
             }
 
-            completed_callback_type on_completed = std::move(this->on_completed_);
+            completed_callbacks on_completed = std::move(this->on_completed_);
 
             // set the data
             result_type* value_ptr =
@@ -631,8 +708,8 @@ namespace detail
             // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
             //       it unlocked when returning.
 
-            // invoke the callback (continuation) function
-            if (on_completed)
+            // invoke the callback (continuation) functions
+            if (!on_completed.empty())
                 handle_on_completed(std::move(on_completed));
         }
 
@@ -650,7 +727,7 @@ namespace detail
                 return;
             }
 
-            completed_callback_type on_completed = std::move(this->on_completed_);
+            completed_callbacks on_completed = std::move(this->on_completed_);
 
             // set the data
             boost::exception_ptr* exception_ptr =
@@ -676,8 +753,8 @@ namespace detail
             // Note: cv.notify_one() above 'consumes' the lock 'l' and leaves
             //       it unlocked when returning.
 
-            // invoke the callback (continuation) function
-            if (on_completed)
+            // invoke the callback (continuation) functions
+            if (!on_completed.empty())
                 handle_on_completed(std::move(on_completed));
         }
 
@@ -743,7 +820,7 @@ namespace detail
             }
 
             state_ = empty;
-            on_completed_ = completed_callback_type();
+            on_completed_.clear();
         }
 
         // continuation support
@@ -759,7 +836,7 @@ namespace detail
 
             if (is_ready_locked(l)) {
 
-                HPX_ASSERT(!on_completed_);
+                HPX_ASSERT(on_completed_.empty());
 
                 // invoke the callback (continuation) function right away
                 l.unlock();
@@ -767,11 +844,9 @@ namespace detail
                 handle_on_completed(std::move(data_sink));
             }
             else {
-                // store a combined callback wrapping the old and the new one
                 // make sure continuations are evaluated in the order they are
                 // attached
-                this->on_completed_ = compose_cb(
-                    std::move(on_completed_), std::move(data_sink));
+                this->on_completed_.push_back(std::move(data_sink));
             }
         }
 
@@ -815,7 +890,7 @@ namespace detail
         }
 
     protected:
-        completed_callback_type on_completed_;
+        completed_callbacks on_completed_;
 
     private:
         local::detail::condition_variable cond_;    // threads waiting in read
@@ -1123,6 +1198,60 @@ namespace detail
     protected:
         threads::thread_id_type id_;
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The allocator used for the shared states created by hpx::async,
+    // hpx::dataflow and future::then if none was specified explicitly.
+    typedef util::pooled_allocator<char> default_shared_state_allocator;
+
+    // Shared state which has been placed in memory obtained from the given
+    // allocator. The memory is returned to (a copy of) that allocator once
+    // the last reference to the shared state has been released.
+    template <typename SharedState, typename Allocator>
+    struct shared_state_allocator : SharedState
+    {
+        typedef typename std::allocator_traits<Allocator>::template
+            rebind_alloc<shared_state_allocator> other_allocator;
+
+        template <typename ...Ts>
+        shared_state_allocator(other_allocator const& alloc, Ts&&... ts)
+          : SharedState(std::forward<Ts>(ts)...), alloc_(alloc)
+        {}
+
+    private:
+        void destroy()
+        {
+            typedef std::allocator_traits<other_allocator> traits;
+
+            other_allocator alloc(alloc_);
+            traits::destroy(alloc, this);
+            traits::deallocate(alloc, this, 1);
+        }
+
+        other_allocator alloc_;
+    };
+
+    // Create a new shared state of the given type using the given allocator.
+    // All additional arguments are passed through to the constructor of the
+    // shared state.
+    template <typename SharedState, typename Allocator, typename ...Ts>
+    SharedState* allocate_shared_state(Allocator const& a, Ts&&... ts)
+    {
+        typedef shared_state_allocator<SharedState, Allocator> state_type;
+        typedef typename state_type::other_allocator other_allocator;
+        typedef std::allocator_traits<other_allocator> traits;
+
+        other_allocator alloc(a);
+        state_type* p = traits::allocate(alloc, 1);
+        try {
+            traits::construct(alloc, p, alloc, std::forward<Ts>(ts)...);
+        }
+        catch (...) {
+            traits::deallocate(alloc, p, 1);
+            throw;
+        }
+        return p;
+    }
 }}}
 
 #endif
@@ -56,8 +56,10 @@ namespace hpx { namespace lcos { namespace detail
                 frame_type;
             typedef typename frame_type::init_no_addref init_no_addref;
 
-            boost::intrusive_ptr<frame_type> p(new frame_type(
-                    policy
+            boost::intrusive_ptr<frame_type> p(
+                lcos::detail::allocate_shared_state<frame_type>(
+                    lcos::detail::default_shared_state_allocator()
+                  , policy
                   , std::forward<F>(f)
                   , util::forward_as_tuple(
                         traits::acquire_future_disp()(
@@ -139,8 +141,10 @@ namespace hpx { namespace lcos { namespace detail
                 frame_type;
             typedef typename frame_type::init_no_addref init_no_addref;
 
-            boost::intrusive_ptr<frame_type> p(new frame_type(
-                    sched
+            boost::intrusive_ptr<frame_type> p(
+                lcos::detail::allocate_shared_state<frame_type>(
+                    lcos::detail::default_shared_state_allocator()
+                  , sched
                   , std::forward<F>(f)
                   , util::forward_as_tuple(
                         traits::acquire_future_disp()(
@@ -183,8 +187,10 @@ namespace hpx { namespace lcos { namespace detail
                 frame_type;
             typedef typename frame_type::init_no_addref init_no_addref;
 
-            boost::intrusive_ptr<frame_type> p(new frame_type(
-                    std::forward<Executor_>(exec)
+            boost::intrusive_ptr<frame_type> p(
+                lcos::detail::allocate_shared_state<frame_type>(
+                    lcos::detail::default_shared_state_allocator()
+                  , std::forward<Executor_>(exec)
                   , std::forward<F>(f)
                   , util::forward_as_tuple(
                         traits::acquire_future_disp()(std::forward<Ts>(ts))...
@@ -22,6 +22,7 @@
 #include <boost/intrusive_ptr.hpp>
 
 #include <cstddef>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -205,38 +206,45 @@ namespace hpx { namespace lcos { namespace local
                 typename lcos::detail::future_data_refcnt_base::init_no_addref
                 init_no_addref;
 
-            template <typename F>
-            static return_type call(threads::executor& sched, F && f)
+            template <typename Allocator, typename F>
+            static return_type call(Allocator const& a,
+                threads::executor& sched, F && f)
             {
                 return return_type(
-                    new task_object<Result, F>(
-                        sched, std::forward<F>(f), init_no_addref()),
+                    lcos::detail::allocate_shared_state<
+                        task_object<Result, F>
+                    >(a, sched, std::forward<F>(f), init_no_addref()),
                     false);
             }
 
-            template <typename R>
-            static return_type call(threads::executor& sched, R (*f)())
+            template <typename Allocator, typename R>
+            static return_type call(Allocator const& a,
+                threads::executor& sched, R (*f)())
             {
                 return return_type(
-                    new task_object<Result, Result (*)()>(
-                        sched, f, init_no_addref()),
+                    lcos::detail::allocate_shared_state<
+                        task_object<Result, Result (*)()>
+                    >(a, sched, f, init_no_addref()),
                     false);
             }
 
-            template <typename F>
-            static return_type call(F&& f)
+            template <typename Allocator, typename F>
+            static return_type call(Allocator const& a, F&& f)
             {
                 return return_type(
-                    new task_object<Result, F>(
-                        std::forward<F>(f), init_no_addref()),
+                    lcos::detail::allocate_shared_state<
+                        task_object<Result, F>
+                    >(a, std::forward<F>(f), init_no_addref()),
                     false);
             }
 
-            template <typename R>
-            static return_type call(R (*f)())
+            template <typename Allocator, typename R>
+            static return_type call(Allocator const& a, R (*f)())
             {
                 return return_type(
-                    new task_object<Result, Result (*)()>(f, init_no_addref()),
+                    lcos::detail::allocate_shared_state<
+                        task_object<Result, Result (*)()>
+                    >(a, f, init_no_addref()),
                     false);
             }
         };
@@ -251,39 +259,45 @@ namespace hpx { namespace lcos { namespace local
                 typename lcos::detail::future_data_refcnt_base::init_no_addref
                 init_no_addref;
 
-            template <typename F>
-            static return_type call(threads::executor& sched, F&& f)
+            template <typename Allocator, typename F>
+            static return_type call(Allocator const& a,
+                threads::executor& sched, F&& f)
             {
                 return return_type(
-                    new cancelable_task_object<Result, F>(
-                        sched, std::forward<F>(f), init_no_addref()),
+                    lcos::detail::allocate_shared_state<
+                        cancelable_task_object<Result, F>
+                    >(a, sched, std::forward<F>(f), init_no_addref()),
                     false);
             }
 
-            template <typename R>
-            static return_type call(threads::executor& sched, R (*f)())
+            template <typename Allocator, typename R>
+            static return_type call(Allocator const& a,
+                threads::executor& sched, R (*f)())
             {
                 return return_type(
-                    new cancelable_task_object<Result, Result (*)()>(
-                        sched, f, init_no_addref()),
+                    lcos::detail::allocate_shared_state<
+                        cancelable_task_object<Result, Result (*)()>
+                    >(a, sched, f, init_no_addref()),
                     false);
             }
 
-            template <typename F>
-            static return_type call(F&& f)
+            template <typename Allocator, typename F>
+            static return_type call(Allocator const& a, F&& f)
             {
                 return return_type(
-                    new cancelable_task_object<Result, F>(
-                        std::forward<F>(f), init_no_addref()),
+                    lcos::detail::allocate_shared_state<
+                        cancelable_task_object<Result, F>
+                    >(a, std::forward<F>(f), init_no_addref()),
                     false);
             }
 
-            template <typename R>
-            static return_type call(R (*f)())
+            template <typename Allocator, typename R>
+            static return_type call(Allocator const& a, R (*f)())
             {
                 return return_type(
-                    new cancelable_task_object<Result, Result (*)()>(
-                        f, init_no_addref()),
+                    lcos::detail::allocate_shared_state<
+                        cancelable_task_object<Result, Result (*)()>
+                    >(a, f, init_no_addref()),
                     false);
             }
         };
@@ -307,24 +321,44 @@ namespace hpx { namespace lcos { namespace local
         template <typename F>
         explicit futures_factory(threads::executor& sched, F&& f)
           : task_(detail::create_task_object<Result, Cancelable>::call(
+                lcos::detail::default_shared_state_allocator(),
                 sched, std::forward<F>(f))),
             future_obtained_(false)
         {}
 
         explicit futures_factory(threads::executor& sched, Result (*f)())
-          : task_(detail::create_task_object<Result, Cancelable>::call(sched, f)),
+          : task_(detail::create_task_object<Result, Cancelable>::call(
+                lcos::detail::default_shared_state_allocator(), sched, f)),
             future_obtained_(false)
         {}
 
         template <typename F>
         explicit futures_factory(F&& f)
           : task_(detail::create_task_object<Result, Cancelable>::call(
+                lcos::detail::default_shared_state_allocator(),
                 std::forward<F>(f))),
             future_obtained_(false)
         {}
 
         explicit futures_factory(Result (*f)())
-          : task_(detail::create_task_object<Result, Cancelable>::call(f)),
+          : task_(detail::create_task_object<Result, Cancelable>::call(
+                lcos::detail::default_shared_state_allocator(), f)),
+            future_obtained_(false)
+        {}
+
+        // the shared state is allocated using the given allocator
+        template <typename Allocator, typename F>
+        futures_factory(std::allocator_arg_t, Allocator const& a,
+                threads::executor& sched, F&& f)
+          : task_(detail::create_task_object<Result, Cancelable>::call(
+                a, sched, std::forward<F>(f))),
+            future_obtained_(false)
+        {}
+
+        template <typename Allocator, typename F>
+        futures_factory(std::allocator_arg_t, Allocator const& a, F&& f)
+          : task_(detail::create_task_object<Result, Cancelable>::call(
+                a, std::forward<F>(f))),
             future_obtained_(false)
         {}
 
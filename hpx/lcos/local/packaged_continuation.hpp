@@ -564,7 +564,10 @@ namespace hpx { namespace lcos { namespace detail
 
         // create a continuation
         typename traits::detail::shared_state_ptr<result_type>::type p(
-            new shared_state(std::forward<F>(f), init_no_addref()), false);
+            allocate_shared_state<shared_state>(
+                default_shared_state_allocator(),
+                std::forward<F>(f), init_no_addref()),
+            false);
         static_cast<shared_state*>(p.get())->attach(future, policy);
         return p;
     }
@@ -581,7 +584,10 @@ namespace hpx { namespace lcos { namespace detail
 
         // create a continuation
         typename traits::detail::shared_state_ptr<result_type>::type p(
-            new shared_state(std::forward<F>(f), init_no_addref()), false);
+            allocate_shared_state<shared_state>(
+                default_shared_state_allocator(),
+                std::forward<F>(f), init_no_addref()),
+            false);
         static_cast<shared_state*>(p.get())->attach(future, sched);
         return p;
     }
@@ -599,7 +605,10 @@ namespace hpx { namespace lcos { namespace detail
 
         // create a continuation
         typename traits::detail::shared_state_ptr<result_type>::type p(
-            new shared_state(std::forward<F>(f), init_no_addref()), false);
+            allocate_shared_state<shared_state>(
+                default_shared_state_allocator(),
+                std::forward<F>(f), init_no_addref()),
+            false);
         static_cast<shared_state*>(p.get())->attach_exec(future, exec);
         return p;
     }
@@ -27,6 +27,7 @@
 
 #include <boost/exception_ptr.hpp>
 
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -61,6 +62,20 @@ namespace hpx { namespace lcos { namespace local
           , promise_()
         {}
 
+        // the shared state is allocated using the given allocator
+        template <
+            typename Allocator,
+            typename F, typename FD = typename std::decay<F>::type,
+            typename Enable = typename std::enable_if<
+                !std::is_same<FD, packaged_task>::value
+             && traits::is_callable<FD&(Ts...), R>::value
+            >::type
+        >
+        explicit packaged_task(std::allocator_arg_t, Allocator const& a, F&& f)
+          : function_(std::forward<F>(f))
+          , promise_(std::allocator_arg, a)
+        {}
+
         packaged_task(packaged_task&& rhs)
           : function_(std::move(rhs.function_))
           , promise_(std::move(rhs.promise_))
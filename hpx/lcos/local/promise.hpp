@@ -17,6 +17,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/utility/swap.hpp>
 
+#include <memory>
 #include <utility>
 
 namespace hpx { namespace lcos { namespace local
@@ -38,6 +39,15 @@ namespace hpx { namespace lcos { namespace local
               , future_retrieved_(false)
             {}
 
+            template <typename Allocator>
+            promise_base(std::allocator_arg_t, Allocator const& a)
+              : shared_state_(
+                    lcos::detail::allocate_shared_state<shared_state_type>(
+                        a, init_no_addref()),
+                    false)
+              , future_retrieved_(false)
+            {}
+
             promise_base(promise_base&& other) HPX_NOEXCEPT
               : shared_state_(std::move(other.shared_state_))
               , future_retrieved_(other.future_retrieved_)
@@ -177,6 +187,13 @@ namespace hpx { namespace lcos { namespace local
           : base_type()
         {}
 
+        // Effects: constructs a promise object and a shared state. The
+        //          shared state is allocated using the given allocator.
+        template <typename Allocator>
+        promise(std::allocator_arg_t, Allocator const& a)
+          : base_type(std::allocator_arg, a)
+        {}
+
         // Effects: constructs a new promise object and transfers ownership of
         //          the shared state of other (if any) to the newly-
         //          constructed object.
@@ -285,6 +302,13 @@ namespace hpx { namespace lcos { namespace local
           : base_type()
         {}
 
+        // Effects: constructs a promise object and a shared state. The
+        //          shared state is allocated using the given allocator.
+        template <typename Allocator>
+        promise(std::allocator_arg_t, Allocator const& a)
+          : base_type(std::allocator_arg, a)
+        {}
+
         // Effects: constructs a new promise object and transfers ownership of
         //          the shared state of other (if any) to the newly-
         //          constructed object.
@@ -375,6 +399,13 @@ namespace hpx { namespace lcos { namespace local
           : base_type()
         {}
 
+        // Effects: constructs a promise object and a shared state. The
+        //          shared state is allocated using the given allocator.
+        template <typename Allocator>
+        promise(std::allocator_arg_t, Allocator const& a)
+          : base_type(std::allocator_arg, a)
+        {}
+
         // Effects: constructs a new promise object and transfers ownership of
         //          the shared state of other (if any) to the newly-
         //          constructed object.
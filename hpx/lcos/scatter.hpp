@@ -0,0 +1,204 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file scatter.hpp
+
+#if !defined(HPX_LCOS_SCATTER_HPP)
+#define HPX_LCOS_SCATTER_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Scatter (send) a part of the given values to all call sites
+    ///
+    /// This function distributes the given values to all sites of the given
+    /// communicator, the i-th value is sent to the i-th site. This site acts
+    /// as the root of the scatter operation.
+    ///
+    /// \param  comm        The communicator connecting the participating
+    ///                     sites.
+    /// \param  values      The values to distribute, one for each site.
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     communicator. This is optional, by default the
+    ///                     operations are numbered in the order they are
+    ///                     invoked on each site.
+    ///
+    /// \returns    This function returns a future holding the value destined
+    ///             for this site. It will become ready once the values have
+    ///             been sent.
+    ///
+    /// \note       Small values are distributed along a binomial tree, which
+    ///             needs log2(num_sites) communication steps. Large values
+    ///             are sent directly to their destination.
+    ///
+    template <typename T>
+    hpx::future<T>
+    scatter_to(communicator<T> const& comm, std::vector<T> values,
+        std::size_t generation = std::size_t(-1));
+
+    /// Receive the value scattered by the given root site
+    ///
+    /// This function receives the value sent to this site by the
+    /// corresponding \a scatter_to operation.
+    ///
+    /// \param  comm        The communicator connecting the participating
+    ///                     sites.
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the operation performed on the given
+    ///                     communicator. This is optional, by default the
+    ///                     operations are numbered in the order they are
+    ///                     invoked on each site.
+    /// \param root_site    The site which invoked \a scatter_to. This value is
+    ///                     optional and defaults to 0.
+    ///
+    /// \returns    This function returns a future holding the value destined
+    ///             for this site. It will become ready once the value has
+    ///             been received.
+    ///
+    template <typename T>
+    hpx::future<T>
+    scatter_from(communicator<T> const& comm,
+        std::size_t generation = std::size_t(-1), std::size_t root_site = 0);
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/communicator.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The given block holds the values for the sites this_site,
+        // this_site + 1, ... (relative to the root site). The upper part of
+        // the block is forwarded to the sites further down the tree until
+        // only the value for this site is left. A block of size one is not
+        // forwarded at all, which allows the root site to send the values
+        // directly to their destinations.
+        template <typename T>
+        hpx::future<T> scatter_forward(communicator<T> const& comm,
+            std::size_t generation, std::size_t root_site,
+            std::vector<T> && block,
+            std::vector<hpx::future<void> > && sent =
+                std::vector<hpx::future<void> >())
+        {
+            std::size_t const num_sites = comm.num_sites();
+            std::size_t const relative_site =
+                (comm.this_site() + num_sites - root_site) % num_sites;
+
+            HPX_ASSERT(!block.empty());
+            HPX_ASSERT(relative_site + block.size() <= num_sites);
+
+            while (block.size() > 1)
+            {
+                std::size_t mask = floor_power_of_two(block.size() - 1);
+                std::size_t site = (relative_site + mask + root_site) % num_sites;
+
+                sent.push_back(comm.set(site, generation, 0,
+                    std::vector<T>(
+                        std::make_move_iterator(block.begin() + mask),
+                        std::make_move_iterator(block.end()))));
+
+                block.resize(mask);
+            }
+
+            return hpx::when_all(sent).then(hpx::launch::sync,
+                hpx::util::bind(
+                    hpx::util::one_shot(
+                        [](std::vector<T> && block,
+                            hpx::future<std::vector<hpx::future<void> > > f)
+                        -> T
+                        {
+                            for (hpx::future<void>& s : f.get())
+                                s.get();            // propagate errors
+                            return std::move(block[0]);
+                        }),
+                    std::move(block), hpx::util::placeholders::_1));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<T>
+    scatter_to(communicator<T> const& comm, std::vector<T> values,
+        std::size_t generation = std::size_t(-1))
+    {
+        HPX_ASSERT(comm);
+
+        std::size_t const num_sites = comm.num_sites();
+        std::size_t const this_site = comm.this_site();
+        if (values.size() != num_sites)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "hpx::lcos::scatter_to",
+                "the number of values has to be equal to the number of "
+                "participating sites");
+        }
+
+        if (generation == std::size_t(-1))
+            generation = comm.next_generation();
+
+        std::size_t message_size = 0;
+        for (T const& value : values)
+            message_size += detail::collective_message_size(value);
+
+        if (message_size <= HPX_COLLECTIVES_LARGE_MESSAGE_SIZE)
+        {
+            // order the values relative to this site
+            std::rotate(values.begin(), values.begin() + this_site,
+                values.end());
+            return detail::scatter_forward(comm, generation, this_site,
+                std::move(values));
+        }
+
+        std::vector<hpx::future<void> > sent;
+        sent.reserve(num_sites - 1);
+        for (std::size_t i = 0; i != num_sites; ++i)
+        {
+            if (i != this_site)
+            {
+                sent.push_back(comm.set(i, generation, 0,
+                    std::vector<T>(1, std::move(values[i]))));
+            }
+        }
+
+        return detail::scatter_forward(comm, generation, this_site,
+            std::vector<T>(1, std::move(values[this_site])), std::move(sent));
+    }
+
+    template <typename T>
+    hpx::future<T>
+    scatter_from(communicator<T> const& comm,
+        std::size_t generation = std::size_t(-1), std::size_t root_site = 0)
+    {
+        HPX_ASSERT(comm);
+
+        if (generation == std::size_t(-1))
+            generation = comm.next_generation();
+
+        return comm.get(generation, 0).then(
+            [=](hpx::future<std::vector<T> > && f)
+            {
+                return detail::scatter_forward(comm, generation, root_site,
+                    f.get());
+            });
+    }
+}}
+
+#endif // DOXYGEN
+#endif
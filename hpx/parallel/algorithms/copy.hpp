@@ -27,13 +27,14 @@
 #include <hpx/parallel/util/foreach_partitioner.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/projection_identity.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
+#include <hpx/parallel/util/single_pass_scan_partitioner.hpp>
 #include <hpx/parallel/util/transfer.hpp>
 #include <hpx/parallel/util/zip_iterator.hpp>
 
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <type_traits>
@@ -406,7 +407,7 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
 
                 using hpx::util::get;
                 using hpx::util::make_zip_iterator;
-                typedef util::scan_partitioner<
+                typedef util::single_pass_scan_partitioner<
                         ExPolicy, std::pair<FwdIter, OutIter>, std::size_t
                     > scan_partitioner_type;
 
@@ -435,39 +436,35 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 auto f3 =
                     [dest, flags, policy](
                         zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<std::size_t> curr,
-                        hpx::shared_future<std::size_t> next
+                        std::size_t prefix
                     ) mutable
                     {
-                        next.get();     // rethrow exceptions
-
-                        std::advance(dest, curr.get());
+                        OutIter dst = dest;
+                        std::advance(dst, prefix);
                         util::loop_n<ExPolicy>(
                             part_begin, part_size,
-                            [&dest](zip_iterator it) mutable
+                            [&dst](zip_iterator it) mutable
                             {
                                 if(get<1>(*it))
-                                    *dest++ = get<0>(*it);
+                                    *dst++ = get<0>(*it);
                             });
                     };
 
                 return scan_partitioner_type::call(
                     std::forward<ExPolicy>(policy),
                     make_zip_iterator(first, flags.get()), count, init,
-                    // step 1 performs first part of scan algorithm
+                    // step 1 counts the elements to copy in each tile
                     std::move(f1),
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapped(std::plus<std::size_t>()),
-                    // step 3 runs final accumulation on each partition
+                    // step 2 combines the counts of adjacent tiles
+                    std::plus<std::size_t>(),
+                    // step 3 copies the elements of each tile, given the
+                    // number of elements copied by all preceding tiles
                     std::move(f3),
                     // step 4 use this return value
-                    [last, dest, flags](
-                        std::vector<hpx::shared_future<std::size_t> > && items,
-                        std::vector<hpx::future<void> > &&) mutable
+                    [last, dest, flags](std::size_t total) mutable
                     ->  std::pair<FwdIter, OutIter>
                     {
-                        std::advance(dest, items.back().get());
+                        std::advance(dest, total);
                         return std::make_pair(last, dest);
                     });
             }
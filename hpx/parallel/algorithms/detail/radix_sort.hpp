@@ -0,0 +1,284 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_RADIX_SORT_JAN_18_2017_1135AM)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_RADIX_SORT_JAN_18_2017_1135AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/sort_buffer.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1) { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Map arithmetic values onto unsigned keys which compare (as unsigned
+    // integers) in the same order as the original values compare using
+    // operator<().
+    template <typename T, typename Enable = void>
+    struct radix_key
+    {
+        typedef void key_type;
+    };
+
+    template <typename T>
+    struct radix_key<T,
+        typename std::enable_if<
+            std::is_integral<T>::value && !std::is_same<T, bool>::value
+        >::type>
+    {
+        typedef typename std::make_unsigned<T>::type key_type;
+
+        static key_type get(T val)
+        {
+            // flip the sign bit to order negative values first
+            return std::is_signed<T>::value ?
+                key_type(key_type(val) ^
+                    (key_type(1) << (sizeof(key_type) * 8 - 1))) :
+                key_type(val);
+        }
+    };
+
+    template <typename T, typename Key>
+    struct radix_float_key
+    {
+        typedef Key key_type;
+
+        static_assert(std::numeric_limits<T>::is_iec559 &&
+            sizeof(T) == sizeof(Key),
+            "radix sort requires IEEE 754 floating point values");
+
+        static key_type get(T val)
+        {
+            key_type key;
+            std::memcpy(&key, &val, sizeof(key_type));
+
+            // negative values are ordered reversed, positive values have to
+            // be ordered after all negative values
+            key_type const sign_bit = key_type(1) << (sizeof(key_type) * 8 - 1);
+            return (key & sign_bit) ? key_type(~key) : key_type(key | sign_bit);
+        }
+    };
+
+    template <>
+    struct radix_key<float>
+      : radix_float_key<float, std::uint32_t>
+    {};
+
+    template <>
+    struct radix_key<double>
+      : radix_float_key<double, std::uint64_t>
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Radix sort is used only if the result is indistinguishable from a
+    // comparison based sort, i.e. for arithmetic values compared with the
+    // default comparison operator and without any projection.
+    template <typename T, typename Compare>
+    struct is_radix_sort_compare
+      : std::integral_constant<bool,
+            std::is_same<Compare, detail::less>::value ||
+            std::is_same<Compare, std::less<T> >::value>
+    {};
+
+    template <typename RandomIt, typename Compare, typename Proj>
+    struct is_radix_sortable
+      : std::integral_constant<bool,
+            !std::is_void<typename radix_key<
+                typename std::iterator_traits<RandomIt>::value_type
+            >::key_type>::value &&
+            is_radix_sort_compare<
+                typename std::iterator_traits<RandomIt>::value_type,
+                typename hpx::util::decay<Compare>::type
+            >::value &&
+            std::is_same<
+                typename hpx::util::decay<Proj>::type,
+                util::projection_identity
+            >::value>
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    static const std::size_t radix_sort_bits = 8;
+    static const std::size_t radix_sort_buckets = 1 << radix_sort_bits;
+    static const std::size_t radix_sort_min_block = 16384;
+
+    // Stable distribution of the elements of [src, src + count) into dst
+    // using the digit selected by shift. Each block counts its digits, the
+    // per-block counts are turned into write offsets which allows all blocks
+    // to scatter their elements concurrently.
+    template <typename ExPolicy, typename Key, typename Src, typename Dst>
+    void radix_sort_pass(ExPolicy& policy, Src src, Dst dst,
+        std::size_t count, std::size_t num_blocks, std::size_t shift,
+        std::vector<std::size_t>& offsets)
+    {
+        std::size_t const block_size = (count + num_blocks - 1) / num_blocks;
+        std::fill(offsets.begin(), offsets.end(), std::size_t(0));
+
+        sort_execute_and_wait(policy, num_blocks,
+            [&](std::size_t block)
+            {
+                std::size_t begin = block * block_size;
+                std::size_t end = (std::min)(begin + block_size, count);
+                std::size_t* counts = &offsets[block * radix_sort_buckets];
+
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    ++counts[(Key::get(src[i]) >> shift) &
+                        (radix_sort_buckets - 1)];
+                }
+            });
+
+        std::size_t sum = 0;
+        for (std::size_t digit = 0; digit != radix_sort_buckets; ++digit)
+        {
+            for (std::size_t block = 0; block != num_blocks; ++block)
+            {
+                std::size_t& offset =
+                    offsets[block * radix_sort_buckets + digit];
+                std::size_t n = offset;
+                offset = sum;
+                sum += n;
+            }
+        }
+        HPX_ASSERT(sum == count);
+
+        sort_execute_and_wait(policy, num_blocks,
+            [&](std::size_t block)
+            {
+                std::size_t begin = block * block_size;
+                std::size_t end = (std::min)(begin + block_size, count);
+                std::size_t* block_offsets =
+                    &offsets[block * radix_sort_buckets];
+
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    std::size_t digit = (Key::get(src[i]) >> shift) &
+                        (radix_sort_buckets - 1);
+                    dst[block_offsets[digit]++] = src[i];
+                }
+            });
+    }
+
+    // Parallel least significant digit radix sort
+    template <typename ExPolicy, typename RandomIt>
+    void radix_sort(ExPolicy& policy, RandomIt first, RandomIt last)
+    {
+        typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+        typedef radix_key<value_type> key;
+        typedef typename key::key_type key_type;
+
+        std::size_t const count = std::size_t(last - first);
+        std::size_t const passes =
+            (sizeof(key_type) * 8 + radix_sort_bits - 1) / radix_sort_bits;
+
+        std::size_t num_blocks = (std::min)(
+            sort_cores(policy) * 4, count / radix_sort_min_block);
+        if (num_blocks == 0)
+            num_blocks = 1;
+        std::size_t const block_size = (count + num_blocks - 1) / num_blocks;
+
+        // compute the histograms of all digits at once to be able to skip
+        // passes where all values have the same digit
+        std::vector<std::size_t> histograms(
+            num_blocks * passes * radix_sort_buckets, 0);
+
+        sort_execute_and_wait(policy, num_blocks,
+            [&](std::size_t block)
+            {
+                std::size_t begin = block * block_size;
+                std::size_t end = (std::min)(begin + block_size, count);
+                std::size_t* counts =
+                    &histograms[block * passes * radix_sort_buckets];
+
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    key_type k = key::get(first[i]);
+                    for (std::size_t pass = 0; pass != passes; ++pass)
+                    {
+                        ++counts[pass * radix_sort_buckets +
+                            ((k >> (pass * radix_sort_bits)) &
+                                (radix_sort_buckets - 1))];
+                    }
+                }
+            });
+
+        std::vector<bool> skip_pass(passes, false);
+        for (std::size_t pass = 0; pass != passes; ++pass)
+        {
+            for (std::size_t digit = 0; digit != radix_sort_buckets; ++digit)
+            {
+                std::size_t n = 0;
+                for (std::size_t block = 0; block != num_blocks; ++block)
+                {
+                    n += histograms[(block * passes + pass) *
+                        radix_sort_buckets + digit];
+                }
+                if (n == count)
+                {
+                    skip_pass[pass] = true;
+                    break;
+                }
+                if (n != 0)
+                    break;
+            }
+        }
+
+        // alternate between the input sequence and a temporary buffer
+        std::vector<value_type> buffer(count);
+        std::vector<std::size_t> offsets(num_blocks * radix_sort_buckets);
+
+        bool in_buffer = false;
+        for (std::size_t pass = 0; pass != passes; ++pass)
+        {
+            if (skip_pass[pass])
+                continue;
+
+            if (in_buffer)
+            {
+                radix_sort_pass<ExPolicy, key>(policy, buffer.data(), first,
+                    count, num_blocks, pass * radix_sort_bits, offsets);
+            }
+            else
+            {
+                radix_sort_pass<ExPolicy, key>(policy, first, buffer.data(),
+                    count, num_blocks, pass * radix_sort_bits, offsets);
+            }
+            in_buffer = !in_buffer;
+        }
+
+        if (in_buffer)
+        {
+            sort_execute_and_wait(policy, num_blocks,
+                [&](std::size_t block)
+                {
+                    std::size_t begin = (std::min)(block * block_size, count);
+                    std::size_t end = (std::min)(begin + block_size, count);
+                    std::copy(buffer.data() + begin, buffer.data() + end,
+                        first + begin);
+                });
+        }
+    }
+
+    /// \endcond
+}}}}
+
+#endif
@@ -0,0 +1,183 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_SAMPLE_SORT_JAN_18_2017_1012AM)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_SAMPLE_SORT_JAN_18_2017_1012AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <hpx/parallel/algorithms/detail/sort_buffer.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1) { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Parallel sample sort
+    //
+    // The input is distributed into buckets delimited by splitters chosen
+    // from a sorted sample of the input. Classifying the elements and moving
+    // them to their buckets is done in parallel for blocks of the input, the
+    // buckets are sorted independently afterwards. In contrast to a quicksort
+    // all passes over the whole input are executed in parallel.
+    static const std::size_t sample_sort_oversampling = 32;
+    static const std::size_t sample_sort_max_buckets = 1024;
+
+    // The elements are moved to a temporary buffer, which requires the
+    // moves not to throw to be able to restore the input on errors.
+    template <typename RandomIt>
+    struct is_sample_sortable
+      : std::integral_constant<bool,
+            std::is_nothrow_move_constructible<
+                typename std::iterator_traits<RandomIt>::value_type
+            >::value &&
+            std::is_nothrow_move_assignable<
+                typename std::iterator_traits<RandomIt>::value_type
+            >::value>
+    {};
+
+    // Number of buckets to use, returns zero if sample sort should not be
+    // used for a sequence of the given size.
+    inline std::size_t sample_sort_buckets(std::size_t cores,
+        std::size_t count, std::size_t min_bucket_size)
+    {
+        if (cores < 2 || count < 2 * cores * min_bucket_size)
+            return 0;
+
+        std::size_t buckets = (std::min)(cores * 4, count / min_bucket_size);
+        return (std::min)(buckets, sample_sort_max_buckets);
+    }
+
+    template <typename ExPolicy, typename RandomIt, typename Compare,
+        typename SortBucket>
+    void sample_sort(ExPolicy& policy, RandomIt first, RandomIt last,
+        Compare const& comp, std::size_t num_buckets, SortBucket && sort_bucket)
+    {
+        typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+        typedef std::uint16_t bucket_id_type;
+
+        std::size_t const count = std::size_t(last - first);
+        HPX_ASSERT(num_buckets >= 2 && num_buckets <= sample_sort_max_buckets);
+
+        // select splitters from a regularly spaced, sorted sample
+        std::size_t const num_samples = num_buckets * sample_sort_oversampling;
+        std::vector<RandomIt> samples;
+        samples.reserve(num_samples);
+        for (std::size_t i = 0; i != num_samples; ++i)
+            samples.push_back(first + (i * count) / num_samples);
+
+        std::sort(samples.begin(), samples.end(),
+            [&comp](RandomIt const& lhs, RandomIt const& rhs)
+            {
+                return comp(*lhs, *rhs);
+            });
+
+        std::vector<RandomIt> splitters;
+        splitters.reserve(num_buckets - 1);
+        for (std::size_t i = 1; i != num_buckets; ++i)
+            splitters.push_back(samples[i * sample_sort_oversampling]);
+
+        // classify all elements, block by block
+        std::size_t const num_blocks = num_buckets;
+        std::size_t const block_size = (count + num_blocks - 1) / num_blocks;
+
+        std::vector<bucket_id_type> bucket_ids(count);
+        std::vector<std::size_t> offsets(num_blocks * num_buckets, 0);
+
+        sort_execute_and_wait(policy, num_blocks,
+            [&](std::size_t block)
+            {
+                std::size_t begin = block * block_size;
+                std::size_t end = (std::min)(begin + block_size, count);
+                std::size_t* counts = &offsets[block * num_buckets];
+
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    value_type const& val = first[i];
+                    std::size_t bucket = std::upper_bound(
+                            splitters.begin(), splitters.end(), val,
+                            [&comp](value_type const& v, RandomIt const& s)
+                            {
+                                return comp(v, *s);
+                            }
+                        ) - splitters.begin();
+
+                    bucket_ids[i] = static_cast<bucket_id_type>(bucket);
+                    ++counts[bucket];
+                }
+            });
+
+        // turn the counts into the offsets each block writes its elements
+        // of a bucket to, buckets are stored consecutively
+        std::vector<std::size_t> bucket_begin(num_buckets + 1, 0);
+        {
+            std::size_t sum = 0;
+            for (std::size_t bucket = 0; bucket != num_buckets; ++bucket)
+            {
+                bucket_begin[bucket] = sum;
+                for (std::size_t block = 0; block != num_blocks; ++block)
+                {
+                    std::size_t& offset = offsets[block * num_buckets + bucket];
+                    std::size_t n = offset;
+                    offset = sum;
+                    sum += n;
+                }
+            }
+            HPX_ASSERT(sum == count);
+            bucket_begin[num_buckets] = sum;
+        }
+
+        // move all elements into their buckets, this does not throw
+        sort_buffer<value_type> buffer(count);
+        value_type* buf = buffer.data();
+
+        sort_execute_and_wait(policy, num_blocks,
+            [&](std::size_t block)
+            {
+                std::size_t begin = block * block_size;
+                std::size_t end = (std::min)(begin + block_size, count);
+                std::size_t* block_offsets = &offsets[block * num_buckets];
+
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    std::size_t& offset = block_offsets[bucket_ids[i]];
+                    ::new (buf + offset++) value_type(std::move(first[i]));
+                }
+            });
+
+        // move the buckets back to the input sequence
+        sort_execute_and_wait(policy, num_buckets,
+            [&](std::size_t bucket)
+            {
+                value_type* begin = buf + bucket_begin[bucket];
+                value_type* end = buf + bucket_begin[bucket + 1];
+
+                std::move(begin, end, first + bucket_begin[bucket]);
+                sort_buffer<value_type>::destroy(begin, end);
+            });
+
+        // sort all buckets independently
+        sort_execute_and_wait(policy, num_buckets,
+            [&](std::size_t bucket)
+            {
+                sort_bucket(first + bucket_begin[bucket],
+                    first + bucket_begin[bucket + 1]);
+            });
+    }
+
+    /// \endcond
+}}}}
+
+#endif
@@ -0,0 +1,119 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_ALGORITHMS_DETAIL_SORT_BUFFER_JAN_18_2017_0955AM)
+#define HPX_PARALLEL_ALGORITHMS_DETAIL_SORT_BUFFER_JAN_18_2017_0955AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/executors/executor_information_traits.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1) { namespace detail
+{
+    /// \cond NOINTERNAL
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Uninitialized temporary storage used by the parallel sort algorithms.
+    // The user of the buffer is responsible for constructing the elements
+    // and has to call destroy() for all constructed elements.
+    template <typename T>
+    class sort_buffer
+    {
+    public:
+        explicit sort_buffer(std::size_t size)
+          : data_(std::allocator<T>().allocate(size)), size_(size)
+        {}
+
+        ~sort_buffer()
+        {
+            std::allocator<T>().deallocate(data_, size_);
+        }
+
+        T* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        static void destroy(T* first, T* last)
+        {
+            for (/**/; first != last; ++first)
+                first->~T();
+        }
+
+    private:
+        sort_buffer(sort_buffer const&);
+        sort_buffer& operator=(sort_buffer const&);
+
+        T* data_;
+        std::size_t size_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Number of cores the given execution policy will run on
+    template <typename ExPolicy>
+    std::size_t sort_cores(ExPolicy const& policy)
+    {
+        typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+            executor_type;
+        std::size_t cores = executor_information_traits<executor_type>::
+            processing_units_count(policy.executor(), policy.parameters());
+        return cores == 0 ? 1 : cores;
+    }
+
+    // Invoke f(i) for all i in [0, count) concurrently and wait for all of
+    // the invocations to finish. Exceptions are collected and rethrown as an
+    // exception_list.
+    template <typename ExPolicy, typename F>
+    void sort_execute_and_wait(ExPolicy& policy, std::size_t count, F const& f)
+    {
+        typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+            executor_type;
+        typedef typename hpx::parallel::executor_traits<executor_type>
+            executor_traits;
+
+        std::vector<hpx::future<void> > workitems;
+        workitems.reserve(count);
+
+        std::list<boost::exception_ptr> errors;
+        try {
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                workitems.push_back(
+                    executor_traits::async_execute(policy.executor(), f, i));
+            }
+        }
+        catch (...) {
+            util::detail::handle_local_exceptions<ExPolicy>::call(
+                boost::current_exception(), errors);
+        }
+
+        hpx::wait_all(workitems);
+        util::detail::handle_local_exceptions<ExPolicy>::call(
+            workitems, errors);
+    }
+
+    /// \endcond
+}}}}
+
+#endif
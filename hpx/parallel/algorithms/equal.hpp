@@ -15,6 +15,7 @@
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/config/inline_namespace.hpp>
 #include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/transfer.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
@@ -142,6 +143,33 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                     });
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename InIter1, typename InIter2,
+            typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, InIter1 first1, InIter1 last1,
+            InIter2 first2, InIter2 last2, F && f, std::false_type)
+        {
+            typedef std::integral_constant<bool,
+                    execution::is_sequential_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<InIter1>::value ||
+                   !hpx::traits::is_forward_iterator<InIter2>::value
+                > is_seq;
+
+            return detail::equal_binary().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first1, last1, first2, last2, std::forward<F>(f));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename InIter1, typename InIter2,
+            typename F>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, InIter1 first1, InIter1 last1,
+            InIter2 first2, InIter2 last2, F && f, std::true_type);
+
         /// \endcond
     }
 
@@ -235,14 +263,12 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             "Requires at least input iterator.");
 
         typedef std::integral_constant<bool,
-                execution::is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter1>::value ||
-               !hpx::traits::is_forward_iterator<InIter2>::value
-            > is_seq;
-
-        return detail::equal_binary().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first1, last1, first2, last2, std::forward<Pred>(op));
+                detail::iterators_are_segmented<InIter1, InIter2>::value
+            > is_segmented;
+
+        return detail::equal_binary_(
+            std::forward<ExPolicy>(policy), first1, last1, first2, last2,
+            std::forward<Pred>(op), is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -317,6 +343,33 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                     });
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename InIter1, typename InIter2,
+            typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, InIter1 first1, InIter1 last1,
+            InIter2 first2, F && f, std::false_type)
+        {
+            typedef std::integral_constant<bool,
+                    execution::is_sequential_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<InIter1>::value ||
+                   !hpx::traits::is_forward_iterator<InIter2>::value
+                > is_seq;
+
+            return detail::equal().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first1, last1, first2, std::forward<F>(f));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename InIter1, typename InIter2,
+            typename F>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, InIter1 first1, InIter1 last1,
+            InIter2 first2, F && f, std::true_type);
+
         /// \endcond
     }
 
@@ -406,14 +459,12 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             "Requires at least input iterator.");
 
         typedef std::integral_constant<bool,
-                execution::is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter1>::value ||
-               !hpx::traits::is_forward_iterator<InIter2>::value
-            > is_seq;
-
-        return detail::equal().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first1, last1, first2, std::forward<Pred>(op));
+                detail::iterators_are_segmented<InIter1, InIter2>::value
+            > is_segmented;
+
+        return detail::equal_(
+            std::forward<ExPolicy>(policy), first1, last1, first2,
+            std::forward<Pred>(op), is_segmented());
     }
 }}}
 
@@ -10,6 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
@@ -39,23 +40,23 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 : find::algorithm("find")
             {}
 
-            template <typename ExPolicy, typename T>
-            static InIter
-            sequential(ExPolicy, InIter first, InIter last, const T& val)
+            template <typename ExPolicy, typename Iter, typename T>
+            static Iter
+            sequential(ExPolicy, Iter first, Iter last, const T& val)
             {
                 return std::find(first, last, val);
             }
 
-            template <typename ExPolicy, typename T>
+            template <typename ExPolicy, typename FwdIter, typename T>
             static typename util::detail::algorithm_result<
-                ExPolicy, InIter
+                ExPolicy, FwdIter
             >::type
-            parallel(ExPolicy && policy, InIter first, InIter last,
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
                 T const& val)
             {
-                typedef util::detail::algorithm_result<ExPolicy, InIter> result;
-                typedef typename std::iterator_traits<InIter>::value_type type;
-                typedef typename std::iterator_traits<InIter>::difference_type
+                typedef util::detail::algorithm_result<ExPolicy, FwdIter> result;
+                typedef typename std::iterator_traits<FwdIter>::value_type type;
+                typedef typename std::iterator_traits<FwdIter>::difference_type
                     difference_type;
 
                 difference_type count = std::distance(first, last);
@@ -64,10 +65,10 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
 
                 util::cancellation_token<std::size_t> tok(count);
 
-                return util::partitioner<ExPolicy, InIter, void>::
+                return util::partitioner<ExPolicy, FwdIter, void>::
                     call_with_index(
                         std::forward<ExPolicy>(policy), first, count, 1,
-                        [val, tok](InIter it, std::size_t part_size,
+                        [val, tok](FwdIter it, std::size_t part_size,
                             std::size_t base_idx) mutable
                         {
                             util::loop_idx_n(
@@ -78,7 +79,7 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                                         tok.cancel(i);
                                 });
                         },
-                        [=](std::vector<hpx::future<void> > &&) mutable -> InIter
+                        [=](std::vector<hpx::future<void> > &&) mutable -> FwdIter
                         {
                             difference_type find_res =
                                 static_cast<difference_type>(tok.get_data());
@@ -91,6 +92,30 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         });
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename InIter, typename T>
+        inline typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_(ExPolicy && policy, InIter first, InIter last, T const& val,
+            std::false_type)
+        {
+            typedef std::integral_constant<bool,
+                    execution::is_sequential_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<InIter>::value
+                > is_seq;
+
+            return detail::find<InIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, val);
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename InIter, typename T>
+        typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_(ExPolicy && policy, InIter first, InIter last, T const& val,
+            std::true_type);
+
         /// \endcond
     }
 
@@ -149,14 +174,11 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             (hpx::traits::is_input_iterator<InIter>::value),
             "Requires at least input iterator.");
 
-        typedef std::integral_constant<bool,
-                execution::is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value
-            > is_seq;
+        typedef hpx::traits::is_segmented_iterator<InIter> is_segmented;
 
-        return detail::find<InIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, val);
+        return detail::find_(
+            std::forward<ExPolicy>(policy), first, last, val,
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -171,9 +193,9 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 : find_if::algorithm("find_if")
             {}
 
-            template <typename ExPolicy, typename F>
-            static InIter
-            sequential(ExPolicy, InIter first, InIter last, F && f)
+            template <typename ExPolicy, typename Iter, typename F>
+            static Iter
+            sequential(ExPolicy, Iter first, Iter last, F && f)
             {
                 return std::find_if(first, last, f);
             }
@@ -185,8 +207,8 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             parallel(ExPolicy && policy, FwdIter first, FwdIter last, F && f)
             {
                 typedef util::detail::algorithm_result<ExPolicy, FwdIter> result;
-                typedef typename std::iterator_traits<InIter>::value_type type;
-                typedef typename std::iterator_traits<InIter>::difference_type
+                typedef typename std::iterator_traits<FwdIter>::value_type type;
+                typedef typename std::iterator_traits<FwdIter>::difference_type
                     difference_type;
 
                 difference_type count = std::distance(first, last);
@@ -222,6 +244,30 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         });
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename InIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_if_(ExPolicy && policy, InIter first, InIter last, F && f,
+            std::false_type)
+        {
+            typedef std::integral_constant<bool,
+                    execution::is_sequential_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<InIter>::value
+                > is_seq;
+
+            return detail::find_if<InIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, std::forward<F>(f));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename InIter, typename F>
+        typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_if_(ExPolicy && policy, InIter first, InIter last, F && f,
+            std::true_type);
+
         /// \endcond
     }
 
@@ -294,14 +340,11 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             (hpx::traits::is_input_iterator<InIter>::value),
             "Requires at least input iterator.");
 
-        typedef std::integral_constant<bool,
-                execution::is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value
-            > is_seq;
+        typedef hpx::traits::is_segmented_iterator<InIter> is_segmented;
 
-        return detail::find_if<InIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, std::forward<F>(f));
+        return detail::find_if_(
+            std::forward<ExPolicy>(policy), first, last, std::forward<F>(f),
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -316,9 +359,9 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 : find_if_not::algorithm("find_if_not")
             {}
 
-            template <typename ExPolicy, typename F>
-            static InIter
-            sequential(ExPolicy, InIter first, InIter last, F && f)
+            template <typename ExPolicy, typename Iter, typename F>
+            static Iter
+            sequential(ExPolicy, Iter first, Iter last, F && f)
             {
                 for (; first != last; ++first) {
                     if (!f(*first)) {
@@ -335,8 +378,8 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             parallel(ExPolicy && policy, FwdIter first, FwdIter last, F && f)
             {
                 typedef util::detail::algorithm_result<ExPolicy, FwdIter> result;
-                typedef typename std::iterator_traits<InIter>::value_type type;
-                typedef typename std::iterator_traits<InIter>::difference_type
+                typedef typename std::iterator_traits<FwdIter>::value_type type;
+                typedef typename std::iterator_traits<FwdIter>::difference_type
                     difference_type;
 
                 difference_type count = std::distance(first, last);
@@ -372,6 +415,30 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         });
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename InIter, typename F>
+        inline typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_if_not_(ExPolicy && policy, InIter first, InIter last, F && f,
+            std::false_type)
+        {
+            typedef std::integral_constant<bool,
+                    execution::is_sequential_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<InIter>::value
+                > is_seq;
+
+            return detail::find_if_not<InIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, std::forward<F>(f));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename InIter, typename F>
+        typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_if_not_(ExPolicy && policy, InIter first, InIter last, F && f,
+            std::true_type);
+
         /// \endcond
     }
 
@@ -444,14 +511,11 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             (hpx::traits::is_input_iterator<InIter>::value),
             "Requires at least input iterator.");
 
-        typedef std::integral_constant<bool,
-                execution::is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value
-            > is_seq;
+        typedef hpx::traits::is_segmented_iterator<InIter> is_segmented;
 
-        return detail::find_if_not<InIter>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, std::forward<F>(f));
+        return detail::find_if_not_(
+            std::forward<ExPolicy>(policy), first, last, std::forward<F>(f),
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -21,7 +21,7 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
+#include <hpx/parallel/util/single_pass_scan_partitioner.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -65,6 +65,15 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             return init;
         }
 
+        template <typename InIter, typename T, typename Op>
+        T sequential_reduce_n(InIter first, std::size_t count, T init,
+            Op && op)
+        {
+            for (/* */; count-- != 0; ++first)
+                init = hpx::util::invoke(op, init, *first);
+            return init;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         template <typename OutIter>
         struct inclusive_scan
@@ -104,58 +113,44 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 OutIter final_dest = dest;
                 std::advance(final_dest, count);
 
-                // The overall scan algorithm is performed by executing 3
-                // steps. The first calculates the scan results for each
-                // partition. The second accumulates the result from left to
-                // right to be used by the third step--which operates on the
-                // same partitions the first step operated on.
+                // The overall scan algorithm is performed in a single pass
+                // over the input. Each tile is reduced first, the tile is
+                // then scanned as soon as the reduction of all preceding
+                // tiles is known, while its data is still in the cache.
 
                 using hpx::util::get;
-                using hpx::util::make_zip_iterator;
-
-                auto f3 =
-                    [op, policy](
-                        zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<T> curr, hpx::shared_future<T> next
-                    )
-                    {
-                        next.get();     // rethrow exceptions
-
-                        T val = curr.get();
-                        OutIter dst = get<1>(part_begin.get_iterator_tuple());
 
-                        // MSVC 2015 fails if op is captured by reference
-                        util::loop_n<ExPolicy>(
-                            dst, part_size,
-                            [=, &val](OutIter it)
-                            {
-                                *it = hpx::util::invoke(op, val, *it);
-                            });
-                    };
-
-                return util::scan_partitioner<ExPolicy, OutIter, T>::call(
+                return util::single_pass_scan_partitioner<
+                        ExPolicy, OutIter, T
+                    >::call(
                     std::forward<ExPolicy>(policy),
-                    make_zip_iterator(first, dest), count, init,
-                    // step 1 performs first part of scan algorithm
+                    hpx::util::make_zip_iterator(first, dest), count, init,
+                    // step 1 reduces each tile
                     [op](zip_iterator part_begin, std::size_t part_size) -> T
                     {
-                        T part_init = get<0>(*part_begin);
-                        get<1>(*part_begin++) = part_init;
                         auto iters = part_begin.get_iterator_tuple();
-                        return sequential_inclusive_scan_n(
-                            get<0>(iters),
-                            part_size-1,
-                            get<1>(iters),
-                            part_init, op);
+                        FwdIter it = get<0>(iters);
+
+                        T val = *it;
+                        return sequential_reduce_n(++it, part_size - 1,
+                            std::move(val), op);
+                    },
+                    // step 2 combines the reductions of adjacent tiles
+                    [op](T const& lhs, T const& rhs) -> T
+                    {
+                        return hpx::util::invoke(op, lhs, rhs);
+                    },
+                    // step 3 scans each tile, given the reduction of all
+                    // preceding tiles
+                    [op](zip_iterator part_begin, std::size_t part_size,
+                        T const& prefix)
+                    {
+                        auto iters = part_begin.get_iterator_tuple();
+                        sequential_inclusive_scan_n(get<0>(iters), part_size,
+                            get<1>(iters), prefix, op);
                     },
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapped(op),
-                    // step 3 runs final accumulation on each partition
-                    std::move(f3),
                     // step 4 use this return value
-                    [final_dest](std::vector<hpx::shared_future<T> > &&,
-                        std::vector<hpx::future<void> > &&)
+                    [final_dest](T const&)
                     {
                         return final_dest;
                     });
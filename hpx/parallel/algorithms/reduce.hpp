@@ -10,6 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/unwrapped.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
@@ -81,6 +82,32 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                     }));
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename InIter, typename T,
+            typename Reduce>
+        inline typename util::detail::algorithm_result<ExPolicy, T>::type
+        reduce_(ExPolicy && policy, InIter first, InIter last, T init,
+            Reduce && r, std::false_type)
+        {
+            typedef std::integral_constant<bool,
+                    execution::is_sequential_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<InIter>::value
+                > is_seq;
+
+            return detail::reduce<T>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, std::move(init), std::forward<Reduce>(r));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename InIter, typename T,
+            typename Reduce>
+        typename util::detail::algorithm_result<ExPolicy, T>::type
+        reduce_(ExPolicy && policy, InIter first, InIter last, T init,
+            Reduce && r, std::true_type);
+
         /// \endcond
     }
 
@@ -165,14 +192,11 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             (hpx::traits::is_input_iterator<InIter>::value),
             "Requires at least input iterator.");
 
-        typedef std::integral_constant<bool,
-                execution::is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value
-            > is_seq;
+        typedef hpx::traits::is_segmented_iterator<InIter> is_segmented;
 
-        return detail::reduce<T>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, std::move(init), std::forward<F>(f));
+        return detail::reduce_(
+            std::forward<ExPolicy>(policy), first, last, std::move(init),
+            std::forward<F>(f), is_segmented());
     }
 
     /// Returns GENERALIZED_SUM(+, init, *first, ..., *(first + (last - first) - 1)).
@@ -239,14 +263,11 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             (hpx::traits::is_input_iterator<InIter>::value),
             "Requires at least input iterator.");
 
-        typedef std::integral_constant<bool,
-                execution::is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value
-            > is_seq;
+        typedef hpx::traits::is_segmented_iterator<InIter> is_segmented;
 
-        return detail::reduce<T>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, std::move(init), std::plus<T>());
+        return detail::reduce_(
+            std::forward<ExPolicy>(policy), first, last, std::move(init),
+            std::plus<T>(), is_segmented());
     }
 
     /// Returns GENERALIZED_SUM(+, T(), *first, ..., *(first + (last - first) - 1)).
@@ -318,14 +339,11 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
 
         typedef typename std::iterator_traits<InIter>::value_type value_type;
 
-        typedef std::integral_constant<bool,
-                execution::is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value
-            > is_seq;
+        typedef hpx::traits::is_segmented_iterator<InIter> is_segmented;
 
-        return detail::reduce<value_type>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first, last, value_type(), std::plus<value_type>());
+        return detail::reduce_(
+            std::forward<ExPolicy>(policy), first, last, value_type(),
+            std::plus<value_type>(), is_segmented());
     }
 }}}
 
@@ -12,12 +12,16 @@
 #include <hpx/dataflow.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/invoke.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/radix_sort.hpp>
+#include <hpx/parallel/algorithms/detail/sample_sort.hpp>
+#include <hpx/parallel/algorithms/detail/sort_buffer.hpp>
 #include <hpx/parallel/config/inline_namespace.hpp>
 #include <hpx/parallel/exception_list.hpp>
 #include <hpx/parallel/execution_policy.hpp>
@@ -177,19 +181,96 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 std::move(left), std::move(right));
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Start the parallel sort of a range which is not sorted yet. Large
+        // ranges of types which can be moved without throwing are sorted
+        // using a sample sort, all other ranges are sorted using a parallel
+        // quicksort.
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        hpx::future<RandomIt>
+        parallel_sort_dispatch(ExPolicy& policy, RandomIt first, RandomIt last,
+            Compare comp, std::false_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename policy_type::executor_type executor_type;
+            typedef typename hpx::parallel::executor_traits<executor_type>
+                executor_traits;
+
+            std::size_t num_buckets = 0;
+            if (is_sample_sortable<RandomIt>::value)
+            {
+                num_buckets = sample_sort_buckets(sort_cores(policy),
+                    std::size_t(last - first), sort_limit_per_task / 4);
+            }
+
+            if (num_buckets == 0)
+            {
+                return executor_traits::async_execute(
+                    policy.executor(),
+                        &sort_thread<ExPolicy, RandomIt, Compare>,
+                        std::ref(policy), first, last, comp);
+            }
+
+            policy_type p(policy);
+            return executor_traits::async_execute(
+                policy.executor(),
+                [p, first, last, comp, num_buckets]() mutable -> RandomIt
+                {
+                    std::size_t const max_bucket_size =
+                        4 * std::size_t(last - first) / num_buckets;
+
+                    sample_sort(p, first, last, comp, num_buckets,
+                        [&](RandomIt f, RandomIt l)
+                        {
+                            // buckets may become large if the input holds
+                            // many equal elements
+                            if (std::size_t(l - f) > max_bucket_size)
+                                sort_thread(p, f, l, comp).get();
+                            else
+                                std::sort(f, l, comp);
+                        });
+                    return last;
+                });
+        }
+
+        // Arithmetic values compared using the default comparison operator
+        // are sorted using a parallel radix sort.
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        hpx::future<RandomIt>
+        parallel_sort_dispatch(ExPolicy& policy, RandomIt first, RandomIt last,
+            Compare comp, std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename policy_type::executor_type executor_type;
+            typedef typename hpx::parallel::executor_traits<executor_type>
+                executor_traits;
+
+            policy_type p(policy);
+            return executor_traits::async_execute(
+                policy.executor(),
+                [p, first, last]() mutable -> RandomIt
+                {
+                    radix_sort(p, first, last);
+                    return last;
+                });
+        }
+
         //------------------------------------------------------------------------
         //  function : parallel_sort_async
         //------------------------------------------------------------------------
         /// @param [in] first : iterator to the first element to sort
         /// @param [in] last : iterator to the next element after the last
         /// @param [in] comp : object for to compare
+        /// @param [in] use_radix : std::true_type if the values can be sorted
+        ///                         using a radix sort
         /// @exception
         /// @return
         /// @remarks
-        template <typename ExPolicy, typename RandomIt, typename Compare>
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename UseRadix = std::false_type>
         hpx::future<RandomIt>
         parallel_sort_async(ExPolicy && policy, RandomIt first, RandomIt last,
-            Compare comp)
+            Compare comp, UseRadix use_radix = UseRadix())
         {
             hpx::future<RandomIt> result;
             try {
@@ -206,15 +287,8 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 if (detail::is_sorted_sequential(first, last, comp))
                     return hpx::make_ready_future(last);
 
-                typedef typename hpx::util::decay<ExPolicy>::type::executor_type
-                    executor_type;
-                typedef typename hpx::parallel::executor_traits<executor_type>
-                    executor_traits;
-
-                result = executor_traits::async_execute(
-                    policy.executor(),
-                        &sort_thread<ExPolicy, RandomIt, Compare>,
-                        std::ref(policy), first, last, comp);
+                result = parallel_sort_dispatch(policy, first, last,
+                    std::move(comp), use_radix);
             }
             catch (...) {
                 return detail::handle_exception<ExPolicy, RandomIt>::call(
@@ -239,9 +313,10 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
               : sort::algorithm("sort")
             {}
 
-            template <typename ExPolicy, typename Compare, typename Proj>
-            static RandomIt
-            sequential(ExPolicy, RandomIt first, RandomIt last,
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
+            static Iter
+            sequential(ExPolicy, Iter first, Iter last,
                 Compare && comp, Proj && proj)
             {
                 std::sort(first, last,
@@ -252,24 +327,53 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 return last;
             }
 
-            template <typename ExPolicy, typename Compare, typename Proj>
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
             static typename util::detail::algorithm_result<
-                ExPolicy, RandomIt
+                ExPolicy, Iter
             >::type
-            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+            parallel(ExPolicy && policy, Iter first, Iter last,
                 Compare && comp, Proj && proj)
             {
+                typedef std::integral_constant<bool,
+                        is_radix_sortable<Iter, Compare, Proj>::value
+                    > use_radix;
+
                 // call the sort routine and return the right type,
                 // depending on execution policy
-                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
+                return util::detail::algorithm_result<ExPolicy, Iter>::get(
                     parallel_sort_async(std::forward<ExPolicy>(policy),
                         first, last,
                         util::compare_projected<Compare, Proj>(
                             std::forward<Compare>(comp),
                             std::forward<Proj>(proj)
-                        )));
+                        ),
+                        use_radix()));
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        inline typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::false_type)
+        {
+            typedef execution::is_sequential_execution_policy<ExPolicy> is_seq;
+
+            return detail::sort<RandomIt>().call(
+                std::forward<ExPolicy>(policy), is_seq(), first, last,
+                std::forward<Compare>(comp), std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::true_type);
+
         /// \endcond
     }
 
@@ -360,11 +464,12 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
             (hpx::traits::is_random_access_iterator<RandomIt>::value),
             "Requires a random access iterator.");
 
-        typedef execution::is_sequential_execution_policy<ExPolicy> is_seq;
+        typedef hpx::traits::is_segmented_iterator<RandomIt> is_segmented;
 
-        return detail::sort<RandomIt>().call(
-            std::forward<ExPolicy>(policy), is_seq(), first, last,
-            std::forward<Compare>(comp), std::forward<Proj>(proj));
+        return detail::sort_(
+            std::forward<ExPolicy>(policy), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj),
+            is_segmented());
     }
 }}}
 
@@ -0,0 +1,409 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/algorithms/stable_sort.hpp
+
+#if !defined(HPX_PARALLEL_ALGORITHM_STABLE_SORT_JAN_18_2017_0230PM)
+#define HPX_PARALLEL_ALGORITHM_STABLE_SORT_JAN_18_2017_0230PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/concepts.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/algorithms/detail/sample_sort.hpp>
+#include <hpx/parallel/algorithms/detail/sort_buffer.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/parallel/traits/projected.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/projection_identity.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // stable_sort
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Describes the part [begin, end) of the output of merging the two
+        // adjacent runs [first, middle) and [middle, last).
+        struct stable_sort_merge_piece
+        {
+            std::size_t first;
+            std::size_t middle;
+            std::size_t last;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        // Number of elements taken from the first run (of size na) if the
+        // first d elements of the stable merge of both runs are produced.
+        template <typename Iter, typename Compare>
+        std::size_t stable_sort_corank(Iter a, std::size_t na, Iter b,
+            std::size_t nb, std::size_t d, Compare const& comp)
+        {
+            std::size_t lo = d > nb ? d - nb : 0;
+            std::size_t hi = (std::min)(d, na);
+            while (lo < hi)
+            {
+                std::size_t i = lo + (hi - lo) / 2;
+                std::size_t j = d - i;
+
+                // elements of the first run go first if they are equivalent
+                if (j != 0 && !comp(b[j - 1], a[i]))
+                    lo = i + 1;
+                else
+                    hi = i;
+            }
+            return lo;
+        }
+
+        template <typename ExPolicy, typename Src, typename Dst,
+            typename Compare>
+        void stable_sort_merge_round(ExPolicy& policy, Src src, Dst dst,
+            std::vector<stable_sort_merge_piece> const& pieces,
+            Compare const& comp)
+        {
+            sort_execute_and_wait(policy, pieces.size(),
+                [&](std::size_t k)
+                {
+                    stable_sort_merge_piece const& p = pieces[k];
+
+                    Src a = src + p.first;
+                    Src b = src + p.middle;
+                    std::size_t na = p.middle - p.first;
+                    std::size_t nb = p.last - p.middle;
+
+                    std::size_t i1 = stable_sort_corank(a, na, b, nb,
+                        p.begin, comp);
+                    std::size_t i2 = stable_sort_corank(a, na, b, nb,
+                        p.end, comp);
+
+                    std::merge(
+                        std::make_move_iterator(a + i1),
+                        std::make_move_iterator(a + i2),
+                        std::make_move_iterator(b + (p.begin - i1)),
+                        std::make_move_iterator(b + (p.end - i2)),
+                        dst + p.first + p.begin, comp);
+                });
+        }
+
+        // Parallel merge sort: the chunks of the input are sorted
+        // independently, afterwards adjacent runs are merged pairwise. Each
+        // merge is split into pieces of similar size which are merged
+        // concurrently.
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        void parallel_stable_sort(ExPolicy& policy, RandomIt first,
+            RandomIt last, Compare const& comp)
+        {
+            typedef typename std::iterator_traits<RandomIt>::value_type
+                value_type;
+
+            std::size_t const count = std::size_t(last - first);
+            std::size_t const cores = sort_cores(policy);
+
+            std::size_t num_runs = (std::min)(cores,
+                count / (sort_limit_per_task / 4));
+            if (num_runs < 2)
+            {
+                std::stable_sort(first, last, comp);
+                return;
+            }
+
+            std::vector<std::size_t> runs(num_runs + 1);
+            for (std::size_t i = 0; i <= num_runs; ++i)
+                runs[i] = (i * count) / num_runs;
+
+            sort_execute_and_wait(policy, num_runs,
+                [&](std::size_t i)
+                {
+                    std::stable_sort(first + runs[i], first + runs[i + 1],
+                        comp);
+                });
+
+            // the merge rounds alternate between the input sequence and a
+            // temporary buffer, the moves into the buffer do not throw
+            sort_buffer<value_type> buffer(count);
+            value_type* buf = buffer.data();
+
+            sort_execute_and_wait(policy, num_runs,
+                [&](std::size_t i)
+                {
+                    for (std::size_t j = runs[i]; j != runs[i + 1]; ++j)
+                        ::new (buf + j) value_type(std::move(first[j]));
+                });
+
+            struct destroy_buffer
+            {
+                ~destroy_buffer()
+                {
+                    sort_buffer<value_type>::destroy(buf_, buf_ + count_);
+                }
+
+                value_type* buf_;
+                std::size_t count_;
+            } on_exit = { buf, count };
+
+            bool in_buffer = true;
+            std::vector<stable_sort_merge_piece> pieces;
+            while (runs.size() > 2)
+            {
+                std::vector<std::size_t> next_runs;
+                next_runs.reserve(runs.size() / 2 + 1);
+                pieces.clear();
+
+                for (std::size_t i = 0; i + 1 < runs.size(); i += 2)
+                {
+                    std::size_t run_first = runs[i];
+                    std::size_t run_middle = runs[i + 1];
+                    std::size_t run_last =
+                        i + 2 < runs.size() ? runs[i + 2] : run_middle;
+
+                    // split each merge such that all cores are busy
+                    std::size_t size = run_last - run_first;
+                    std::size_t num_pieces = (size * cores + count - 1) / count;
+                    if (num_pieces == 0)
+                        num_pieces = 1;
+
+                    for (std::size_t k = 0; k != num_pieces; ++k)
+                    {
+                        stable_sort_merge_piece p = {
+                            run_first, run_middle, run_last,
+                            (k * size) / num_pieces,
+                            ((k + 1) * size) / num_pieces
+                        };
+                        pieces.push_back(p);
+                    }
+
+                    next_runs.push_back(run_first);
+                }
+                next_runs.push_back(count);
+
+                if (in_buffer)
+                    stable_sort_merge_round(policy, buf, first, pieces, comp);
+                else
+                    stable_sort_merge_round(policy, first, buf, pieces, comp);
+
+                in_buffer = !in_buffer;
+                runs.swap(next_runs);
+            }
+
+            if (in_buffer)
+            {
+                sort_execute_and_wait(policy, num_runs,
+                    [&](std::size_t i)
+                    {
+                        std::size_t begin = (i * count) / num_runs;
+                        std::size_t end = ((i + 1) * count) / num_runs;
+                        std::move(buf + begin, buf + end, first + begin);
+                    });
+            }
+        }
+
+        template <typename ExPolicy, typename RandomIt, typename Compare>
+        hpx::future<RandomIt>
+        parallel_stable_sort_async(ExPolicy && policy, RandomIt first,
+            RandomIt last, Compare comp)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename policy_type::executor_type executor_type;
+            typedef typename hpx::parallel::executor_traits<executor_type>
+                executor_traits;
+
+            hpx::future<RandomIt> result;
+            try {
+                std::ptrdiff_t N = last - first;
+                HPX_ASSERT(N >= 0);
+
+                // the temporary buffer requires that the elements can be
+                // moved without throwing
+                if (std::size_t(N) < sort_limit_per_task ||
+                    !is_sample_sortable<RandomIt>::value)
+                {
+                    std::stable_sort(first, last, comp);
+                    return hpx::make_ready_future(last);
+                }
+
+                // check if already sorted
+                if (detail::is_sorted_sequential(first, last, comp))
+                    return hpx::make_ready_future(last);
+
+                policy_type p(policy);
+                result = executor_traits::async_execute(
+                    policy.executor(),
+                    [p, first, last, comp]() mutable -> RandomIt
+                    {
+                        parallel_stable_sort(p, first, last, comp);
+                        return last;
+                    });
+            }
+            catch (...) {
+                return detail::handle_exception<ExPolicy, RandomIt>::call(
+                    boost::current_exception());
+            }
+
+            if (result.has_exception())
+            {
+                return detail::handle_exception<ExPolicy, RandomIt>::call(
+                    std::move(result));
+            }
+
+            return result;
+        }
+
+        template <typename RandomIt>
+        struct stable_sort
+          : public detail::algorithm<stable_sort<RandomIt>, RandomIt>
+        {
+            stable_sort()
+              : stable_sort::algorithm("stable_sort")
+            {}
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static RandomIt
+            sequential(ExPolicy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                std::stable_sort(first, last,
+                    util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        ));
+                return last;
+            }
+
+            template <typename ExPolicy, typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, RandomIt
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+                Compare && comp, Proj && proj)
+            {
+                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
+                    parallel_stable_sort_async(std::forward<ExPolicy>(policy),
+                        first, last,
+                        util::compare_projected<Compare, Proj>(
+                            std::forward<Compare>(comp),
+                            std::forward<Proj>(proj)
+                        )));
+            }
+        };
+        /// \endcond
+    }
+
+    //-----------------------------------------------------------------------------
+    /// Sorts the elements in the range [first, last) in ascending order. The
+    /// order of equal elements is guaranteed to be preserved. The function
+    /// uses the given comparison function object comp (defaults to using
+    /// operator<()).
+    ///
+    /// \note   Complexity: O(Nlog(N)), where N = std::distance(first, last)
+    ///                     comparisons.
+    ///
+    /// A sequence is sorted with respect to a comparator \a comp and a
+    /// projection \a proj if for every iterator i pointing to the sequence and
+    /// every non-negative integer n such that i + n is a valid iterator
+    /// pointing to an element of the sequence, and
+    /// INVOKE(comp, INVOKE(proj, *(i + n)), INVOKE(proj, *i)) == false.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the algorithm may be parallelized and the manner
+    ///                     in which it applies user-provided function objects.
+    /// \tparam Iter        The type of the source iterators used (deduced).
+    ///                     This iterator type must meet the requirements of a
+    ///                     random access iterator.
+    /// \tparam Comp        The type of the function/function object to use
+    ///                     (deduced).
+    /// \tparam Proj        The type of an optional projection function. This
+    ///                     defaults to \a util::projection_identity
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param first        Refers to the beginning of the sequence of elements
+    ///                     the algorithm will be applied to.
+    /// \param last         Refers to the end of the sequence of elements the
+    ///                     algorithm will be applied to.
+    /// \param comp         comp is a callable object. The return value of the
+    ///                     INVOKE operation applied to an object of type Comp,
+    ///                     when contextually converted to bool, yields true if
+    ///                     the first argument of the call is less than the
+    ///                     second, and false otherwise. It is assumed that comp
+    ///                     will not apply any non-constant function through the
+    ///                     dereferenced iterator.
+    /// \param proj         Specifies the function (or function object) which
+    ///                     will be invoked for each pair of elements as a
+    ///                     projection operation before the actual predicate
+    ///                     \a comp is invoked.
+    ///
+    /// \a comp has to induce a strict weak ordering on the values.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a sequenced_policy execute in sequential order in the
+    /// calling thread.
+    ///
+    /// The application of function objects in parallel algorithm
+    /// invoked with an execution policy object of type
+    /// \a parallel_policy or \a parallel_task_policy are
+    /// permitted to execute in an unordered fashion in unspecified
+    /// threads, and indeterminately sequenced within each thread.
+    ///
+    /// \returns  The \a stable_sort algorithm returns a
+    ///           \a hpx::future<RandomIt> if the execution policy is of
+    ///           type
+    ///           \a sequenced_task_policy or
+    ///           \a parallel_task_policy and returns \a RandomIt
+    ///           otherwise.
+    ///           The algorithm returns an iterator pointing to the first
+    ///           element after the last element in the input sequence.
+    //-----------------------------------------------------------------------------
+    template <typename ExPolicy, typename RandomIt,
+        typename Proj = util::projection_identity,
+        typename Compare = detail::less,
+    HPX_CONCEPT_REQUIRES_(
+        execution::is_execution_policy<ExPolicy>::value &&
+        hpx::traits::is_iterator<RandomIt>::value &&
+        traits::is_projected<Proj, RandomIt>::value &&
+        traits::is_indirect_callable<
+            ExPolicy, Compare,
+                traits::projected<Proj, RandomIt>,
+                traits::projected<Proj, RandomIt>
+        >::value)>
+    typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+    stable_sort(ExPolicy && policy, RandomIt first, RandomIt last,
+        Compare && comp = Compare(), Proj && proj = Proj())
+    {
+        static_assert(
+            (hpx::traits::is_random_access_iterator<RandomIt>::value),
+            "Requires a random access iterator.");
+
+        typedef execution::is_sequential_execution_policy<ExPolicy> is_seq;
+
+        return detail::stable_sort<RandomIt>().call(
+            std::forward<ExPolicy>(policy), is_seq(), first, last,
+            std::forward<Compare>(comp), std::forward<Proj>(proj));
+    }
+}}}
+
+#endif
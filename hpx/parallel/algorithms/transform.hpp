@@ -12,6 +12,7 @@
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_callable.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tagged_pair.hpp>
 #include <hpx/util/tagged_tuple.hpp>
@@ -20,6 +21,7 @@
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/config/inline_namespace.hpp>
 #include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/transfer.hpp>
 #include <hpx/parallel/tagspec.hpp>
 #include <hpx/parallel/traits/projected.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
@@ -159,6 +161,38 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                     >::get(std::make_pair(std::move(first), std::move(dest)));
             }
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // non-segmented implementation
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename F, typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, std::pair<InIter, OutIter>
+        >::type
+        transform_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, F && f, Proj && proj, std::false_type)
+        {
+            typedef std::integral_constant<bool,
+                    execution::is_sequential_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<InIter>::value ||
+                   !hpx::traits::is_forward_iterator<OutIter>::value
+                > is_seq;
+
+            return detail::transform<std::pair<InIter, OutIter> >().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, dest, std::forward<F>(f),
+                std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<InIter, OutIter>
+        >::type
+        transform_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, F && f, Proj && proj, std::true_type);
+
         /// \endcond
     }
 
@@ -261,17 +295,17 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 hpx::traits::is_input_iterator<OutIter>::value),
             "Requires at least output iterator.");
 
+        // both sequences have to be segmented for the segmented version of
+        // the algorithm to be used
         typedef std::integral_constant<bool,
-                execution::is_sequential_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<InIter>::value ||
-               !hpx::traits::is_forward_iterator<OutIter>::value
-            > is_seq;
+                detail::iterators_are_segmented<InIter, OutIter>::value
+            > is_segmented;
 
         return hpx::util::make_tagged_pair<tag::in, tag::out>(
-            detail::transform<std::pair<InIter, OutIter> >().call(
-                std::forward<ExPolicy>(policy), is_seq(),
-                first, last, dest, std::forward<F>(f),
-                std::forward<Proj>(proj)));
+            detail::transform_(
+                std::forward<ExPolicy>(policy), first, last, dest,
+                std::forward<F>(f), std::forward<Proj>(proj),
+                is_segmented()));
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -22,7 +22,7 @@
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/loop.hpp>
 #include <hpx/parallel/util/partitioner.hpp>
-#include <hpx/parallel/util/scan_partitioner.hpp>
+#include <hpx/parallel/util/single_pass_scan_partitioner.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -114,58 +114,46 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                 OutIter final_dest = dest;
                 std::advance(final_dest, count);
 
-                // The overall scan algorithm is performed by executing 2
-                // subsequent parallel steps. The first calculates the scan
-                // results for each partition and the second produces the
-                // overall result
+                // The overall scan algorithm is performed in a single pass
+                // over the input. Each tile is reduced first, the tile is
+                // then scanned as soon as the reduction of all preceding
+                // tiles is known, while its data is still in the cache.
 
                 using hpx::util::get;
-                using hpx::util::make_zip_iterator;
 
-                auto f3 =
-                    [op, policy](
-                        zip_iterator part_begin, std::size_t part_size,
-                        hpx::shared_future<T> curr, hpx::shared_future<T> next
-                    )
-                    {
-                        next.get();     // rethrow exceptions
-
-                        T val = curr.get();
-                        OutIter dst = get<1>(part_begin.get_iterator_tuple());
-                        *dst++ = val;
-
-                        util::loop_n<ExPolicy>(
-                            dst, part_size - 1,
-                            [&op, &val](OutIter it)
-                            {
-                                *it = hpx::util::invoke(op, *it, val);
-                            });
-                    };
-
-                return util::scan_partitioner<ExPolicy, OutIter, T>::call(
+                return util::single_pass_scan_partitioner<
+                        ExPolicy, OutIter, T
+                    >::call(
                     std::forward<ExPolicy>(policy),
-                    make_zip_iterator(first, dest), count, init,
-                    // step 1 performs first part of scan algorithm
-                    [op, conv](zip_iterator part_begin, std::size_t part_size) -> T
+                    hpx::util::make_zip_iterator(first, dest), count, init,
+                    // step 1 reduces each tile
+                    [op, conv](
+                        zip_iterator part_begin, std::size_t part_size
+                    ) -> T
                     {
-                        T part_init =
-                            hpx::util::invoke(conv, get<0>(*part_begin++));
+                        auto iters = part_begin.get_iterator_tuple();
+                        FwdIter it = get<0>(iters);
 
+                        T val = hpx::util::invoke(conv, *it);
+                        return sequential_transform_reduce_n(++it,
+                            part_size - 1, conv, std::move(val), op);
+                    },
+                    // step 2 combines the reductions of adjacent tiles
+                    [op](T const& lhs, T const& rhs) -> T
+                    {
+                        return hpx::util::invoke(op, lhs, rhs);
+                    },
+                    // step 3 scans each tile, given the reduction of all
+                    // preceding tiles
+                    [op, conv](zip_iterator part_begin, std::size_t part_size,
+                        T const& prefix)
+                    {
                         auto iters = part_begin.get_iterator_tuple();
-                        return sequential_transform_exclusive_scan_n(
-                            get<0>(iters),
-                            part_size - 1,
-                            get<1>(iters),
-                            conv, part_init, op);
+                        sequential_transform_exclusive_scan_n(get<0>(iters),
+                            part_size, get<1>(iters), conv, prefix, op);
                     },
-                    // step 2 propagates the partition results from left
-                    // to right
-                    hpx::util::unwrapped(op),
-                    // step 3 runs final_accumulation on each partition
-                    std::move(f3),
-                    // use this return value
-                    [final_dest](std::vector<hpx::shared_future<T> > &&,
-                        std::vector<hpx::future<void> > &&)
+                    // step 4 use this return value
+                    [final_dest](T const&)
                     {
                         return final_dest;
                     });
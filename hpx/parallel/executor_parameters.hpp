@@ -10,6 +10,7 @@
 #include <hpx/parallel/executors/dynamic_chunk_size.hpp>
 #include <hpx/parallel/executors/executor_parameter_traits.hpp>
 #include <hpx/parallel/executors/guided_chunk_size.hpp>
+#include <hpx/parallel/executors/lazy_split_chunk_size.hpp>
 #include <hpx/parallel/executors/persistent_auto_chunk_size.hpp>
 #include <hpx/parallel/executors/static_chunk_size.hpp>
 #include <hpx/parallel/executors/thread_executor_parameter_traits.hpp>
@@ -0,0 +1,86 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/lazy_split_chunk_size.hpp
+
+#if !defined(HPX_PARALLEL_LAZY_SPLIT_CHUNK_SIZE_HPP)
+#define HPX_PARALLEL_LAZY_SPLIT_CHUNK_SIZE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/traits/is_executor_parameters.hpp>
+
+#include <cstddef>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Loop iterations are divided into one contiguous range for each core.
+    /// While executing its range, a thread splits off the upper half of the
+    /// remaining iterations whenever the queue of its core has run empty,
+    /// which makes the split-off half available to be stolen by other cores
+    /// (lazy binary splitting). The iterations are executed in pieces of
+    /// \a chunk_size iterations, the decision to split is made in between two
+    /// pieces. If \a chunk_size is not specified (or zero), it is chosen such
+    /// that each core executes about 32 pieces.
+    ///
+    /// \note This executor parameters type is supported by the partitioners
+    ///       used by \a for_each, \a for_loop, \a transform, \a reduce and
+    ///       similar algorithms. The other algorithms treat it like
+    ///       \a static_chunk_size, each core is assigned one contiguous range.
+    ///
+    struct lazy_split_chunk_size : executor_parameters_tag
+    {
+        /// Construct a \a lazy_split_chunk_size executor parameters object
+        ///
+        /// \param chunk_size   [in] The optional number of loop iterations to
+        ///                     execute in between two decisions to split.
+        ///
+        HPX_CONSTEXPR explicit lazy_split_chunk_size(std::size_t chunk_size = 0)
+          : chunk_size_(chunk_size)
+        {}
+
+        /// \cond NOINTERNAL
+        // one initial range for each core
+        template <typename Executor, typename F>
+        HPX_CONSTEXPR std::size_t
+        get_chunk_size(Executor&, F &&, std::size_t cores, std::size_t count)
+        {
+            return (count + cores - 1) / cores;
+        }
+
+        // the number of iterations executed in between two decisions to split
+        std::size_t get_split_chunk_size(std::size_t cores,
+            std::size_t count) const
+        {
+            if (chunk_size_ != 0)
+                return chunk_size_;
+
+            std::size_t chunk_size = count / (32 * cores);
+            return chunk_size == 0 ? 1 : chunk_size;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive & ar, const unsigned int version)
+        {
+            ar & chunk_size_;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::size_t chunk_size_;
+        /// \endcond
+    };
+}}}
+
+#endif
@@ -251,10 +251,8 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                         >::call(r, errors);
 
                         local_iterator_pair p = r.back().get();
-                        return std::make_pair(
-                                output_traits::compose(sdest, p.first),
-                                output_traits::compose(sdest, p.second)
-                            );
+                        return std::make_pair(last,
+                            output_traits::compose(sdest, p.second));
                     },
                     std::move(segments)));
         }
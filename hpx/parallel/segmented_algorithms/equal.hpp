@@ -0,0 +1,269 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_EQUAL)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_EQUAL
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/equal.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_equal
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The second sequence is expected to be partitioned the same way as
+        // the first one, each pair of segments is compared on the locality
+        // where it lives.
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename F>
+        static typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal(Algo && algo, ExPolicy const& policy,
+            SegIter1 first1, SegIter1 last1, SegIter2 first2, F && f,
+            std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef typename traits1::segment_iterator segment_iterator1;
+            typedef typename traits1::local_iterator local_iterator_type1;
+
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+            typedef typename traits2::segment_iterator segment_iterator2;
+            typedef typename traits2::local_iterator local_iterator_type2;
+
+            typedef util::detail::algorithm_result<ExPolicy, bool> result;
+
+            segment_iterator1 sit = traits1::segment(first1);
+            segment_iterator1 send = traits1::segment(last1);
+
+            segment_iterator2 sit2 = traits2::segment(first2);
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type1 beg = traits1::local(first1);
+                local_iterator_type1 end = traits1::local(last1);
+                if (beg != end)
+                {
+                    return result::get(dispatch(traits1::get_id(sit),
+                        algo, policy, std::true_type(),
+                        beg, end, traits2::local(first2), f));
+                }
+                return result::get(true);
+            }
+
+            // handle the remaining part of the first partition
+            local_iterator_type1 beg = traits1::local(first1);
+            local_iterator_type1 end = traits1::end(sit);
+            local_iterator_type2 beg2 = traits2::local(first2);
+            if (beg != end && !dispatch(traits1::get_id(sit), algo, policy,
+                    std::true_type(), beg, end, beg2, f))
+            {
+                return result::get(false);
+            }
+
+            // handle all of the full partitions
+            for ((void) ++sit, ++sit2; sit != send; (void) ++sit, ++sit2)
+            {
+                beg = traits1::begin(sit);
+                end = traits1::end(sit);
+                beg2 = traits2::begin(sit2);
+                if (beg != end && !dispatch(traits1::get_id(sit), algo, policy,
+                        std::true_type(), beg, end, beg2, f))
+                {
+                    return result::get(false);
+                }
+            }
+
+            // handle the beginning of the last partition
+            beg = traits1::begin(sit);
+            end = traits1::local(last1);
+            beg2 = traits2::begin(sit2);
+            if (beg != end && !dispatch(traits1::get_id(sit), algo, policy,
+                    std::true_type(), beg, end, beg2, f))
+            {
+                return result::get(false);
+            }
+
+            return result::get(true);
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename F>
+        static typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal(Algo && algo, ExPolicy const& policy,
+            SegIter1 first1, SegIter1 last1, SegIter2 first2, F && f,
+            std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef typename traits1::segment_iterator segment_iterator1;
+            typedef typename traits1::local_iterator local_iterator_type1;
+
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+            typedef typename traits2::segment_iterator segment_iterator2;
+            typedef typename traits2::local_iterator local_iterator_type2;
+
+            typedef util::detail::algorithm_result<ExPolicy, bool> result;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter1>::value
+                > forced_seq;
+
+            segment_iterator1 sit = traits1::segment(first1);
+            segment_iterator1 send = traits1::segment(last1);
+
+            segment_iterator2 sit2 = traits2::segment(first2);
+
+            std::vector<future<bool> > segments;
+            segments.reserve(std::distance(sit, send));
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type1 beg = traits1::local(first1);
+                local_iterator_type1 end = traits1::local(last1);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits1::get_id(sit),
+                        algo, policy, forced_seq(),
+                        beg, end, traits2::local(first2), f));
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type1 beg = traits1::local(first1);
+                local_iterator_type1 end = traits1::end(sit);
+                local_iterator_type2 beg2 = traits2::local(first2);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits1::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, beg2, f));
+                }
+
+                // handle all of the full partitions
+                for ((void) ++sit, ++sit2; sit != send; (void) ++sit, ++sit2)
+                {
+                    beg = traits1::begin(sit);
+                    end = traits1::end(sit);
+                    beg2 = traits2::begin(sit2);
+                    if (beg != end)
+                    {
+                        segments.push_back(dispatch_async(traits1::get_id(sit),
+                            algo, policy, forced_seq(), beg, end, beg2, f));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg = traits1::begin(sit);
+                end = traits1::local(last1);
+                beg2 = traits2::begin(sit2);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits1::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, beg2, f));
+                }
+            }
+
+            return result::get(
+                dataflow(
+                    [=](std::vector<future<bool> > && r) -> bool
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<boost::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        return std::all_of(r.begin(), r.end(),
+                            [](future<bool>& val)
+                            {
+                                return val.get();
+                            });
+                    },
+                    std::move(segments)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename InIter1, typename InIter2,
+            typename F>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, InIter1 first1, InIter1 last1,
+            InIter2 first2, F && f, std::true_type)
+        {
+            typedef parallel::execution::is_sequential_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            if (first1 == last1)
+            {
+                return util::detail::algorithm_result<ExPolicy, bool>::get(
+                    true);
+            }
+
+            return segmented_equal(equal(), std::forward<ExPolicy>(policy),
+                first1, last1, first2, std::forward<F>(f), is_seq());
+        }
+
+        template <typename ExPolicy, typename InIter1, typename InIter2,
+            typename F>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, InIter1 first1, InIter1 last1,
+            InIter2 first2, InIter2 last2, F && f, std::true_type)
+        {
+            // sequences of different length are never equal, no need to
+            // compare any elements in this case
+            if (std::distance(first1, last1) != std::distance(first2, last2))
+            {
+                return util::detail::algorithm_result<ExPolicy, bool>::get(
+                    false);
+            }
+
+            return equal_(std::forward<ExPolicy>(policy), first1, last1,
+                first2, std::forward<F>(f), std::true_type());
+        }
+
+        // forward declare the non-segmented version of these algorithms
+        template <typename ExPolicy, typename InIter1, typename InIter2,
+            typename F>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, InIter1 first1, InIter1 last1,
+            InIter2 first2, F && f, std::false_type);
+
+        template <typename ExPolicy, typename InIter1, typename InIter2,
+            typename F>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, InIter1 first1, InIter1 last1,
+            InIter2 first2, InIter2 last2, F && f, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
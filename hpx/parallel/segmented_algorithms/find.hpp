@@ -0,0 +1,297 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_FIND)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_FIND
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/find.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_find
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // sequential remote implementation, the segments are searched one
+        // after the other, stopping at the first segment containing a match
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename T>
+        static typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_find(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, T && val, std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef util::detail::algorithm_result<ExPolicy, SegIter> result;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::local(last);
+                if (beg != end)
+                {
+                    local_iterator_type out = dispatch(traits::get_id(sit),
+                        algo, policy, std::true_type(), beg, end, val);
+                    if (out != end)
+                        return result::get(traits::compose(sit, out));
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::end(sit);
+                if (beg != end)
+                {
+                    local_iterator_type out = dispatch(traits::get_id(sit),
+                        algo, policy, std::true_type(), beg, end, val);
+                    if (out != end)
+                        return result::get(traits::compose(sit, out));
+                }
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                {
+                    beg = traits::begin(sit);
+                    end = traits::end(sit);
+                    if (beg != end)
+                    {
+                        local_iterator_type out = dispatch(traits::get_id(sit),
+                            algo, policy, std::true_type(), beg, end, val);
+                        if (out != end)
+                            return result::get(traits::compose(sit, out));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg = traits::begin(sit);
+                end = traits::local(last);
+                if (beg != end)
+                {
+                    local_iterator_type out = dispatch(traits::get_id(sit),
+                        algo, policy, std::true_type(), beg, end, val);
+                    if (out != end)
+                        return result::get(traits::compose(sit, out));
+                }
+            }
+
+            return result::get(std::move(last));
+        }
+
+        // parallel remote implementation, all segments are searched
+        // concurrently, the match in the first segment wins
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename T>
+        static typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_find(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, T && val, std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef util::detail::algorithm_result<ExPolicy, SegIter> result;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            std::vector<future<local_iterator_type> > segments;
+            segments.reserve(std::distance(sit, send));
+
+            // remember where each of the searched ranges ends
+            std::vector<std::pair<segment_iterator, local_iterator_type> >
+                ends;
+            ends.reserve(std::distance(sit, send));
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::local(last);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, val));
+                    ends.push_back(std::make_pair(sit, end));
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::end(sit);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, val));
+                    ends.push_back(std::make_pair(sit, end));
+                }
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                {
+                    beg = traits::begin(sit);
+                    end = traits::end(sit);
+                    if (beg != end)
+                    {
+                        segments.push_back(dispatch_async(traits::get_id(sit),
+                            algo, policy, forced_seq(), beg, end, val));
+                        ends.push_back(std::make_pair(sit, end));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg = traits::begin(sit);
+                end = traits::local(last);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, val));
+                    ends.push_back(std::make_pair(sit, end));
+                }
+            }
+
+            return result::get(
+                dataflow(
+                    [=](std::vector<future<local_iterator_type> > && r)
+                        ->  SegIter
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<boost::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        for (std::size_t i = 0; i != r.size(); ++i)
+                        {
+                            local_iterator_type out = r[i].get();
+                            if (out != ends[i].second)
+                                return traits::compose(ends[i].first, out);
+                        }
+                        return last;
+                    },
+                    std::move(segments)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename InIter, typename T>
+        typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_(ExPolicy && policy, InIter first, InIter last, T const& val,
+            std::true_type)
+        {
+            typedef parallel::execution::is_sequential_execution_policy<
+                    ExPolicy
+                > is_seq;
+            typedef hpx::traits::segmented_iterator_traits<InIter>
+                iterator_traits;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<ExPolicy, InIter>::get(
+                    std::move(last));
+            }
+
+            return segmented_find(
+                find<typename iterator_traits::local_iterator>(),
+                std::forward<ExPolicy>(policy), first, last, val, is_seq());
+        }
+
+        template <typename ExPolicy, typename InIter, typename F>
+        typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_if_(ExPolicy && policy, InIter first, InIter last, F && f,
+            std::true_type)
+        {
+            typedef parallel::execution::is_sequential_execution_policy<
+                    ExPolicy
+                > is_seq;
+            typedef hpx::traits::segmented_iterator_traits<InIter>
+                iterator_traits;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<ExPolicy, InIter>::get(
+                    std::move(last));
+            }
+
+            return segmented_find(
+                find_if<typename iterator_traits::local_iterator>(),
+                std::forward<ExPolicy>(policy), first, last,
+                std::forward<F>(f), is_seq());
+        }
+
+        template <typename ExPolicy, typename InIter, typename F>
+        typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_if_not_(ExPolicy && policy, InIter first, InIter last, F && f,
+            std::true_type)
+        {
+            typedef parallel::execution::is_sequential_execution_policy<
+                    ExPolicy
+                > is_seq;
+            typedef hpx::traits::segmented_iterator_traits<InIter>
+                iterator_traits;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<ExPolicy, InIter>::get(
+                    std::move(last));
+            }
+
+            return segmented_find(
+                find_if_not<typename iterator_traits::local_iterator>(),
+                std::forward<ExPolicy>(policy), first, last,
+                std::forward<F>(f), is_seq());
+        }
+
+        // forward declare the non-segmented version of these algorithms
+        template <typename ExPolicy, typename InIter, typename T>
+        typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_(ExPolicy && policy, InIter first, InIter last, T const& val,
+            std::false_type);
+
+        template <typename ExPolicy, typename InIter, typename F>
+        typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_if_(ExPolicy && policy, InIter first, InIter last, F && f,
+            std::false_type);
+
+        template <typename ExPolicy, typename InIter, typename F>
+        typename util::detail::algorithm_result<ExPolicy, InIter>::type
+        find_if_not_(ExPolicy && policy, InIter first, InIter last, F && f,
+            std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,795 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/latch.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/invoke.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_sort
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The segmented sort is a sample sort: every segment is sorted
+        // locally, a set of splitters is derived from regular samples of all
+        // segments, and each segment is split into buckets by those
+        // splitters. Finally, every segment fetches the pieces of the bucket
+        // (or buckets) ending up in it directly from the segments holding
+        // them, merges them and writes the result back in place. Apart from
+        // the samples and the bucket bounds no element data is sent to the
+        // calling locality.
+
+        // number of samples taken from each of the segments
+        HPX_CONSTEXPR_OR_CONST std::size_t sort_samples_per_segment = 128;
+
+        // Select up to count regularly spaced elements from a sorted segment.
+        template <typename T>
+        struct sort_samples
+          : public detail::algorithm<sort_samples<T>, std::vector<T> >
+        {
+            sort_samples()
+              : sort_samples::algorithm("sort_samples")
+            {}
+
+            template <typename ExPolicy, typename Iter>
+            static std::vector<T>
+            sequential(ExPolicy, Iter first, Iter last, std::size_t count)
+            {
+                std::size_t size = std::distance(first, last);
+                count = (std::min)(count, size);
+
+                std::vector<T> samples;
+                samples.reserve(count);
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    samples.push_back(*std::next(first, (i * size) / count));
+                }
+                return samples;
+            }
+
+            template <typename ExPolicy, typename Iter>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, Iter first, Iter last,
+                std::size_t count)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<T>
+                    >::get(sequential(policy, first, last, count));
+            }
+        };
+
+        // Find the positions the given (sorted) splitters divide a sorted
+        // segment at.
+        struct sort_partition_bounds
+          : public detail::algorithm<
+                sort_partition_bounds, std::vector<std::size_t> >
+        {
+            sort_partition_bounds()
+              : sort_partition_bounds::algorithm("sort_partition_bounds")
+            {}
+
+            template <typename ExPolicy, typename Iter, typename T,
+                typename Compare, typename Proj>
+            static std::vector<std::size_t>
+            sequential(ExPolicy, Iter first, Iter last,
+                std::vector<T> const& splitters, Compare && comp, Proj && proj)
+            {
+                typedef typename std::iterator_traits<Iter>::value_type
+                    value_type;
+
+                std::vector<std::size_t> bounds;
+                bounds.reserve(splitters.size());
+
+                Iter it = first;
+                for (T const& s : splitters)
+                {
+                    it = std::lower_bound(it, last, s,
+                        [&](value_type const& elem, T const& val) -> bool
+                        {
+                            return hpx::util::invoke(comp,
+                                hpx::util::invoke(proj, elem),
+                                hpx::util::invoke(proj, val));
+                        });
+                    bounds.push_back(std::distance(first, it));
+                }
+                return bounds;
+            }
+
+            template <typename ExPolicy, typename Iter, typename T,
+                typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<std::size_t>
+            >::type
+            parallel(ExPolicy && policy, Iter first, Iter last,
+                std::vector<T> const& splitters, Compare && comp, Proj && proj)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<std::size_t>
+                    >::get(sequential(policy, first, last, splitters,
+                        std::forward<Compare>(comp), std::forward<Proj>(proj)));
+            }
+        };
+
+        // Find the range of elements equal to the given value in a part of a
+        // sorted segment, relative to the start of that part.
+        struct sort_equal_range
+          : public detail::algorithm<
+                sort_equal_range, std::vector<std::size_t> >
+        {
+            sort_equal_range()
+              : sort_equal_range::algorithm("sort_equal_range")
+            {}
+
+            template <typename ExPolicy, typename Iter, typename T,
+                typename Compare, typename Proj>
+            static std::vector<std::size_t>
+            sequential(ExPolicy, Iter first, Iter last, T const& val,
+                Compare && comp, Proj && proj)
+            {
+                typedef typename std::iterator_traits<Iter>::value_type
+                    value_type;
+
+                Iter lower = std::lower_bound(first, last, val,
+                    [&](value_type const& elem, T const& v) -> bool
+                    {
+                        return hpx::util::invoke(comp,
+                            hpx::util::invoke(proj, elem),
+                            hpx::util::invoke(proj, v));
+                    });
+                Iter upper = std::upper_bound(lower, last, val,
+                    [&](T const& v, value_type const& elem) -> bool
+                    {
+                        return hpx::util::invoke(comp,
+                            hpx::util::invoke(proj, v),
+                            hpx::util::invoke(proj, elem));
+                    });
+
+                std::vector<std::size_t> range;
+                range.push_back(std::distance(first, lower));
+                range.push_back(std::distance(first, upper));
+                return range;
+            }
+
+            template <typename ExPolicy, typename Iter, typename T,
+                typename Compare, typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<std::size_t>
+            >::type
+            parallel(ExPolicy && policy, Iter first, Iter last, T const& val,
+                Compare && comp, Proj && proj)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<std::size_t>
+                    >::get(sequential(policy, first, last, val,
+                        std::forward<Compare>(comp), std::forward<Proj>(proj)));
+            }
+        };
+
+        // Return a copy of the elements of a part of a segment.
+        template <typename T>
+        struct sort_fetch
+          : public detail::algorithm<sort_fetch<T>, std::vector<T> >
+        {
+            sort_fetch()
+              : sort_fetch::algorithm("sort_fetch")
+            {}
+
+            template <typename ExPolicy, typename Iter>
+            static std::vector<T>
+            sequential(ExPolicy, Iter first, Iter last)
+            {
+                return std::vector<T>(first, last);
+            }
+
+            template <typename ExPolicy, typename Iter>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, Iter first, Iter last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<T>
+                    >::get(sequential(policy, first, last));
+            }
+        };
+
+        // A sorted run of elements belonging to a bucket, stored on the
+        // segment identified by id_.
+        template <typename LocalIter>
+        struct sort_bucket_source
+        {
+            naming::id_type id_;
+            LocalIter first_;
+            LocalIter last_;
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                ar & id_ & first_ & last_;
+            }
+        };
+
+        // The part [offset_, offset_ + count_) of the bucket made up of the
+        // merged sources is to be stored on the receiving segment.
+        template <typename LocalIter>
+        struct sort_bucket
+        {
+            std::vector<sort_bucket_source<LocalIter> > sources_;
+            std::size_t offset_;
+            std::size_t count_;
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned)
+            {
+                ar & sources_ & offset_ & count_;
+            }
+        };
+
+        // Find the positions splitting the sorted runs of a bucket such that
+        // the elements in front of them are the first rank elements of the
+        // merged bucket. Equal elements are ordered by the index of their
+        // run, which is the order the runs are merged in. This is a binary
+        // search on pivot elements taken from the runs, only the pivots and
+        // the bounds of the elements equal to them are transferred.
+        template <typename T, typename LocalIter, typename Compare,
+            typename Proj>
+        std::vector<std::size_t> sort_select_bounds(
+            std::vector<sort_bucket_source<LocalIter> > const& sources,
+            std::size_t rank, Compare const& comp, Proj const& proj)
+        {
+            std::size_t const m = sources.size();
+
+            // the split position of run i is in [lo[i], hi[i]]
+            std::vector<std::size_t> lo(m, 0);
+            std::vector<std::size_t> hi;
+            hi.reserve(m);
+
+            std::size_t total = 0;
+            for (sort_bucket_source<LocalIter> const& src : sources)
+            {
+                hi.push_back(std::distance(src.first_, src.last_));
+                total += hi.back();
+            }
+
+            HPX_ASSERT(rank <= total);
+            if (rank == 0)
+                return lo;
+            if (rank == total)
+                return hi;
+
+            while (true)
+            {
+                // take the pivot from the middle of the largest open range
+                std::size_t k = 0;
+                for (std::size_t i = 1; i != m; ++i)
+                {
+                    if (hi[i] - lo[i] > hi[k] - lo[k])
+                        k = i;
+                }
+                HPX_ASSERT(lo[k] != hi[k]);
+
+                LocalIter pos = sources[k].first_ + (lo[k] + hi[k]) / 2;
+                std::vector<T> pivot = dispatch(sources[k].id_,
+                    sort_fetch<T>(), execution::seq, std::true_type(),
+                    pos, std::next(pos));
+                HPX_ASSERT(pivot.size() == 1);
+
+                std::vector<future<std::vector<std::size_t> > > ranges;
+                ranges.reserve(m);
+                for (std::size_t i = 0; i != m; ++i)
+                {
+                    ranges.push_back(dispatch_async(sources[i].id_,
+                        sort_equal_range(), execution::seq, std::true_type(),
+                        sources[i].first_ + lo[i], sources[i].first_ + hi[i],
+                        pivot[0], comp, proj));
+                }
+                hpx::wait_all(ranges);
+
+                std::vector<std::size_t> lower(m), upper(m);
+                std::size_t num_lower = 0, num_upper = 0;
+                for (std::size_t i = 0; i != m; ++i)
+                {
+                    std::vector<std::size_t> r = ranges[i].get();
+                    lower[i] = lo[i] + r[0];
+                    upper[i] = lo[i] + r[1];
+                    num_lower += lower[i];
+                    num_upper += upper[i];
+                }
+
+                if (num_lower >= rank)
+                {
+                    // all selected elements are less than the pivot
+                    hi = std::move(lower);
+                    if (num_lower == rank)
+                        return hi;
+                }
+                else if (num_upper <= rank)
+                {
+                    // all elements not greater than the pivot are selected
+                    lo = std::move(upper);
+                    if (num_upper == rank)
+                        return lo;
+                }
+                else
+                {
+                    // the split falls into the elements equal to the pivot,
+                    // take them in order of their runs
+                    std::size_t remaining = rank - num_lower;
+                    for (std::size_t i = 0; i != m; ++i)
+                    {
+                        std::size_t n =
+                            (std::min)(remaining, upper[i] - lower[i]);
+                        lower[i] += n;
+                        remaining -= n;
+                    }
+                    return lower;
+                }
+            }
+        }
+
+        // Counts down the latch shared by the segments exactly once, also if
+        // the exchange fails. A failing segment does not wait for the others
+        // as it does not overwrite its elements.
+        class sort_exchange_latch
+        {
+        public:
+            explicit sort_exchange_latch(naming::id_type const& id)
+              : latch_(id), counted_down_(false)
+            {}
+
+            ~sort_exchange_latch()
+            {
+                if (!counted_down_)
+                {
+                    try {
+                        latch_.count_down(1);
+                    }
+                    catch (...) {
+                        // there is nothing we can do at this point
+                    }
+                }
+            }
+
+            void count_down_and_wait()
+            {
+                counted_down_ = true;
+                latch_.count_down_and_wait();
+            }
+
+        private:
+            lcos::latch latch_;
+            bool counted_down_;
+        };
+
+        // Runs on the locality of a segment: gather the elements which end up
+        // in this segment and store them once all segments have fetched their
+        // data.
+        template <typename T, typename LocalIter>
+        struct sort_exchange
+          : public detail::algorithm<sort_exchange<T, LocalIter>, std::size_t>
+        {
+            sort_exchange()
+              : sort_exchange::algorithm("sort_exchange")
+            {}
+
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
+            static std::size_t
+            sequential(ExPolicy, Iter first, Iter last,
+                std::vector<sort_bucket<LocalIter> > const& buckets,
+                naming::id_type const& latch_id, Compare && comp, Proj && proj)
+            {
+                typedef typename hpx::util::decay<Compare>::type compare_type;
+                typedef typename hpx::util::decay<Proj>::type proj_type;
+
+                // the latch is counted down on all paths, otherwise the other
+                // segments would wait forever
+                sort_exchange_latch l(latch_id);
+
+                util::compare_projected<compare_type, proj_type> pred(
+                    comp, proj);
+
+                std::vector<T> data;
+                data.reserve(std::distance(first, last));
+
+                for (sort_bucket<LocalIter> const& b : buckets)
+                {
+                    // fetch only the parts of the runs of this bucket which
+                    // end up in this segment
+                    std::vector<std::size_t> lower = sort_select_bounds<T>(
+                        b.sources_, b.offset_, comp, proj);
+                    std::vector<std::size_t> upper = sort_select_bounds<T>(
+                        b.sources_, b.offset_ + b.count_, comp, proj);
+
+                    std::vector<future<std::vector<T> > > runs;
+                    runs.reserve(b.sources_.size());
+                    for (std::size_t i = 0; i != b.sources_.size(); ++i)
+                    {
+                        if (lower[i] == upper[i])
+                            continue;
+
+                        sort_bucket_source<LocalIter> const& src =
+                            b.sources_[i];
+                        runs.push_back(dispatch_async(src.id_,
+                            sort_fetch<T>(), execution::seq,
+                            std::true_type(), src.first_ + lower[i],
+                            src.first_ + upper[i]));
+                    }
+
+                    // no fetch may be outstanding once this segment is done
+                    hpx::wait_all(runs);
+
+                    // merge the sorted runs
+                    std::size_t const middle = data.size();
+                    for (future<std::vector<T> >& f : runs)
+                    {
+                        std::vector<T> run = f.get();
+                        std::size_t const mid = data.size();
+                        data.insert(data.end(),
+                            std::make_move_iterator(run.begin()),
+                            std::make_move_iterator(run.end()));
+                        std::inplace_merge(data.begin() + middle,
+                            data.begin() + mid, data.end(), pred);
+                    }
+
+                    HPX_ASSERT(data.size() - middle == b.count_);
+                }
+
+                // the segment may be overwritten only after all segments
+                // have fetched their data
+                l.count_down_and_wait();
+
+                HPX_ASSERT(data.size() ==
+                    static_cast<std::size_t>(std::distance(first, last)));
+                std::move(data.begin(), data.end(), first);
+                return data.size();
+            }
+
+            template <typename ExPolicy, typename Iter, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::size_t
+            >::type
+            parallel(ExPolicy && policy, Iter first, Iter last,
+                std::vector<sort_bucket<LocalIter> > const& buckets,
+                naming::id_type const& latch_id, Compare && comp, Proj && proj)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::size_t
+                    >::get(sequential(policy, first, last, buckets, latch_id,
+                        std::forward<Compare>(comp), std::forward<Proj>(proj)));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        SegIter segmented_sort(ExPolicy const& policy, SegIter first,
+            SegIter last, Compare const& comp, Proj const& proj)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            struct segment
+            {
+                naming::id_type id_;
+                local_iterator_type first_;
+                local_iterator_type last_;
+                std::size_t size_;
+            };
+
+            // collect all non-empty segments of the sequence
+            std::vector<segment> segments;
+
+            auto add_segment =
+                [&segments](segment_iterator sit, local_iterator_type beg,
+                    local_iterator_type end)
+                {
+                    std::size_t size = std::distance(beg, end);
+                    if (size != 0)
+                    {
+                        segments.push_back(
+                            segment{traits::get_id(sit), beg, end, size});
+                    }
+                };
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                add_segment(sit, traits::local(first), traits::local(last));
+            }
+            else {
+                // handle the remaining part of the first partition
+                add_segment(sit, traits::local(first), traits::end(sit));
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                    add_segment(sit, traits::begin(sit), traits::end(sit));
+
+                // handle the beginning of the last partition
+                add_segment(sit, traits::begin(sit), traits::local(last));
+            }
+
+            std::size_t const p = segments.size();
+            std::list<boost::exception_ptr> errors;
+
+            // sort all segments locally
+            {
+                std::vector<future<local_iterator_type> > sorted;
+                sorted.reserve(p);
+                for (segment const& s : segments)
+                {
+                    sorted.push_back(dispatch_async(s.id_,
+                        sort<local_iterator_type>(), policy, forced_seq(),
+                        s.first_, s.last_, comp, proj));
+                }
+                hpx::wait_all(sorted);
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(sorted, errors);
+            }
+
+            if (p < 2)
+                return last;
+
+            // select the splitters from regular samples of all segments
+            std::vector<value_type> splitters;
+            std::vector<std::size_t> offsets(p + 1, 0);
+            {
+                std::vector<future<std::vector<value_type> > > samples;
+                samples.reserve(p);
+                for (std::size_t i = 0; i != p; ++i)
+                {
+                    segment const& s = segments[i];
+                    samples.push_back(dispatch_async(s.id_,
+                        sort_samples<value_type>(), policy, forced_seq(),
+                        s.first_, s.last_, sort_samples_per_segment));
+                    offsets[i + 1] = offsets[i] + s.size_;
+                }
+                hpx::wait_all(samples);
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(samples, errors);
+
+                std::vector<value_type> all_samples;
+                for (future<std::vector<value_type> >& f : samples)
+                {
+                    std::vector<value_type> s = f.get();
+                    all_samples.insert(all_samples.end(),
+                        std::make_move_iterator(s.begin()),
+                        std::make_move_iterator(s.end()));
+                }
+
+                std::sort(all_samples.begin(), all_samples.end(),
+                    util::compare_projected<Compare, Proj>(comp, proj));
+
+                // bucket j is destined to end up in segment j, choose the
+                // splitters such that the buckets are sized proportionally
+                // to the segments
+                std::size_t const count = all_samples.size();
+                std::size_t const total = offsets[p];
+                splitters.reserve(p - 1);
+                for (std::size_t j = 1; j != p; ++j)
+                {
+                    std::size_t rank = (offsets[j] * count) / total;
+                    splitters.push_back(
+                        all_samples[(std::min)(rank, count - 1)]);
+                }
+            }
+
+            // bounds[i][j] is the start of bucket j in segment i
+            std::vector<std::vector<std::size_t> > bounds;
+            bounds.reserve(p);
+            {
+                std::vector<future<std::vector<std::size_t> > > results;
+                results.reserve(p);
+                for (segment const& s : segments)
+                {
+                    results.push_back(dispatch_async(s.id_,
+                        sort_partition_bounds(), policy, forced_seq(),
+                        s.first_, s.last_, splitters, comp, proj));
+                }
+                hpx::wait_all(results);
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(results, errors);
+
+                for (std::size_t i = 0; i != p; ++i)
+                {
+                    std::vector<std::size_t> b = results[i].get();
+                    b.insert(b.begin(), std::size_t(0));
+                    b.push_back(segments[i].size_);
+                    bounds.push_back(std::move(b));
+                }
+            }
+
+            // global position of each of the buckets in the sorted sequence
+            std::vector<std::size_t> bucket_offsets(p + 1, 0);
+            for (std::size_t j = 0; j != p; ++j)
+            {
+                std::size_t size = 0;
+                for (std::size_t i = 0; i != p; ++i)
+                    size += bounds[i][j + 1] - bounds[i][j];
+                bucket_offsets[j + 1] = bucket_offsets[j] + size;
+            }
+
+            // let each segment fetch its part of the overlapping buckets,
+            // the latch keeps any segment from being overwritten before all
+            // of its data has been fetched
+            hpx::lcos::latch l(static_cast<std::ptrdiff_t>(p));
+            {
+                std::vector<future<std::size_t> > exchanged;
+                exchanged.reserve(p);
+                try {
+                    for (std::size_t k = 0; k != p; ++k)
+                    {
+                        std::size_t const lo = offsets[k];
+                        std::size_t const hi = offsets[k + 1];
+
+                        std::vector<sort_bucket<local_iterator_type> > buckets;
+                        for (std::size_t j = 0; j != p; ++j)
+                        {
+                            std::size_t const blo =
+                                (std::max)(lo, bucket_offsets[j]);
+                            std::size_t const bhi =
+                                (std::min)(hi, bucket_offsets[j + 1]);
+                            if (blo >= bhi)
+                                continue;
+
+                            sort_bucket<local_iterator_type> b;
+                            b.offset_ = blo - bucket_offsets[j];
+                            b.count_ = bhi - blo;
+                            for (std::size_t i = 0; i != p; ++i)
+                            {
+                                if (bounds[i][j] == bounds[i][j + 1])
+                                    continue;
+
+                                sort_bucket_source<local_iterator_type> src;
+                                src.id_ = segments[i].id_;
+                                src.first_ =
+                                    segments[i].first_ + bounds[i][j];
+                                src.last_ =
+                                    segments[i].first_ + bounds[i][j + 1];
+                                b.sources_.push_back(std::move(src));
+                            }
+                            buckets.push_back(std::move(b));
+                        }
+
+                        segment const& s = segments[k];
+                        exchanged.push_back(dispatch_async(s.id_,
+                            sort_exchange<value_type, local_iterator_type>(),
+                            policy, forced_seq(), s.first_, s.last_,
+                            std::move(buckets), l.get_id(), comp, proj));
+                    }
+                }
+                catch (...) {
+                    // the segments which were not started yet will never
+                    // count down the latch, release the ones running already
+                    l.count_down(
+                        static_cast<std::ptrdiff_t>(p - exchanged.size()));
+                    hpx::wait_all(exchanged);
+                    throw;
+                }
+
+                hpx::wait_all(exchanged);
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(exchanged, errors);
+            }
+
+            return last;
+        }
+
+        // sort synchronously
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_sort(ExPolicy && policy, SegIter first, SegIter last,
+            Compare && comp, Proj && proj, std::false_type)
+        {
+            return util::detail::algorithm_result<ExPolicy, SegIter>::get(
+                segmented_sort(policy, first, last, comp, proj));
+        }
+
+        // sort asynchronously
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_sort(ExPolicy && policy, SegIter first, SegIter last,
+            Compare && comp, Proj && proj, std::true_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Compare>::type compare_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            policy_type p = std::forward<ExPolicy>(policy);
+            compare_type c = std::forward<Compare>(comp);
+            proj_type pr = std::forward<Proj>(proj);
+
+            return util::detail::algorithm_result<ExPolicy, SegIter>::get(
+                hpx::async(
+                    [p, first, last, c, pr]() -> SegIter
+                    {
+                        return segmented_sort(p, first, last, c, pr);
+                    }));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::true_type)
+        {
+            typedef parallel::execution::is_async_execution_policy<ExPolicy>
+                is_async;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<ExPolicy, RandomIt>::get(
+                    std::move(last));
+            }
+
+            return segmented_sort(std::forward<ExPolicy>(policy), first, last,
+                std::forward<Compare>(comp), std::forward<Proj>(proj),
+                is_async());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
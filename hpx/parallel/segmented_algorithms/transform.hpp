@@ -0,0 +1,291 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_TRANSFORM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_TRANSFORM
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/transform.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_transform
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The destination is expected to be partitioned the same way as the
+        // source (as it is for copy), each segment is transformed on the
+        // locality where it lives.
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename SegOutIter, typename F, typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter, SegOutIter>
+        >::type
+        segmented_transform(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, SegOutIter dest, F && f, Proj && proj,
+            std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+
+            typedef hpx::traits::segmented_iterator_traits<SegOutIter>
+                output_traits;
+            typedef typename output_traits::segment_iterator
+                segment_output_iterator;
+            typedef typename output_traits::local_iterator
+                local_output_iterator_type;
+
+            typedef std::pair<
+                    local_iterator_type, local_output_iterator_type
+                > local_iterator_pair;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            segment_output_iterator sdest = output_traits::segment(dest);
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::local(last);
+                if (beg != end)
+                {
+                    local_iterator_pair p = dispatch(traits::get_id(sit),
+                        algo, policy, std::true_type(),
+                        beg, end, output_traits::local(dest), f, proj);
+
+                    dest = output_traits::compose(sdest, p.second);
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::end(sit);
+                local_output_iterator_type out = output_traits::local(dest);
+
+                if (beg != end)
+                {
+                    local_iterator_pair p = dispatch(traits::get_id(sit),
+                        algo, policy, std::true_type(), beg, end, out, f, proj);
+                    out = p.second;
+                }
+
+                // handle all of the full partitions
+                for ((void) ++sit, ++sdest; sit != send; (void) ++sit, ++sdest)
+                {
+                    beg = traits::begin(sit);
+                    end = traits::end(sit);
+                    out = output_traits::begin(sdest);
+
+                    if (beg != end)
+                    {
+                        local_iterator_pair p = dispatch(traits::get_id(sit),
+                            algo, policy, std::true_type(),
+                            beg, end, out, f, proj);
+                        out = p.second;
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg = traits::begin(sit);
+                end = traits::local(last);
+                out = output_traits::begin(sdest);
+                if (beg != end)
+                {
+                    local_iterator_pair p = dispatch(traits::get_id(sit),
+                        algo, policy, std::true_type(), beg, end, out, f, proj);
+                    out = p.second;
+                }
+
+                dest = output_traits::compose(sdest, out);
+            }
+
+            return util::detail::algorithm_result<
+                    ExPolicy, std::pair<SegIter, SegOutIter>
+                >::get(std::make_pair(last, dest));
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename SegOutIter, typename F, typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter, SegOutIter>
+        >::type
+        segmented_transform(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, SegOutIter dest, F && f, Proj && proj,
+            std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+
+            typedef hpx::traits::segmented_iterator_traits<SegOutIter>
+                output_traits;
+            typedef typename output_traits::segment_iterator
+                segment_output_iterator;
+            typedef typename output_traits::local_iterator
+                local_output_iterator_type;
+
+            typedef std::pair<
+                    local_iterator_type, local_output_iterator_type
+                > local_iterator_pair;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            segment_output_iterator sdest = output_traits::segment(dest);
+
+            std::vector<future<local_iterator_pair> > segments;
+            segments.reserve(std::distance(sit, send));
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::local(last);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(),
+                        beg, end, output_traits::local(dest), f, proj));
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type beg = traits::local(first);
+                local_iterator_type end = traits::end(sit);
+                local_output_iterator_type out = output_traits::local(dest);
+
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, out, f, proj));
+                }
+
+                // handle all of the full partitions
+                for ((void) ++sit, ++sdest; sit != send; (void) ++sit, ++sdest)
+                {
+                    beg = traits::begin(sit);
+                    end = traits::end(sit);
+                    out = output_traits::begin(sdest);
+
+                    if (beg != end)
+                    {
+                        segments.push_back(dispatch_async(traits::get_id(sit),
+                            algo, policy, forced_seq(),
+                            beg, end, out, f, proj));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg = traits::begin(sit);
+                end = traits::local(last);
+                out = output_traits::begin(sdest);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, out, f, proj));
+                }
+            }
+            HPX_ASSERT(!segments.empty());
+
+            return util::detail::algorithm_result<
+                    ExPolicy, std::pair<SegIter, SegOutIter>
+                >::get(dataflow(
+                    [=](std::vector<future<local_iterator_pair> > && r)
+                        ->  std::pair<SegIter, SegOutIter>
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<boost::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        local_iterator_pair p = r.back().get();
+                        return std::make_pair(last,
+                            output_traits::compose(sdest, p.second));
+                    },
+                    std::move(segments)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<InIter, OutIter>
+        >::type
+        transform_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, F && f, Proj && proj, std::true_type)
+        {
+            typedef parallel::execution::is_sequential_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            typedef hpx::traits::segmented_iterator_traits<InIter>
+                input_traits;
+            typedef hpx::traits::segmented_iterator_traits<OutIter>
+                output_traits;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::pair<InIter, OutIter>
+                    >::get(std::make_pair(last, dest));
+            }
+
+            typedef std::pair<
+                    typename input_traits::local_iterator,
+                    typename output_traits::local_iterator
+                > local_iterator_pair;
+
+            return segmented_transform(transform<local_iterator_pair>(),
+                std::forward<ExPolicy>(policy), first, last, dest,
+                std::forward<F>(f), std::forward<Proj>(proj), is_seq());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<InIter, OutIter>
+        >::type
+        transform_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, F && f, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -7,6 +7,10 @@
 #define HPX_PARALLEL_TRAITS_EXTRACT_PARTITIONER_OCT_03_2014_0105PM
 
 #include <hpx/config.hpp>
+#include <hpx/parallel/executors/lazy_split_chunk_size.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <type_traits>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace parallel { namespace traits
@@ -14,12 +18,31 @@ namespace hpx { namespace parallel { namespace traits
     struct static_partitioner_tag {};
     struct auto_partitioner_tag {};
     struct default_partitioner_tag {};
+    struct lazy_split_partitioner_tag {};
 
     template <typename ExPolicy, typename Enable = void>
     struct extract_partitioner
     {
         typedef default_partitioner_tag type;
     };
+
+    // execution policies using lazy_split_chunk_size select the partitioner
+    // splitting the iterations on demand
+    template <typename ExPolicy>
+    struct extract_partitioner<ExPolicy,
+        typename std::enable_if<
+            std::is_same<
+                typename hpx::util::decay<
+                    typename hpx::util::decay_unwrap<
+                        typename ExPolicy::executor_parameters_type
+                    >::type
+                >::type,
+                parallel::lazy_split_chunk_size
+            >::value
+        >::type>
+    {
+        typedef lazy_split_partitioner_tag type;
+    };
 }}}
 
 #endif
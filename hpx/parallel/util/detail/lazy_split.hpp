@@ -0,0 +1,284 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_UTIL_DETAIL_LAZY_SPLIT_HPP)
+#define HPX_PARALLEL_UTIL_DETAIL_LAZY_SPLIT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/tuple.hpp>
+#include <hpx/util/unwrap_ref.hpp>
+
+#include <hpx/parallel/algorithms/detail/predicates.hpp>
+#include <hpx/parallel/executors/executor_information_traits.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/parallel/util/detail/chunk_size.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace util { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Result>
+    struct lazy_split_invoke
+    {
+        template <typename F, typename FwdIter>
+        static hpx::future<Result> call(F& f, FwdIter it, std::size_t size,
+            std::size_t base_idx)
+        {
+            try {
+                return hpx::make_ready_future(
+                    hpx::util::invoke(f, it, size, base_idx));
+            }
+            catch (...) {
+                return hpx::make_exceptional_future<Result>(
+                    boost::current_exception());
+            }
+        }
+    };
+
+    template <>
+    struct lazy_split_invoke<void>
+    {
+        template <typename F, typename FwdIter>
+        static hpx::future<void> call(F& f, FwdIter it, std::size_t size,
+            std::size_t base_idx)
+        {
+            try {
+                hpx::util::invoke(f, it, size, base_idx);
+                return hpx::make_ready_future();
+            }
+            catch (...) {
+                return hpx::make_exceptional_future<void>(
+                    boost::current_exception());
+            }
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Adapt a function taking (first, size) to the (first, size, base_idx)
+    // signature used by lazy_split.
+    template <typename F>
+    struct lazy_split_drop_index
+    {
+        typename hpx::util::decay<F>::type f_;
+
+        template <typename FwdIter>
+        HPX_FORCEINLINE auto operator()(FwdIter it, std::size_t size,
+                std::size_t)
+        ->  decltype(hpx::util::invoke(f_, it, size))
+        {
+            return hpx::util::invoke(f_, it, size);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Lazy binary splitting: every task executes its range of iterations in
+    // pieces of chunk_size iterations. Before starting a piece the task
+    // checks whether the queue of the core it runs on is empty. If it is
+    // (and enough iterations are left), it splits off the upper half of its
+    // remaining iterations into a new task, which can then be stolen by an
+    // idle core. This way new tasks are created only if there is a core
+    // which can run them.
+    //
+    // The results of all pieces are delivered in order of their position in
+    // the input sequence once all tasks have finished.
+    template <typename Result, typename Executor, typename FwdIter,
+        typename F>
+    struct lazy_split_state
+      : std::enable_shared_from_this<
+            lazy_split_state<Result, Executor, FwdIter, F> >
+    {
+        typedef hpx::parallel::executor_traits<Executor> executor_traits;
+        typedef std::pair<std::size_t, hpx::future<Result> > result_type;
+
+        template <typename F_>
+        lazy_split_state(Executor const& exec, F_ && f,
+                std::size_t chunk_size, std::size_t stride)
+          : exec_(exec),
+            f_(std::forward<F_>(f)),
+            chunk_size_(chunk_size),
+            stride_(stride),
+            outstanding_(1)
+        {}
+
+        template <typename Shapes>
+        void start(Shapes const& shapes)
+        {
+            for (auto const& shape : shapes)
+            {
+                spawn(hpx::util::get<0>(shape), hpx::util::get<1>(shape),
+                    hpx::util::get<2>(shape));
+            }
+            finish();
+        }
+
+        hpx::future<std::vector<hpx::future<Result> > > get_future()
+        {
+            return promise_.get_future();
+        }
+
+    private:
+        void spawn(FwdIter it, std::size_t size, std::size_t base_idx)
+        {
+            ++outstanding_;
+
+            std::shared_ptr<lazy_split_state> self(this->shared_from_this());
+            try {
+                executor_traits::async_execute(exec_,
+                    [self, it, size, base_idx]()
+                    {
+                        self->run(it, size, base_idx);
+                    });
+            }
+            catch (...) {
+                // the task could not be created, do the work right here
+                run(it, size, base_idx);
+            }
+        }
+
+        void run(FwdIter it, std::size_t size, std::size_t base_idx)
+        {
+            // every task works on its own copy of the function object
+            typename hpx::util::decay<F>::type f = f_;
+
+            while (size != 0)
+            {
+                if (size >= 2 * chunk_size_ &&
+                    hpx::threads::get_local_queue_length() == 0)
+                {
+                    std::size_t half = size / 2;
+                    if (stride_ != 1)
+                        half = ((half + stride_ - 1) / stride_) * stride_;
+
+                    if (half < size)
+                    {
+                        spawn(parallel::v1::detail::next(it, half),
+                            size - half, base_idx + half);
+                        size = half;
+                    }
+                }
+
+                std::size_t piece = (std::min)(chunk_size_, size);
+
+                hpx::future<Result> r = lazy_split_invoke<Result>::call(
+                    f, it, piece, base_idx);
+                bool failed = r.has_exception();
+
+                {
+                    std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+                    results_.emplace_back(base_idx, std::move(r));
+                }
+
+                // stop working on this range after the first error
+                if (failed)
+                    break;
+
+                size -= piece;
+                base_idx += piece;
+                if (size != 0)
+                    it = parallel::v1::detail::next(it, piece);
+            }
+
+            finish();
+        }
+
+        void finish()
+        {
+            if (--outstanding_ != 0)
+                return;
+
+            std::sort(results_.begin(), results_.end(),
+                [](result_type const& lhs, result_type const& rhs)
+                {
+                    return lhs.first < rhs.first;
+                });
+
+            std::vector<hpx::future<Result> > results;
+            results.reserve(results_.size());
+            for (result_type& r : results_)
+                results.push_back(std::move(r.second));
+
+            promise_.set_value(std::move(results));
+        }
+
+    private:
+        Executor exec_;
+        typename hpx::util::decay<F>::type f_;
+        std::size_t const chunk_size_;
+        std::size_t const stride_;
+
+        // the number of running tasks, plus one while tasks are being
+        // created in start()
+        std::atomic<std::size_t> outstanding_;
+
+        hpx::lcos::local::spinlock mtx_;
+        std::vector<result_type> results_;
+
+        hpx::lcos::local::promise<std::vector<hpx::future<Result> > > promise_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Execute f(it, size, base_idx) for all iterations of the given range
+    // using lazy binary splitting. The returned future becomes ready once
+    // all iterations have been executed. The policy has to use
+    // lazy_split_chunk_size as its executor parameters.
+    template <typename Result, typename ExPolicy, typename FwdIter,
+        typename Stride, typename F>
+    hpx::future<std::vector<hpx::future<Result> > >
+    lazy_split(ExPolicy && policy, FwdIter first, std::size_t count,
+        Stride s, F && f)
+    {
+        typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+            executor_type;
+        typedef lazy_split_state<Result, executor_type, FwdIter, F>
+            state_type;
+
+        std::size_t const cores = executor_information_traits<executor_type>::
+            processing_units_count(policy.executor(), policy.parameters());
+
+        std::size_t stride = std::size_t(parallel::v1::detail::abs(s));
+        std::size_t chunk_size = hpx::util::unwrap_ref(policy.parameters()).
+            get_split_chunk_size(cores, count);
+        if (stride != 1)
+        {
+            chunk_size = (std::max)(stride,
+                ((chunk_size + stride) / stride - 1) * stride);
+        }
+
+        // the executor parameters don't invoke the test function, no
+        // iterations are executed while determining the initial ranges
+        std::vector<hpx::future<Result> > inititems;
+        auto shapes = get_bulk_iteration_shape_idx(policy, inititems, f,
+            first, count, s, std::false_type());
+        HPX_ASSERT(inititems.empty());
+
+        std::shared_ptr<state_type> state = std::make_shared<state_type>(
+            policy.executor(), std::forward<F>(f), chunk_size, stride);
+
+        hpx::future<std::vector<hpx::future<Result> > > result =
+            state->get_future();
+        state->start(shapes);
+        return result;
+    }
+}}}}
+
+#endif
@@ -22,6 +22,7 @@
 #include <hpx/parallel/traits/extract_partitioner.hpp>
 #include <hpx/parallel/util/detail/chunk_size.hpp>
 #include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/detail/lazy_split.hpp>
 #include <hpx/parallel/util/detail/partitioner_iteration.hpp>
 #include <hpx/parallel/util/detail/scoped_executor_parameters.hpp>
 
@@ -189,6 +190,112 @@ namespace hpx { namespace parallel { namespace util
           : foreach_static_partitioner<execution::parallel_task_policy, Result>
         {};
 
+        ///////////////////////////////////////////////////////////////////////
+        // The lazy split partitioner starts one task for each core, each of
+        // which splits off half of its remaining iterations whenever its core
+        // runs out of work (see lazy_split).
+        template <typename ExPolicy_, typename Result = void>
+        struct foreach_lazy_split_partitioner
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2>
+            static FwdIter call(ExPolicy && policy, FwdIter first,
+                std::size_t count, F1 && f1, F2 && f2)
+            {
+                typedef typename
+                    hpx::util::decay<ExPolicy>::type::executor_parameters_type
+                    parameters_type;
+
+                // inform parameter traits
+                scoped_executor_parameters<parameters_type> scoped_param(
+                    policy.parameters());
+
+                FwdIter last = parallel::v1::detail::next(first, count);
+
+                std::vector<hpx::future<Result> > workitems;
+                std::list<boost::exception_ptr> errors;
+
+                try {
+                    workitems = lazy_split<Result>(policy, first, count, 1,
+                        std::forward<F1>(f1)).get();
+                }
+                catch (...) {
+                    handle_local_exceptions<ExPolicy>::call(
+                        boost::current_exception(), errors);
+                }
+
+                // handle exceptions
+                handle_local_exceptions<ExPolicy>::call(workitems, errors);
+
+                try {
+                    return f2(std::move(last));
+                }
+                catch (...) {
+                    // rethrow either bad_alloc or exception_list
+                    handle_local_exceptions<ExPolicy>::call(
+                        boost::current_exception());
+                }
+            }
+        };
+
+        template <typename Result>
+        struct foreach_lazy_split_partitioner<
+            execution::parallel_task_policy, Result>
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2>
+            static hpx::future<FwdIter> call(ExPolicy && policy,
+                FwdIter first, std::size_t count, F1 && f1, F2 && f2)
+            {
+                typedef typename
+                    hpx::util::decay<ExPolicy>::type::executor_parameters_type
+                    parameters_type;
+                typedef scoped_executor_parameters<parameters_type>
+                    scoped_executor_parameters;
+
+                // inform parameter traits
+                std::shared_ptr<scoped_executor_parameters>
+                    scoped_param(std::make_shared<
+                            scoped_executor_parameters
+                        >(policy.parameters()));
+
+                FwdIter last = parallel::v1::detail::next(first, count);
+
+                hpx::future<std::vector<hpx::future<Result> > > workitems;
+                try {
+                    workitems = lazy_split<Result>(policy, first, count, 1,
+                        std::forward<F1>(f1));
+                }
+                catch (...) {
+                    return hpx::make_exceptional_future<FwdIter>(
+                        boost::current_exception());
+                }
+
+                // wait for all tasks to finish
+                return workitems.then(
+                    [last, scoped_param, f2](
+                        hpx::future<std::vector<hpx::future<Result> > > && f)
+                        mutable -> FwdIter
+                    {
+                        HPX_UNUSED(scoped_param);
+                        std::vector<hpx::future<Result> > r = f.get();
+
+                        std::list<boost::exception_ptr> errors;
+                        handle_local_exceptions<ExPolicy>::call(r, errors);
+
+                        return f2(std::move(last));
+                    });
+            }
+        };
+
+        template <typename Executor, typename Parameters, typename Result>
+        struct foreach_lazy_split_partitioner<
+                execution::parallel_task_policy_shim<Executor, Parameters>,
+                Result>
+          : foreach_lazy_split_partitioner<
+                execution::parallel_task_policy, Result>
+        {};
+
         ///////////////////////////////////////////////////////////////////////
         // ExPolicy: execution policy
         // Result:   intermediate result type of first step (default: void)
@@ -231,6 +338,41 @@ namespace hpx { namespace parallel { namespace util
             }
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy_, typename Result>
+        struct foreach_partitioner<ExPolicy_, Result,
+            parallel::traits::lazy_split_partitioner_tag>
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2>
+            static FwdIter call(ExPolicy && policy, FwdIter first,
+                std::size_t count, F1 && f1, F2 && f2)
+            {
+                return foreach_lazy_split_partitioner<
+                        typename hpx::util::decay<ExPolicy>::type, Result
+                    >::call(
+                        std::forward<ExPolicy>(policy), first, count,
+                        std::forward<F1>(f1), std::forward<F2>(f2));
+            }
+        };
+
+        template <typename Result>
+        struct foreach_partitioner<execution::parallel_task_policy, Result,
+                parallel::traits::lazy_split_partitioner_tag>
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2>
+            static hpx::future<FwdIter> call(ExPolicy && policy,
+                FwdIter first, std::size_t count, F1 && f1, F2 && f2)
+            {
+                return foreach_lazy_split_partitioner<
+                        execution::parallel_task_policy, Result
+                    >::call(
+                        std::forward<ExPolicy>(policy), first, count,
+                        std::forward<F1>(f1), std::forward<F2>(f2));
+            }
+        };
+
 #if defined(HPX_HAVE_DATAPAR)
         template <typename Result>
         struct foreach_partitioner<execution::datapar_task_policy, Result,
@@ -248,6 +390,13 @@ namespace hpx { namespace parallel { namespace util
                         std::forward<F1>(f1), std::forward<F2>(f2));
             }
         };
+
+        template <typename Result>
+        struct foreach_partitioner<execution::datapar_task_policy, Result,
+                parallel::traits::lazy_split_partitioner_tag>
+          : foreach_partitioner<execution::parallel_task_policy, Result,
+                parallel::traits::lazy_split_partitioner_tag>
+        {};
 #endif
 
         template <typename Executor, typename Parameters, typename Result>
@@ -266,6 +415,14 @@ namespace hpx { namespace parallel { namespace util
                 parallel::traits::auto_partitioner_tag>
         {};
 
+        template <typename Executor, typename Parameters, typename Result>
+        struct foreach_partitioner<
+                execution::parallel_task_policy_shim<Executor, Parameters>,
+                Result, parallel::traits::lazy_split_partitioner_tag>
+          : foreach_partitioner<execution::parallel_task_policy, Result,
+                parallel::traits::lazy_split_partitioner_tag>
+        {};
+
         template <typename Executor, typename Parameters, typename Result>
         struct foreach_partitioner<
                 execution::parallel_task_policy_shim<Executor, Parameters>,
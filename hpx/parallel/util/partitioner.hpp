@@ -20,6 +20,7 @@
 #include <hpx/parallel/traits/extract_partitioner.hpp>
 #include <hpx/parallel/util/detail/chunk_size.hpp>
 #include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/detail/lazy_split.hpp>
 #include <hpx/parallel/util/detail/partitioner_iteration.hpp>
 #include <hpx/parallel/util/detail/scoped_executor_parameters.hpp>
 
@@ -488,6 +489,130 @@ namespace hpx { namespace parallel { namespace util
           : static_partitioner<execution::parallel_task_policy, R, Result>
         {};
 
+        ///////////////////////////////////////////////////////////////////////
+        // The lazy split partitioner starts one task for each core, each of
+        // which splits off half of its remaining iterations whenever its core
+        // runs out of work (see lazy_split).
+        template <typename ExPolicy_, typename R, typename Result = void>
+        struct lazy_split_partitioner
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2>
+            static R call(ExPolicy && policy, FwdIter first,
+                std::size_t count, F1 && f1, F2 && f2)
+            {
+                return call_with_index(std::forward<ExPolicy>(policy), first,
+                    count, 1,
+                    lazy_split_drop_index<F1>{std::forward<F1>(f1)},
+                    std::forward<F2>(f2));
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Stride,
+                typename F1, typename F2>
+            static R call_with_index(ExPolicy && policy, FwdIter first,
+                std::size_t count, Stride stride, F1 && f1, F2 && f2)
+            {
+                typedef typename
+                    hpx::util::decay<ExPolicy>::type::executor_parameters_type
+                    parameters_type;
+
+                // inform parameter traits
+                scoped_executor_parameters<parameters_type> scoped_param(
+                    policy.parameters());
+
+                std::vector<hpx::future<Result> > workitems;
+                std::list<boost::exception_ptr> errors;
+
+                try {
+                    workitems = lazy_split<Result>(policy, first, count,
+                        stride, std::forward<F1>(f1)).get();
+                }
+                catch (...) {
+                    handle_local_exceptions<ExPolicy>::call(
+                        boost::current_exception(), errors);
+                }
+
+                // always rethrow if 'errors' is not empty or workitems has
+                // exceptional future
+                handle_local_exceptions<ExPolicy>::call(workitems, errors);
+
+                try {
+                    return f2(std::move(workitems));
+                }
+                catch (...) {
+                    // rethrow either bad_alloc or exception_list
+                    handle_local_exceptions<ExPolicy>::call(
+                        boost::current_exception());
+                }
+            }
+        };
+
+        template <typename R, typename Result>
+        struct lazy_split_partitioner<
+            execution::parallel_task_policy, R, Result>
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2>
+            static hpx::future<R> call(ExPolicy && policy,
+                FwdIter first, std::size_t count, F1 && f1, F2 && f2)
+            {
+                return call_with_index(std::forward<ExPolicy>(policy), first,
+                    count, 1,
+                    lazy_split_drop_index<F1>{std::forward<F1>(f1)},
+                    std::forward<F2>(f2));
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Stride,
+                typename F1, typename F2>
+            static hpx::future<R> call_with_index(ExPolicy && policy,
+                FwdIter first, std::size_t count, Stride stride,
+                F1 && f1, F2 && f2)
+            {
+                typedef typename
+                    hpx::util::decay<ExPolicy>::type::executor_parameters_type
+                    parameters_type;
+                typedef scoped_executor_parameters<parameters_type>
+                    scoped_executor_parameters;
+
+                // inform parameter traits
+                std::shared_ptr<scoped_executor_parameters>
+                    scoped_param(std::make_shared<
+                            scoped_executor_parameters
+                        >(policy.parameters()));
+
+                hpx::future<std::vector<hpx::future<Result> > > workitems;
+                try {
+                    workitems = lazy_split<Result>(policy, first, count,
+                        stride, std::forward<F1>(f1));
+                }
+                catch (...) {
+                    return hpx::make_exceptional_future<R>(
+                        boost::current_exception());
+                }
+
+                // wait for all tasks to finish
+                return workitems.then(
+                    [f2, scoped_param](
+                        hpx::future<std::vector<hpx::future<Result> > > && f)
+                        mutable -> R
+                    {
+                        std::vector<hpx::future<Result> > r = f.get();
+
+                        std::list<boost::exception_ptr> errors;
+                        handle_local_exceptions<ExPolicy>::call(r, errors);
+                        return f2(std::move(r));
+                    });
+            }
+        };
+
+        template <typename Executor, typename Parameters, typename R,
+            typename Result>
+        struct lazy_split_partitioner<
+                execution::parallel_task_policy_shim<Executor, Parameters>,
+                R, Result>
+          : lazy_split_partitioner<execution::parallel_task_policy, R, Result>
+        {};
+
         ///////////////////////////////////////////////////////////////////////
         // ExPolicy: execution policy
         // R:        overall result type
@@ -583,6 +708,96 @@ namespace hpx { namespace parallel { namespace util
             }
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy_, typename R, typename Result>
+        struct partitioner<ExPolicy_, R, Result,
+            parallel::traits::lazy_split_partitioner_tag>
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2>
+            static R call(ExPolicy && policy, FwdIter first,
+                std::size_t count, F1 && f1, F2 && f2)
+            {
+                return lazy_split_partitioner<
+                        typename hpx::util::decay<ExPolicy>::type, R, Result
+                    >::call(
+                        std::forward<ExPolicy>(policy), first, count,
+                        std::forward<F1>(f1), std::forward<F2>(f2));
+            }
+
+            // explicitly sized chunks are not split any further
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2, typename Data>
+            static R call_with_data(ExPolicy && policy, FwdIter first,
+                std::size_t count, F1 && f1, F2 && f2,
+                std::vector<std::size_t> const& chunk_sizes, Data && data)
+            {
+                return static_partitioner<
+                        typename hpx::util::decay<ExPolicy>::type, R, Result
+                    >::call_with_data(
+                        std::forward<ExPolicy>(policy), first, count,
+                        std::forward<F1>(f1), std::forward<F2>(f2), chunk_sizes,
+                        std::forward<Data>(data));
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Stride,
+                typename F1, typename F2>
+            static R call_with_index(ExPolicy && policy, FwdIter first,
+                std::size_t count, Stride stride, F1 && f1, F2 && f2)
+            {
+                return lazy_split_partitioner<
+                        typename hpx::util::decay<ExPolicy>::type, R, Result
+                    >::call_with_index(
+                        std::forward<ExPolicy>(policy), first, count, stride,
+                        std::forward<F1>(f1), std::forward<F2>(f2));
+            }
+        };
+
+        template <typename R, typename Result>
+        struct partitioner<execution::parallel_task_policy, R, Result,
+            parallel::traits::lazy_split_partitioner_tag>
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2>
+            static hpx::future<R> call(ExPolicy && policy,
+                FwdIter first, std::size_t count, F1 && f1, F2 && f2)
+            {
+                return lazy_split_partitioner<
+                        execution::parallel_task_policy, R, Result
+                    >::call(
+                        std::forward<ExPolicy>(policy), first, count,
+                        std::forward<F1>(f1), std::forward<F2>(f2));
+            }
+
+            // explicitly sized chunks are not split any further
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2, typename Data>
+            static hpx::future<R> call_with_data(ExPolicy && policy,
+                FwdIter first, std::size_t count, F1 && f1, F2 && f2,
+                std::vector<std::size_t> const& chunk_sizes, Data && data)
+            {
+                return static_partitioner<
+                        execution::parallel_task_policy, R, Result
+                    >::call_with_data(
+                        std::forward<ExPolicy>(policy), first, count,
+                        std::forward<F1>(f1), std::forward<F2>(f2),
+                        chunk_sizes, std::forward<Data>(data));
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Stride,
+                typename F1, typename F2>
+            static hpx::future<R> call_with_index(ExPolicy && policy,
+                FwdIter first, std::size_t count, Stride stride,
+                F1 && f1, F2 && f2)
+            {
+                return lazy_split_partitioner<
+                        execution::parallel_task_policy, R, Result
+                    >::call_with_index(
+                        std::forward<ExPolicy>(policy), first, count, stride,
+                        std::forward<F1>(f1), std::forward<F2>(f2));
+            }
+        };
+
 #if defined(HPX_HAVE_DATAPAR)
         template <typename R, typename Result>
         struct partitioner<execution::datapar_task_policy, R, Result,
@@ -627,6 +842,13 @@ namespace hpx { namespace parallel { namespace util
                         std::forward<F1>(f1), std::forward<F2>(f2));
             }
         };
+
+        template <typename R, typename Result>
+        struct partitioner<execution::datapar_task_policy, R, Result,
+                parallel::traits::lazy_split_partitioner_tag>
+          : partitioner<execution::parallel_task_policy, R, Result,
+                parallel::traits::lazy_split_partitioner_tag>
+        {};
 #endif
 
         template <typename Executor, typename Parameters, typename R,
@@ -647,6 +869,15 @@ namespace hpx { namespace parallel { namespace util
                 parallel::traits::auto_partitioner_tag>
         {};
 
+        template <typename Executor, typename Parameters, typename R,
+            typename Result>
+        struct partitioner<
+                execution::parallel_task_policy_shim<Executor, Parameters>,
+                R, Result, parallel::traits::lazy_split_partitioner_tag>
+          : partitioner<execution::parallel_task_policy, R, Result,
+                parallel::traits::lazy_split_partitioner_tag>
+        {};
+
         template <typename Executor, typename Parameters, typename R,
             typename Result>
         struct partitioner<
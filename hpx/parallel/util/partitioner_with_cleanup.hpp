@@ -270,6 +270,16 @@ namespace hpx { namespace parallel { namespace util
           : partitioner_with_cleanup<ExPolicy, R, Result,
                 parallel::traits::static_partitioner_tag>
         {};
+
+        // the lazy split partitioner does not support cleaning up after
+        // failed chunks, every core is assigned one contiguous range of
+        // elements instead
+        template <typename ExPolicy, typename R, typename Result>
+        struct partitioner_with_cleanup<ExPolicy, R, Result,
+                parallel::traits::lazy_split_partitioner_tag>
+          : partitioner_with_cleanup<ExPolicy, R, Result,
+                parallel::traits::static_partitioner_tag>
+        {};
     }
 
     ///////////////////////////////////////////////////////////////////////////
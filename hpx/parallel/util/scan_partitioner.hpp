@@ -374,6 +374,16 @@ namespace hpx { namespace parallel { namespace util
           : scan_partitioner<ExPolicy, R, Result1,
                 Result2, parallel::traits::static_partitioner_tag>
         {};
+
+        // the lazy split partitioner does not support scans, every core
+        // is assigned one contiguous range of elements instead
+        template <typename ExPolicy, typename R, typename Result1,
+            typename Result2>
+        struct scan_partitioner<ExPolicy, R, Result1,
+                Result2, parallel::traits::lazy_split_partitioner_tag>
+          : scan_partitioner<ExPolicy, R, Result1,
+                Result2, parallel::traits::static_partitioner_tag>
+        {};
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,439 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_UTIL_SINGLE_PASS_SCAN_PARTITIONER_HPP)
+#define HPX_PARALLEL_UTIL_SINGLE_PASS_SCAN_PARTITIONER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/exception_list.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/executors/executor_information_traits.hpp>
+#include <hpx/parallel/executors/executor_parameter_traits.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/parallel/util/detail/handle_local_exceptions.hpp>
+#include <hpx/parallel/util/detail/scoped_executor_parameters.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parallel { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The single pass scan partitioner splits the input into small tiles
+        // which are handed out in order to one task per core. A task reduces
+        // its tile (f1) and publishes the result, it then looks back at the
+        // published results of the preceding tiles until it finds one which
+        // knows its overall prefix (decoupled look-back). Knowing its own
+        // prefix, the tile is published as complete and is finalized (f3)
+        // while its data is still in the cache. This way every element is
+        // fetched from memory only once.
+        template <typename T>
+        struct single_pass_scan_state
+        {
+            enum tile_status
+            {
+                status_invalid = 0,     // nothing is known yet
+                status_aggregate = 1,   // the reduction of the tile is known
+                status_prefix = 2       // the inclusive prefix is known
+            };
+
+            struct tile
+            {
+                explicit tile(T const& init)
+                  : status_(status_invalid), aggregate_(init), prefix_(init)
+                {}
+
+                tile(tile const& rhs)
+                  : status_(status_invalid),
+                    aggregate_(rhs.aggregate_), prefix_(rhs.prefix_)
+                {}
+
+                std::atomic<int> status_;
+                T aggregate_;
+                T prefix_;
+
+                // avoid false sharing between the tiles
+                char pad_[64];
+            };
+
+            template <typename FwdIter>
+            single_pass_scan_state(FwdIter first, std::size_t count,
+                    std::size_t tile_size, T const& init,
+                    std::vector<FwdIter>& tile_begins)
+              : tiles_(), tile_size_(tile_size), next_tile_(0), failed_(false)
+            {
+                HPX_ASSERT(tile_size != 0);
+
+                std::size_t num_tiles = (count + tile_size - 1) / tile_size;
+
+                tiles_.reserve(num_tiles);
+                tile_begins.reserve(num_tiles);
+                for (std::size_t i = 0; i != num_tiles; ++i)
+                {
+                    tiles_.emplace_back(init);
+                    tile_begins.push_back(first);
+                    if (i != num_tiles - 1)
+                        std::advance(first, tile_size);
+                }
+            }
+
+            // Find the exclusive prefix of the given tile by looking at the
+            // preceding tiles, return false if another tile has failed.
+            template <typename F2>
+            bool look_back(std::size_t index, T& prefix, F2& f2)
+            {
+                HPX_ASSERT(index != 0);
+
+                bool has_prefix = false;
+                for (std::size_t i = index; i-- != 0; /**/)
+                {
+                    tile& t = tiles_[i];
+
+                    int status = t.status_.load(std::memory_order_acquire);
+                    for (std::size_t k = 0; status == status_invalid; ++k)
+                    {
+                        if (failed_.load(std::memory_order_relaxed))
+                            return false;
+
+                        hpx::util::detail::yield_k(k,
+                            "hpx::parallel::util::single_pass_scan_partitioner");
+                        status = t.status_.load(std::memory_order_acquire);
+                    }
+
+                    T const& value = (status == status_prefix) ?
+                        t.prefix_ : t.aggregate_;
+                    prefix = has_prefix ? f2(value, prefix) : value;
+                    has_prefix = true;
+
+                    if (status == status_prefix)
+                        break;
+                }
+                return true;
+            }
+
+            // Process tiles until all are done.
+            template <typename FwdIter, typename F1, typename F2, typename F3>
+            void run(std::vector<FwdIter> const& tile_begins,
+                std::size_t count, T const& init, F1& f1, F2& f2, F3& f3)
+            {
+                try {
+                    std::size_t const num_tiles = tiles_.size();
+                    while (!failed_.load(std::memory_order_relaxed))
+                    {
+                        std::size_t index = next_tile_++;
+                        if (index >= num_tiles)
+                            break;
+
+                        tile& t = tiles_[index];
+                        FwdIter it = tile_begins[index];
+                        std::size_t size = (index == num_tiles - 1) ?
+                            count - index * tile_size_ : tile_size_;
+
+                        T aggregate = f1(it, size);
+                        if (index == 0)
+                        {
+                            t.prefix_ = f2(init, aggregate);
+                            t.status_.store(status_prefix,
+                                std::memory_order_release);
+
+                            f3(it, size, init);
+                            continue;
+                        }
+
+                        // let the following tiles make progress early
+                        t.aggregate_ = aggregate;
+                        t.status_.store(status_aggregate,
+                            std::memory_order_release);
+
+                        T prefix = init;
+                        if (!look_back(index, prefix, f2))
+                            break;
+
+                        t.prefix_ = f2(prefix, aggregate);
+                        t.status_.store(status_prefix,
+                            std::memory_order_release);
+
+                        f3(it, size, prefix);
+                    }
+                }
+                catch (...) {
+                    // make sure no other task waits for this tile
+                    failed_.store(true);
+                    throw;
+                }
+            }
+
+            T const& total() const
+            {
+                return tiles_.back().prefix_;
+            }
+
+            std::vector<tile> tiles_;
+            std::size_t const tile_size_;
+            std::atomic<std::size_t> next_tile_;
+            std::atomic<bool> failed_;
+        };
+
+        // the largest tile size, a tile should still be in the cache when it
+        // is finalized
+        HPX_CONSTEXPR_OR_CONST std::size_t single_pass_scan_max_tile_size =
+            4096;
+
+        // Determine the number of elements in a tile from the chunk size
+        // given by the executor parameters.
+        template <typename ExPolicy>
+        std::size_t get_single_pass_scan_tile_size(ExPolicy && policy,
+            std::size_t count)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+                executor_type;
+            typedef typename hpx::util::decay<ExPolicy>::type::
+                executor_parameters_type parameters_type;
+            typedef executor_parameter_traits<parameters_type> traits;
+
+            std::size_t const cores =
+                executor_information_traits<executor_type>::
+                    processing_units_count(policy.executor(),
+                        policy.parameters());
+
+            // the parameters don't invoke the test function, no elements
+            // are processed while determining the tile size
+            std::size_t tile_size = traits::get_chunk_size(
+                policy.parameters(), policy.executor(),
+                [](){ return 0; }, cores, count);
+
+            if (tile_size == 0)
+                return single_pass_scan_max_tile_size;
+            return (std::min)(tile_size, single_pass_scan_max_tile_size);
+        }
+
+        // Launch one task per core (but not more than there are tiles) which
+        // process the tiles of the given scan state.
+        template <typename ExPolicy, typename T, typename FwdIter,
+            typename F1, typename F2, typename F3>
+        std::vector<hpx::future<void> > single_pass_scan(ExPolicy && policy,
+            std::shared_ptr<single_pass_scan_state<T> > const& state,
+            std::shared_ptr<std::vector<FwdIter> > const& tile_begins,
+            std::size_t count, T const& init, F1 && f1, F2 && f2, F3 && f3)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type::executor_type
+                executor_type;
+            typedef typename hpx::parallel::executor_traits<executor_type>
+                executor_traits;
+
+            std::size_t const cores =
+                executor_information_traits<executor_type>::
+                    processing_units_count(policy.executor(),
+                        policy.parameters());
+
+            std::size_t num_tasks =
+                (std::min)(cores, state->tiles_.size());
+            if (num_tasks == 0)
+                num_tasks = 1;
+
+            typedef typename hpx::util::decay<F1>::type f1_type;
+            typedef typename hpx::util::decay<F2>::type f2_type;
+            typedef typename hpx::util::decay<F3>::type f3_type;
+
+            std::shared_ptr<f1_type> f1_(
+                std::make_shared<f1_type>(std::forward<F1>(f1)));
+            std::shared_ptr<f2_type> f2_(
+                std::make_shared<f2_type>(std::forward<F2>(f2)));
+            std::shared_ptr<f3_type> f3_(
+                std::make_shared<f3_type>(std::forward<F3>(f3)));
+
+            std::vector<hpx::future<void> > workitems;
+            workitems.reserve(num_tasks);
+            for (std::size_t i = 0; i != num_tasks; ++i)
+            {
+                workitems.push_back(executor_traits::async_execute(
+                    policy.executor(),
+                    [=]()
+                    {
+                        state->run(*tile_begins, count, init,
+                            *f1_, *f2_, *f3_);
+                    }));
+            }
+            return workitems;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename ExPolicy_, typename R, typename T>
+        struct single_pass_scan_partitioner
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2, typename F3, typename F4>
+            static R call(ExPolicy && policy, FwdIter first,
+                std::size_t count, T const& init, F1 && f1, F2 && f2,
+                F3 && f3, F4 && f4)
+            {
+                typedef typename
+                    hpx::util::decay<ExPolicy>::type::executor_parameters_type
+                    parameters_type;
+
+                // inform parameter traits
+                scoped_executor_parameters<parameters_type> scoped_param(
+                    policy.parameters());
+
+                std::vector<hpx::future<void> > workitems;
+                std::list<boost::exception_ptr> errors;
+                std::shared_ptr<single_pass_scan_state<T> > state;
+
+                try {
+                    HPX_ASSERT(count > 0);
+
+                    std::shared_ptr<std::vector<FwdIter> > tile_begins(
+                        std::make_shared<std::vector<FwdIter> >());
+                    state = std::make_shared<single_pass_scan_state<T> >(
+                        first, count,
+                        get_single_pass_scan_tile_size(policy, count), init,
+                        *tile_begins);
+
+                    workitems = single_pass_scan(policy, state, tile_begins,
+                        count, init, std::forward<F1>(f1),
+                        std::forward<F2>(f2), std::forward<F3>(f3));
+                }
+                catch (...) {
+                    handle_local_exceptions<ExPolicy>::call(
+                        boost::current_exception(), errors);
+                }
+
+                // wait for all tasks to finish
+                hpx::wait_all(workitems);
+
+                // always rethrow if 'errors' is not empty or 'workitems' has
+                // an exceptional future
+                handle_local_exceptions<ExPolicy>::call(workitems, errors);
+
+                try {
+                    return f4(state->total());
+                }
+                catch (...) {
+                    // rethrow either bad_alloc or exception_list
+                    handle_local_exceptions<ExPolicy>::call(
+                        boost::current_exception());
+                }
+            }
+        };
+
+        template <typename R, typename T>
+        struct single_pass_scan_partitioner<
+            execution::parallel_task_policy, R, T>
+        {
+            template <typename ExPolicy, typename FwdIter, typename F1,
+                typename F2, typename F3, typename F4>
+            static hpx::future<R> call(ExPolicy && policy, FwdIter first,
+                std::size_t count, T const& init, F1 && f1, F2 && f2,
+                F3 && f3, F4 && f4)
+            {
+                typedef typename
+                    hpx::util::decay<ExPolicy>::type::executor_parameters_type
+                    parameters_type;
+                typedef scoped_executor_parameters<parameters_type>
+                    scoped_executor_parameters;
+
+                // inform parameter traits
+                std::shared_ptr<scoped_executor_parameters>
+                    scoped_param(std::make_shared<
+                            scoped_executor_parameters
+                        >(policy.parameters()));
+
+                std::vector<hpx::future<void> > workitems;
+                std::list<boost::exception_ptr> errors;
+                std::shared_ptr<single_pass_scan_state<T> > state;
+
+                try {
+                    HPX_ASSERT(count > 0);
+
+                    std::shared_ptr<std::vector<FwdIter> > tile_begins(
+                        std::make_shared<std::vector<FwdIter> >());
+                    state = std::make_shared<single_pass_scan_state<T> >(
+                        first, count,
+                        get_single_pass_scan_tile_size(policy, count), init,
+                        *tile_begins);
+
+                    workitems = single_pass_scan(policy, state, tile_begins,
+                        count, init, std::forward<F1>(f1),
+                        std::forward<F2>(f2), std::forward<F3>(f3));
+                }
+                catch (std::bad_alloc const&) {
+                    return hpx::make_exceptional_future<R>(
+                        boost::current_exception());
+                }
+                catch (...) {
+                    errors.push_back(boost::current_exception());
+                }
+
+                // wait for all tasks to finish
+                return dataflow(
+                    [errors, state, f4, scoped_param](
+                        std::vector<hpx::future<void> >&& witems
+                    ) mutable -> R
+                    {
+                        handle_local_exceptions<ExPolicy>::call(witems, errors);
+                        return f4(state->total());
+                    },
+                    std::move(workitems));
+            }
+        };
+
+        template <typename Executor, typename Parameters, typename R,
+            typename T>
+        struct single_pass_scan_partitioner<
+                execution::parallel_task_policy_shim<Executor, Parameters>,
+                R, T>
+          : single_pass_scan_partitioner<execution::parallel_task_policy,
+                R, T>
+        {};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // This partitioner is used by inclusive_scan, exclusive_scan, their
+    // transform variants and by copy_if (and through it by remove_copy and
+    // remove_copy_if). stable_partition does not use it, it partitions in
+    // place by recursively rotating sub-ranges and has no scan step.
+    //
+    // ExPolicy: execution policy
+    // R:        overall result type
+    // T:        type of the tile reductions and prefixes
+    //
+    // The functions passed to call() are invoked as:
+    //      T f1(FwdIter part_begin, std::size_t part_size)
+    //          reduces a tile
+    //      T f2(T const& lhs, T const& rhs)
+    //          combines the reductions of two adjacent tiles
+    //      void f3(FwdIter part_begin, std::size_t part_size, T const& prefix)
+    //          finalizes a tile, given the reduction of all preceding tiles
+    //          (including the initial value)
+    //      R f4(T const& total)
+    //          produces the overall result from the overall reduction
+    template <typename ExPolicy, typename R, typename T>
+    struct single_pass_scan_partitioner
+      : detail::single_pass_scan_partitioner<
+            typename hpx::util::decay<ExPolicy>::type, R, T>
+    {};
+}}}
+
+#endif
@@ -0,0 +1,55 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTION_LZ4_SERIALIZATION_FILTER_HPP)
+#define HPX_ACTION_LZ4_SERIALIZATION_FILTER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter_registration.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+
+#include <hpx/runtime/serialization/block_binary_filter.hpp>
+
+#include <cstddef>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    // LZ4 trades compression ratio for speed, it compresses and decompresses
+    // at several hundred MB/s per core, which makes it suitable for large
+    // parcels on fast networks.
+    struct HPX_LIBRARY_EXPORT lz4_serialization_filter
+      : public serialization::block_binary_filter
+    {
+        lz4_serialization_filter(bool compress = false,
+                serialization::binary_filter* next_filter = nullptr)
+          : serialization::block_binary_filter(compress)
+        {}
+
+    protected:
+        std::size_t max_compressed_length(std::size_t size) const;
+        std::size_t compress_block(char const* src, std::size_t size,
+            char* dst, std::size_t dst_size) const;
+        void decompress_block(char const* src, std::size_t size,
+            char* dst, std::size_t dst_size) const;
+
+    private:
+        // serialization support
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        HPX_FORCEINLINE void serialize(Archive& ar, const unsigned int) {}
+
+        HPX_SERIALIZATION_POLYMORPHIC(lz4_serialization_filter);
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
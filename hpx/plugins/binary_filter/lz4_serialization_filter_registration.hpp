@@ -0,0 +1,39 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTION_LZ4_SERIALIZATION_FILTER_REGISTRATION_HPP)
+#define HPX_ACTION_LZ4_SERIALIZATION_FILTER_REGISTRATION_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+
+#include <hpx/traits/action_serialization_filter.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_ACTION_USES_LZ4_COMPRESSION(action)                            \
+    namespace hpx { namespace traits                                          \
+    {                                                                         \
+        template <>                                                           \
+        struct action_serialization_filter<action>                            \
+        {                                                                     \
+            /* Note that the caller is responsible for deleting the filter */ \
+            /* instance returned from this function */                        \
+            static serialization::binary_filter* call(                        \
+                    parcelset::parcel const& p)                               \
+            {                                                                 \
+                return hpx::create_binary_filter(                             \
+                    "lz4_serialization_filter", true);                     \
+            }                                                                 \
+        };                                                                    \
+    }}                                                                        \
+/**/
+
+#else
+
+#define HPX_ACTION_USES_LZ4_COMPRESSION(action)
+
+#endif
+#endif
@@ -11,13 +11,9 @@
 
 #if defined(HPX_HAVE_COMPRESSION_SNAPPY)
 
-#include <hpx/runtime/serialization/binary_filter.hpp>
-
-#include <boost/iostreams/filter/zlib.hpp>
+#include <hpx/runtime/serialization/block_binary_filter.hpp>
 
 #include <cstddef>
-#include <memory>
-#include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
 
@@ -25,20 +21,19 @@
 namespace hpx { namespace plugins { namespace compression
 {
     struct HPX_LIBRARY_EXPORT snappy_serialization_filter
-      : public serialization::binary_filter
+      : public serialization::block_binary_filter
     {
         snappy_serialization_filter(bool compress = false,
                 serialization::binary_filter* next_filter = nullptr)
-          : current_(0), compress_(compress)
+          : serialization::block_binary_filter(compress)
         {}
 
-        void load(void* dst, std::size_t dst_count);
-        void save(void const* src, std::size_t src_count);
-        bool flush(void* dst, std::size_t dst_count, std::size_t& written);
-
-        void set_max_length(std::size_t size);
-        std::size_t init_data(char const* buffer,
-            std::size_t size, std::size_t buffer_size);
+    protected:
+        std::size_t max_compressed_length(std::size_t size) const;
+        std::size_t compress_block(char const* src, std::size_t size,
+            char* dst, std::size_t dst_size) const;
+        void decompress_block(char const* src, std::size_t size,
+            char* dst, std::size_t dst_size) const;
 
     private:
         // serialization support
@@ -48,10 +43,6 @@ namespace hpx { namespace plugins { namespace compression
         HPX_FORCEINLINE void serialize(Archive& ar, const unsigned int) {}
 
         HPX_SERIALIZATION_POLYMORPHIC(snappy_serialization_filter);
-
-        std::vector<char> buffer_;
-        std::size_t current_;
-        bool compress_;
     };
 }}}
 
@@ -51,6 +51,8 @@ namespace hpx { namespace plugins { namespace parcel
             get_counter_type average_time_between_parcels;
             get_counter_values_creator_type time_between_parcels_histogram_creator;
             std::int64_t min_boundary, max_boundary, num_buckets;
+            get_counter_type average_message_latency;
+            get_counter_type flush_deadline;
         };
 
         typedef std::unordered_map<
@@ -65,7 +67,9 @@ namespace hpx { namespace plugins { namespace parcel
             get_counter_type num_parcels, get_counter_type num_messages,
             get_counter_type time_between_parcels,
             get_counter_type average_time_between_parcels,
-            get_counter_values_creator_type time_between_parcels_histogram_creator);
+            get_counter_values_creator_type time_between_parcels_histogram_creator,
+            get_counter_type average_message_latency,
+            get_counter_type flush_deadline);
 
         get_counter_type get_parcels_counter(std::string const& name) const;
         get_counter_type get_messages_counter(std::string const& name) const;
@@ -73,6 +77,10 @@ namespace hpx { namespace plugins { namespace parcel
             std::string const& name) const;
         get_counter_type get_average_time_between_parcels_counter(
             std::string const& name) const;
+        get_counter_type get_average_message_latency_counter(
+            std::string const& name) const;
+        get_counter_type get_flush_deadline_counter(
+            std::string const& name) const;
         get_counter_values_type get_time_between_parcels_histogram_counter(
             std::string const& name, std::int64_t min_boundary,
             std::int64_t max_boundary, std::int64_t num_buckets);
@@ -19,6 +19,7 @@
 
 #include <hpx/plugins/parcel/message_buffer.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -60,6 +61,8 @@ namespace hpx { namespace plugins { namespace parcel
         std::int64_t get_messages_count(bool reset);
         std::int64_t get_parcels_per_message_count(bool reset);
         std::int64_t get_average_time_between_parcels(bool reset);
+        std::int64_t get_average_message_latency(bool reset);
+        std::int64_t get_flush_deadline(bool reset);
         std::vector<std::int64_t>
             get_time_between_parcels_histogram(bool reset);
         void get_time_between_parcels_histogram_creator(
@@ -76,25 +79,66 @@ namespace hpx { namespace plugins { namespace parcel
             parcelset::policies::message_handler::flush_mode mode,
             bool stop_buffering, bool cancel_timer);
 
+        // adaptive mode
+        void put_parcel_adaptive(parcelset::locality const & dest,
+            parcelset::parcel p, write_handler_type f);
+        bool flush_staged(
+            parcelset::policies::message_handler::flush_mode mode,
+            bool stop_buffering);
+        std::size_t get_batch_size(std::int64_t time_between_parcels) const;
+
+        void send_message(parcelset::locality const& dest,
+            parcelset::parcel p, write_handler_type f);
+        void send_message(detail::message_buffer& buff);
+
         void update_num_messages();
         void update_interval();
 
     private:
+        // Parcels are staged per worker thread in adaptive mode, this avoids
+        // contention on the handler wide lock.
+        struct staging_buffer
+        {
+            staging_buffer()
+              : last_parcel_time_(0), average_time_between_parcels_(0)
+            {}
+
+            mutex_type mtx_;
+            detail::message_buffer buffer_;
+            std::int64_t last_parcel_time_;
+            std::int64_t average_time_between_parcels_;
+            char pad_[64];
+        };
+
+        // The data needed to tune the flush deadline, this is shared with the
+        // write handlers of the messages in flight.
+        struct tuning_data;
+        struct measure_message_latency;
+
         mutable mutex_type mtx_;
         parcelset::parcelport* pp_;
-        std::size_t num_coalesced_parcels_;
-        std::size_t interval_;
+        std::atomic<std::size_t> num_coalesced_parcels_;
+        std::atomic<std::size_t> interval_;
         detail::message_buffer buffer_;
         util::pool_timer timer_;
-        bool stopped_;
+        std::atomic<bool> stopped_;
         bool allow_background_flush_;
+        bool adaptive_;
         std::string action_name_;
 
+        std::vector<staging_buffer> staging_;
+        std::shared_ptr<tuning_data> tuning_;
+
+        // whether there were pending threads when this was last checked
+        // during background work, and the time of the next check [ns]
+        std::atomic<bool> busy_;
+        std::atomic<std::int64_t> next_busy_check_;
+
         // performance counter data
-        std::int64_t num_parcels_;
+        std::atomic<std::int64_t> num_parcels_;
         std::int64_t reset_num_parcels_;
         std::int64_t reset_num_parcels_per_message_parcels_;
-        std::int64_t num_messages_;
+        std::atomic<std::int64_t> num_messages_;
         std::int64_t reset_num_messages_;
         std::int64_t reset_num_parcels_per_message_messages_;
         std::int64_t started_at_;
@@ -107,6 +151,7 @@ namespace hpx { namespace plugins { namespace parcel
             > histogram_collector_type;
 
         std::unique_ptr<histogram_collector_type> time_between_parcels_;
+        std::atomic<bool> collect_time_between_parcels_;
         std::int64_t histogram_min_boundary_;
         std::int64_t histogram_max_boundary_;
         std::int64_t histogram_num_buckets_;
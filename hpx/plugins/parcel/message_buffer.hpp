@@ -149,6 +149,13 @@ namespace hpx { namespace plugins { namespace parcel { namespace detail
 
         std::size_t capacity() const { return max_messages_; }
 
+        // access the write handler of the message appended last
+        parcelset::write_handler_type& last_handler()
+        {
+            HPX_ASSERT(!handlers_.empty());
+            return handlers_.back();
+        }
+
     private:
         parcelset::locality dest_;
         std::vector<parcelset::parcel> messages_;
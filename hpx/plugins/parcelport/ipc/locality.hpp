@@ -0,0 +1,94 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_LOCALITY_HPP
+#define HPX_PARCELSET_POLICIES_IPC_LOCALITY_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+
+#include <string>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace ipc
+    {
+        // A locality reachable through shared memory is identified by the
+        // name of the host it runs on and by the name of the shared memory
+        // segment holding its inbound ring buffer.
+        class locality
+        {
+        public:
+            locality()
+            {}
+
+            locality(std::string const& host, std::string const& name)
+              : host_(host), name_(name)
+            {}
+
+            std::string const & host() const
+            {
+                return host_;
+            }
+
+            std::string const & name() const
+            {
+                return name_;
+            }
+
+            static const char *type()
+            {
+                return "ipc";
+            }
+
+            explicit operator bool() const HPX_NOEXCEPT
+            {
+                return !name_.empty();
+            }
+
+            void save(serialization::output_archive & ar) const
+            {
+                ar << host_;
+                ar << name_;
+            }
+
+            void load(serialization::input_archive & ar)
+            {
+                ar >> host_;
+                ar >> name_;
+            }
+
+        private:
+            friend bool operator==(locality const & lhs, locality const & rhs)
+            {
+                return lhs.name_ == rhs.name_ && lhs.host_ == rhs.host_;
+            }
+
+            friend bool operator<(locality const & lhs, locality const & rhs)
+            {
+                return lhs.host_ < rhs.host_ ||
+                    (lhs.host_ == rhs.host_ && lhs.name_ < rhs.name_);
+            }
+
+            friend std::ostream & operator<<(std::ostream & os, locality const & loc)
+            {
+                os << loc.host_ << ":" << loc.name_;
+                return os;
+            }
+
+            std::string host_;
+            std::string name_;
+        };
+    }}
+}}
+
+#endif
+
+#endif
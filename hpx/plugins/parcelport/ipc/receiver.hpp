@@ -0,0 +1,251 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_IPC_RECEIVER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/error.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/ipc/ring_buffer.hpp>
+#include <hpx/plugins/parcelport/ipc/shared_memory.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace ipc
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A zero-copy chunk which has been received either inline, through the
+    // ring buffer, or through a separate segment. In the latter case the
+    // data is deserialized directly from the mapped segment.
+    class receive_chunk
+    {
+        HPX_MOVABLE_ONLY(receive_chunk);
+
+    public:
+        receive_chunk() {}
+
+        receive_chunk(receive_chunk && rhs)
+          : data_(std::move(rhs.data_))
+          , segment_(std::move(rhs.segment_))
+        {}
+
+        receive_chunk& operator=(receive_chunk && rhs)
+        {
+            data_ = std::move(rhs.data_);
+            segment_ = std::move(rhs.segment_);
+            return *this;
+        }
+
+        char const* data() const
+        {
+            return segment_ ? segment_.data() : data_.data();
+        }
+
+        std::size_t size() const
+        {
+            return segment_ ? segment_.size() : data_.size();
+        }
+
+        std::vector<char> data_;
+        shared_memory_segment segment_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Parcelport>
+    struct receiver
+    {
+        typedef hpx::lcos::local::spinlock mutex_type;
+        typedef std::vector<char> data_type;
+        typedef parcel_buffer<data_type, receive_chunk> buffer_type;
+
+        receiver(Parcelport & pp)
+          : pp_(pp)
+        {}
+
+        // create the inbound ring buffer of this locality
+        void create(std::string const& name, std::size_t capacity)
+        {
+            boost::system::error_code ec = ring_.create(name, capacity);
+            if (ec)
+            {
+                HPX_THROW_EXCEPTION(network_error, "ipc::receiver::create",
+                    "could not create shared memory segment '" + name +
+                    "': " + ec.message());
+            }
+        }
+
+        // remove the name of the ring buffer, no new senders can attach
+        void stop()
+        {
+            ring_.unlink();
+        }
+
+        bool background_work()
+        {
+            buffer_type buffer;
+            {
+                std::unique_lock<mutex_type> l(mtx_, std::try_to_lock);
+                if (!l)
+                    return false;
+
+                std::size_t size = ring_.begin_read();
+                if (size == 0)
+                    return false;
+
+                buffer.data_point_.time_ = timer_.elapsed_nanoseconds();
+                buffer.data_point_.bytes_ = size;
+
+                boost::system::error_code ec = receive(buffer);
+
+                // release the space occupied by the message in any case
+                ring_.end_read();
+
+                if (ec)
+                {
+                    l.unlock();
+
+                    boost::exception_ptr exception =
+                        hpx::detail::get_exception(hpx::exception(
+                            boost::system::system_error(ec)),
+                            "ipc::receiver::background_work", __FILE__,
+                            __LINE__, "error while receiving message: " +
+                                ec.message());
+                    hpx::report_error(exception);
+                    return true;
+                }
+            }
+
+            buffer.data_point_.time_ =
+                timer_.elapsed_nanoseconds() - buffer.data_point_.time_;
+
+            decode_parcels(pp_, std::move(buffer), -1);
+            return true;
+        }
+
+    private:
+        // read the current message from the ring buffer
+        boost::system::error_code receive(buffer_type& buffer)
+        {
+            std::uint64_t instance = 0;
+            ring_.read(&instance, sizeof(instance));
+            ring_.read(&buffer.size_, sizeof(buffer.size_));
+            ring_.read(&buffer.data_size_, sizeof(buffer.data_size_));
+            ring_.read(&buffer.num_chunks_, sizeof(buffer.num_chunks_));
+
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer.num_chunks_.first));
+            std::size_t num_non_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer.num_chunks_.second));
+
+            if (num_zero_copy_chunks != 0)
+            {
+                std::vector<buffer_type::transmission_chunk_type>& chunks =
+                    buffer.transmission_chunks_;
+
+                chunks.resize(num_zero_copy_chunks + num_non_zero_copy_chunks);
+                ring_.read(chunks.data(), chunks.size() *
+                    sizeof(buffer_type::transmission_chunk_type));
+            }
+
+            // the main buffer is always copied as it has to be a vector
+            std::size_t const size = static_cast<std::size_t>(buffer.size_);
+            buffer.data_.resize(size);
+
+            // After an error the rest of the record is still walked through,
+            // the names of the remaining segments would leak otherwise.
+            boost::system::error_code ec;
+
+            std::uint64_t segment_id = 0;
+            ring_.read(&segment_id, sizeof(segment_id));
+            if (segment_id == 0)
+            {
+                ring_.read(buffer.data_.data(), size);
+            }
+            else
+            {
+                shared_memory_segment segment;
+                ec = open(segment, instance, segment_id, size);
+                if (!ec)
+                    std::memcpy(buffer.data_.data(), segment.data(), size);
+            }
+
+            // the zero-copy chunks are used in place
+            buffer.chunks_.resize(num_zero_copy_chunks);
+            for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
+            {
+                std::size_t const chunk_size = static_cast<std::size_t>(
+                    buffer.transmission_chunks_[i].second);
+
+                receive_chunk& c = buffer.chunks_[i];
+
+                ring_.read(&segment_id, sizeof(segment_id));
+                if (segment_id == 0)
+                {
+                    if (ec)
+                    {
+                        ring_.skip(chunk_size);
+                        continue;
+                    }
+
+                    c.data_.resize(chunk_size);
+                    ring_.read(c.data_.data(), chunk_size);
+                }
+                else if (ec)
+                {
+                    ::shm_unlink(segment_name(instance, segment_id).c_str());
+                }
+                else
+                {
+                    ec = open(c.segment_, instance, segment_id, chunk_size);
+                }
+            }
+
+            // report the first error only
+            return ec;
+        }
+
+        // map a segment handed off by the sender and remove its name
+        static boost::system::error_code open(shared_memory_segment& segment,
+            std::uint64_t instance, std::uint64_t id, std::size_t size)
+        {
+            std::string const name = segment_name(instance, id);
+            boost::system::error_code ec = segment.open(name, size, true);
+            ::shm_unlink(name.c_str());
+            return ec;
+        }
+
+        Parcelport & pp_;
+
+        mutex_type mtx_;
+        ring_buffer ring_;
+
+        util::high_resolution_timer timer_;
+    };
+}}}}
+
+#endif
+
+#endif
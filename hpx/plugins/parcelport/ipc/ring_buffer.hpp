@@ -0,0 +1,278 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_RING_BUFFER_HPP
+#define HPX_PARCELSET_POLICIES_IPC_RING_BUFFER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/plugins/parcelport/ipc/shared_memory.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace ipc
+{
+    namespace detail
+    {
+        // This structure is placed at the beginning of the shared memory
+        // segment, the atomics are accessed by all processes mapping the
+        // segment.
+        struct ring_buffer_header
+        {
+            enum { magic = 0x48505849 };    // "HPXI"
+
+            // read position, modified by the consumer only
+            boost::atomic<std::uint64_t> head_;
+            char padding0_[64];
+
+            // write position and lock serializing the producers
+            boost::atomic<std::uint64_t> tail_;
+            boost::atomic<std::uint32_t> lock_;
+            char padding1_[64];
+
+            std::uint64_t capacity_;
+            std::uint32_t magic_;
+        };
+
+        // Atomics which are not lock-free are implemented using a lock local
+        // to the process, they would not synchronize the processes sharing
+        // the segment.
+        static_assert(BOOST_ATOMIC_INT64_LOCK_FREE == 2,
+            "the ipc parcelport requires lock-free 64 bit atomics");
+        static_assert(BOOST_ATOMIC_INT32_LOCK_FREE == 2,
+            "the ipc parcelport requires lock-free 32 bit atomics");
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A ring buffer of variable sized records living in a shared memory
+    // segment. Any number of processes may write records, records are read
+    // by the process which has created the segment only. Records are written
+    // and read in pieces, which allows to directly copy the parts of a
+    // parcel buffer without assembling the whole message first.
+    class ring_buffer
+    {
+        typedef detail::ring_buffer_header header_type;
+
+        enum
+        {
+            record_alignment = sizeof(std::uint64_t),
+            data_offset = (sizeof(header_type) + 63) & ~std::size_t(63)
+        };
+
+    public:
+        ring_buffer()
+          : header_(nullptr), data_(nullptr), capacity_(0), pos_(0), end_(0)
+        {}
+
+        // create the segment, this is done by the consumer
+        boost::system::error_code create(std::string const& name,
+            std::size_t capacity)
+        {
+            capacity = aligned(capacity);
+
+            boost::system::error_code ec =
+                segment_.create(name, data_offset + capacity);
+            if (ec)
+                return ec;
+
+            header_ = new (segment_.data()) header_type;
+            header_->head_.store(0);
+            header_->tail_.store(0);
+            header_->lock_.store(0);
+            header_->capacity_ = capacity;
+            header_->magic_ = header_type::magic;
+
+            data_ = segment_.data() + data_offset;
+            capacity_ = capacity;
+            return ec;
+        }
+
+        // attach to an existing segment, this is done by the producers
+        boost::system::error_code open(std::string const& name)
+        {
+            boost::system::error_code ec = segment_.open(name);
+            if (ec)
+                return ec;
+
+            header_ = reinterpret_cast<header_type*>(segment_.data());
+            if (segment_.size() < std::size_t(data_offset) ||
+                header_->magic_ != header_type::magic ||
+                segment_.size() != data_offset + header_->capacity_)
+            {
+                segment_ = shared_memory_segment();
+                header_ = nullptr;
+                return boost::system::error_code(EINVAL,
+                    boost::system::system_category());
+            }
+
+            data_ = segment_.data() + data_offset;
+            capacity_ = static_cast<std::size_t>(header_->capacity_);
+            return ec;
+        }
+
+        void unlink()
+        {
+            segment_.unlink();
+        }
+
+        std::size_t capacity() const
+        {
+            return capacity_;
+        }
+
+        // return whether a record of the given size can be stored at all
+        bool fits(std::size_t size) const
+        {
+            return sizeof(std::uint64_t) + aligned(size) <= capacity_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Start writing a record of the given size. Returns false if another
+        // producer is writing or if there is not enough space available.
+        bool try_begin_write(std::size_t size)
+        {
+            HPX_ASSERT(size != 0 && fits(size));
+
+            std::uint32_t expected = 0;
+            if (!header_->lock_.compare_exchange_strong(expected, 1,
+                    boost::memory_order_acquire))
+            {
+                return false;
+            }
+
+            std::uint64_t const tail =
+                header_->tail_.load(boost::memory_order_relaxed);
+            std::uint64_t const head =
+                header_->head_.load(boost::memory_order_acquire);
+
+            std::size_t const required = sizeof(std::uint64_t) + aligned(size);
+            if (capacity_ - static_cast<std::size_t>(tail - head) < required)
+            {
+                header_->lock_.store(0, boost::memory_order_release);
+                return false;
+            }
+
+            // the record size never wraps as all records are aligned
+            std::uint64_t const record_size = size;
+            std::memcpy(data_ + index(tail), &record_size, sizeof(record_size));
+
+            pos_ = tail + sizeof(std::uint64_t);
+            end_ = tail + required;
+            return true;
+        }
+
+        void write(void const* p, std::size_t size)
+        {
+            HPX_ASSERT(pos_ + size <= end_);
+
+            char const* src = static_cast<char const*>(p);
+            std::size_t const idx = index(pos_);
+            std::size_t const first = (std::min)(size, capacity_ - idx);
+
+            std::memcpy(data_ + idx, src, first);
+            std::memcpy(data_, src + first, size - first);
+            pos_ += size;
+        }
+
+        // make the record visible to the consumer
+        void end_write()
+        {
+            header_->tail_.store(end_, boost::memory_order_release);
+            header_->lock_.store(0, boost::memory_order_release);
+        }
+
+        // give up the record being written, it never becomes visible to the
+        // consumer
+        void abort_write()
+        {
+            header_->lock_.store(0, boost::memory_order_release);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Start reading the next record, returns its size or zero if no
+        // record is available.
+        std::size_t begin_read()
+        {
+            std::uint64_t const head =
+                header_->head_.load(boost::memory_order_relaxed);
+            std::uint64_t const tail =
+                header_->tail_.load(boost::memory_order_acquire);
+
+            if (head == tail)
+                return 0;
+
+            std::uint64_t record_size = 0;
+            std::memcpy(&record_size, data_ + index(head), sizeof(record_size));
+
+            std::size_t const size = static_cast<std::size_t>(record_size);
+            pos_ = head + sizeof(std::uint64_t);
+            end_ = head + sizeof(std::uint64_t) + aligned(size);
+            return size;
+        }
+
+        void read(void* p, std::size_t size)
+        {
+            HPX_ASSERT(pos_ + size <= end_);
+
+            char* dest = static_cast<char*>(p);
+            std::size_t const idx = index(pos_);
+            std::size_t const first = (std::min)(size, capacity_ - idx);
+
+            std::memcpy(dest, data_ + idx, first);
+            std::memcpy(dest + first, data_, size - first);
+            pos_ += size;
+        }
+
+        // skip a part of the current record without copying it
+        void skip(std::size_t size)
+        {
+            HPX_ASSERT(pos_ + size <= end_);
+            pos_ += size;
+        }
+
+        // release the space occupied by the current record
+        void end_read()
+        {
+            header_->head_.store(end_, boost::memory_order_release);
+        }
+
+    private:
+        static std::size_t aligned(std::size_t size)
+        {
+            return (size + record_alignment - 1) &
+                ~std::size_t(record_alignment - 1);
+        }
+
+        std::size_t index(std::uint64_t pos) const
+        {
+            return static_cast<std::size_t>(pos % capacity_);
+        }
+
+        shared_memory_segment segment_;
+        header_type* header_;
+        char* data_;
+        std::size_t capacity_;
+
+        // current position and end of the record being written or read
+        std::uint64_t pos_;
+        std::uint64_t end_;
+    };
+}}}}
+
+#endif
+
+#endif
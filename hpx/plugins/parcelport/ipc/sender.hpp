@@ -0,0 +1,119 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_IPC_SENDER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/ipc/sender_connection.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace hpx { namespace parcelset { namespace policies { namespace ipc
+{
+    struct sender
+    {
+        typedef
+            sender_connection
+            connection_type;
+        typedef std::shared_ptr<connection_type> connection_ptr;
+        typedef std::deque<connection_ptr> connection_list;
+
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        sender()
+          : next_segment_id_(0)
+        {
+        }
+
+        connection_ptr create_connection(parcelset::locality const& l,
+            parcelset::parcelport* pp, std::size_t zero_copy_threshold,
+            boost::system::error_code& ec)
+        {
+            connection_ptr connection = std::make_shared<connection_type>(
+                this, l, pp, zero_copy_threshold);
+
+            ec = connection->open();
+            if (ec)
+                connection.reset();
+            return connection;
+        }
+
+        // the connection will be retried as soon as the ring buffer of its
+        // destination has space available
+        void add(connection_ptr const & ptr)
+        {
+            std::unique_lock<mutex_type> l(connections_mtx_);
+            connections_.push_back(ptr);
+        }
+
+        std::uint64_t next_segment_id()
+        {
+            return ++next_segment_id_;
+        }
+
+        void send_messages(
+            connection_ptr connection
+        )
+        {
+            // Check if sending has been completed....
+            boost::system::error_code ec;
+            if (connection->send(ec))
+            {
+                connection->postprocess_handler_(
+                    ec, connection->destination(), connection);
+            }
+            else
+            {
+                std::unique_lock<mutex_type> l(connections_mtx_);
+                connections_.push_back(std::move(connection));
+            }
+        }
+
+        bool background_work()
+        {
+            connection_ptr connection;
+            {
+                std::unique_lock<mutex_type> l(connections_mtx_, std::try_to_lock);
+                if(l && !connections_.empty())
+                {
+                    connection = std::move(connections_.front());
+                    connections_.pop_front();
+                }
+            }
+            bool has_work = false;
+            if(connection)
+            {
+                send_messages(std::move(connection));
+                has_work = true;
+            }
+            return has_work;
+        }
+
+    private:
+        mutex_type connections_mtx_;
+        connection_list connections_;
+
+        boost::atomic<std::uint64_t> next_segment_id_;
+    };
+}}}}
+
+#endif
+
+#endif
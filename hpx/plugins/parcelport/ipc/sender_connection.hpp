@@ -0,0 +1,323 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_SENDER_CONNECTION_HPP
+#define HPX_PARCELSET_POLICIES_IPC_SENDER_CONNECTION_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/plugins/parcelport/ipc/locality.hpp>
+#include <hpx/plugins/parcelport/ipc/ring_buffer.hpp>
+#include <hpx/plugins/parcelport/ipc/shared_memory.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace ipc
+{
+    struct sender;
+    struct sender_connection;
+
+    std::uint64_t next_segment_id(sender *);
+    void add_connection(sender *, std::shared_ptr<sender_connection> const&);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A message is written as a single record into the ring buffer of the
+    // destination. It consists of the message header, the transmission chunk
+    // descriptions, the main data buffer, and the zero-copy chunks. The main
+    // data buffer and the zero-copy chunks are either stored inline or, if
+    // they are larger than the configured threshold, in a separate shared
+    // memory segment which is mapped by the receiving process. In the latter
+    // case only the id of that segment is stored in the ring buffer.
+    struct sender_connection
+      : parcelset::parcelport_connection<
+            sender_connection
+          , std::vector<char>
+        >
+    {
+    private:
+        typedef sender sender_type;
+
+        // a part of the message which is either sent inline or through a
+        // separate segment
+        struct message_part
+        {
+            void const* data_;
+            std::size_t size_;
+            std::uint64_t segment_id_;
+        };
+
+    public:
+        sender_connection(
+            sender_type * s
+          , parcelset::locality const& there
+          , parcelset::parcelport* pp
+          , std::size_t zero_copy_threshold
+        )
+          : sender_(s)
+          , pp_(pp)
+          , there_(there)
+          , zero_copy_threshold_(zero_copy_threshold)
+          , message_size_(0)
+        {
+        }
+
+        // a message which has never been written into the ring buffer (for
+        // instance on shutdown) still owns its segments
+        ~sender_connection()
+        {
+            remove_segments();
+        }
+
+        // attach to the ring buffer of the destination
+        boost::system::error_code open()
+        {
+            return ring_.open(there_.get<locality>().name());
+        }
+
+        parcelset::locality const& destination() const
+        {
+            return there_;
+        }
+
+        void verify(parcelset::locality const & parcel_locality_id) const
+        {
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler && handler, ParcelPostprocess && parcel_postprocess)
+        {
+            HPX_ASSERT(!buffer_.data_.empty());
+
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
+            handler_ = std::forward<Handler>(handler);
+
+            // The hand-off segments are created and filled before any space
+            // in the ring buffer is reserved, this way the ring buffer is
+            // locked only while the (small) record is written.
+            boost::system::error_code ec = prepare();
+            if (!ec)
+                ec = create_segments();
+            if (ec)
+            {
+                done(ec);
+                parcel_postprocess(ec, there_, shared_from_this());
+                return;
+            }
+
+            if (send(ec))
+            {
+                parcel_postprocess(ec, there_, shared_from_this());
+                return;
+            }
+
+            postprocess_handler_
+                = std::forward<ParcelPostprocess>(parcel_postprocess);
+            add_connection(sender_, shared_from_this());
+        }
+
+        // Write the message into the ring buffer of the destination, returns
+        // false if there is currently not enough space available. Otherwise
+        // the write operation has been completed, 'ec' is set if it failed.
+        bool send(boost::system::error_code& ec)
+        {
+            if (!ring_.try_begin_write(message_size_))
+                return false;
+
+            std::uint64_t const instance = instance_id();
+            ring_.write(&instance, sizeof(instance));
+            ring_.write(&buffer_.size_, sizeof(buffer_.size_));
+            ring_.write(&buffer_.data_size_, sizeof(buffer_.data_size_));
+            ring_.write(&buffer_.num_chunks_, sizeof(buffer_.num_chunks_));
+
+            std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if (!chunks.empty())
+            {
+                ring_.write(chunks.data(), chunks.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type));
+            }
+
+            for (message_part const& part : parts_)
+            {
+                ring_.write(&part.segment_id_, sizeof(part.segment_id_));
+                if (part.segment_id_ == 0)
+                    ring_.write(part.data_, part.size_);
+            }
+
+            ring_.end_write();
+
+            // the receiver owns the segments from now on
+            parts_.clear();
+
+            done(ec);
+            return true;
+        }
+
+        // complete the write operation
+        void done(boost::system::error_code const& ec)
+        {
+            handler_(ec);
+
+            if (!ec)
+            {
+                buffer_.data_point_.time_ =
+                    timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+                pp_->add_sent_data(buffer_.data_point_);
+            }
+
+            buffer_.clear();
+            remove_segments();
+            parts_.clear();
+            message_size_ = 0;
+        }
+
+    private:
+        // Decide which parts of the message are handed off through separate
+        // segments and compute the size of the record in the ring buffer. The
+        // segments themselves are created by create_segments().
+        boost::system::error_code prepare()
+        {
+            parts_.clear();
+
+            message_part data = { buffer_.data_.data(), buffer_.data_.size(), 0 };
+            parts_.push_back(data);
+
+            for (serialization::serialization_chunk& c : buffer_.chunks_)
+            {
+                if (c.type_ == serialization::chunk_type_pointer)
+                {
+                    message_part part = { c.data_.cpos_, c.size_, 0 };
+                    parts_.push_back(part);
+                }
+            }
+
+            message_size_ = compute_message_size(zero_copy_threshold_);
+            if (!ring_.fits(message_size_))
+            {
+                // hand off all parts if the message would not fit otherwise
+                message_size_ = compute_message_size(0);
+                if (!ring_.fits(message_size_))
+                {
+                    return boost::asio::error::make_error_code(
+                        boost::asio::error::message_size);
+                }
+            }
+
+            return boost::system::error_code();
+        }
+
+        // Create the segments for the parts of the message which are handed
+        // off and copy the data.
+        boost::system::error_code create_segments()
+        {
+            for (message_part& part : parts_)
+            {
+                if (part.segment_id_ == 0)
+                    continue;
+
+                std::uint64_t const id = next_segment_id(sender_);
+
+                shared_memory_segment segment;
+                boost::system::error_code ec = segment.create(
+                    segment_name(instance_id(), id), part.size_);
+                if (ec)
+                    return ec;      // done() removes the segments created so far
+
+                // the receiver removes the segment after mapping it
+                std::memcpy(segment.data(), part.data_, part.size_);
+                part.segment_id_ = id;
+            }
+
+            return boost::system::error_code();
+        }
+
+        // remove the segments of a message which has not been written into
+        // the ring buffer
+        void remove_segments()
+        {
+            for (message_part& part : parts_)
+            {
+                if (part.segment_id_ != 0 &&
+                    part.segment_id_ != std::uint64_t(-1))
+                {
+                    ::shm_unlink(segment_name(instance_id(),
+                        part.segment_id_).c_str());
+                    part.segment_id_ = std::uint64_t(-1);
+                }
+            }
+        }
+
+        std::size_t compute_message_size(std::size_t threshold)
+        {
+            std::size_t size = sizeof(std::uint64_t) +
+                sizeof(buffer_.size_) + sizeof(buffer_.data_size_) +
+                sizeof(buffer_.num_chunks_) +
+                buffer_.transmission_chunks_.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type);
+
+            for (message_part& part : parts_)
+            {
+                size += sizeof(part.segment_id_);
+
+                // mark the parts which are handed off, the actual segment id
+                // is assigned once the segment has been created
+                if (part.size_ != 0 && part.size_ >= threshold)
+                {
+                    part.segment_id_ = std::uint64_t(-1);
+                }
+                else
+                {
+                    part.segment_id_ = 0;
+                    size += part.size_;
+                }
+            }
+            return size;
+        }
+
+        sender_type * sender_;
+        parcelset::parcelport* pp_;
+        parcelset::locality there_;
+        std::size_t zero_copy_threshold_;
+
+        ring_buffer ring_;
+        std::vector<message_part> parts_;
+        std::size_t message_size_;
+
+        util::high_resolution_timer timer_;
+
+    public:
+        util::unique_function_nonser<
+            void(
+                boost::system::error_code const&
+            )
+        > handler_;
+        util::unique_function_nonser<
+            void(
+                boost::system::error_code const&
+              , parcelset::locality const&
+              , std::shared_ptr<sender_connection>
+            )
+        > postprocess_handler_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,210 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_SHARED_MEMORY_HPP
+#define HPX_PARCELSET_POLICIES_IPC_SHARED_MEMORY_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <boost/system/error_code.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hpx { namespace parcelset { namespace policies { namespace ipc
+{
+    // Return the value identifying this run of the process in the names of
+    // its segments. Besides the process id it contains a random part, which
+    // makes sure that segments left behind by a crashed process (which may
+    // have had the same process id) don't collide with the ones of this
+    // process.
+    inline std::uint64_t instance_id()
+    {
+        static std::uint64_t const id =
+            (std::uint64_t(::getpid()) << 32) |
+            std::uint32_t(std::random_device()());
+        return id;
+    }
+
+    // name of the segment holding the inbound ring buffer of a process
+    inline std::string ring_buffer_name(std::uint64_t instance)
+    {
+        return "/hpx.ipc." + std::to_string(instance);
+    }
+
+    // name of a segment used to hand off a large message part
+    inline std::string segment_name(std::uint64_t instance, std::uint64_t id)
+    {
+        return "/hpx.ipc." + std::to_string(instance) + "." +
+            std::to_string(id);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A named POSIX shared memory segment mapped into the address space of
+    // this process. The mapping is released on destruction, the name of the
+    // segment stays valid until unlink() has been called by one of the
+    // processes using it.
+    class shared_memory_segment
+    {
+        HPX_MOVABLE_ONLY(shared_memory_segment);
+
+    public:
+        shared_memory_segment()
+          : data_(nullptr), size_(0)
+        {}
+
+        shared_memory_segment(shared_memory_segment && rhs)
+          : name_(std::move(rhs.name_))
+          , data_(rhs.data_)
+          , size_(rhs.size_)
+        {
+            rhs.data_ = nullptr;
+            rhs.size_ = 0;
+        }
+
+        shared_memory_segment& operator=(shared_memory_segment && rhs)
+        {
+            if (this != &rhs)
+            {
+                unmap();
+                name_ = std::move(rhs.name_);
+                data_ = rhs.data_;
+                size_ = rhs.size_;
+                rhs.data_ = nullptr;
+                rhs.size_ = 0;
+            }
+            return *this;
+        }
+
+        ~shared_memory_segment()
+        {
+            unmap();
+        }
+
+        // Create a new segment of the given size, fails if a segment with the
+        // same name exists already.
+        boost::system::error_code create(std::string const& name,
+            std::size_t size)
+        {
+            int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR,
+                S_IRUSR | S_IWUSR);
+            if (fd == -1)
+                return last_error();
+
+            if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+            {
+                boost::system::error_code ec = last_error();
+                ::close(fd);
+                ::shm_unlink(name.c_str());
+                return ec;
+            }
+
+            boost::system::error_code ec = map(fd, size, PROT_READ | PROT_WRITE);
+            ::close(fd);
+
+            if (ec)
+                ::shm_unlink(name.c_str());
+            else
+                name_ = name;
+            return ec;
+        }
+
+        // Map an existing segment, a size of zero maps the whole segment.
+        boost::system::error_code open(std::string const& name,
+            std::size_t size = 0, bool read_only = false)
+        {
+            int fd = ::shm_open(name.c_str(), read_only ? O_RDONLY : O_RDWR, 0);
+            if (fd == -1)
+                return last_error();
+
+            if (size == 0)
+            {
+                struct stat st;
+                if (::fstat(fd, &st) == -1)
+                {
+                    boost::system::error_code ec = last_error();
+                    ::close(fd);
+                    return ec;
+                }
+                size = static_cast<std::size_t>(st.st_size);
+            }
+
+            boost::system::error_code ec = map(fd, size,
+                read_only ? PROT_READ : (PROT_READ | PROT_WRITE));
+            ::close(fd);
+
+            if (!ec)
+                name_ = name;
+            return ec;
+        }
+
+        // Remove the name of the segment, existing mappings stay valid.
+        void unlink()
+        {
+            if (!name_.empty())
+                ::shm_unlink(name_.c_str());
+        }
+
+        char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+        std::string const& name() const { return name_; }
+
+        explicit operator bool() const HPX_NOEXCEPT
+        {
+            return data_ != nullptr;
+        }
+
+    private:
+        static boost::system::error_code last_error()
+        {
+            return boost::system::error_code(errno,
+                boost::system::system_category());
+        }
+
+        boost::system::error_code map(int fd, std::size_t size, int prot)
+        {
+            if (size == 0)
+                return boost::system::error_code(EINVAL,
+                    boost::system::system_category());
+
+            void* p = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED)
+                return last_error();
+
+            data_ = static_cast<char*>(p);
+            size_ = size;
+            return boost::system::error_code();
+        }
+
+        void unmap()
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(data_, size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+
+        std::string name_;
+        char* data_;
+        std::size_t size_;
+    };
+}}}}
+
+#endif
+
+#endif
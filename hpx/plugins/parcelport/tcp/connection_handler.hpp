@@ -118,6 +118,10 @@ namespace hpx { namespace parcelset
             /// Acceptor used to listen for incoming connections.
             boost::asio::ip::tcp::acceptor* acceptor_;
 
+            /// Time in microseconds a sender waits for more parcel buffers
+            /// to be coalesced into a single write.
+            std::size_t const write_coalescing_delay_;
+
             /// The list of accepted connections
             mutable lcos::local::spinlock connections_mtx_;
 
@@ -0,0 +1,252 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_TCP_RECEIVE_BUFFER_POOL_HPP
+#define HPX_PARCELSET_POLICIES_TCP_RECEIVE_BUFFER_POOL_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_TCP)
+
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace tcp
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The receive_buffer_pool caches the memory blocks used to receive the
+    // data of inbound messages. Blocks are grouped into power of two size
+    // classes (just like util::buffer_pool does), released blocks are kept
+    // for reuse as long as the overall number of cached bytes stays below
+    // the configured limit (hpx.parcel.tcp.receive_buffer_pool_size). No
+    // size class may use more than half of it. Blocks larger than the
+    // largest size class are allocated from the heap directly.
+    class receive_buffer_pool
+    {
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        static HPX_CONSTEXPR_OR_CONST std::size_t min_size_class = 10;
+        static HPX_CONSTEXPR_OR_CONST std::size_t max_size_class = 26;
+        static HPX_CONSTEXPR_OR_CONST std::size_t num_size_classes =
+            max_size_class - min_size_class + 1;
+
+        struct size_class
+        {
+            mutex_type mtx_;
+            std::vector<void*> blocks_;
+        };
+
+        // Return the size class for blocks of the given size, or
+        // num_size_classes if blocks of this size are not pooled.
+        static std::size_t get_size_class(std::size_t size)
+        {
+            std::size_t c = 0;
+            while (c != num_size_classes &&
+                (std::size_t(1) << (c + min_size_class)) < size)
+            {
+                ++c;
+            }
+            return c;
+        }
+
+        static std::size_t get_block_size(std::size_t c)
+        {
+            return std::size_t(1) << (c + min_size_class);
+        }
+
+        // account for a block to be cached, fails if the limit would be
+        // exceeded
+        bool reserve_cached_bytes(std::size_t size)
+        {
+            std::size_t const max_cached_bytes =
+                max_cached_bytes_.load(boost::memory_order_relaxed);
+
+            std::size_t cached =
+                cached_bytes_.load(boost::memory_order_relaxed);
+            do {
+                if (cached + size > max_cached_bytes)
+                    return false;
+            } while (!cached_bytes_.compare_exchange_weak(cached,
+                cached + size, boost::memory_order_relaxed));
+
+            return true;
+        }
+
+    public:
+        // the default limit for the overall number of cached bytes
+        static HPX_CONSTEXPR_OR_CONST std::size_t default_max_cached_bytes =
+            std::size_t(64) << 20;
+
+        receive_buffer_pool()
+          : max_cached_bytes_(default_max_cached_bytes), cached_bytes_(0)
+        {}
+
+        ~receive_buffer_pool()
+        {
+            for (size_class& sc : size_classes_)
+            {
+                for (void* p : sc.blocks_)
+                    ::operator delete(p);
+            }
+        }
+
+        void* allocate(std::size_t size)
+        {
+            std::size_t c = get_size_class(size);
+            if (c == num_size_classes)
+                return ::operator new(size);
+
+            {
+                size_class& sc = size_classes_[c];
+                std::lock_guard<mutex_type> l(sc.mtx_);
+                if (!sc.blocks_.empty())
+                {
+                    void* p = sc.blocks_.back();
+                    sc.blocks_.pop_back();
+                    cached_bytes_.fetch_sub(get_block_size(c),
+                        boost::memory_order_relaxed);
+                    return p;
+                }
+            }
+            return ::operator new(get_block_size(c));
+        }
+
+        void deallocate(void* p, std::size_t size) HPX_NOEXCEPT
+        {
+            std::size_t c = get_size_class(size);
+            if (c != num_size_classes)
+            {
+                std::size_t const block_size = get_block_size(c);
+                std::size_t const max_class_bytes =
+                    max_cached_bytes_.load(boost::memory_order_relaxed) / 2;
+
+                size_class& sc = size_classes_[c];
+                std::lock_guard<mutex_type> l(sc.mtx_);
+                if ((sc.blocks_.size() + 1) * block_size <= max_class_bytes &&
+                    reserve_cached_bytes(block_size))
+                {
+                    try {
+                        sc.blocks_.push_back(p);
+                        return;
+                    }
+                    catch (...) {
+                        // fall through, release the block
+                        cached_bytes_.fetch_sub(block_size,
+                            boost::memory_order_relaxed);
+                    }
+                }
+            }
+            ::operator delete(p);
+        }
+
+        // Change the limit for the overall number of cached bytes, this
+        // affects blocks released from now on only.
+        void set_max_cached_bytes(std::size_t max_cached_bytes)
+        {
+            max_cached_bytes_.store(max_cached_bytes,
+                boost::memory_order_relaxed);
+        }
+
+    private:
+        HPX_NON_COPYABLE(receive_buffer_pool);
+
+        size_class size_classes_[num_size_classes];
+
+        boost::atomic<std::size_t> max_cached_bytes_;
+        boost::atomic<std::size_t> cached_bytes_;
+    };
+
+    // Return the pool used by all receivers of the TCP parcelport
+    receive_buffer_pool& get_receive_buffer_pool();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Stateless allocator drawing its memory from the receive buffer pool.
+    // Elements are default initialized, which avoids clearing the memory of
+    // a buffer which is resized only to be overwritten by the received data.
+    template <typename T>
+    class receive_buffer_allocator
+    {
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef T const* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef receive_buffer_allocator<U> other;
+        };
+
+        receive_buffer_allocator() HPX_NOEXCEPT {}
+
+        template <typename U>
+        receive_buffer_allocator(receive_buffer_allocator<U> const&)
+            HPX_NOEXCEPT
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(
+                get_receive_buffer_pool().allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) HPX_NOEXCEPT
+        {
+            get_receive_buffer_pool().deallocate(p, n * sizeof(T));
+        }
+
+        template <typename U>
+        void construct(U* p)
+        {
+            ::new (static_cast<void*>(p)) U;
+        }
+
+        template <typename U, typename... Ts>
+        void construct(U* p, Ts &&... ts)
+        {
+            ::new (static_cast<void*>(p)) U(std::forward<Ts>(ts)...);
+        }
+
+        template <typename U>
+        void destroy(U* p)
+        {
+            p->~U();
+        }
+    };
+
+    template <typename T, typename U>
+    HPX_CONSTEXPR bool operator==(receive_buffer_allocator<T> const&,
+        receive_buffer_allocator<U> const&) HPX_NOEXCEPT
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    HPX_CONSTEXPR bool operator!=(receive_buffer_allocator<T> const&,
+        receive_buffer_allocator<U> const&) HPX_NOEXCEPT
+    {
+        return false;
+    }
+
+    // The type of the buffers used to receive inbound messages
+    typedef std::vector<char, receive_buffer_allocator<char> >
+        receive_buffer_type;
+}}}}
+
+#endif
+
+#endif
@@ -19,6 +19,7 @@
 #include <hpx/config/asio.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/plugins/parcelport/tcp/receive_buffer_pool.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
 #include <hpx/util/bind.hpp>
@@ -45,8 +46,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 {
     class connection_handler;
 
+    // The data and the zero-copy chunks of inbound messages are received
+    // into memory drawn from the receive_buffer_pool. The chunks are handed
+    // over to the de-serialized objects which may refer to them instead of
+    // copying their contents.
     class receiver
-      : public parcelport_connection<receiver, std::vector<char>, std::vector<char> >
+      : public parcelport_connection<
+            receiver, receive_buffer_type, receive_buffer_type>
     {
         typedef hpx::lcos::local::spinlock mutex_type;
     public:
@@ -315,7 +321,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                     = &receiver::handle_write_ack<Handler>;
 
                 // decode the received parcels.
-                decode_parcels(parcelport_, std::move(buffer_), -1);
+                decode_parcels_shared_chunks(
+                    parcelport_, std::move(buffer_), -1);
                 buffer_ = parcel_buffer_type();
 
                 ack_ = true;
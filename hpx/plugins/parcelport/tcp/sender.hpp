@@ -20,11 +20,16 @@
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/atomic_count.hpp>
 #include <hpx/util/bind.hpp>
+#include <hpx/util/chrono_traits.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/steady_clock.hpp>
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/asio_util.hpp>
 
+#include <boost/asio/basic_deadline_timer.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -33,26 +38,93 @@
 #include <boost/asio/write.hpp>
 #include <boost/atomic.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 namespace hpx { namespace parcelset { namespace policies { namespace tcp
 {
+    // The sender does not wait for a buffer to be written (and acknowledged)
+    // before handing the connection back to the parcelport. Instead, the
+    // buffers passed to async_write are staged and all staged buffers are
+    // sent using a single gather-write operation as soon as the previous
+    // write has completed (or after the configured coalescing delay has
+    // expired). This allows for the next buffer to be serialized while the
+    // previous one is still in flight. The acknowledgments sent by the
+    // receiver for each of the buffers are consumed in the background.
     class sender
       : public parcelset::parcelport_connection<sender, std::vector<char> >
     {
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        typedef boost::asio::basic_deadline_timer<
+            util::steady_clock
+          , util::chrono_traits<util::steady_clock>
+        > deadline_timer_type;
+
+        typedef util::unique_function_nonser<
+            void(
+                boost::system::error_code const&
+            )
+        > write_handler_type;
+
+        typedef util::unique_function_nonser<
+            void(
+                boost::system::error_code const&
+              , parcelset::locality const&
+              , std::shared_ptr<sender>
+            )
+        > postprocess_handler_type;
+
+        // a buffer waiting to be written together with its completion handler
+        struct pending_write
+        {
+            pending_write(parcel_buffer_type && buffer,
+                    write_handler_type && handler)
+              : buffer_(std::move(buffer))
+              , handler_(std::move(handler))
+            {}
+
+            pending_write(pending_write && rhs)
+              : buffer_(std::move(rhs.buffer_))
+              , handler_(std::move(rhs.handler_))
+            {}
+
+            pending_write& operator=(pending_write && rhs)
+            {
+                buffer_ = std::move(rhs.buffer_);
+                handler_ = std::move(rhs.handler_);
+                return *this;
+            }
+
+            parcel_buffer_type buffer_;
+            write_handler_type handler_;
+        };
+
     public:
         /// Construct a sending parcelport_connection with the given io_service.
         sender(boost::asio::io_service& io_service,
                 parcelset::locality const& locality_id,
-                parcelset::parcelport* pp)
-          : socket_(io_service)
-          , ack_(0)
+                parcelset::parcelport* pp,
+                util::atomic_count& operations_in_flight,
+                std::size_t write_coalescing_delay = 0)
+          : io_service_(io_service)
+          , socket_(io_service)
+          , delay_timer_(io_service)
           , there_(locality_id)
           , timer_()
           , pp_(pp)
+          , operations_in_flight_(operations_in_flight)
+          , write_coalescing_delay_(write_coalescing_delay)
+          , write_in_flight_(false)
+          , delay_timer_armed_(false)
+          , ack_read_in_flight_(false)
+          , acks_pending_(0)
         {
         }
 
@@ -101,48 +173,110 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         {
             HPX_ASSERT(!buffer_.data_.empty());
 
-            handler_ = std::forward<Handler>(handler);
-            postprocess_handler_ = std::forward<ParcelPostprocess>(parcel_postprocess);
-
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             state_ = state_async_write;
 #endif
             /// Increment sends and begin timer.
             buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
 
-            // Write the serialized data to the socket. We use "gather-write"
-            // to send both the header and the data in a single write operation.
-            std::vector<boost::asio::const_buffer> buffers;
-            buffers.push_back(boost::asio::buffer(&buffer_.size_,
-                sizeof(buffer_.size_)));
-            buffers.push_back(boost::asio::buffer(&buffer_.data_size_,
-                sizeof(buffer_.data_size_)));
+            boost::system::error_code e;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                e = error_;
+                if (!e)
+                {
+                    // the staged buffer keeps the parcelport from shutting
+                    // down until it has been written
+                    ++operations_in_flight_;
+                    staged_.push_back(pending_write(std::move(buffer_),
+                        write_handler_type(std::forward<Handler>(handler))));
+
+                    // Buffers staged while a write is in flight will be sent
+                    // as soon as this write has completed.
+                    if (!write_in_flight_)
+                    {
+                        if (write_coalescing_delay_ == 0)
+                        {
+                            start_write();
+                        }
+                        else if (!delay_timer_armed_)
+                        {
+                            start_delay_timer();
+                        }
+                    }
+                }
+            }
+
+            if (e)
+            {
+                // this connection is broken, report the error right away
+                handler(e);
+            }
+
+            // the buffer is owned by the staged write now, start over
+            buffer_.clear();
+
+            // Hand the connection back to the parcelport, this allows for the
+            // next buffer to be encoded while the staged ones are being sent.
+            // This is done asynchronously to avoid recursing into the
+            // parcelport if more parcels are pending.
+            postprocess_handler_ =
+                std::forward<ParcelPostprocess>(parcel_postprocess);
+
+            void (sender::*f)() = &sender::handle_release;
+            io_service_.post(util::bind(f, shared_from_this()));
+        }
+
+    private:
+        // add the buffers describing the given parcel buffer, the mutex has
+        // to be held by the caller
+        void add_buffers(parcel_buffer_type& buffer)
+        {
+            // We use "gather-write" to send the header and the data of all
+            // staged parcel buffers in a single write operation.
+            buffers_.push_back(boost::asio::buffer(&buffer.size_,
+                sizeof(buffer.size_)));
+            buffers_.push_back(boost::asio::buffer(&buffer.data_size_,
+                sizeof(buffer.data_size_)));
 
             // add chunk description
-            buffers.push_back(boost::asio::buffer(&buffer_.num_chunks_,
-                sizeof(buffer_.num_chunks_)));
+            buffers_.push_back(boost::asio::buffer(&buffer.num_chunks_,
+                sizeof(buffer.num_chunks_)));
 
             std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
-                buffer_.transmission_chunks_;
+                buffer.transmission_chunks_;
             if (!chunks.empty()) {
-                buffers.push_back(
+                buffers_.push_back(
                     boost::asio::buffer(chunks.data(), chunks.size() *
                         sizeof(parcel_buffer_type::transmission_chunk_type)));
 
                 // add main buffer holding data which was serialized normally
-                buffers.push_back(boost::asio::buffer(buffer_.data_));
+                buffers_.push_back(boost::asio::buffer(buffer.data_));
 
                 // now add chunks themselves, those hold zero-copy serialized chunks
-                for (serialization::serialization_chunk& c : buffer_.chunks_)
+                for (serialization::serialization_chunk& c : buffer.chunks_)
                 {
                     if (c.type_ == serialization::chunk_type_pointer)
-                        buffers.push_back(boost::asio::buffer(c.data_.cpos_, c.size_));
+                        buffers_.push_back(boost::asio::buffer(c.data_.cpos_, c.size_));
                 }
             }
             else {
                 // add main buffer holding data which was serialized normally
-                buffers.push_back(boost::asio::buffer(buffer_.data_));
+                buffers_.push_back(boost::asio::buffer(buffer.data_));
             }
+        }
+
+        // send all staged buffers, the mutex has to be held by the caller
+        void start_write()
+        {
+            HPX_ASSERT(!write_in_flight_ && !staged_.empty());
+            write_in_flight_ = true;
+
+            std::swap(in_flight_, staged_);
+
+            buffers_.clear();
+            for (pending_write& w : in_flight_)
+                add_buffers(w.buffer_);
 
             // this additional wrapping of the handler into a bind object is
             // needed to keep  this parcelport_connection object alive for the whole
@@ -152,63 +286,192 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
             using util::placeholders::_1;
             using util::placeholders::_2;
-            boost::asio::async_write(socket_, buffers,
+            boost::asio::async_write(socket_, buffers_,
                 util::bind(f, shared_from_this(), _1, _2));
         }
 
-    private:
+        // wait for more buffers to be staged, the mutex has to be held by the
+        // caller
+        void start_delay_timer()
+        {
+            delay_timer_armed_ = true;
+            delay_timer_.expires_from_now(
+                std::chrono::microseconds(write_coalescing_delay_));
+
+            void (sender::*f)(boost::system::error_code const&)
+                = &sender::handle_delay_timer;
+
+            using util::placeholders::_1;
+            delay_timer_.async_wait(util::bind(f, shared_from_this(), _1));
+        }
+
+        // consume outstanding acknowledgments, the mutex has to be held by the
+        // caller
+        void start_read_ack()
+        {
+            if (ack_read_in_flight_ || acks_pending_ == 0)
+                return;
+
+            ack_read_in_flight_ = true;
+
+            // now handle the acknowledgment bytes which are sent by the receiver
+#if defined(__linux) || defined(linux) || defined(__linux__)
+            boost::asio::detail::socket_option::boolean<
+                IPPROTO_TCP, TCP_QUICKACK> quickack(true);
+            boost::system::error_code ec;
+            socket_.set_option(quickack, ec);
+#endif
+
+            std::size_t const count = (std::min)(acks_pending_,
+                sizeof(acks_) / sizeof(acks_[0]));
+
+            void (sender::*f)(boost::system::error_code const&, std::size_t)
+                = &sender::handle_read_ack;
+
+            using util::placeholders::_1;
+            using util::placeholders::_2;
+            socket_.async_read_some(
+                boost::asio::buffer(acks_, count * sizeof(acks_[0])),
+                util::bind(f, shared_from_this(), _1, _2));
+        }
+
+        // report the given error to all staged buffers
+        void fail_writes(std::vector<pending_write>& writes,
+            boost::system::error_code const& e)
+        {
+            for (pending_write& w : writes)
+            {
+                w.handler_(e);
+                --operations_in_flight_;
+            }
+            writes.clear();
+        }
+
         /// handle completed write operation
         void handle_write(boost::system::error_code const& e, std::size_t bytes)
         {
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             state_ = state_handle_write;
 #endif
-            // just call initial handler
-            handler_(e);
+            std::vector<pending_write> written;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                write_in_flight_ = false;
+                std::swap(written, in_flight_);
+
+                if (e)
+                {
+                    if (!error_)
+                        error_ = e;
+                }
+                else
+                {
+                    acks_pending_ += written.size();
+                    start_read_ack();
+                }
+            }
+
             if (e)
             {
-                // inform post-processing handler of error as well
-                postprocess_handler_(e, there_, shared_from_this());
-                return;
+                fail_writes(written, e);
             }
+            else
+            {
+                std::int64_t const now = timer_.elapsed_nanoseconds();
+                for (pending_write& w : written)
+                {
+                    // just call initial handler
+                    w.handler_(e);
 
-            // complete data point and push back onto gatherer
-            buffer_.data_point_.time_ =
-                timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
-            pp_->add_sent_data(buffer_.data_point_);
+                    // complete data point and push back onto gatherer
+                    w.buffer_.data_point_.time_ =
+                        now - w.buffer_.data_point_.time_;
+                    pp_->add_sent_data(w.buffer_.data_point_);
 
-            // now handle the acknowledgment byte which is sent by the receiver
-#if defined(__linux) || defined(linux) || defined(__linux__)
-            boost::asio::detail::socket_option::boolean<
-                IPPROTO_TCP, TCP_QUICKACK> quickack(true);
-            socket_.set_option(quickack);
-#endif
+                    --operations_in_flight_;
+                }
+            }
 
-            void (sender::*f)(boost::system::error_code const&)
-                = &sender::handle_read_ack;
+            // send the buffers which were staged in the meantime
+            flush_staged();
+        }
 
-            using util::placeholders::_1;
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(&ack_, sizeof(ack_)),
-                util::bind(f, shared_from_this(), _1));
+        void handle_delay_timer(boost::system::error_code const&)
+        {
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                delay_timer_armed_ = false;
+            }
+            flush_staged();
         }
 
-        void handle_read_ack(boost::system::error_code const& e)
+        void flush_staged()
+        {
+            std::vector<pending_write> failed;
+            boost::system::error_code e;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (write_in_flight_ || staged_.empty())
+                    return;
+
+                if (!error_)
+                {
+                    start_write();
+                    return;
+                }
+
+                e = error_;
+                std::swap(failed, staged_);
+            }
+            fail_writes(failed, e);
+        }
+
+        void handle_read_ack(boost::system::error_code const& e,
+            std::size_t bytes)
         {
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             state_ = state_handle_read_ack;
 #endif
-            buffer_.clear();
+            std::lock_guard<mutex_type> l(mtx_);
+            ack_read_in_flight_ = false;
+
+            if (e)
+            {
+                // the next write on this connection will report the error
+                if (!error_)
+                    error_ = e;
+                return;
+            }
+
+            std::size_t const count = bytes / sizeof(acks_[0]);
+            HPX_ASSERT(count <= acks_pending_);
+            acks_pending_ -= count;
+
+            start_read_ack();
+        }
+
+        void handle_release()
+        {
+            boost::system::error_code e;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                e = error_;
+            }
+
             // Call post-processing handler, which will send remaining pending
             // parcels. Pass along the connection so it can be reused if more
             // parcels have to be sent.
-            postprocess_handler_(e, there_, shared_from_this());
+            postprocess_handler_type f = std::move(postprocess_handler_);
+            f(e, there_, shared_from_this());
         }
 
+        boost::asio::io_service& io_service_;
+
         /// Socket for the parcelport_connection.
         boost::asio::ip::tcp::socket socket_;
 
-        bool ack_;
+        /// Timer used to delay writes to be able to coalesce more buffers.
+        deadline_timer_type delay_timer_;
 
         /// the other (receiving) end of this connection
         parcelset::locality there_;
@@ -216,19 +479,25 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         /// Counters and their data containers.
         util::high_resolution_timer timer_;
         parcelset::parcelport* pp_;
+        util::atomic_count& operations_in_flight_;
 
-        util::unique_function_nonser<
-            void(
-                boost::system::error_code const&
-            )
-        > handler_;
-        util::unique_function_nonser<
-            void(
-                boost::system::error_code const&
-              , parcelset::locality const&
-              , std::shared_ptr<sender>
-            )
-        > postprocess_handler_;
+        /// Time in microseconds a write is delayed to allow for more
+        /// buffers to be staged.
+        std::size_t const write_coalescing_delay_;
+
+        mutex_type mtx_;
+        std::vector<pending_write> staged_;
+        std::vector<pending_write> in_flight_;
+        std::vector<boost::asio::const_buffer> buffers_;
+        boost::system::error_code error_;
+        bool write_in_flight_;
+        bool delay_timer_armed_;
+
+        bool ack_read_in_flight_;
+        std::size_t acks_pending_;
+        bool acks_[64];
+
+        postprocess_handler_type postprocess_handler_;
     };
 }}}}
 
@@ -80,13 +80,32 @@ public:
       , gva
       , hpx::util::cache::statistics::local_full_statistics
     > gva_cache_type;
+
+    // The cache is split into independently locked shards, which allows
+    // concurrent lookups of unrelated ids. Ids are assigned to the shards in
+    // blocks of 2^gva_cache_block_bits consecutive ids. A cached range which
+    // covers more than one block is stored once in a separate range cache,
+    // which is consulted if the shard of an id doesn't hold it.
+    enum { gva_cache_num_shards = 32 };
+    enum { gva_cache_block_bits = 4 };
+
+    struct gva_cache_shard
+    {
+        gva_cache_shard();
+
+        mutable mutex_type mtx_;
+        std::shared_ptr<gva_cache_type> cache_;
+
+        // place each shard on a separate cache line
+        char padding_[64];
+    };
     // }}}
 
     typedef std::set<naming::gid_type> migrated_objects_table_type;
     typedef std::map<naming::gid_type, std::int64_t> refcnt_requests_type;
 
-    mutable mutex_type gva_cache_mtx_;
-    std::shared_ptr<gva_cache_type> gva_cache_;
+    gva_cache_shard gva_cache_[gva_cache_num_shards];
+    gva_cache_shard gva_range_cache_;
 
     mutable mutex_type migrated_objects_mtx_;
     migrated_objects_table_type migrated_objects_table_;
@@ -32,6 +32,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -126,19 +127,42 @@ struct HPX_EXPORT primary_namespace
 
     typedef std::pair<gva, naming::gid_type> gva_table_data_type;
     typedef std::map<naming::gid_type, gva_table_data_type> gva_table_type;
-    typedef std::map<naming::gid_type, std::int64_t> refcnt_table_type;
+    typedef std::unordered_map<naming::gid_type, std::int64_t>
+        refcnt_table_type;
 
     typedef hpx::util::tuple<naming::gid_type, gva, naming::gid_type>
         resolved_type;
     // }}}
 
   private:
-    // REVIEW: Separate mutexes might reduce contention here. This has to be
-    // investigated carefully.
+    // The reference count table is hashed into a number of shards, each
+    // protected by its own lock. This lets credit operations on unrelated
+    // objects proceed concurrently and keeps them from blocking lookups in
+    // the GVA table.
+    enum { refcnt_num_shards = 32 };
+
+    struct refcnt_shard
+    {
+        mutex_type mtx_;
+        refcnt_table_type table_;
+
+        // place each shard on a separate cache line
+        char padding_[64];
+    };
+
+    refcnt_shard& get_refcnt_shard(naming::gid_type const& gid)
+    {
+        return refcnts_[std::hash<naming::gid_type>()(gid) % refcnt_num_shards];
+    }
+
+    // protects gvas_ and migrating_objects_
     mutex_type mutex_;
 
+    // protects next_id_
+    mutex_type allocate_mutex_;
+
     gva_table_type gvas_;
-    refcnt_table_type refcnts_;
+    refcnt_shard refcnts_[refcnt_num_shards];
     typedef std::map<
             naming::gid_type,
             hpx::util::tuple<bool, std::size_t, lcos::local::condition_variable_any>
@@ -223,14 +247,11 @@ struct HPX_EXPORT primary_namespace
     counter_data counter_data_;
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    /// Dump the credit counts of all matching ranges. Expects that \p l
-    /// is locked.
+    /// Dump the credit counts of all entries in the given range. Acquires
+    /// the locks of the affected shards.
     void dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         );
 #endif
@@ -245,6 +266,7 @@ struct HPX_EXPORT primary_namespace
     primary_namespace()
       : base_type(HPX_AGAS_PRIMARY_NS_MSB, HPX_AGAS_PRIMARY_NS_LSB)
       , mutex_()
+      , allocate_mutex_()
       , instance_name_()
       , next_id_(naming::invalid_gid)
       , locality_(naming::invalid_gid)
@@ -341,16 +363,13 @@ struct HPX_EXPORT primary_namespace
     };
 
     void resolve_free_list(
-        std::unique_lock<mutex_type>& l
-      , std::list<refcnt_table_type::iterator> const& free_list
+        std::vector<naming::gid_type> const& free_list
       , std::list<free_entry>& free_entry_list
-      , naming::gid_type const& lower
-      , naming::gid_type const& upper
       , error_code& ec
         );
 
     void decrement_sweep(
-        std::list<free_entry>& free_list
+        std::vector<naming::gid_type>& free_list
       , naming::gid_type const& lower
       , naming::gid_type const& upper
       , std::int64_t credits
@@ -359,8 +378,6 @@ struct HPX_EXPORT primary_namespace
 
     void free_components_sync(
         std::list<free_entry>& free_list
-      , naming::gid_type const& lower
-      , naming::gid_type const& upper
       , error_code& ec
         );
 
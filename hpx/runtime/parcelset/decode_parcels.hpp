@@ -22,7 +22,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <sstream>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -98,6 +100,7 @@ namespace hpx { namespace parcelset
       , std::size_t parcel_count
       , std::vector<serialization::serialization_chunk> &chunks
       , std::size_t num_thread = -1
+      , std::shared_ptr<void> chunk_owner = std::shared_ptr<void>()
     )
     {
         std::uint64_t inbound_data_size = buffer.data_size_;
@@ -115,7 +118,7 @@ namespace hpx { namespace parcelset
                     std::vector<parcel> deferred_parcels;
                     // De-serialize the parcel data
                     serialization::input_archive archive(buffer.data_,
-                        inbound_data_size, &chunks);
+                        inbound_data_size, &chunks, std::move(chunk_owner));
 
                     if(parcel_count == 0)
                     {
@@ -268,6 +271,33 @@ namespace hpx { namespace parcelset
             parcel_count, chunks, num_thread);
     }
 
+    // Decode the parcels in the given buffer, the received zero-copy chunks
+    // are handed over to the de-serialized objects which are able to refer
+    // to them directly (e.g. serialize_buffer) instead of being copied.
+    // The chunks are released once the last of those objects is destroyed.
+    template <typename Parcelport, typename Buffer>
+    void decode_parcels_shared_chunks(Parcelport & parcelport, Buffer buffer,
+        std::size_t num_thread)
+    {
+        typedef typename std::decay<decltype(buffer.chunks_)>::type
+            chunks_type;
+
+        std::vector<serialization::serialization_chunk>
+            chunks(decode_chunks(buffer));
+
+        // moving the chunks does not move the data they hold, so the
+        // pointer chunks created above stay valid
+        std::shared_ptr<void> chunk_owner;
+        if (!buffer.chunks_.empty())
+        {
+            chunk_owner = std::make_shared<chunks_type>(
+                std::move(buffer.chunks_));
+        }
+
+        decode_message_with_chunks(parcelport, std::move(buffer), 0,
+            chunks, num_thread, std::move(chunk_owner));
+    }
+
     template <typename Parcelport, typename Buffer>
     void decode_parcel(Parcelport & parcelport, Buffer buffer, std::size_t num_thread)
     {
@@ -0,0 +1,105 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_DETAIL_PROGRESS_THREADS_HPP
+#define HPX_PARCELSET_DETAIL_PROGRESS_THREADS_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/cpu_mask.hpp>
+#include <hpx/util/function.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The progress_threads are dedicated OS threads performing the background
+    // work of the parcel layer and of AGAS, which is otherwise done by the
+    // worker threads of the thread manager in between running HPX threads.
+    // This way the network makes progress even while all worker threads are
+    // busy running long HPX threads.
+    //
+    // Each progress thread repeatedly invokes the given work function. After
+    // spin_count invocations which did not find any work the thread backs off
+    // by sleeping for an exponentially growing time, up to max_idle_time
+    // microseconds.
+    class HPX_EXPORT progress_threads
+    {
+    public:
+        typedef util::function_nonser<bool(std::size_t)> work_function_type;
+        typedef util::function_nonser<void(std::size_t, char const*)>
+            on_start_thread_type;
+        typedef util::function_nonser<void()> on_stop_thread_type;
+
+        progress_threads(std::size_t num_threads, std::int64_t spin_count,
+            std::int64_t max_idle_time,
+            on_start_thread_type const& on_start_thread,
+            on_stop_thread_type const& on_stop_thread);
+
+        ~progress_threads();
+
+        // Start the progress threads. They are bound to processing units
+        // not used by the given mask (if any are left).
+        void run(work_function_type const& work,
+            threads::mask_cref_type used_processing_units);
+
+        // Stop the progress threads and wait for them to exit.
+        void stop();
+
+        std::size_t size() const { return data_.size(); }
+
+        // Return the overall time (in nanoseconds) the progress threads spent
+        // doing work.
+        std::int64_t get_busy_time(bool reset);
+
+        // Return the ratio of the time the progress threads spent doing work
+        // to the time they were running (in 0.01%).
+        std::int64_t get_busy_rate(bool reset);
+
+    private:
+        HPX_NON_COPYABLE(progress_threads);
+
+        void thread_func(std::size_t num_thread, threads::mask_type mask);
+
+        std::int64_t accumulate_busy_time() const;
+
+        struct thread_data
+        {
+            thread_data()
+              : busy_time_(0)
+            {}
+
+            boost::atomic<std::int64_t> busy_time_;     // [ns]
+
+            // avoid false sharing between the progress threads
+            char pad_[64];
+        };
+
+        std::vector<std::unique_ptr<thread_data> > data_;
+        std::vector<boost::thread> threads_;
+
+        work_function_type work_;
+        on_start_thread_type on_start_thread_;
+        on_stop_thread_type on_stop_thread_;
+
+        std::int64_t const spin_count_;
+        std::int64_t const max_idle_time_;
+
+        boost::atomic<bool> running_;
+
+        // values at the time the counters were last reset
+        std::int64_t reset_busy_time_;
+        std::int64_t reset_busy_rate_busy_time_;
+        std::uint64_t reset_busy_rate_time_;
+    };
+}}}
+
+#endif
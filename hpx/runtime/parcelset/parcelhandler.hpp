@@ -14,6 +14,7 @@
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/parcelset/detail/progress_threads.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime_fwd.hpp>
@@ -119,6 +120,30 @@ namespace hpx { namespace parcelset
         bool do_background_work(std::size_t num_thread = 0,
             bool stop_buffering = false);
 
+        /// \brief Return the number of dedicated progress threads
+        ///
+        /// If this is not zero, the background work of the parcel layer is
+        /// performed by the progress threads instead of the worker threads.
+        std::size_t get_num_progress_threads() const
+        {
+            return num_progress_threads_;
+        }
+
+        /// \brief Start the dedicated progress threads (if any)
+        ///
+        /// This has to be called after the thread manager was started, the
+        /// progress threads are bound to the processing units not used by
+        /// the worker threads.
+        void start_progress_threads();
+
+        /// \brief Stop the dedicated progress threads (if any)
+        ///
+        /// This has to be called after the thread manager has been stopped
+        /// and before the parcel ports are stopped. The worker threads don't
+        /// poll the parcel ports if there are progress threads, so those
+        /// have to keep running while the thread manager drains.
+        void stop_progress_threads();
+
         /// \brief Allow access to AGAS resolver instance.
         ///
         /// This accessor returns a reference to the AGAS resolver client
@@ -441,6 +466,12 @@ namespace hpx { namespace parcelset
         locality find_endpoint(endpoints_type const & eps, std::string const & name);
 
         void register_counter_types(std::string const& pp_type);
+        void register_progress_counter_types();
+
+        bool do_progress_work(std::size_t num_thread);
+
+        std::int64_t get_progress_busy_time(bool reset);
+        std::int64_t get_progress_busy_rate(bool reset);
         void register_connection_cache_counter_types(std::string const& pp_type);
 
     private:
@@ -497,6 +528,16 @@ namespace hpx { namespace parcelset
         mutable mutex_type mtx_;
         write_handler_type write_handler_;
 
+        /// dedicated threads performing the background work (optional)
+        std::size_t num_progress_threads_;
+        std::unique_ptr<detail::progress_threads> progress_threads_;
+
+        /// the number of polls of the first progress thread since the AGAS
+        /// garbage collection was last triggered, and the number of polls
+        /// in between those
+        std::int64_t progress_gc_count_;
+        std::int64_t const max_progress_gc_count_;
+
     private:
         static std::vector<plugins::parcelport_factory_base *> &
             get_parcelport_factories();
@@ -0,0 +1,106 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_SERIALIZATION_BLOCK_BINARY_FILTER_HPP)
+#define HPX_SERIALIZATION_BLOCK_BINARY_FILTER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/serialization/binary_filter.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+/// The size (in bytes) of the blocks the serialized data is split into by
+/// the block based binary filters. Each block is compressed independently.
+#if !defined(HPX_SERIALIZATION_FILTER_BLOCK_SIZE)
+#  define HPX_SERIALIZATION_FILTER_BLOCK_SIZE 65536
+#endif
+
+/// Blocks smaller than this (in bytes) are not compressed at all.
+#if !defined(HPX_SERIALIZATION_FILTER_MIN_COMPRESS_SIZE)
+#  define HPX_SERIALIZATION_FILTER_MIN_COMPRESS_SIZE 1024
+#endif
+
+namespace hpx { namespace serialization
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Base class for binary filters compressing the serialized data in
+    // fixed-size blocks. A block is handed to the codec as soon as it is
+    // complete, which allows to compress it (on another worker thread)
+    // while the remaining data is still being serialized. Blocks which are
+    // too small or which don't compress well are stored uncompressed.
+    //
+    // The compressed stream is a sequence of blocks, each of which is
+    // preceded by its uncompressed size and its stored size (zero for
+    // blocks stored uncompressed), both as 32 bit little endian integers.
+    struct HPX_EXPORT block_binary_filter : binary_filter
+    {
+        block_binary_filter(bool compress,
+            std::size_t block_size = HPX_SERIALIZATION_FILTER_BLOCK_SIZE);
+        ~block_binary_filter();
+
+        // compression API
+        void set_max_length(std::size_t size);
+        void save(void const* src, std::size_t src_count);
+        bool flush(void* dst, std::size_t dst_count, std::size_t& written);
+
+        // decompression API
+        std::size_t init_data(char const* buffer, std::size_t size,
+            std::size_t buffer_size);
+        void load(void* dst, std::size_t dst_count);
+
+    protected:
+        // codec API to be implemented by derived filters
+
+        // return the maximum size of the compressed representation of a
+        // block of the given size
+        virtual std::size_t max_compressed_length(std::size_t size) const = 0;
+
+        // compress the given block, return the size of the compressed data
+        // or zero if the data could not be compressed
+        virtual std::size_t compress_block(char const* src, std::size_t size,
+            char* dst, std::size_t dst_size) const = 0;
+
+        // decompress the given block, the uncompressed size is known
+        virtual void decompress_block(char const* src, std::size_t size,
+            char* dst, std::size_t dst_size) const = 0;
+
+    private:
+        struct block
+        {
+            block() : submitted_(false) {}
+
+            std::vector<char> data_;        // uncompressed data
+            std::vector<char> compressed_;  // empty if stored uncompressed
+            hpx::future<void> done_;
+            bool submitted_;
+        };
+
+        void submit_block();
+        void compress(block& b);
+        bool skip_compression() const;
+
+        std::size_t block_size_;
+        bool compress_;
+
+        // compression state
+        std::deque<block> blocks_;
+        std::atomic<std::size_t> compressed_blocks_;
+        std::atomic<std::size_t> incompressible_blocks_;
+
+        // decompression state
+        std::vector<char> buffer_;
+        std::size_t current_;
+    };
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -15,6 +15,7 @@
 #include <hpx/util/assert.hpp>
 
 #include <cstddef>
+#include <memory>
 
 namespace hpx { namespace serialization
 {
@@ -45,6 +46,15 @@ namespace hpx { namespace serialization
         virtual void set_filter(binary_filter* filter) = 0;
         virtual void load_binary(void * address, std::size_t count) = 0;
         virtual void load_binary_chunk(void * address, std::size_t count) = 0;
+
+        // Return the address of the data of the next zero-copy chunk if it
+        // holds exactly count bytes and may be referenced directly, owner
+        // is set to keep this data alive. Returns nullptr otherwise.
+        virtual void const* reference_binary_chunk(std::size_t,
+            std::shared_ptr<void>&)
+        {
+            return nullptr;
+        }
     };
 }}
 
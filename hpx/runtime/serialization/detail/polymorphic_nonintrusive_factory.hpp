@@ -18,6 +18,7 @@
 #include <hpx/util/jenkins_hash.hpp>
 #include <hpx/util/static.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <typeinfo>
@@ -87,18 +88,36 @@ namespace hpx { namespace serialization { namespace detail
         }
     };
 
+    // Every registered class is identified on the wire by a 32 bit id which
+    // is derived from its serialization name. The ids are computed
+    // independently on each locality, collisions are detected while
+    // registering the classes.
     class polymorphic_nonintrusive_factory
     {
         HPX_NON_COPYABLE(polymorphic_nonintrusive_factory);
 
     public:
+        struct serializer_entry
+        {
+            std::uint32_t id;
+            function_bunch_type bunch;
+        };
+
+        typedef std::unordered_map<std::uint32_t,
+                  function_bunch_type> serializer_map_type;
         typedef std::unordered_map<std::string,
-                  function_bunch_type, hpx::util::jenkins_hash> serializer_map_type;
-        typedef std::unordered_map<std::string,
-                  std::string, hpx::util::jenkins_hash> serializer_typeinfo_map_type;
+                  serializer_entry, hpx::util::jenkins_hash>
+            serializer_typeinfo_map_type;
+        typedef std::unordered_map<std::uint32_t,
+                  std::string> serializer_name_map_type;
 
         HPX_EXPORT static polymorphic_nonintrusive_factory& instance();
 
+        static std::uint32_t get_id(std::string const& class_name)
+        {
+            return hpx::util::jenkins_hash()(class_name);
+        }
+
         void register_class(const std::type_info& typeinfo,
             const std::string& class_name,
             const function_bunch_type& bunch)
@@ -115,13 +134,30 @@ namespace hpx { namespace serialization { namespace detail
                   , "polymorphic_nonintrusive_factory::register_class"
                   , "Cannot register a factory with an empty name");
             }
-            auto it = map_.find(class_name);
-            auto jt = typeinfo_map_.find(typeinfo.name());
 
-            if(it == map_.end())
-                map_[class_name] = bunch;
+            std::uint32_t id = get_id(class_name);
+
+            auto nt = names_.find(id);
+            if(nt == names_.end())
+            {
+                names_[id] = class_name;
+                map_[id] = bunch;
+            }
+            else if(nt->second != class_name)
+            {
+                HPX_THROW_EXCEPTION(serialization_error
+                  , "polymorphic_nonintrusive_factory::register_class"
+                  , "The serialization names '" + class_name + "' and '" +
+                    nt->second + "' map to the same type id, please "
+                    "register one of the classes using a different name");
+            }
+
+            auto jt = typeinfo_map_.find(typeinfo.name());
             if(jt == typeinfo_map_.end())
-                typeinfo_map_[typeinfo.name()] = class_name;
+            {
+                serializer_entry entry = { id, bunch };
+                typeinfo_map_[typeinfo.name()] = entry;
+            }
         }
 
         // the following templates are defined in *.ipp file
@@ -141,10 +177,15 @@ namespace hpx { namespace serialization { namespace detail
         {
         }
 
+        HPX_EXPORT serializer_entry const& locate(
+            std::type_info const& typeinfo) const;
+        HPX_EXPORT function_bunch_type const& locate(std::uint32_t id) const;
+
         friend struct hpx::util::static_<polymorphic_nonintrusive_factory>;
 
         serializer_map_type map_;
         serializer_typeinfo_map_type typeinfo_map_;
+        serializer_name_map_type names_;
     };
 
     template <class Derived>
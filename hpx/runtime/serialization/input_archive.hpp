@@ -42,9 +42,11 @@ namespace hpx { namespace serialization
         template <typename Container>
         input_archive(Container & buffer,
             std::size_t inbound_data_size = 0,
-            const std::vector<serialization_chunk>* chunks = nullptr)
+            const std::vector<serialization_chunk>* chunks = nullptr,
+            std::shared_ptr<void> chunk_owner = std::shared_ptr<void>())
           : base_type(0U)
-          , buffer_(new input_container<Container>(buffer, chunks, inbound_data_size))
+          , buffer_(new input_container<Container>(buffer, chunks,
+                inbound_data_size, std::move(chunk_owner)))
         {
             // endianness needs to be saves separately as it is needed to
             // properly interpret the flags
@@ -134,6 +136,8 @@ namespace hpx { namespace serialization
         friend struct basic_archive<input_archive>;
         template <class T>
         friend class array;
+        template <typename T, typename Allocator>
+        friend class serialize_buffer;
 
         template <typename T>
         void load_bitwise(T & t, std::false_type)
@@ -257,6 +261,21 @@ namespace hpx { namespace serialization
             size_ += count;
         }
 
+        // Return the address of the received data of the next zero-copy
+        // chunk if it can be referenced directly instead of being copied
+        // by load_binary_chunk, owner keeps the data alive.
+        void const* reference_binary_chunk(std::size_t count,
+            std::shared_ptr<void>& owner)
+        {
+            if (0 == count || disable_data_chunking())
+                return nullptr;
+
+            void const* data = buffer_->reference_binary_chunk(count, owner);
+            if (data != nullptr)
+                size_ += count;
+            return data;
+        }
+
         // make functions visible through adl
         friend void register_pointer(input_archive& ar,
                 std::uint64_t pos, detail::ptr_helper_ptr helper)
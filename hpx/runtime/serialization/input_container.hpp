@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <cstring> // for memcpy
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace hpx { namespace serialization
@@ -55,10 +56,12 @@ namespace hpx { namespace serialization
 
         input_container(Container const& cont,
                 std::vector<serialization_chunk> const* chunks,
-                std::size_t inbound_data_size)
+                std::size_t inbound_data_size,
+                std::shared_ptr<void> chunk_owner = std::shared_ptr<void>())
           : cont_(cont), current_(0), filter_(),
             decompressed_size_(inbound_data_size),
-            chunks_(nullptr), current_chunk_(std::size_t(-1)), current_chunk_size_(0)
+            chunks_(nullptr), current_chunk_(std::size_t(-1)), current_chunk_size_(0),
+            chunk_owner_(std::move(chunk_owner))
         {
             if (chunks && chunks->size() != 0)
             {
@@ -155,6 +158,31 @@ namespace hpx { namespace serialization
             }
         }
 
+        void const* reference_binary_chunk(std::size_t count,
+            std::shared_ptr<void>& owner) // override
+        {
+            // the received data can be referenced only if its owner is known
+            if (!chunk_owner_ || filter_.get() || chunks_ == nullptr ||
+                count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
+            {
+                return nullptr;
+            }
+
+            HPX_ASSERT(current_chunk_ != std::size_t(-1));
+            HPX_ASSERT(get_chunk_type(current_chunk_) == chunk_type_pointer);
+
+            if (get_chunk_size(current_chunk_) != count)
+            {
+                HPX_THROW_EXCEPTION(serialization_error
+                  , "input_container::reference_binary_chunk"
+                  , "archive data bstream data chunk size mismatch");
+                return nullptr;
+            }
+
+            owner = chunk_owner_;
+            return get_chunk_data(current_chunk_++).cpos_;
+        }
+
         Container const& cont_;
         std::size_t current_;
         std::unique_ptr<binary_filter> filter_;
@@ -163,6 +191,9 @@ namespace hpx { namespace serialization
         std::vector<serialization_chunk> const* chunks_;
         std::size_t current_chunk_;
         std::size_t current_chunk_size_;
+
+        // keeps the memory referenced by the pointer chunks alive
+        std::shared_ptr<void> chunk_owner_;
     };
 }}
 
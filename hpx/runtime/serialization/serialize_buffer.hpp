@@ -11,6 +11,7 @@
 #include <hpx/runtime/serialization/array.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/traits/is_bitwise_serializable.hpp>
 #include <hpx/traits/supports_streaming_with_any.hpp>
 #include <hpx/util/bind.hpp>
 
@@ -18,7 +19,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace hpx { namespace serialization
 {
@@ -253,12 +256,59 @@ namespace hpx { namespace serialization
         }
 
         ///////////////////////////////////////////////////////////////////////
+        static void owner_deleter(T*, std::shared_ptr<void> const&) {}
+
+        template <typename Archive>
+        bool load_reference(Archive&, std::false_type)
+        {
+            return false;
+        }
+
+        // Refer to the received data directly instead of copying it if the
+        // archive allows for it, which is the case if the array was sent as
+        // a zero-copy chunk and the receiving parcelport keeps the memory
+        // of the chunks alive on our behalf.
+        template <typename Archive>
+        bool load_reference(Archive& ar, std::true_type)
+        {
+            using util::placeholders::_1;
+
+#ifdef BOOST_BIG_ENDIAN
+            bool archive_endianess_differs = ar.endian_little();
+#else
+            bool archive_endianess_differs = ar.endian_big();
+#endif
+            if (ar.disable_array_optimization() || archive_endianess_differs)
+                return false;
+
+            std::shared_ptr<void> owner;
+            void const* data = ar.reference_binary_chunk(size_ * sizeof(T),
+                owner);
+            if (data == nullptr)
+                return false;
+
+            data_.reset(static_cast<T*>(const_cast<void*>(data)),
+                util::bind(&serialize_buffer::owner_deleter, _1,
+                    std::move(owner)));
+            return true;
+        }
+
         template <typename Archive>
         void load(Archive& ar, const unsigned int version)
         {
             using util::placeholders::_1;
             ar >> size_ >> alloc_; //-V128
 
+            // only buffers using the default allocator may refer to memory
+            // which was not allocated by their allocator
+            typedef std::integral_constant<bool,
+                    hpx::traits::is_bitwise_serializable<T>::value &&
+                    std::is_same<Allocator, std::allocator<T> >::value
+                > can_reference;
+
+            if (size_ != 0 && load_reference(ar, can_reference()))
+                return;
+
             data_.reset(alloc_.allocate(size_),
                 util::bind(&serialize_buffer::deleter<allocator_type>, _1,
                     alloc_, size_));
@@ -24,6 +24,7 @@
 
 #if defined(_POSIX_VERSION)
 #include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_cache.hpp>
 #endif
 
 #include <boost/version.hpp>
@@ -96,7 +97,7 @@ namespace hpx { namespace threads { namespace coroutines
             void* allocate(std::size_t size) const
             {
 #if defined(_POSIX_VERSION)
-                void* limit = posix::alloc_stack(size);
+                void* limit = detail::allocate_stack(size);
                 posix::watermark_stack(limit, size);
 #else
                 void* limit = std::calloc(size, sizeof(char));
@@ -111,7 +112,7 @@ namespace hpx { namespace threads { namespace coroutines
                 HPX_ASSERT(vp);
                 void* limit = static_cast<char*>(vp) - size;
 #if defined(_POSIX_VERSION)
-                posix::free_stack(limit, size);
+                detail::deallocate_stack(limit, size);
 #else
                 std::free(limit);
 #endif
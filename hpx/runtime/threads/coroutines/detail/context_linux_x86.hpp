@@ -16,6 +16,7 @@
 #include <hpx/config.hpp>
 #include <hpx/runtime/threads/coroutines/detail/get_stack_pointer.hpp>
 #include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_cache.hpp>
 #include <hpx/runtime/threads/coroutines/detail/swap_context.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
@@ -168,7 +169,7 @@ namespace hpx { namespace threads { namespace coroutines
                             m_stack_size));
                 }
 
-                m_stack = posix::alloc_stack(static_cast<std::size_t>(m_stack_size));
+                m_stack = allocate_stack(static_cast<std::size_t>(m_stack_size));
                 HPX_ASSERT(m_stack);
                 posix::watermark_stack(m_stack, static_cast<std::size_t>(m_stack_size));
 
@@ -199,7 +200,7 @@ namespace hpx { namespace threads { namespace coroutines
                     VALGRIND_STACK_DEREGISTER(
                         reinterpret_cast<std::size_t>(m_sp[valgrind_id_idx]));
 #endif
-                    posix::free_stack(m_stack, static_cast<std::size_t>(m_stack_size));
+                    deallocate_stack(m_stack, static_cast<std::size_t>(m_stack_size));
                 }
             }
 
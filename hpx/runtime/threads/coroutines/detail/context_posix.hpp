@@ -144,6 +144,7 @@ namespace posix { namespace ucontext
 
 #include <hpx/runtime/threads/coroutines/detail/get_stack_pointer.hpp>
 #include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_cache.hpp>
 #include <hpx/runtime/threads/coroutines/detail/swap_context.hpp>
 #include <hpx/runtime/threads/coroutines/exception.hpp>
 #include <signal.h>                 // SIGSTKSZ
@@ -213,7 +214,7 @@ namespace hpx { namespace threads { namespace coroutines
             explicit ucontext_context_impl(Functor & cb, std::ptrdiff_t stack_size)
               : m_stack_size(stack_size == -1 ? (std::ptrdiff_t)default_stack_size
                     : stack_size),
-                m_stack(alloc_stack(m_stack_size)),
+                m_stack(detail::allocate_stack(m_stack_size)),
                 cb_(&cb)
             {
                 HPX_ASSERT(m_stack);
@@ -227,7 +228,7 @@ namespace hpx { namespace threads { namespace coroutines
             ~ucontext_context_impl()
             {
                 if (m_stack)
-                    free_stack(m_stack, m_stack_size);
+                    detail::deallocate_stack(m_stack, m_stack_size);
             }
 
             // Return the size of the reserved stack address space.
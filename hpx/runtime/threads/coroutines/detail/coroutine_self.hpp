@@ -32,6 +32,8 @@
 #include <hpx/config.hpp>
 #include <hpx/runtime/threads/coroutines/detail/coroutine_accessor.hpp>
 #include <hpx/runtime/threads/coroutines/detail/coroutine_impl.hpp>
+#include <hpx/runtime/threads/coroutines/exception.hpp>
+#include <hpx/runtime/threads/coroutines/stackless_coroutine.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/function.hpp>
@@ -86,6 +88,15 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         arg_type yield_impl(result_type arg)
         {
+            if (HPX_UNLIKELY(m_stackless != nullptr))
+            {
+                // there is nothing to switch to, simply keep on running
+                // if this is a plain yield
+                if (arg.first == threads::pending)
+                    return threads::wait_signaled;
+                throw stackless_suspension();
+            }
+
             HPX_ASSERT(m_pimpl);
 
             this->m_pimpl->bind_result(&arg);
@@ -128,18 +139,27 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         HPX_ATTRIBUTE_NORETURN void exit()
         {
+            if (m_stackless)
+                throw exit_exception();
+
             m_pimpl->exit_self();
             std::terminate(); // FIXME: replace with hpx::terminate();
         }
 
         bool pending() const
         {
+            if (m_stackless)
+                return false;
+
             HPX_ASSERT(m_pimpl);
             return m_pimpl->pending() != 0;
         }
 
         thread_id_repr_type get_thread_id() const
         {
+            if (m_stackless)
+                return m_stackless->get_thread_id();
+
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_id();
         }
@@ -147,6 +167,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         std::size_t get_thread_phase() const
         {
 #if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+            if (m_stackless)
+                return m_stackless->get_thread_phase();
+
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_phase();
 #else
@@ -156,6 +179,11 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         std::ptrdiff_t get_available_stack_space()
         {
+            // a stackless thread runs on the stack of the scheduling thread,
+            // which is not ours to consume
+            if (m_stackless)
+                return 0;
+
 #if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
             return m_pimpl->get_available_stack_space();
 #else
@@ -165,16 +193,34 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         explicit coroutine_self(impl_type * pimpl,
                 coroutine_self* next_self = nullptr)
-          : m_pimpl(pimpl), next_self_(next_self)
+          : m_pimpl(pimpl), m_stackless(nullptr), next_self_(next_self)
         {}
 
+        explicit coroutine_self(stackless_coroutine * pimpl,
+                coroutine_self* next_self = nullptr)
+          : m_pimpl(nullptr), m_stackless(pimpl), next_self_(next_self)
+        {}
+
+        // Return whether this thread runs without a stack of its own, such
+        // threads can not be suspended.
+        bool is_stackless() const
+        {
+            return m_stackless != nullptr;
+        }
+
         std::size_t get_thread_data() const
         {
+            if (m_stackless)
+                return m_stackless->get_thread_data();
+
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_data();
         }
         std::size_t set_thread_data(std::size_t data)
         {
+            if (m_stackless)
+                return m_stackless->set_thread_data(data);
+
             HPX_ASSERT(m_pimpl);
             return m_pimpl->set_thread_data(data);
         }
@@ -182,12 +228,18 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
         tss_storage* get_thread_tss_data()
         {
+            if (m_stackless)
+                return m_stackless->get_thread_tss_data(false);
+
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_tss_data(false);
         }
 
         tss_storage* get_or_create_thread_tss_data()
         {
+            if (m_stackless)
+                return m_stackless->get_thread_tss_data(true);
+
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_thread_tss_data(true);
         }
@@ -195,6 +247,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         std::size_t& get_continuation_recursion_count()
         {
+            if (m_stackless)
+                return m_stackless->get_continuation_recursion_count();
+
             HPX_ASSERT(m_pimpl);
             return m_pimpl->get_continuation_recursion_count();
         }
@@ -213,6 +268,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             return m_pimpl;
         }
         impl_ptr m_pimpl;
+        stackless_coroutine* m_stackless;
         coroutine_self* next_self_;
     };
 }}}}
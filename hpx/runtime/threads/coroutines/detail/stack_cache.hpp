@@ -0,0 +1,66 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_RUNTIME_THREADS_COROUTINES_DETAIL_STACK_CACHE_HPP
+#define HPX_RUNTIME_THREADS_COROUTINES_DETAIL_STACK_CACHE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+// Tiered cache for the stacks of coroutines.
+//
+// Each worker thread owns a small magazine of stacks for each stack size
+// which is accessed without any synchronization. Once a magazine runs empty
+// it is refilled from (or once it is full, half of it is returned to) a depot
+// shared between all worker threads of the same NUMA domain. Depots hold at
+// most a configurable number of stacks, any excess stacks are returned to the
+// operating system. This allows for stacks released by one worker thread to
+// be reused by another one instead of being unmapped and mapped again.
+//
+// The sizes of the tiers are controlled by the configuration settings
+// hpx.stacks.cache_magazine_size and hpx.stacks.cache_depot_size.
+namespace hpx { namespace threads { namespace coroutines { namespace detail
+{
+#if defined(_POSIX_VERSION)
+    // allocate a stack of the given size, try to reuse a cached stack first
+    HPX_EXPORT void* allocate_stack(std::size_t size);
+
+    // release a stack of the given size, it might be cached for later reuse
+    HPX_EXPORT void deallocate_stack(void* stack, std::size_t size);
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Attach a stack magazine to the calling (worker) OS thread for as long
+    // as this object is alive. Threads without a magazine use the depot of
+    // NUMA domain zero directly.
+    class HPX_EXPORT thread_stack_cache
+    {
+        HPX_NON_COPYABLE(thread_stack_cache);
+
+    public:
+        explicit thread_stack_cache(std::size_t numa_domain);
+        ~thread_stack_cache();
+
+    private:
+        bool owns_magazine_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Number of stacks which had to be requested from the operating system
+    HPX_EXPORT std::int64_t get_stack_allocation_count(bool reset);
+
+    // Number of stacks which were given back to the operating system
+    HPX_EXPORT std::int64_t get_stack_deallocation_count(bool reset);
+
+    // Number of stack allocations served from one of the caches
+    HPX_EXPORT std::int64_t get_stack_cache_hit_count(bool reset);
+}}}}
+
+#endif
@@ -55,6 +55,18 @@ namespace hpx { namespace threads { namespace coroutines
     // on a waiting coroutine is undefined behavior.
     class waiting : public exception_base {};
 
+    // This exception is thrown if a coroutine which does not own a stack
+    // (see stackless_coroutine) attempts to suspend itself.
+    class stackless_suspension : public exception_base
+    {
+    public:
+        char const* what() const throw()
+        {
+            return "a thread running without a stack of its own "
+                "(thread_stacksize_nostack) cannot be suspended";
+        }
+    };
+
     class unknown_exception_tag {};
 
     // This exception is thrown on a coroutine invocation
@@ -0,0 +1,169 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_RUNTIME_THREADS_COROUTINES_STACKLESS_COROUTINE_HPP
+#define HPX_RUNTIME_THREADS_COROUTINES_STACKLESS_COROUTINE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/coroutines/coroutine_fwd.hpp>
+#include <hpx/runtime/threads/coroutines/detail/tss.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <boost/intrusive_ptr.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace hpx { namespace threads { namespace coroutines
+{
+    namespace detail
+    {
+        // Stack size used to mark threads which do not have a stack of their
+        // own (see thread_stacksize_nostack).
+        std::ptrdiff_t const nostack_stack_size =
+            (std::numeric_limits<std::ptrdiff_t>::max)();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A coroutine which runs its function to completion directly on the stack
+    // of the calling (scheduling) thread. It does not own a stack and does
+    // not need any context switch, which makes it considerably cheaper than
+    // a coroutine for short tasks. The downside is that it cannot be
+    // suspended, any attempt to do so is reported as an error.
+    class stackless_coroutine
+    {
+        HPX_NON_COPYABLE(stackless_coroutine);
+
+    public:
+        typedef void* thread_id_repr_type;
+        typedef boost::intrusive_ptr<threads::thread_data> thread_id_type;
+
+        typedef std::pair<thread_state_enum, thread_id_type> result_type;
+        typedef thread_state_ex_enum arg_type;
+
+        typedef util::unique_function_nonser<result_type(arg_type)> functor_type;
+
+        stackless_coroutine(functor_type&& f, thread_id_repr_type id)
+          : f_(std::move(f)),
+            running_(false),
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+            phase_(0),
+#endif
+            thread_data_(0),
+            thread_id_(id),
+            continuation_recursion_count_(0)
+        {}
+
+        ~stackless_coroutine()
+        {
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            detail::delete_tss_storage(thread_data_);
+#else
+            thread_data_ = 0;
+#endif
+        }
+
+        thread_id_repr_type get_thread_id() const
+        {
+            return thread_id_;
+        }
+
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+        std::size_t get_thread_phase() const
+        {
+            return phase_;
+        }
+#endif
+
+        std::size_t get_thread_data() const
+        {
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            if (!thread_data_)
+                return 0;
+            return detail::get_tss_thread_data(thread_data_);
+#else
+            return thread_data_;
+#endif
+        }
+
+        std::size_t set_thread_data(std::size_t data)
+        {
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            return detail::set_tss_thread_data(thread_data_, data);
+#else
+            std::size_t olddata = thread_data_;
+            thread_data_ = data;
+            return olddata;
+#endif
+        }
+
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+        detail::tss_storage* get_thread_tss_data(bool create_if_needed) const
+        {
+            if (!thread_data_ && create_if_needed)
+                thread_data_ = detail::create_tss_storage();
+            return thread_data_;
+        }
+#endif
+
+        std::size_t& get_continuation_recursion_count()
+        {
+            return continuation_recursion_count_;
+        }
+
+        void rebind(functor_type&& f, thread_id_repr_type id)
+        {
+            HPX_ASSERT(!running_);
+
+            f_ = std::move(f);
+            thread_id_ = id;
+            continuation_recursion_count_ = 0;
+        }
+
+        void reset()
+        {
+            f_.reset();
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+            phase_ = 0;
+#endif
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+            detail::delete_tss_storage(thread_data_);
+#else
+            thread_data_ = 0;
+#endif
+            thread_id_ = nullptr;
+        }
+
+        bool is_ready() const
+        {
+            return !running_;
+        }
+
+        // Run the bound function on the current stack.
+        HPX_EXPORT result_type operator()(arg_type arg = arg_type());
+
+    private:
+        functor_type f_;
+        bool running_;
+
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+        std::size_t phase_;
+#endif
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+        mutable detail::tss_storage* thread_data_;
+#else
+        mutable std::size_t thread_data_;
+#endif
+
+        thread_id_repr_type thread_id_;
+        std::size_t continuation_recursion_count_;
+    };
+}}}
+
+#endif /*HPX_RUNTIME_THREADS_COROUTINES_STACKLESS_COROUTINE_HPP*/
@@ -0,0 +1,166 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_RUNTIME_THREADS_DETAIL_EVENTCOUNT_HPP
+#define HPX_RUNTIME_THREADS_DETAIL_EVENTCOUNT_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#define HPX_EVENTCOUNT_USE_FUTEX
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The eventcount allows OS threads to block until some condition, which
+    // is checked without holding a lock, becomes true. A waiting thread
+    // announces itself by calling prepare_wait(), re-checks the condition,
+    // and either calls cancel_wait() or blocks in wait_until(). A thread
+    // making the condition true calls notify_one() or notify_all() afterwards,
+    // which is cheap if nobody is waiting.
+    //
+    // The waiting threads block on a futex (on Linux) or on a condition
+    // variable (elsewhere) associated with the epoch counter, notifying
+    // advances the epoch.
+    class eventcount
+    {
+    public:
+        typedef std::uint32_t key_type;
+
+        eventcount()
+          : epoch_(0), waiters_(0)
+        {}
+
+        // Announce that the calling thread is about to wait, the returned key
+        // has to be passed to wait_until().
+        key_type prepare_wait()
+        {
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            return epoch_.load(std::memory_order_seq_cst);
+        }
+
+        // The calling thread does not wait after all.
+        void cancel_wait()
+        {
+            waiters_.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        // Block the calling thread until the eventcount was notified after the
+        // corresponding prepare_wait() or until the given point in time.
+        // Returns false if the wait timed out.
+        bool wait_until(key_type key,
+            util::steady_clock::time_point const& abs_time)
+        {
+            bool notified = true;
+#if defined(HPX_EVENTCOUNT_USE_FUTEX)
+            while (epoch_.load(std::memory_order_acquire) == key)
+            {
+                util::steady_clock::duration rel_time =
+                    abs_time - util::steady_clock::now();
+                if (rel_time <= util::steady_clock::duration::zero())
+                {
+                    notified = false;
+                    break;
+                }
+
+                std::chrono::nanoseconds ns =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        rel_time);
+
+                timespec timeout;
+                timeout.tv_sec = static_cast<time_t>(ns.count() / 1000000000);
+                timeout.tv_nsec = static_cast<long>(ns.count() % 1000000000);
+
+                // spurious wake-ups and interruptions are handled by the loop
+                syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch_),
+                    FUTEX_WAIT_PRIVATE, key, &timeout, nullptr, 0);
+            }
+#else
+            {
+                std::unique_lock<std::mutex> l(mtx_);
+                while (epoch_.load(std::memory_order_acquire) == key)
+                {
+                    if (cond_.wait_until(l, abs_time) ==
+                        std::cv_status::timeout)
+                    {
+                        notified = epoch_.load() != key;
+                        break;
+                    }
+                }
+            }
+#endif
+            waiters_.fetch_sub(1, std::memory_order_seq_cst);
+            return notified;
+        }
+
+        // Wake up one thread waiting on the eventcount, if any.
+        void notify_one()
+        {
+            notify(false);
+        }
+
+        // Wake up all threads waiting on the eventcount.
+        void notify_all()
+        {
+            notify(true);
+        }
+
+    private:
+        HPX_NON_COPYABLE(eventcount);
+
+        void notify(bool all)
+        {
+            // pairs with prepare_wait(), either we see the waiter or the
+            // waiter sees the condition which was made true before
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters_.load(std::memory_order_relaxed) == 0)
+                return;
+
+#if defined(HPX_EVENTCOUNT_USE_FUTEX)
+            epoch_.fetch_add(1, std::memory_order_release);
+            syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch_),
+                FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1, nullptr, nullptr, 0);
+#else
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                epoch_.fetch_add(1, std::memory_order_release);
+            }
+            if (all)
+                cond_.notify_all();
+            else
+                cond_.notify_one();
+#endif
+        }
+
+        static_assert(sizeof(std::atomic<std::uint32_t>) ==
+            sizeof(std::uint32_t), "the epoch has to be usable as a futex");
+
+        std::atomic<std::uint32_t> epoch_;
+        std::atomic<std::uint32_t> waiters_;
+
+#if !defined(HPX_EVENTCOUNT_USE_FUTEX)
+        std::mutex mtx_;
+        std::condition_variable cond_;
+#endif
+    };
+}}}
+
+#undef HPX_EVENTCOUNT_USE_FUTEX
+
+#endif
@@ -11,6 +11,7 @@
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/get_thread_name.hpp>
 #include <hpx/runtime/threads/detail/periodic_maintenance.hpp>
+#include <hpx/runtime/threads/detail/set_thread_state.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/state.hpp>
 #include <hpx/util/assert.hpp>
@@ -30,6 +31,7 @@
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace threads { namespace detail
 {
@@ -330,6 +332,37 @@ namespace hpx { namespace threads { namespace detail
         return background_thread;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Wake up the threads whose timed suspension has expired. An idle worker
+    // thread additionally checks the timer wheels of all other worker
+    // threads, as their owners might be busy running long tasks.
+    template <typename SchedulingPolicy>
+    void expire_timers(SchedulingPolicy& scheduler, std::size_t num_thread,
+        std::vector<thread_id_type>& expired, bool idle = false)
+    {
+        scheduler.get_timer_wheel(num_thread).expire(expired);
+        if (idle)
+        {
+            std::size_t num_wheels = scheduler.get_num_timer_wheels();
+            for (std::size_t i = 1; i != num_wheels; ++i)
+            {
+                scheduler.get_timer_wheel(num_thread + i).expire(
+                    expired, true);
+            }
+        }
+
+        if (expired.empty())
+            return;
+
+        for (thread_id_type const& id : expired)
+        {
+            error_code ec(lightweight);    // do not throw
+            set_thread_state(id, pending, wait_timeout,
+                thread_priority_boost, num_thread, ec);
+        }
+        expired.clear();
+    }
+
     // This function tries to invoke the background work thread. It returns
     // false when we need to give the background thread back to scheduler
     // and create a new one that is supposed to be executed inside the
@@ -427,6 +460,8 @@ namespace hpx { namespace threads { namespace detail
         std::shared_ptr<bool> background_running = nullptr;
         thread_id_type background_thread = nullptr;
 
+        std::vector<thread_id_type> expired_timers;
+
         if ((scheduler.get_scheduler_mode() & policies::do_background_work) &&
             num_thread < params.max_background_threads_ &&
             !params.background_.empty())
@@ -436,6 +471,9 @@ namespace hpx { namespace threads { namespace detail
         }
 
         while (true) {
+            // wake up the threads whose timed suspension has expired
+            detail::expire_timers(scheduler, num_thread, expired_timers);
+
             // Get the next HPX thread from the queue
             thrd = next_thrd;
             bool running = this_state.load(
@@ -633,6 +671,10 @@ namespace hpx { namespace threads { namespace detail
             else {
                 ++idle_loop_count;
 
+                // help with the timers of the other worker threads
+                detail::expire_timers(
+                    scheduler, num_thread, expired_timers, true);
+
                 if (scheduler.SchedulingPolicy::wait_or_add_new(
                         num_thread, running, idle_loop_count))
                 {
@@ -677,6 +719,14 @@ namespace hpx { namespace threads { namespace detail
                 // call back into invoking context
                 if (!params.inner_.empty())
                     params.inner_();
+
+                // park this worker thread if it has been idle for long
+                // enough, it is woken up by new work or its next timer
+                if (!may_exit && next_thrd == nullptr)
+                {
+                    scheduler.SchedulingPolicy::park(
+                        num_thread, idle_loop_count);
+                }
             }
 
             // something went badly wrong, give up
@@ -146,6 +146,7 @@ namespace hpx { namespace threads { namespace detail
         void reset_thread_distribution();
 
         void set_scheduler_mode(threads::policies::scheduler_mode mode);
+        void remove_scheduler_mode(threads::policies::scheduler_mode mode);
 
         //
         void abort_all_suspended_threads();
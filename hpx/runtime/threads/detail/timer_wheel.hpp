@@ -0,0 +1,325 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_HPP
+#define HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/spinlock.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The timer_wheel keeps track of the threads which are suspended until a
+    // point in time. There is one wheel per worker thread of a scheduler, it
+    // is polled by the scheduling loop of this worker thread.
+    //
+    // Time is divided into ticks of 2^tick_shift nanoseconds. The wheel has
+    // num_levels levels of num_slots slots each, a slot on level L covers
+    // num_slots^L ticks. Timers are kept in the slot of the lowest level
+    // which covers their deadline, the slots of the higher levels are
+    // cascaded down to the lower levels as time advances. Timers expiring
+    // beyond the range of the wheel are kept on the highest level and are
+    // re-inserted until their deadline is in range.
+    //
+    // Arming and canceling a timer is O(1), the timer entries are linked
+    // into intrusive lists and are owned by the suspended threads. All
+    // timers of a slot expire at once.
+    class timer_wheel
+    {
+    private:
+        typedef util::spinlock mutex_type;
+
+        static HPX_CONSTEXPR_OR_CONST int tick_shift = 14;      // ~16us
+        static HPX_CONSTEXPR_OR_CONST int level_bits = 6;
+        static HPX_CONSTEXPR_OR_CONST std::size_t num_slots =
+            std::size_t(1) << level_bits;
+        static HPX_CONSTEXPR_OR_CONST std::size_t num_levels = 4;
+
+    public:
+        // A timer armed on the wheel, it has to stay alive until it expired
+        // or was canceled.
+        class entry
+        {
+        public:
+            entry()
+              : deadline_(0), prev_(nullptr), next_(nullptr)
+            {}
+
+        private:
+            friend class timer_wheel;
+
+            HPX_NON_COPYABLE(entry);
+
+            bool is_linked() const { return next_ != nullptr; }
+
+            thread_id_type thrd_;
+            std::int64_t deadline_;         // [ticks]
+            entry* prev_;
+            entry* next_;
+        };
+
+        timer_wheel()
+          : current_tick_(now_ticks()), count_(0)
+        {
+            for (std::size_t l = 0; l != num_levels; ++l)
+            {
+                for (std::size_t i = 0; i != num_slots; ++i)
+                {
+                    entry& head = slots_[l][i];
+                    head.prev_ = head.next_ = &head;
+                }
+            }
+        }
+
+        // Return whether no timers are armed
+        bool empty() const
+        {
+            return count_.load(std::memory_order_relaxed) == 0;
+        }
+
+        // Arm the given timer to expire at the given point in time. The
+        // given thread will be reported as expired afterwards.
+        void arm(entry& e, thread_id_type const& thrd,
+            util::steady_clock::time_point const& abs_time)
+        {
+            HPX_ASSERT(!e.is_linked());
+
+            std::int64_t now = now_ticks();
+
+            // round up, timers never expire early
+            std::int64_t deadline =
+                (std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    abs_time.time_since_epoch()).count() +
+                        (std::int64_t(1) << tick_shift) - 1) >> tick_shift;
+
+            e.thrd_ = thrd;
+
+            std::lock_guard<mutex_type> l(mtx_);
+
+            // the wheel is not advanced while it is empty
+            std::int64_t current =
+                current_tick_.load(std::memory_order_relaxed);
+            if (count_.load(std::memory_order_relaxed) == 0 && current < now)
+            {
+                current = now;
+                current_tick_.store(current, std::memory_order_relaxed);
+            }
+
+            // the slot of the current tick has been processed already
+            e.deadline_ = deadline;
+            insert(e, deadline > current ? deadline : current + 1, current);
+            count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Cancel the given timer, return false if it has expired already.
+        bool cancel(entry& e)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (!e.is_linked())
+                return false;
+
+            unlink(e);
+            count_.fetch_sub(1, std::memory_order_relaxed);
+            e.thrd_.reset();
+            return true;
+        }
+
+        // Advance the wheel up to the current point in time, the threads of
+        // all expired timers are appended to the given vector. Returns the
+        // number of expired timers.
+        std::size_t expire(std::vector<thread_id_type>& expired,
+            bool try_lock = false)
+        {
+            if (empty())
+                return 0;
+
+            std::int64_t now = now_ticks();
+            if (now <= current_tick_.load(std::memory_order_relaxed))
+                return 0;
+
+            std::unique_lock<mutex_type> l(mtx_, std::defer_lock);
+            if (try_lock)
+            {
+                if (!l.try_lock())
+                    return 0;
+            }
+            else
+            {
+                l.lock();
+            }
+
+            std::size_t size = expired.size();
+            std::int64_t current =
+                current_tick_.load(std::memory_order_relaxed);
+            while (current < now &&
+                count_.load(std::memory_order_relaxed) != 0)
+            {
+                std::int64_t tick = ++current;
+                current_tick_.store(tick, std::memory_order_relaxed);
+
+                // cascade the higher levels whose slot boundary was reached,
+                // starting with the highest one
+                std::size_t level = 1;
+                while (level != num_levels &&
+                    (tick & (slot_ticks(level) - 1)) == 0)
+                {
+                    ++level;
+                }
+                while (--level != 0)
+                    cascade(level, tick);
+
+                // all timers in the slot of this tick have expired
+                entry& head = slots_[0][tick & (num_slots - 1)];
+                while (head.next_ != &head)
+                {
+                    entry& e = *head.next_;
+                    HPX_ASSERT(e.deadline_ <= tick);
+
+                    unlink(e);
+                    count_.fetch_sub(1, std::memory_order_relaxed);
+                    expired.push_back(std::move(e.thrd_));
+                }
+            }
+
+            // catch up with the current time if nothing is left to do
+            if (current < now)
+                current_tick_.store(now, std::memory_order_relaxed);
+
+            return expired.size() - size;
+        }
+
+        // Return the earliest point in time at which expire() may find an
+        // expired timer, but not later than the given point in time. The
+        // returned time may be earlier than the deadline of the next timer.
+        util::steady_clock::time_point next_expiry(
+            util::steady_clock::time_point const& latest)
+        {
+            if (empty())
+                return latest;
+
+            std::int64_t tick = 0;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                std::int64_t current =
+                    current_tick_.load(std::memory_order_relaxed);
+
+                // the next cascade may move timers to any slot of level 0
+                tick = current + 1;
+                while ((tick & (num_slots - 1)) != 0)
+                {
+                    entry& head = slots_[0][tick & (num_slots - 1)];
+                    if (head.next_ != &head)
+                        break;
+                    ++tick;
+                }
+            }
+
+            util::steady_clock::time_point next(
+                std::chrono::duration_cast<util::steady_clock::duration>(
+                    std::chrono::nanoseconds(tick << tick_shift)));
+            return next < latest ? next : latest;
+        }
+
+    private:
+        HPX_NON_COPYABLE(timer_wheel);
+
+        // the number of ticks covered by a slot on the given level
+        static std::int64_t slot_ticks(std::size_t level)
+        {
+            return std::int64_t(1) << (level * level_bits);
+        }
+
+        static std::int64_t now_ticks()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                util::steady_clock::now().time_since_epoch()).count() >>
+                    tick_shift;
+        }
+
+        // Link the given timer into the slot covering the given tick, which
+        // must not be earlier than the current tick.
+        void insert(entry& e, std::int64_t tick, std::int64_t current)
+        {
+            HPX_ASSERT(tick >= current);
+
+            std::int64_t delta = tick - current;
+
+            std::size_t level = 0;
+            while (level != num_levels - 1 && delta >= slot_ticks(level + 1))
+                ++level;
+
+            std::size_t index = 0;
+            if (delta < slot_ticks(num_levels))
+            {
+                index = std::size_t(tick >> (level * level_bits)) &
+                    (num_slots - 1);
+            }
+            else
+            {
+                // out of range, use the slot which is cascaded last
+                index = std::size_t(current >> (level * level_bits)) &
+                    (num_slots - 1);
+            }
+
+            entry& head = slots_[level][index];
+            e.prev_ = head.prev_;
+            e.next_ = &head;
+            head.prev_->next_ = &e;
+            head.prev_ = &e;
+        }
+
+        static void unlink(entry& e)
+        {
+            e.prev_->next_ = e.next_;
+            e.next_->prev_ = e.prev_;
+            e.prev_ = e.next_ = nullptr;
+        }
+
+        // Move all timers of the current slot of the given level to the lower
+        // levels.
+        void cascade(std::size_t level, std::int64_t tick)
+        {
+            entry& head = slots_[level]
+                [std::size_t(tick >> (level * level_bits)) & (num_slots - 1)];
+
+            if (head.next_ == &head)
+                return;
+
+            // detach the list of timers from the slot
+            entry list;
+            list.next_ = head.next_;
+            list.prev_ = head.prev_;
+            list.next_->prev_ = &list;
+            list.prev_->next_ = &list;
+            head.prev_ = head.next_ = &head;
+
+            while (list.next_ != &list)
+            {
+                entry& e = *list.next_;
+                unlink(e);
+                insert(e, e.deadline_ > tick ? e.deadline_ : tick, tick);
+            }
+        }
+
+        mutex_type mtx_;
+        std::atomic<std::int64_t> current_tick_;
+        std::atomic<std::size_t> count_;
+        entry slots_[num_levels][num_slots];
+    };
+}}}
+
+#endif
@@ -10,7 +10,11 @@
 
 #include <hpx/config.hpp>
 
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
 #include <hpx/util/lockfree/deque.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
 #include <boost/lockfree/queue.hpp>
 #include <boost/lockfree/stack.hpp>
 
@@ -22,6 +26,7 @@ namespace hpx { namespace threads { namespace policies
 
 struct lockfree_fifo;
 struct lockfree_lifo;
+struct lockfree_chase_lev;
 
 ///////////////////////////////////////////////////////////////////////////////
 template <typename T, typename Queuing>
@@ -81,6 +86,99 @@ struct lockfree_lifo
     };
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Work-stealing deque: LIFO for the owning OS thread, FIFO for thieves.
+//
+// The owner is the OS thread which called bind_owner() (the worker thread
+// the queue belongs to). Its push/pop operations go to the bottom end of a
+// Chase-Lev deque and do not need any atomic read-modify-write operations.
+// All other threads steal from the top end. Items pushed by non-owning
+// threads (e.g. threads woken up from another worker) or pushed to the
+// 'other end' are placed into a separate MPMC inbox which is drained once
+// the deque runs empty.
+namespace detail
+{
+    inline void const* this_os_thread_tag()
+    {
+        static HPX_NATIVE_TLS char tag = 0;
+        return &tag;
+    }
+}
+
+template <typename T>
+struct lockfree_chase_lev_backend
+{
+    typedef hpx::util::lockfree::chase_lev_deque<T> container_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::uint64_t size_type;
+
+    lockfree_chase_lev_backend(
+        size_type initial_size = 0
+      , size_type num_thread = size_type(-1)
+        )
+      : owner_(nullptr)
+      , queue_(std::size_t(initial_size))
+      , inbox_(std::size_t(initial_size))
+    {}
+
+    // make the calling OS thread the owner of the bottom end of this queue
+    void bind_owner()
+    {
+        owner_.store(detail::this_os_thread_tag(), boost::memory_order_release);
+    }
+
+    bool push(const_reference val, bool other_end = false)
+    {
+        if (!other_end && is_owner())
+        {
+            queue_.push_bottom(val);
+            return true;
+        }
+        return inbox_.push(val);
+    }
+
+    bool pop(reference val, bool /*steal*/ = true)
+    {
+        if (is_owner())
+        {
+            if (queue_.pop_bottom(val))
+                return true;
+        }
+        else if (queue_.steal_top(val))
+        {
+            return true;
+        }
+        return inbox_.pop(val);
+    }
+
+    bool empty()
+    {
+        return queue_.empty() && inbox_.empty();
+    }
+
+  private:
+    bool is_owner() const
+    {
+        return owner_.load(boost::memory_order_relaxed) ==
+            detail::this_os_thread_tag();
+    }
+
+    boost::atomic<void const*> owner_;
+    container_type queue_;
+    boost::lockfree::queue<T> inbox_;
+};
+
+struct lockfree_chase_lev
+{
+    template <typename T>
+    struct apply
+    {
+        typedef lockfree_chase_lev_backend<T> type;
+    };
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // FIFO + stealing at opposite end.
 #if defined(HPX_HAVE_ABP_SCHEDULER)
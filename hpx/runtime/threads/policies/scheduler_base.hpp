@@ -11,14 +11,19 @@
 #define HPX_THREADMANAGER_SCHEDULING_SCHEDULER_BASE_JUL_14_2013_1132AM
 
 #include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
 #include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
+#include <hpx/runtime/threads/detail/eventcount.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
 #include <hpx/runtime/threads/policies/affinity_data.hpp>
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/state.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/steady_clock.hpp>
 #include <hpx/util_fwd.hpp>
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
 #include <hpx/runtime/threads/coroutines/detail/tss.hpp>
@@ -67,6 +72,24 @@ namespace hpx { namespace threads { namespace policies
     }
 #endif
 
+    namespace detail
+    {
+        // The state of a worker thread which may park while being idle
+        struct parking_slot
+        {
+            parking_slot()
+              : parked_(false), numa_domain_(0)
+            {}
+
+            threads::detail::eventcount event_;
+            boost::atomic<bool> parked_;
+            std::size_t numa_domain_;
+
+            // avoid false sharing between the slots of different workers
+            char pad_[64];
+        };
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// The scheduler_base defines the interface to be implemented by all
     /// scheduler policies
@@ -87,9 +110,21 @@ namespace hpx { namespace threads { namespace policies
 #endif
           , states_(num_threads)
           , description_(description)
+          , idle_parking_(false)
+          , parking_spin_count_(0)
+          , max_parking_time_(util::steady_clock::duration::zero())
+          , num_parked_(0)
         {
             for (std::size_t i = 0; i != num_threads; ++i)
                 states_[i].store(state_initialized);
+
+            timer_wheels_.resize((std::max)(num_threads, std::size_t(1)));
+            for (auto& wheel : timer_wheels_)
+                wheel.reset(new threads::detail::timer_wheel);
+
+            parking_slots_.resize((std::max)(num_threads, std::size_t(1)));
+            for (auto& slot : parking_slots_)
+                slot.reset(new detail::parking_slot);
         }
 
         virtual ~scheduler_base()
@@ -122,6 +157,10 @@ namespace hpx { namespace threads { namespace policies
         void idle_callback(std::size_t /*num_thread*/)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            // idle worker threads park instead, if enabled
+            if (idle_parking_.load(boost::memory_order_relaxed))
+                return;
+
             // Put this thread to sleep for some time, additionally it gets
             // woken up on new work.
             boost::chrono::milliseconds period(++wait_count_);
@@ -147,6 +186,12 @@ namespace hpx { namespace threads { namespace policies
         /// possibly idling OS threads
         void do_some_work(std::size_t num_thread)
         {
+            if (idle_parking_.load(boost::memory_order_relaxed))
+            {
+                unpark_one(num_thread);
+                return;
+            }
+
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
             wait_count_.store(0, boost::memory_order_release);
 
@@ -157,6 +202,87 @@ namespace hpx { namespace threads { namespace policies
 #endif
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        /// Enable parking of idle worker threads. A worker thread parks after
+        /// \a spin_count idle loop iterations, it is woken up by new work, by
+        /// its next timer, or after \a max_time at the latest.
+        void enable_idle_parking(std::int64_t spin_count,
+            util::steady_clock::duration max_time)
+        {
+            parking_spin_count_ = spin_count;
+            max_parking_time_ = max_time;
+
+            for (std::size_t i = 0; i != parking_slots_.size(); ++i)
+            {
+                error_code ec(lightweight);
+                std::size_t domain =
+                    topology_.get_numa_node_number(get_pu_num(i), ec);
+                parking_slots_[i]->numa_domain_ = ec ? 0 : domain;
+            }
+
+            idle_parking_.store(true);
+        }
+
+        bool is_idle_parking_enabled() const
+        {
+            return idle_parking_.load(boost::memory_order_relaxed);
+        }
+
+        /// This function gets called by an idle worker thread, it blocks the
+        /// worker thread if idle parking is enabled and the worker thread was
+        /// idle for long enough. Returns whether the worker thread was parked.
+        bool park(std::size_t num_thread, std::int64_t idle_loop_count)
+        {
+            if (!idle_parking_.load(boost::memory_order_relaxed) ||
+                idle_loop_count < parking_spin_count_)
+            {
+                return false;
+            }
+
+            HPX_ASSERT(num_thread < parking_slots_.size());
+            detail::parking_slot& slot = *parking_slots_[num_thread];
+
+            // wake up in time for the next timer of this worker thread
+            util::steady_clock::time_point abs_time =
+                get_timer_wheel(num_thread).next_expiry(
+                    util::steady_clock::now() + max_parking_time_);
+
+            slot.parked_.store(true);
+            ++num_parked_;
+
+            threads::detail::eventcount::key_type key =
+                slot.event_.prepare_wait();
+
+            // re-check for work which was added in the meantime, the thread
+            // adding it might have missed that we are about to park
+            if (get_queue_length(std::size_t(-1)) != 0 ||
+                states_[num_thread].load() != state_running)
+            {
+                slot.event_.cancel_wait();
+            }
+            else
+            {
+                slot.event_.wait_until(key, abs_time);
+            }
+
+            --num_parked_;
+            slot.parked_.store(false);
+            return true;
+        }
+
+        /// Wake up all parked worker threads
+        void unpark_all()
+        {
+            if (!idle_parking_.load(boost::memory_order_relaxed))
+                return;
+
+            for (auto& slot : parking_slots_)
+            {
+                slot->parked_.store(false);
+                slot->event_.notify_all();
+            }
+        }
+
         // allow to access/manipulate states
         boost::atomic<hpx::state>& get_state(std::size_t num_thread)
         {
@@ -215,6 +341,18 @@ namespace hpx { namespace threads { namespace policies
             return result;
         }
 
+        // Return the timer wheel keeping track of the threads suspended until
+        // a point in time by the given worker thread.
+        threads::detail::timer_wheel& get_timer_wheel(std::size_t num_thread)
+        {
+            return *timer_wheels_[num_thread % timer_wheels_.size()];
+        }
+
+        std::size_t get_num_timer_wheels() const
+        {
+            return timer_wheels_.size();
+        }
+
         // get/set scheduler mode
         scheduler_mode get_scheduler_mode() const
         {
@@ -307,6 +445,62 @@ namespace hpx { namespace threads { namespace policies
         virtual void reset_thread_distribution() {}
 
     protected:
+        // Wake up the given worker thread if it is parked, returns whether a
+        // parked worker thread was found.
+        bool unpark(std::size_t num_thread)
+        {
+            detail::parking_slot& slot = *parking_slots_[num_thread];
+            if (!slot.parked_.load(boost::memory_order_relaxed) ||
+                !slot.parked_.exchange(false))
+            {
+                return false;
+            }
+
+            slot.event_.notify_one();
+            return true;
+        }
+
+        // Wake up a parked worker thread to run new work which was added to
+        // the queue of the given worker thread. If this worker thread is not
+        // parked, another one (preferably sharing its NUMA domain) is woken
+        // up to steal the work.
+        void unpark_one(std::size_t num_thread)
+        {
+            // pairs with park(), either we see the parked worker thread or
+            // it sees the new work
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            if (num_parked_.load(boost::memory_order_relaxed) == 0)
+                return;
+
+            // if no queue was given, prefer the NUMA domain of the calling
+            // worker thread
+            if (num_thread == std::size_t(-1))
+            {
+                num_thread = hpx::get_worker_thread_num();
+                if (num_thread == std::size_t(-1))
+                    num_thread = 0;
+            }
+
+            std::size_t size = parking_slots_.size();
+            num_thread %= size;
+            if (unpark(num_thread))
+                return;
+
+            std::size_t domain = parking_slots_[num_thread]->numa_domain_;
+            for (std::size_t i = 1; i != size; ++i)
+            {
+                std::size_t n = (num_thread + i) % size;
+                if (parking_slots_[n]->numa_domain_ == domain && unpark(n))
+                    return;
+            }
+            for (std::size_t i = 1; i != size; ++i)
+            {
+                std::size_t n = (num_thread + i) % size;
+                if (parking_slots_[n]->numa_domain_ != domain && unpark(n))
+                    return;
+            }
+        }
+
         topology const& topology_;
         detail::affinity_data affinity_data_;
         boost::atomic<scheduler_mode> mode_;
@@ -321,6 +515,16 @@ namespace hpx { namespace threads { namespace policies
         std::vector<boost::atomic<hpx::state> > states_;
         char const* description_;
 
+        std::vector<std::unique_ptr<threads::detail::timer_wheel> >
+            timer_wheels_;
+
+        // support for parking idle worker threads
+        boost::atomic<bool> idle_parking_;
+        std::int64_t parking_spin_count_;
+        util::steady_clock::duration max_parking_time_;
+        boost::atomic<std::size_t> num_parked_;
+        std::vector<std::unique_ptr<detail::parking_slot> > parking_slots_;
+
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
     public:
         coroutines::detail::tss_data_node* find_tss_data(void const* key)
@@ -0,0 +1,145 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADS_POLICIES_SHARDED_THREAD_MAP_JAN_14_2017_1107AM)
+#define HPX_THREADS_POLICIES_SHARDED_THREAD_MAP_JAN_14_2017_1107AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/util/spinlock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The set of all threads (except depleted ones) managed by a thread_queue.
+    //
+    // The threads are distributed over a fixed number of independently locked
+    // shards based on the address of their thread_data. Registering and
+    // unregistering a thread only locks the shard the thread belongs to,
+    // which allows to create and to recycle threads concurrently without
+    // serializing on the queue's mutex.
+    class sharded_thread_map
+    {
+    private:
+        typedef hpx::util::spinlock mutex_type;
+
+        struct thread_id_hash
+        {
+            std::size_t operator()(thread_id_type const& id) const
+            {
+                return reinterpret_cast<std::size_t>(id.get());
+            }
+        };
+
+        typedef std::unordered_set<thread_id_type, thread_id_hash> map_type;
+
+        // place each shard on a separate cache line
+        struct shard
+        {
+            shard() {}
+
+            mutable mutex_type mtx_;
+            map_type map_;
+
+            char padding_[64];
+        };
+
+        HPX_NON_COPYABLE(sharded_thread_map);
+
+    public:
+        enum { num_shards = 32 };
+
+        sharded_thread_map()
+        {}
+
+        // Add the given thread, returns false if the thread is already known.
+        bool insert(thread_id_type const& id)
+        {
+            shard& s = get_shard(id.get());
+            std::lock_guard<mutex_type> lk(s.mtx_);
+            return s.map_.insert(id).second;
+        }
+
+        // Remove the given thread, hands back the reference held by the map.
+        bool erase(thread_data* thrd, thread_id_type& id)
+        {
+            shard& s = get_shard(thrd);
+
+            std::lock_guard<mutex_type> lk(s.mtx_);
+            map_type::iterator it = s.map_.find(thrd);
+            if (it == s.map_.end())
+                return false;
+
+            id = *it;
+            s.map_.erase(it);
+            return true;
+        }
+
+        bool erase(thread_data* thrd)
+        {
+            thread_id_type id;
+            return erase(thrd, id);
+        }
+
+        bool contains(thread_data* thrd) const
+        {
+            shard const& s = get_shard(thrd);
+            std::lock_guard<mutex_type> lk(s.mtx_);
+            return s.map_.find(thrd) != s.map_.end();
+        }
+
+        // Invoke the given function for all threads, the function is invoked
+        // while the corresponding shard is locked.
+        template <typename F>
+        void for_each(F && f) const
+        {
+            for (shard const& s : shards_)
+            {
+                std::lock_guard<mutex_type> lk(s.mtx_);
+                for (thread_id_type const& id : s.map_)
+                    f(id);
+            }
+        }
+
+        // Return a snapshot of all currently registered threads
+        std::vector<thread_id_type> get_threads(std::size_t count = 0) const
+        {
+            std::vector<thread_id_type> ids;
+            ids.reserve(count);
+            for_each([&ids](thread_id_type const& id) { ids.push_back(id); });
+            return ids;
+        }
+
+    private:
+        static std::size_t get_shard_index(thread_data const* thrd)
+        {
+            // thread_data objects are large, ignore the lower address bits
+            std::size_t v = reinterpret_cast<std::size_t>(thrd);
+            return ((v >> 6) ^ (v >> 12)) % num_shards;
+        }
+
+        shard& get_shard(thread_data const* thrd)
+        {
+            return shards_[get_shard_index(thrd)];
+        }
+
+        shard const& get_shard(thread_data const* thrd) const
+        {
+            return shards_[get_shard_index(thrd)];
+        }
+
+        shard shards_[num_shards];
+    };
+}}}
+
+#endif
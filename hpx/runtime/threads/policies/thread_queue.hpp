@@ -12,14 +12,17 @@
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
 #include <hpx/runtime/threads/policies/queue_helpers.hpp>
+#include <hpx/runtime/threads/policies/sharded_thread_map.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/traits/has_member_xxx.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/block_profiler.hpp>
 #include <hpx/util/function.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/unlock_guard.hpp>
+#include <hpx/util/unused.hpp>
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
 #   include <hpx/util/tick_counter.hpp>
@@ -36,7 +39,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
-#include <unordered_set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -116,6 +119,32 @@ namespace hpx { namespace threads { namespace policies
                     "hpx.thread_queue.max_delete_count", "1000"));
             return max_delete_count;
         }
+
+        inline std::size_t get_max_thread_heap_count()
+        {
+            static std::size_t max_thread_heap_count =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.thread_queue.max_thread_heap_count", "1000"));
+            return max_thread_heap_count;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Some queue back-ends distinguish between the OS thread owning the
+        // queue and all other threads (see lockfree_chase_lev).
+        HPX_HAS_MEMBER_XXX_TRAIT_DEF(bind_owner);
+
+        template <typename Queue>
+        typename std::enable_if<has_bind_owner<Queue>::value>::type
+        bind_queue_owner(Queue& queue)
+        {
+            queue.bind_owner();
+        }
+
+        template <typename Queue>
+        typename std::enable_if<!has_bind_owner<Queue>::value>::type
+        bind_queue_owner(Queue&)
+        {
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -140,6 +169,9 @@ namespace hpx { namespace threads { namespace policies
     //     bool pop(reference val, bool steal = true);
     //
     //     bool empty();
+    //
+    //     // optional, invoked on the OS thread owning the queue
+    //     void bind_owner();
     // };
     //
     // struct queue_policy
@@ -173,8 +205,11 @@ namespace hpx { namespace threads { namespace policies
         // number of terminated threads to discard
         int const max_delete_count;
 
+        // number of terminated threads to keep for reuse (per stack size)
+        std::size_t const max_thread_heap_count;
+
         // this is the type of a map holding all threads (except depleted ones)
-        typedef std::unordered_set<thread_id_type> thread_map_type;
+        typedef sharded_thread_map thread_map_type;
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         typedef
@@ -200,6 +235,39 @@ namespace hpx { namespace threads { namespace policies
             apply<thread_data*>::type terminated_items_type;
 
     protected:
+        // return the list of unused thread objects for the given stack size
+        std::list<thread_id_type>* get_thread_heap(std::ptrdiff_t stacksize)
+        {
+            if (stacksize == get_stack_size(thread_stacksize_small))
+                return &thread_heap_small_;
+            if (stacksize == get_stack_size(thread_stacksize_medium))
+                return &thread_heap_medium_;
+            if (stacksize == get_stack_size(thread_stacksize_large))
+                return &thread_heap_large_;
+            if (stacksize == get_stack_size(thread_stacksize_huge))
+                return &thread_heap_huge_;
+            if (stacksize == coroutines::detail::nostack_stack_size)
+                return &thread_heap_nostack_;
+
+            switch(stacksize) {
+            case thread_stacksize_small:
+                return &thread_heap_small_;
+
+            case thread_stacksize_medium:
+                return &thread_heap_medium_;
+
+            case thread_stacksize_large:
+                return &thread_heap_large_;
+
+            case thread_stacksize_huge:
+                return &thread_heap_huge_;
+
+            default:
+                break;
+            }
+            return nullptr;
+        }
+
         template <typename Lock>
         void create_thread_object(threads::thread_id_type& thrd,
             threads::thread_init_data& data, thread_state_enum state, Lock& lk)
@@ -209,46 +277,7 @@ namespace hpx { namespace threads { namespace policies
 
             std::ptrdiff_t stacksize = data.stacksize;
 
-            std::list<thread_id_type>* heap = nullptr;
-
-            if (stacksize == get_stack_size(thread_stacksize_small))
-            {
-                heap = &thread_heap_small_;
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_medium))
-            {
-                heap = &thread_heap_medium_;
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_large))
-            {
-                heap = &thread_heap_large_;
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_huge))
-            {
-                heap = &thread_heap_huge_;
-            }
-            else {
-                switch(stacksize) {
-                case thread_stacksize_small:
-                    heap = &thread_heap_small_;
-                    break;
-
-                case thread_stacksize_medium:
-                    heap = &thread_heap_medium_;
-                    break;
-
-                case thread_stacksize_large:
-                    heap = &thread_heap_large_;
-                    break;
-
-                case thread_stacksize_huge:
-                    heap = &thread_heap_huge_;
-                    break;
-
-                default:
-                    break;
-                }
-            }
+            std::list<thread_id_type>* heap = get_thread_heap(stacksize);
             HPX_ASSERT(heap);
 
             if (state == pending_do_not_schedule || state == pending_boost)
@@ -310,10 +339,7 @@ namespace hpx { namespace threads { namespace policies
                 delete task;
 
                 // add the new entry to the map of all threads
-                std::pair<thread_map_type::iterator, bool> p =
-                    thread_map_.insert(thrd);
-
-                if (HPX_UNLIKELY(!p.second)) {
+                if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
                     lk.unlock();
                     HPX_THROW_EXCEPTION(hpx::out_of_memory,
                         "threadmanager::add_new",
@@ -332,7 +358,7 @@ namespace hpx { namespace threads { namespace policies
                 }
 
                 // this thread has to be in the map now
-                HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
+                HPX_ASSERT(thread_map_.contains(thrd.get()));
                 HPX_ASSERT(thrd->get_pool() == &memory_pool_);
             }
 
@@ -358,7 +384,8 @@ namespace hpx { namespace threads { namespace policies
             // if we are desperate (no work in the queues), add some even if the
             // map holds more than max_count
             if (HPX_LIKELY(max_count_)) {
-                std::size_t count = thread_map_.size();
+                std::size_t count =
+                    static_cast<std::size_t>(thread_map_count_.load());
                 if (max_count_ >= count + min_add_new_count) { //-V104
                     HPX_ASSERT(max_count_ - count <
                         static_cast<std::size_t>(
@@ -388,46 +415,21 @@ namespace hpx { namespace threads { namespace policies
         {
             std::ptrdiff_t stacksize = thrd->get_stack_size();
 
-            if (stacksize == get_stack_size(thread_stacksize_small))
-            {
-                thread_heap_small_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_medium))
-            {
-                thread_heap_medium_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_large))
-            {
-                thread_heap_large_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_huge))
+            std::list<thread_id_type>* heap = get_thread_heap(stacksize);
+            if (heap == nullptr)
             {
-                thread_heap_huge_.push_front(thrd);
+                HPX_ASSERT(false);
+                return;
             }
-            else
-            {
-                switch(stacksize) {
-                case thread_stacksize_small:
-                    thread_heap_small_.push_front(thrd);
-                    break;
 
-                case thread_stacksize_medium:
-                    thread_heap_medium_.push_front(thrd);
-                    break;
-
-                case thread_stacksize_large:
-                    thread_heap_large_.push_front(thrd);
-                    break;
+            // Do not keep more than the configured number of threads around.
+            // Dropping the last reference destroys the thread, which hands
+            // its stack to the stack cache where it can be picked up by other
+            // queues of the same NUMA domain.
+            if (heap->size() >= max_thread_heap_count)
+                return;
 
-                case thread_stacksize_huge:
-                    thread_heap_huge_.push_front(thrd);
-                    break;
-
-                default:
-                    HPX_ASSERT(false);
-                    break;
-                }
-            }
+            heap->push_front(thrd);
         }
 
     public:
@@ -442,7 +444,7 @@ namespace hpx { namespace threads { namespace policies
             util::tick_counter tc(cleanup_terminated_time_);
 #endif
 
-            if (terminated_items_count_ == 0 && thread_map_.empty())
+            if (terminated_items_count_ == 0 && thread_map_count_ == 0)
                 return true;
 
             if (delete_all) {
@@ -453,9 +455,7 @@ namespace hpx { namespace threads { namespace policies
                     --terminated_items_count_;
 
                     // this thread has to be in this map
-                    HPX_ASSERT(thread_map_.find(todelete) != thread_map_.end());
-
-                    bool deleted = thread_map_.erase(todelete) != 0;
+                    bool deleted = thread_map_.erase(todelete);
                     HPX_ASSERT(deleted);
                     if (deleted) {
                         --thread_map_count_;
@@ -475,14 +475,14 @@ namespace hpx { namespace threads { namespace policies
                 {
                     --terminated_items_count_;
 
-                    thread_map_type::iterator it = thread_map_.find(todelete);
-
                     // this thread has to be in this map
-                    HPX_ASSERT(it != thread_map_.end());
+                    thread_id_type thrd;
+                    bool deleted = thread_map_.erase(todelete, thrd);
+                    HPX_ASSERT(deleted);
+                    HPX_UNUSED(deleted);
 
-                    recycle_thread(*it);
+                    recycle_thread(thrd);
 
-                    thread_map_.erase(it);
                     --thread_map_count_;
                     HPX_ASSERT(thread_map_count_ >= 0);
 
@@ -495,7 +495,7 @@ namespace hpx { namespace threads { namespace policies
         bool cleanup_terminated_locked(bool delete_all = false)
         {
             return cleanup_terminated_locked_helper(delete_all) &&
-                thread_map_.empty();
+                thread_map_count_ == 0;
         }
 
     public:
@@ -539,6 +539,7 @@ namespace hpx { namespace threads { namespace policies
             min_add_new_count(detail::get_min_add_new_count()),
             max_add_new_count(detail::get_max_add_new_count()),
             max_delete_count(detail::get_max_delete_count()),
+            max_thread_heap_count(detail::get_max_thread_heap_count()),
             thread_map_count_(0),
             work_items_(128, queue_num),
             work_items_count_(0),
@@ -562,6 +563,7 @@ namespace hpx { namespace threads { namespace policies
             thread_heap_medium_(),
             thread_heap_large_(),
             thread_heap_huge_(),
+            thread_heap_nostack_(),
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
             add_new_time_(0),
             cleanup_terminated_time_(0),
@@ -716,39 +718,36 @@ namespace hpx { namespace threads { namespace policies
 
                 // The mutex can not be locked while a new thread is getting
                 // created, as it might have that the current HPX thread gets
-                // suspended.
+                // suspended. The mutex protects the thread heaps only, the
+                // map of threads synchronizes itself.
                 {
                     std::unique_lock<mutex_type> lk(mtx_);
-
                     create_thread_object(thrd, data, initial_state, lk);
+                }
 
-                    // add a new entry in the map for this thread
-                    std::pair<thread_map_type::iterator, bool> p =
-                        thread_map_.insert(thrd);
-
-                    if (HPX_UNLIKELY(!p.second)) {
-                        HPX_THROWS_IF(ec, hpx::out_of_memory,
-                            "threadmanager::register_thread",
-                            "Couldn't add new thread to the map of threads");
-                        return;
-                    }
-                    ++thread_map_count_;
+                // add a new entry in the map for this thread
+                if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
+                    HPX_THROWS_IF(ec, hpx::out_of_memory,
+                        "threadmanager::register_thread",
+                        "Couldn't add new thread to the map of threads");
+                    return;
+                }
+                ++thread_map_count_;
 
-                    // this thread has to be in the map now
-                    HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
-                    HPX_ASSERT(thrd->get_pool() == &memory_pool_);
+                // this thread has to be in the map now
+                HPX_ASSERT(thread_map_.contains(thrd.get()));
+                HPX_ASSERT(thrd->get_pool() == &memory_pool_);
 
-                    // push the new thread in the pending queue thread
-                    if (initial_state == pending)
-                        schedule_thread(thrd.get());
+                // push the new thread in the pending queue thread
+                if (initial_state == pending)
+                    schedule_thread(thrd.get());
 
-                    // return the thread_id of the newly created thread
-                    if (id) *id = std::move(thrd);
+                // return the thread_id of the newly created thread
+                if (id) *id = std::move(thrd);
 
-                    if (&ec != &throws)
-                        ec = make_success_code();
-                    return;
-                }
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
             }
 
             // do not execute the work, but register a task description for
@@ -903,32 +902,29 @@ namespace hpx { namespace threads { namespace policies
             if (unknown == state)
                 return thread_map_count_ + new_tasks_count_ - terminated_items_count_;
 
-            // acquire lock only if absolutely necessary
-            std::lock_guard<mutex_type> lk(mtx_);
-
             std::int64_t num_threads = 0;
-            thread_map_type::const_iterator end = thread_map_.end();
-            for (thread_map_type::const_iterator it = thread_map_.begin();
-                 it != end; ++it)
-            {
-                if ((*it)->get_state().state() == state)
-                    ++num_threads;
-            }
+            thread_map_.for_each(
+                [&num_threads, state](thread_id_type const& id)
+                {
+                    if (id->get_state().state() == state)
+                        ++num_threads;
+                });
             return num_threads;
         }
 
         ///////////////////////////////////////////////////////////////////////
         void abort_all_suspended_threads()
         {
-            std::lock_guard<mutex_type> lk(mtx_);
-            thread_map_type::iterator end =  thread_map_.end();
-            for (thread_map_type::iterator it = thread_map_.begin();
-                 it != end; ++it)
+            std::vector<thread_id_type> ids =
+                thread_map_.get_threads(
+                    static_cast<std::size_t>(thread_map_count_.load()));
+
+            for (thread_id_type const& id : ids)
             {
-                if ((*it)->get_state().state() == suspended)
+                if (id->get_state().state() == suspended)
                 {
-                    (*it)->set_state(pending, wait_abort);
-                    schedule_thread((*it).get());
+                    id->set_state(pending, wait_abort);
+                    schedule_thread(id.get());
                 }
             }
         }
@@ -955,24 +951,20 @@ namespace hpx { namespace threads { namespace policies
 
             if (state == unknown)
             {
-                std::lock_guard<mutex_type> lk(mtx_);
-                thread_map_type::const_iterator end =  thread_map_.end();
-                for (thread_map_type::const_iterator it = thread_map_.begin();
-                     it != end; ++it)
-                {
-                    ids.push_back(*it);
-                }
+                thread_map_.for_each(
+                    [&ids](thread_id_type const& id)
+                    {
+                        ids.push_back(id);
+                    });
             }
             else
             {
-                std::lock_guard<mutex_type> lk(mtx_);
-                thread_map_type::const_iterator end =  thread_map_.end();
-                for (thread_map_type::const_iterator it = thread_map_.begin();
-                     it != end; ++it)
-                {
-                    if ((*it)->get_state().state() == state)
-                        ids.push_back(*it);
-                }
+                thread_map_.for_each(
+                    [&ids, state](thread_id_type const& id)
+                    {
+                        if (id->get_state().state() == state)
+                            ids.push_back(id);
+                    });
             }
 
             // now invoke callback function for all matching threads
@@ -1059,8 +1051,9 @@ namespace hpx { namespace threads { namespace policies
             return false;
 #else
             if (minimal_deadlock_detection) {
-                std::lock_guard<mutex_type> lk(mtx_);
-                return detail::dump_suspended_threads(num_thread, thread_map_
+                std::vector<thread_id_type> ids = thread_map_.get_threads(
+                    static_cast<std::size_t>(thread_map_count_.load()));
+                return detail::dump_suspended_threads(num_thread, ids
                   , idle_loop_count, running);
             }
             return false;
@@ -1068,7 +1061,10 @@ namespace hpx { namespace threads { namespace policies
         }
 
         ///////////////////////////////////////////////////////////////////////
-        void on_start_thread(std::size_t num_thread) {}
+        void on_start_thread(std::size_t num_thread)
+        {
+            detail::bind_queue_owner(work_items_);
+        }
         void on_stop_thread(std::size_t num_thread) {}
         void on_error(std::size_t num_thread, boost::exception_ptr const& e) {}
 
@@ -1076,7 +1072,8 @@ namespace hpx { namespace threads { namespace policies
         mutable mutex_type mtx_;                    ///< mutex protecting the members
 
         thread_map_type thread_map_;
-        ///< mapping of thread id's to HPX-threads
+        ///< set of all HPX-threads (except depleted ones), not protected by
+        ///< mtx_
         boost::atomic<std::int64_t> thread_map_count_;
         ///< overall count of work items
 
@@ -1116,6 +1113,7 @@ namespace hpx { namespace threads { namespace policies
         std::list<thread_id_type> thread_heap_medium_;
         std::list<thread_id_type> thread_heap_large_;
         std::list<thread_id_type> thread_heap_huge_;
+        std::list<thread_id_type> thread_heap_nostack_;
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
         std::uint64_t add_new_time_;
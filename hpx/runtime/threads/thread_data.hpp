@@ -12,6 +12,7 @@
 #include <hpx/runtime/get_locality_id.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
 #include <hpx/runtime/threads/coroutines/coroutine.hpp>
+#include <hpx/runtime/threads/coroutines/stackless_coroutine.hpp>
 #include <hpx/runtime/threads/detail/combined_tagged_state.hpp>
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
@@ -506,6 +507,13 @@ namespace hpx { namespace threads
             return pool_;
         }
 
+        /// Return whether this thread runs directly on the stack of the
+        /// scheduling thread (see \a thread_stacksize_nostack).
+        bool is_stackless() const
+        {
+            return stacksize_ == coroutines::detail::nostack_stack_size;
+        }
+
         /// \brief Execute the thread function
         ///
         /// \returns        This function returns the thread state the thread
@@ -514,16 +522,24 @@ namespace hpx { namespace threads
         ///                 thread's scheduling status.
         coroutine_type::result_type operator()()
         {
+            if (is_stackless())
+            {
+                HPX_ASSERT(this == stackless_coroutine_.get_thread_id());
+                return stackless_coroutine_(set_state_ex(wait_signaled));
+            }
+
             HPX_ASSERT(this == coroutine_.get_thread_id());
             return coroutine_(set_state_ex(wait_signaled));
         }
 
         thread_id_type get_thread_id() const
         {
-            HPX_ASSERT(this == coroutine_.get_thread_id());
-            return thread_id_type(
-                    reinterpret_cast<thread_data*>(coroutine_.get_thread_id())
-                );
+            void* id = is_stackless() ?
+                stackless_coroutine_.get_thread_id() :
+                coroutine_.get_thread_id();
+
+            HPX_ASSERT(this == id);
+            return thread_id_type(reinterpret_cast<thread_data*>(id));
         }
 
         std::size_t get_thread_phase() const
@@ -531,17 +547,23 @@ namespace hpx { namespace threads
 #ifndef HPX_HAVE_THREAD_PHASE_INFORMATION
             return 0;
 #else
+            if (is_stackless())
+                return stackless_coroutine_.get_thread_phase();
             return coroutine_.get_thread_phase();
 #endif
         }
 
         std::size_t get_thread_data() const
         {
+            if (is_stackless())
+                return stackless_coroutine_.get_thread_data();
             return coroutine_.get_thread_data();
         }
 
         std::size_t set_thread_data(std::size_t data)
         {
+            if (is_stackless())
+                return stackless_coroutine_.set_thread_data(data);
             return coroutine_.set_thread_data(data);
         }
 
@@ -554,10 +576,17 @@ namespace hpx { namespace threads
 
             rebind_base(init_data, newstate);
 
-            coroutine_.rebind(std::move(init_data.func), this_());
-
             HPX_ASSERT(init_data.stacksize != 0);
-            HPX_ASSERT(coroutine_.is_ready());
+            if (is_stackless())
+            {
+                stackless_coroutine_.rebind(std::move(init_data.func), this_());
+                HPX_ASSERT(stackless_coroutine_.is_ready());
+            }
+            else
+            {
+                coroutine_.rebind(std::move(init_data.func), this_());
+                HPX_ASSERT(coroutine_.is_ready());
+            }
         }
 
         /// This function will be called when the thread is about to be deleted
@@ -595,8 +624,11 @@ namespace hpx { namespace threads
             scheduler_base_(init_data.scheduler_base),
             count_(0),
             stacksize_(init_data.stacksize),
-            coroutine_(std::move(init_data.func),
-                this_(), init_data.stacksize),
+            coroutine_(stacksize_ == coroutines::detail::nostack_stack_size ?
+                coroutine_type() :
+                coroutine_type(std::move(init_data.func),
+                    this_(), init_data.stacksize)),
+            stackless_coroutine_(std::move(init_data.func), this_()),
             pool_(pool)
         {
             LTM_(debug) << "thread::thread(" << this << "), description("
@@ -617,7 +649,8 @@ namespace hpx { namespace threads
                 parent_locality_id_ = get_locality_id();
 #endif
             HPX_ASSERT(init_data.stacksize != 0);
-            HPX_ASSERT(coroutine_.is_ready());
+            HPX_ASSERT(is_stackless() ?
+                stackless_coroutine_.is_ready() : coroutine_.is_ready());
         }
 
     private:
@@ -724,6 +757,7 @@ namespace hpx { namespace threads
         std::ptrdiff_t stacksize_;
 
         coroutine_type coroutine_;
+        coroutines::stackless_coroutine stackless_coroutine_;
         pool_type* pool_;
     };
 
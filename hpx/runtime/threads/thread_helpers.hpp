@@ -444,6 +444,11 @@ namespace hpx { namespace threads
 
     /// Set the new scheduler mode
     HPX_API_EXPORT void set_scheduler_mode(threads::policies::scheduler_mode);
+
+    /// Return the number of threads waiting to be run by the worker thread
+    /// executing the calling HPX-thread (zero if called outside of an
+    /// HPX-thread)
+    HPX_API_EXPORT std::int64_t get_local_queue_length();
     /// \endcond
 }}
 
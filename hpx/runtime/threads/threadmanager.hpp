@@ -214,6 +214,11 @@ namespace hpx { namespace threads
         virtual void reset_thread_distribution() = 0;
 
         virtual void set_scheduler_mode(threads::policies::scheduler_mode m) = 0;
+
+        // Disable the given scheduler modes for all worker threads, this has
+        // to be called before the thread manager is started.
+        virtual void remove_scheduler_mode(
+            threads::policies::scheduler_mode m) = 0;
     };
 }}
 
@@ -291,6 +291,11 @@ namespace hpx { namespace threads
             pool_.set_scheduler_mode(mode);
         }
 
+        void remove_scheduler_mode(threads::policies::scheduler_mode mode)
+        {
+            pool_.remove_scheduler_mode(mode);
+        }
+
         void reset_thread_distribution()
         {
             pool_.reset_thread_distribution();
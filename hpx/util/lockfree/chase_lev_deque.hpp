@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithm from "Dynamic Circular Work-Stealing Deque" by D. Chase and
+//  Y. Lev, using the memory orderings from "Correct and Efficient
+//  Work-Stealing for Weak Memory Models" by N. M. Le, A. Pop, A. Cohen and
+//  F. Zappa Nardelli.
+//
+//  C++ implementation - Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The owning thread pushes and pops at the bottom end of the deque using
+//  plain loads and stores (plus one fence in pop), while any number of
+//  thieves take items from the top end. Only thieves (and the owner when
+//  racing a thief for the very last item) need a compare-and-swap.
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_JAN_12_2017_0412PM)
+#define HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_JAN_12_2017_0412PM
+
+#include <hpx/config.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace hpx { namespace util { namespace lockfree
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Circular array used as the storage of the work-stealing deque. The
+        // capacity is always a power of two to allow for cheap index masking.
+        template <typename T>
+        class chase_lev_array
+        {
+        public:
+            explicit chase_lev_array(std::size_t log_size)
+              : log_size_(log_size),
+                mask_((std::int64_t(1) << log_size) - 1),
+                items_(new boost::atomic<T>[std::size_t(1) << log_size])
+            {}
+
+            ~chase_lev_array()
+            {
+                delete [] items_;
+            }
+
+            std::int64_t size() const
+            {
+                return mask_ + 1;
+            }
+
+            T get(std::int64_t i) const
+            {
+                return items_[i & mask_].load(boost::memory_order_relaxed);
+            }
+
+            void put(std::int64_t i, T val)
+            {
+                items_[i & mask_].store(val, boost::memory_order_relaxed);
+            }
+
+            // create a new array twice as large, holding all items in [t, b)
+            chase_lev_array* grow(std::int64_t b, std::int64_t t) const
+            {
+                chase_lev_array* a = new chase_lev_array(log_size_ + 1);
+                for (std::int64_t i = t; i != b; ++i)
+                    a->put(i, get(i));
+                return a;
+            }
+
+        private:
+            chase_lev_array(chase_lev_array const&);
+            chase_lev_array& operator=(chase_lev_array const&);
+
+            std::size_t log_size_;
+            std::int64_t mask_;
+            boost::atomic<T>* items_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Single-owner, multi-thief work-stealing deque with a growable circular
+    // buffer. push_bottom() and pop_bottom() must only be called by the
+    // owning thread, steal_top() may be called concurrently from any thread.
+    template <typename T>
+    class chase_lev_deque
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "chase_lev_deque supports only trivially copyable value types");
+
+        typedef detail::chase_lev_array<T> array_type;
+
+    public:
+        typedef T value_type;
+
+        explicit chase_lev_deque(std::size_t initial_size = 128)
+          : top_(0), bottom_(0)
+        {
+            std::size_t log_size = 1;
+            while ((std::size_t(1) << log_size) < initial_size)
+                ++log_size;
+            array_.store(new array_type(log_size), boost::memory_order_relaxed);
+        }
+
+        ~chase_lev_deque()
+        {
+            delete array_.load(boost::memory_order_relaxed);
+            for (array_type* a : retired_)
+                delete a;
+        }
+
+        // Owner only: add an item at the bottom end.
+        void push_bottom(T val)
+        {
+            std::int64_t b = bottom_.load(boost::memory_order_relaxed);
+            std::int64_t t = top_.load(boost::memory_order_acquire);
+            array_type* a = array_.load(boost::memory_order_relaxed);
+
+            if (b - t > a->size() - 1)
+            {
+                // Thieves may still be reading from the old buffer, keep it
+                // alive until the deque is destroyed.
+                array_type* new_a = a->grow(b, t);
+                retired_.push_back(a);
+                array_.store(new_a, boost::memory_order_release);
+                a = new_a;
+            }
+
+            a->put(b, val);
+            boost::atomic_thread_fence(boost::memory_order_release);
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+        }
+
+        // Owner only: remove the most recently pushed item.
+        bool pop_bottom(T& val)
+        {
+            std::int64_t b = bottom_.load(boost::memory_order_relaxed) - 1;
+            array_type* a = array_.load(boost::memory_order_relaxed);
+            bottom_.store(b, boost::memory_order_relaxed);
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            std::int64_t t = top_.load(boost::memory_order_relaxed);
+
+            if (t > b)
+            {
+                // deque was empty
+                bottom_.store(b + 1, boost::memory_order_relaxed);
+                return false;
+            }
+
+            val = a->get(b);
+            if (t != b)
+                return true;        // more than one item left, no race
+
+            // this is the last item, compete with the thieves for it
+            bool result = top_.compare_exchange_strong(t, t + 1,
+                boost::memory_order_seq_cst, boost::memory_order_relaxed);
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return result;
+        }
+
+        // Any thread: remove the least recently pushed item. This may fail
+        // spuriously if another thread concurrently took the same item.
+        bool steal_top(T& val)
+        {
+            std::int64_t t = top_.load(boost::memory_order_acquire);
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            std::int64_t b = bottom_.load(boost::memory_order_acquire);
+
+            if (t >= b)
+                return false;
+
+            array_type* a = array_.load(boost::memory_order_acquire);
+            val = a->get(t);
+            return top_.compare_exchange_strong(t, t + 1,
+                boost::memory_order_seq_cst, boost::memory_order_relaxed);
+        }
+
+        bool empty() const
+        {
+            std::int64_t b = bottom_.load(boost::memory_order_relaxed);
+            std::int64_t t = top_.load(boost::memory_order_relaxed);
+            return b <= t;
+        }
+
+        std::int64_t size() const
+        {
+            std::int64_t b = bottom_.load(boost::memory_order_relaxed);
+            std::int64_t t = top_.load(boost::memory_order_relaxed);
+            return b > t ? b - t : 0;
+        }
+
+    private:
+        chase_lev_deque(chase_lev_deque const&);
+        chase_lev_deque& operator=(chase_lev_deque const&);
+
+        // keep top and bottom on separate cache lines, top is written by the
+        // thieves while bottom is written by the owner only
+        boost::atomic<std::int64_t> top_;
+        char pad0_[64 - sizeof(boost::atomic<std::int64_t>)];
+        boost::atomic<std::int64_t> bottom_;
+        boost::atomic<array_type*> array_;
+        char pad1_[64 - sizeof(boost::atomic<std::int64_t>) -
+            sizeof(boost::atomic<array_type*>)];
+
+        std::vector<array_type*> retired_;  // owner only
+    };
+}}}
+
+#endif
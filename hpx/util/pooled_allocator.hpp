@@ -0,0 +1,82 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_UTIL_POOLED_ALLOCATOR_HPP
+#define HPX_UTIL_POOLED_ALLOCATOR_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <new>
+
+namespace hpx { namespace util
+{
+    namespace detail
+    {
+        // Allocate and release memory blocks of the given size using a free
+        // list cache associated with the calling worker thread. Blocks which
+        // are too large for the cache, or which are requested from outside of
+        // a worker thread, are served by the global heap.
+        HPX_API_EXPORT void* pooled_allocate(std::size_t size);
+        HPX_API_EXPORT void pooled_deallocate(void* p, std::size_t size)
+            HPX_NOEXCEPT;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Stateless allocator which recycles small memory blocks through per
+    /// worker thread caches. It is used by default for the shared states of
+    /// the futures created by \a hpx::async, \a hpx::dataflow and
+    /// \a future::then, which are typically very short lived. Memory
+    /// allocated by one worker thread may be released by any other thread.
+    template <typename T>
+    class pooled_allocator
+    {
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef T const* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef pooled_allocator<U> other;
+        };
+
+        pooled_allocator() HPX_NOEXCEPT {}
+
+        template <typename U>
+        pooled_allocator(pooled_allocator<U> const&) HPX_NOEXCEPT {}
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(detail::pooled_allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) HPX_NOEXCEPT
+        {
+            detail::pooled_deallocate(p, n * sizeof(T));
+        }
+    };
+
+    template <typename T, typename U>
+    HPX_CONSTEXPR bool operator==(pooled_allocator<T> const&,
+        pooled_allocator<U> const&) HPX_NOEXCEPT
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    HPX_CONSTEXPR bool operator!=(pooled_allocator<T> const&,
+        pooled_allocator<U> const&) HPX_NOEXCEPT
+    {
+        return false;
+    }
+}}
+
+#endif
@@ -0,0 +1,63 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+
+#include <hpx/plugins/plugin_registry.hpp>
+#include <hpx/plugins/binary_filter_factory.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <boost/format.hpp>
+
+#include <cstddef>
+
+#include <lz4.h>
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_PLUGIN_MODULE();
+HPX_REGISTER_BINARY_FILTER_FACTORY(
+    hpx::plugins::compression::lz4_serialization_filter,
+    lz4_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    std::size_t lz4_serialization_filter::max_compressed_length(
+        std::size_t size) const
+    {
+        return static_cast<std::size_t>(
+            LZ4_compressBound(static_cast<int>(size)));
+    }
+
+    std::size_t lz4_serialization_filter::compress_block(char const* src,
+        std::size_t size, char* dst, std::size_t dst_size) const
+    {
+        // a result of zero signals a failure, the block will be stored
+        // uncompressed
+        int compressed_size = LZ4_compress_default(src, dst,
+            static_cast<int>(size), static_cast<int>(dst_size));
+        return compressed_size > 0 ?
+            static_cast<std::size_t>(compressed_size) : 0;
+    }
+
+    void lz4_serialization_filter::decompress_block(char const* src,
+        std::size_t size, char* dst, std::size_t dst_size) const
+    {
+        int decompressed_size = LZ4_decompress_safe(src, dst,
+            static_cast<int>(size), static_cast<int>(dst_size));
+
+        if (decompressed_size < 0 ||
+            static_cast<std::size_t>(decompressed_size) != dst_size)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "lz4_serialization_filter::decompress_block",
+                boost::str(boost::format("decompression failure, number of "
+                    "bytes expected: %d, number of bytes decoded: %d") %
+                        dst_size % decompressed_size));
+        }
+    }
+}}}
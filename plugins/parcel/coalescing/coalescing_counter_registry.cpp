@@ -34,7 +34,9 @@ namespace hpx { namespace plugins { namespace parcel
         get_counter_type num_parcels, get_counter_type num_messages,
         get_counter_type num_parcels_per_message,
         get_counter_type average_time_between_parcels,
-        get_counter_values_creator_type time_between_parcels_histogram_creator)
+        get_counter_values_creator_type time_between_parcels_histogram_creator,
+        get_counter_type average_message_latency,
+        get_counter_type flush_deadline)
     {
         if (name.empty())
         {
@@ -53,7 +55,8 @@ namespace hpx { namespace plugins { namespace parcel
                 num_parcels, num_messages,
                 num_parcels_per_message, average_time_between_parcels,
                 time_between_parcels_histogram_creator,
-                0, 0, 1
+                0, 0, 1,
+                average_message_latency, flush_deadline
             };
 
             map_.emplace(name, std::move(data));
@@ -68,6 +71,8 @@ namespace hpx { namespace plugins { namespace parcel
                 average_time_between_parcels;
             (*it).second.time_between_parcels_histogram_creator =
                 time_between_parcels_histogram_creator;
+            (*it).second.average_message_latency = average_message_latency;
+            (*it).second.flush_deadline = flush_deadline;
 
             if ((*it).second.min_boundary != (*it).second.max_boundary)
             {
@@ -172,6 +177,43 @@ namespace hpx { namespace plugins { namespace parcel
         return (*it).second.average_time_between_parcels;
     }
 
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_average_message_latency_counter(
+            std::string const& name) const
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            l.unlock();
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::"
+                    "get_average_message_latency_counter",
+                "unknown action type");
+            return get_counter_type();
+        }
+        return (*it).second.average_message_latency;
+    }
+
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_flush_deadline_counter(
+            std::string const& name) const
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            l.unlock();
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::get_flush_deadline_counter",
+                "unknown action type");
+            return get_counter_type();
+        }
+        return (*it).second.flush_deadline;
+    }
+
     coalescing_counter_registry::get_counter_values_type
         coalescing_counter_registry::get_time_between_parcels_histogram_counter(
             std::string const& name, std::int64_t min_boundary,
@@ -8,7 +8,10 @@
 #if defined(HPX_HAVE_PARCEL_COALESCING)
 #include <hpx/traits/plugin_config_data.hpp>
 #include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/util/unlock_guard.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
@@ -22,6 +25,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/accumulators/accumulators.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -40,6 +45,8 @@ namespace hpx { namespace traits
     //      ...
     //      num_messages = 50
     //      interval = 100
+    //      allow_background_flush = 1
+    //      adaptive = 0
     //
     template <>
     struct plugin_config_data<hpx::plugins::parcel::coalescing_message_handler>
@@ -48,7 +55,8 @@ namespace hpx { namespace traits
         {
             return "num_messages = 50\n"
                    "interval = 100\n"
-                   "allow_background_flush = 1";
+                   "allow_background_flush = 1\n"
+                   "adaptive = 0";
         }
     };
 }}
@@ -84,8 +92,74 @@ namespace hpx { namespace plugins { namespace parcel
                 "1");
             return !value.empty() && value[0] != '0';
         }
+
+        bool get_adaptive()
+        {
+            std::string value = hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.adaptive", "0");
+            return !value.empty() && value[0] != '0';
+        }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    struct coalescing_message_handler::tuning_data
+    {
+        explicit tuning_data(std::size_t interval)
+          : average_message_latency_(0),
+            max_interval_(interval),
+            flush_deadline_(interval)
+        {}
+
+        // Account for the time it took to send a message. Updates racing with
+        // each other may get lost, which is fine for an estimate.
+        void update(std::int64_t latency)
+        {
+            std::int64_t average =
+                average_message_latency_.load(std::memory_order_relaxed);
+            if (average != 0)
+                average += (latency - average) / 8;
+            else
+                average = latency;
+            average_message_latency_.store(average, std::memory_order_relaxed);
+
+            // Holding back parcels for much longer than it takes to get a
+            // message out gains little, the deadline follows twice the
+            // observed latency bounded by the configured interval.
+            std::size_t deadline = std::size_t(2 * average / 1000);
+            std::size_t max_interval =
+                max_interval_.load(std::memory_order_relaxed);
+            if (deadline > max_interval)
+                deadline = max_interval;
+            if (deadline == 0)
+                deadline = 1;
+            flush_deadline_.store(deadline, std::memory_order_relaxed);
+        }
+
+        std::atomic<std::int64_t> average_message_latency_;     // [ns]
+        std::atomic<std::size_t> max_interval_;                 // [us]
+        std::atomic<std::size_t> flush_deadline_;               // [us]
+    };
+
+    // Write handler measuring the time it took to send a message
+    struct coalescing_message_handler::measure_message_latency
+    {
+        void operator()(boost::system::error_code const& ec,
+            parcelset::parcel const& p)
+        {
+            if (!ec)
+            {
+                tuning_->update(
+                    util::high_resolution_clock::now() - started_at_);
+            }
+            if (!f_.empty())
+                f_(ec, p);
+        }
+
+        std::shared_ptr<tuning_data> tuning_;
+        std::int64_t started_at_;
+        write_handler_type f_;
+    };
+
     void coalescing_message_handler::update_num_messages()
     {
         std::lock_guard<mutex_type> l(mtx_);
@@ -97,6 +171,7 @@ namespace hpx { namespace plugins { namespace parcel
     {
         std::lock_guard<mutex_type> l(mtx_);
         interval_ = detail::get_interval(interval_);
+        tuning_->max_interval_ = interval_.load();
     }
 
     coalescing_message_handler::coalescing_message_handler(
@@ -112,7 +187,12 @@ namespace hpx { namespace plugins { namespace parcel
             std::string(action_name) + "_timer"),
         stopped_(false),
         allow_background_flush_(detail::get_background_flush()),
+        adaptive_(detail::get_adaptive()),
         action_name_(action_name),
+        staging_(adaptive_ ? hpx::get_os_thread_count() : 0),
+        tuning_(std::make_shared<tuning_data>(interval_.load())),
+        busy_(false),
+        next_busy_check_(0),
         num_parcels_(0), reset_num_parcels_(0),
             reset_num_parcels_per_message_parcels_(0),
         num_messages_(0), reset_num_messages_(0),
@@ -120,6 +200,7 @@ namespace hpx { namespace plugins { namespace parcel
         started_at_(util::high_resolution_clock::now()),
         reset_time_num_parcels_(0),
         last_parcel_time_(started_at_),
+        collect_time_between_parcels_(false),
         histogram_min_boundary_(-1),
         histogram_max_boundary_(-1),
         histogram_num_buckets_(-1)
@@ -137,7 +218,11 @@ namespace hpx { namespace plugins { namespace parcel
             util::bind(&coalescing_message_handler::
                 get_average_time_between_parcels, this, _1),
             util::bind(&coalescing_message_handler::
-                get_time_between_parcels_histogram_creator, this, _1, _2, _3, _4));
+                get_time_between_parcels_histogram_creator, this, _1, _2, _3, _4),
+            util::bind(&coalescing_message_handler::
+                get_average_message_latency, this, _1),
+            util::bind(&coalescing_message_handler::
+                get_flush_deadline, this, _1));
 
         // register parameter update callbacks
         set_config_entry_callback(
@@ -152,6 +237,12 @@ namespace hpx { namespace plugins { namespace parcel
         parcelset::locality const& dest, parcelset::parcel p,
         write_handler_type f)
     {
+        if (adaptive_)
+        {
+            put_parcel_adaptive(dest, std::move(p), std::move(f));
+            return;
+        }
+
         std::unique_lock<mutex_type> l(mtx_);
         ++num_parcels_;
 
@@ -173,11 +264,10 @@ namespace hpx { namespace plugins { namespace parcel
                 std::chrono::nanoseconds(time_since_last_parcel) > interval
            ))
         {
-            ++num_messages_;
             l.unlock();
 
             // this instance should not buffer parcels anymore
-            pp_->put_parcel(dest, std::move(p), std::move(f));
+            send_message(dest, std::move(p), std::move(f));
             return;
         }
 
@@ -215,8 +305,188 @@ namespace hpx { namespace plugins { namespace parcel
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // In adaptive mode the parcels are staged per worker thread. The number of
+    // parcels sent in one message follows the rate at which the thread
+    // generates parcels, the deadline for flushing the staged parcels follows
+    // the time it takes to send a message (see tuning_data::update).
+    void coalescing_message_handler::put_parcel_adaptive(
+        parcelset::locality const& dest, parcelset::parcel p,
+        write_handler_type f)
+    {
+        ++num_parcels_;
+
+        std::int64_t parcel_time = util::high_resolution_clock::now();
+
+        // collect data for time between parcels histogram
+        if (collect_time_between_parcels_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (time_between_parcels_)
+                (*time_between_parcels_)(parcel_time - last_parcel_time_);
+            last_parcel_time_ = parcel_time;
+        }
+
+        HPX_ASSERT(!staging_.empty());
+        staging_buffer& staged =
+            staging_[hpx::get_worker_thread_num() % staging_.size()];
+
+        std::unique_lock<mutex_type> l(staged.mtx_);
+
+        // update the average time between parcels staged by this thread, long
+        // pauses are capped to react quickly when parcels arrive faster again
+        std::int64_t time_between_parcels = (std::min)(
+            parcel_time - staged.last_parcel_time_,
+            std::int64_t(2000 * interval_.load(std::memory_order_relaxed)));
+        staged.last_parcel_time_ = parcel_time;
+
+        std::int64_t& average = staged.average_time_between_parcels_;
+        if (average != 0)
+            average += (time_between_parcels - average) / 4;
+        else
+            average = time_between_parcels;
+
+        std::size_t batch_size = get_batch_size(average);
+
+        // just send the parcel if the coalescing was stopped or if no other
+        // parcels are expected to arrive before the flush deadline expires
+        if (stopped_ || (batch_size <= 1 && staged.buffer_.empty()))
+        {
+            l.unlock();
+            send_message(dest, std::move(p), std::move(f));
+            return;
+        }
+
+        detail::message_buffer::message_buffer_append_state s =
+            staged.buffer_.append(dest, std::move(p), std::move(f));
+
+        if (staged.buffer_.size() >= batch_size)
+        {
+            detail::message_buffer buff(batch_size);
+            std::swap(buff, staged.buffer_);
+            l.unlock();
+
+            send_message(buff);
+            return;
+        }
+        l.unlock();
+
+        // start deadline timer to flush the staged parcels, the timer flushes
+        // the parcels staged by all threads
+        if (s == detail::message_buffer::first_message)
+        {
+            timer_.start(std::chrono::microseconds(
+                tuning_->flush_deadline_.load(std::memory_order_relaxed)));
+        }
+    }
+
+    // Return the number of parcels which are expected to be staged by a
+    // thread before the flush deadline expires.
+    std::size_t coalescing_message_handler::get_batch_size(
+        std::int64_t time_between_parcels) const
+    {
+        std::size_t max_batch_size =
+            num_coalesced_parcels_.load(std::memory_order_relaxed);
+        if (time_between_parcels <= 0)
+            return max_batch_size;
+
+        std::int64_t deadline = 1000 * std::int64_t(
+            tuning_->flush_deadline_.load(std::memory_order_relaxed));
+        std::size_t batch_size =
+            std::size_t(deadline / time_between_parcels);
+
+        return (std::min)(batch_size, max_batch_size);
+    }
+
+    bool coalescing_message_handler::flush_staged(
+        parcelset::policies::message_handler::flush_mode mode,
+        bool stop_buffering)
+    {
+        // Background work is performed while the locality is idle and every
+        // so often while it is busy. Staged parcels are sent right away if
+        // there is no other work left, otherwise they are given the chance
+        // to fill up the batch. Counting the pending threads walks all queues
+        // of the scheduler, so this is done at most four times per flush
+        // deadline. The deadline timer sends the parcels in any case.
+        if (mode ==
+                parcelset::policies::message_handler::flush_mode_background_work &&
+            !stop_buffering)
+        {
+            std::int64_t now = util::high_resolution_clock::now();
+            if (now >= next_busy_check_.load(std::memory_order_relaxed))
+            {
+                next_busy_check_.store(now + 250 * std::int64_t(
+                        tuning_->flush_deadline_.load(
+                            std::memory_order_relaxed)),
+                    std::memory_order_relaxed);
+                busy_.store(threads::get_thread_count(threads::pending) != 0,
+                    std::memory_order_relaxed);
+            }
+
+            if (busy_.load(std::memory_order_relaxed))
+                return false;
+        }
+
+        if (stop_buffering && !stopped_.exchange(true))
+            timer_.stop();              // interrupt timer
+
+        bool did_some_work = false;
+        for (staging_buffer& staged : staging_)
+        {
+            detail::message_buffer buff;
+            {
+                std::lock_guard<mutex_type> l(staged.mtx_);
+                if (staged.buffer_.empty())
+                    continue;
+                std::swap(buff, staged.buffer_);
+            }
+
+            send_message(buff);
+            did_some_work = true;
+        }
+        return did_some_work;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void coalescing_message_handler::send_message(
+        parcelset::locality const& dest, parcelset::parcel p,
+        write_handler_type f)
+    {
+        ++num_messages_;
+
+        measure_message_latency measure = {
+            tuning_, std::int64_t(util::high_resolution_clock::now()),
+            std::move(f)
+        };
+        pp_->put_parcel(dest, std::move(p), std::move(measure));
+    }
+
+    void coalescing_message_handler::send_message(
+        detail::message_buffer& buff)
+    {
+        ++num_messages_;
+
+        write_handler_type& f = buff.last_handler();
+        measure_message_latency measure = {
+            tuning_, std::int64_t(util::high_resolution_clock::now()),
+            std::move(f)
+        };
+        f = std::move(measure);
+
+        HPX_ASSERT(nullptr != pp_);
+        buff(pp_);                   // 'invoke' the buffer
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
     bool coalescing_message_handler::timer_flush()
     {
+        if (adaptive_)
+        {
+            flush_staged(
+                parcelset::policies::message_handler::flush_mode_timer, false);
+            return false;
+        }
+
         // adjust timer if needed
         std::unique_lock<mutex_type> l(mtx_);
         if (!buffer_.empty())
@@ -234,12 +504,23 @@ namespace hpx { namespace plugins { namespace parcel
         parcelset::policies::message_handler::flush_mode mode,
         bool stop_buffering)
     {
+        if (adaptive_)
+            return flush_staged(mode, stop_buffering);
+
         std::unique_lock<mutex_type> l(mtx_);
         return flush_locked(l, mode, stop_buffering, true);
     }
 
     void coalescing_message_handler::flush_terminate()
     {
+        if (adaptive_)
+        {
+            stopped_ = true;
+            flush_staged(
+                parcelset::policies::message_handler::flush_mode_timer, false);
+            return;
+        }
+
         std::unique_lock<mutex_type> l(mtx_);
         flush_locked(l, parcelset::policies::message_handler::flush_mode_timer,
             true, true);
@@ -278,13 +559,9 @@ namespace hpx { namespace plugins { namespace parcel
 
         detail::message_buffer buff (num_coalesced_parcels_);
         std::swap(buff, buffer_);
-
-        ++num_messages_;
         l.unlock();
 
-        HPX_ASSERT(nullptr != pp_);
-        buff(pp_);                   // 'invoke' the buffer
-
+        send_message(buff);
         return true;
     }
 
@@ -319,6 +596,19 @@ namespace hpx { namespace plugins { namespace parcel
         return value;
     }
 
+    std::int64_t
+    coalescing_message_handler::get_average_message_latency(bool /*reset*/)
+    {
+        return tuning_->average_message_latency_.load();
+    }
+
+    std::int64_t coalescing_message_handler::get_flush_deadline(bool /*reset*/)
+    {
+        if (!adaptive_)
+            return 1000 * std::int64_t(interval_.load());
+        return 1000 * std::int64_t(tuning_->flush_deadline_.load());
+    }
+
     std::int64_t coalescing_message_handler::get_parcels_count(bool reset)
     {
         std::unique_lock<mutex_type> l(mtx_);
@@ -423,6 +713,7 @@ namespace hpx { namespace plugins { namespace parcel
             hpx::util::tag::histogram::min_range = double(min_boundary),
             hpx::util::tag::histogram::max_range = double(max_boundary)));
         last_parcel_time_ = util::high_resolution_clock::now();
+        collect_time_between_parcels_ = true;
 
         result = util::bind(&coalescing_message_handler::
             get_time_between_parcels_histogram, this, util::placeholders::_1);
@@ -371,6 +371,160 @@ namespace hpx { namespace plugins { namespace parcel
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    struct average_message_latency_counter_surrogate
+    {
+        average_message_latency_counter_surrogate(std::string const& parameters)
+          : parameters_(parameters)
+        {}
+
+        std::int64_t operator()(bool reset)
+        {
+            if (counter_.empty())
+            {
+                counter_ = coalescing_counter_registry::instance().
+                    get_average_message_latency_counter(parameters_);
+                if (counter_.empty())
+                    return 0;           // no counter available yet
+            }
+
+            // dispatch to actual counter
+            return counter_(reset);
+        }
+
+        hpx::util::function_nonser<std::int64_t(bool)> counter_;
+        std::string parameters_;
+    };
+
+    hpx::naming::gid_type average_message_latency_counter_creator(
+        hpx::performance_counters::counter_info const& info, hpx::error_code& ec)
+    {
+        switch (info.type_) {
+        case performance_counters::counter_raw:
+            {
+                performance_counters::counter_path_elements paths;
+                performance_counters::get_counter_path_elements(
+                    info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "average_message_latency_counter_creator",
+                        "invalid counter name for message latency (instance "
+                        "name must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "average_message_latency_counter_creator",
+                        "invalid counter parameter for message latency: must "
+                        "specify an action type");
+                    return naming::invalid_gid;
+                }
+
+                // ask registry
+                hpx::util::function_nonser<std::int64_t(bool)> f =
+                    coalescing_counter_registry::instance().
+                        get_average_message_latency_counter(paths.parameters_);
+
+                if (!f.empty())
+                {
+                    return performance_counters::detail::create_raw_counter(
+                        info, std::move(f), ec);
+                }
+
+                // the counter is not available yet, create surrogate function
+                return performance_counters::detail::create_raw_counter(info,
+                    average_message_latency_counter_surrogate(paths.parameters_), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "average_message_latency_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct flush_deadline_counter_surrogate
+    {
+        flush_deadline_counter_surrogate(std::string const& parameters)
+          : parameters_(parameters)
+        {}
+
+        std::int64_t operator()(bool reset)
+        {
+            if (counter_.empty())
+            {
+                counter_ = coalescing_counter_registry::instance().
+                    get_flush_deadline_counter(parameters_);
+                if (counter_.empty())
+                    return 0;           // no counter available yet
+            }
+
+            // dispatch to actual counter
+            return counter_(reset);
+        }
+
+        hpx::util::function_nonser<std::int64_t(bool)> counter_;
+        std::string parameters_;
+    };
+
+    hpx::naming::gid_type flush_deadline_counter_creator(
+        hpx::performance_counters::counter_info const& info, hpx::error_code& ec)
+    {
+        switch (info.type_) {
+        case performance_counters::counter_raw:
+            {
+                performance_counters::counter_path_elements paths;
+                performance_counters::get_counter_path_elements(
+                    info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "flush_deadline_counter_creator",
+                        "invalid counter name for flush deadline (instance "
+                        "name must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "flush_deadline_counter_creator",
+                        "invalid counter parameter for flush deadline: must "
+                        "specify an action type");
+                    return naming::invalid_gid;
+                }
+
+                // ask registry
+                hpx::util::function_nonser<std::int64_t(bool)> f =
+                    coalescing_counter_registry::instance().
+                        get_flush_deadline_counter(paths.parameters_);
+
+                if (!f.empty())
+                {
+                    return performance_counters::detail::create_raw_counter(
+                        info, std::move(f), ec);
+                }
+
+                // the counter is not available yet, create surrogate function
+                return performance_counters::detail::create_raw_counter(info,
+                    flush_deadline_counter_surrogate(paths.parameters_), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "flush_deadline_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     struct time_between_parcels_histogram_counter_surrogate
     {
@@ -558,6 +712,26 @@ namespace hpx { namespace plugins { namespace parcel
               &time_between_parcels_histogram_counter_creator,
               &counter_discoverer,
               "ns/0.1%"
+            },
+            // /coalescing(...)/time/message-latency-average@action-name
+            { "/coalescing/time/message-latency-average", counter_raw,
+              "returns the average time it takes to send a message generated "
+              "by the message handler associated with the action which is "
+              "given by the counter parameter",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &average_message_latency_counter_creator,
+              &counter_discoverer,
+              "ns"
+            },
+            // /coalescing(...)/time/flush-deadline@action-name
+            { "/coalescing/time/flush-deadline", counter_raw,
+              "returns the current time after which the parcels buffered by "
+              "the message handler associated with the action which is given "
+              "by the counter parameter are sent",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &flush_deadline_counter_creator,
+              &counter_discoverer,
+              "ns"
             }
         };
 
@@ -0,0 +1,295 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_IPC)
+#include <hpx/traits/plugin_config_data.hpp>
+
+#include <hpx/plugins/parcelport_factory.hpp>
+#include <hpx/util/command_line_handling.hpp>
+
+// parcelport
+#include <hpx/runtime.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_impl.hpp>
+
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <hpx/plugins/parcelport/ipc/locality.hpp>
+#include <hpx/plugins/parcelport/ipc/receiver.hpp>
+#include <hpx/plugins/parcelport/ipc/sender.hpp>
+#include <hpx/plugins/parcelport/ipc/shared_memory.hpp>
+
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+#include <boost/atomic.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/preprocessor/stringize.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <unistd.h>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx
+{
+    bool is_starting();
+}
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace ipc
+    {
+        class HPX_EXPORT parcelport;
+    }}
+
+    template <>
+    struct connection_handler_traits<policies::ipc::parcelport>
+    {
+        typedef policies::ipc::sender_connection connection_type;
+        typedef std::false_type send_early_parcel;
+        typedef std::true_type  do_background_work;
+        typedef std::false_type send_immediate_parcels;
+
+        static const char * type()
+        {
+            return "ipc";
+        }
+
+        static const char * pool_name()
+        {
+            return "parcel-pool-ipc";
+        }
+
+        static const char * pool_name_postfix()
+        {
+            return "-ipc";
+        }
+    };
+
+    namespace policies { namespace ipc
+    {
+        std::uint64_t next_segment_id(sender * s)
+        {
+            return s->next_segment_id();
+        }
+
+        void add_connection(sender * s, std::shared_ptr<sender_connection> const &ptr)
+        {
+            s->add(ptr);
+        }
+
+        // This parcelport is used to communicate with localities running on
+        // the same node only. Each locality creates a ring buffer in a POSIX
+        // shared memory segment which is used by all other localities on the
+        // same node to deliver messages. This parcelport cannot be used for
+        // bootstrapping, the localities exchange their ring buffer names
+        // through AGAS.
+        class HPX_EXPORT parcelport
+          : public parcelport_impl<parcelport>
+        {
+            typedef parcelport_impl<parcelport> base_type;
+
+            static parcelset::locality here()
+            {
+                return
+                    parcelset::locality(
+                        locality(
+                            boost::asio::ip::host_name()
+                          , ring_buffer_name(instance_id())
+                        )
+                    );
+            }
+
+        public:
+            parcelport(util::runtime_configuration const& ini,
+                util::function_nonser<void(std::size_t, char const*)> const& on_start,
+                util::function_nonser<void()> const& on_stop)
+              : base_type(ini, here(), on_start, on_stop)
+              , stopped_(false)
+              , zero_copy_threshold_(hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.ipc.zero_copy_threshold",
+                    HPX_PARCEL_IPC_ZERO_COPY_THRESHOLD))
+              , receiver_(*this)
+            {
+                // the ring buffer has to exist before this locality is
+                // registered with AGAS
+                receiver_.create(here_.get<locality>().name(),
+                    hpx::util::get_entry_as<std::size_t>(
+                        ini, "hpx.parcel.ipc.ring_buffer_size",
+                        HPX_PARCEL_IPC_RING_BUFFER_SIZE));
+            }
+
+            ~parcelport()
+            {
+                receiver_.stop();
+            }
+
+            /// Start the handling of connections.
+            bool do_run()
+            {
+                for(std::size_t i = 0; i != io_service_pool_.size(); ++i)
+                {
+                    io_service_pool_.get_io_service(int(i)).post(
+                        hpx::util::bind(
+                            &parcelport::io_service_work, this
+                        )
+                    );
+                }
+                return true;
+            }
+
+            /// Stop the handling of connectons.
+            void do_stop()
+            {
+                while(do_background_work(0))
+                {
+                    if(threads::get_self_ptr())
+                        hpx::this_thread::suspend(hpx::threads::pending,
+                            "ipc::parcelport::do_stop");
+                }
+                stopped_ = true;
+                receiver_.stop();
+            }
+
+            /// Only localities running on the same node can be reached
+            bool can_connect(parcelset::locality const& l,
+                bool use_alternative_parcelport)
+            {
+                return use_alternative_parcelport &&
+                    l.get<locality>().host() == here_.get<locality>().host();
+            }
+
+            /// Return the name of this locality
+            std::string get_locality_name() const
+            {
+                return boost::asio::ip::host_name();
+            }
+
+            std::shared_ptr<sender_connection> create_connection(
+                parcelset::locality const& l, error_code& ec)
+            {
+                boost::system::error_code e;
+                std::shared_ptr<sender_connection> connection =
+                    sender_.create_connection(l, this, zero_copy_threshold_, e);
+
+                if (e)
+                {
+                    HPX_THROWS_IF(ec, network_error,
+                        "ipc::parcelport::create_connection",
+                        "could not attach to the ring buffer of locality " +
+                            l.get<locality>().name() + ": " + e.message());
+                    return connection;
+                }
+
+                if (&ec != &throws)
+                    ec = make_success_code();
+
+                return connection;
+            }
+
+            parcelset::locality agas_locality(
+                util::runtime_configuration const & ini) const
+            {
+                return parcelset::locality(locality());
+            }
+
+            parcelset::locality create_locality() const
+            {
+                return parcelset::locality(locality());
+            }
+
+            bool background_work(std::size_t num_thread)
+            {
+                if (stopped_)
+                    return false;
+
+                bool has_work = false;
+                has_work = sender_.background_work();
+                has_work = receiver_.background_work() || has_work;
+                return has_work;
+            }
+
+        private:
+            boost::atomic<bool> stopped_;
+
+            std::size_t const zero_copy_threshold_;
+
+            sender sender_;
+            receiver<parcelport> receiver_;
+
+            void io_service_work()
+            {
+                std::size_t k = 0;
+                // We only execute work on the IO service while HPX is starting
+                while(hpx::is_starting())
+                {
+                    bool has_work = sender_.background_work();
+                    has_work = receiver_.background_work() || has_work;
+                    if(has_work)
+                    {
+                        k = 0;
+                    }
+                    else
+                    {
+                        ++k;
+                        hpx::lcos::local::spinlock::yield(k);
+                    }
+                }
+            }
+        };
+    }}
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+namespace hpx { namespace traits
+{
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.parcel.ipc]
+    //      ...
+    //      priority = 150
+    //
+    template <>
+    struct plugin_config_data<hpx::parcelset::policies::ipc::parcelport>
+    {
+        // Prefer this parcelport over all others for localities on the same
+        // node, it is not used for any other destination.
+        static char const* priority()
+        {
+            return "150";
+        }
+        static void init(int *argc, char ***argv, util::command_line_handling &cfg)
+        {
+        }
+
+        static char const* call()
+        {
+            return
+                "ring_buffer_size = ${HPX_PARCEL_IPC_RING_BUFFER_SIZE:"
+                    BOOST_PP_STRINGIZE(HPX_PARCEL_IPC_RING_BUFFER_SIZE) "}\n"
+                "zero_copy_threshold = ${HPX_PARCEL_IPC_ZERO_COPY_THRESHOLD:"
+                    BOOST_PP_STRINGIZE(HPX_PARCEL_IPC_ZERO_COPY_THRESHOLD) "}\n"
+                ;
+        }
+    };
+}}
+
+HPX_REGISTER_PARCELPORT(
+    hpx::parcelset::policies::ipc::parcelport,
+    ipc);
+
+#endif
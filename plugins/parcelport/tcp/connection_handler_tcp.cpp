@@ -17,11 +17,13 @@
 #include <hpx/exception_list.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/plugins/parcelport/tcp/connection_handler.hpp>
+#include <hpx/plugins/parcelport/tcp/receive_buffer_pool.hpp>
 #include <hpx/plugins/parcelport/tcp/sender.hpp>
 #include <hpx/plugins/parcelport/tcp/receiver.hpp>
 #include <hpx/util/asio_util.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
 
 #include <boost/chrono/chrono.hpp>
 #include <boost/io/ios_state.hpp>
@@ -36,6 +38,13 @@
 
 namespace hpx { namespace parcelset { namespace policies { namespace tcp
 {
+    receive_buffer_pool& get_receive_buffer_pool()
+    {
+        // never destroyed, received data may outlive static destruction
+        static receive_buffer_pool* pool = new receive_buffer_pool;
+        return *pool;
+    }
+
     parcelset::locality parcelport_address(util::runtime_configuration const & ini)
     {
         // load all components as described in the configuration information
@@ -65,12 +74,19 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             util::function_nonser<void()> const& on_stop_thread)
       : base_type(ini, parcelport_address(ini), on_start_thread, on_stop_thread)
       , acceptor_(nullptr)
+      , write_coalescing_delay_(hpx::util::get_entry_as<std::size_t>(
+            ini, "hpx.parcel.tcp.write_coalescing_delay", 0))
     {
         if (here_.type() != std::string("tcp")) {
             HPX_THROW_EXCEPTION(network_error, "tcp::parcelport::parcelport",
                 "this parcelport was instantiated to represent an unexpected "
                 "locality type: " + std::string(here_.type()));
         }
+
+        get_receive_buffer_pool().set_max_cached_bytes(
+            hpx::util::get_entry_as<std::size_t>(ini,
+                "hpx.parcel.tcp.receive_buffer_pool_size",
+                std::size_t(receive_buffer_pool::default_max_cached_bytes)));
     }
 
     connection_handler::~connection_handler()
@@ -153,7 +169,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
         // The parcel gets serialized inside the connection constructor, no
         // need to keep the original parcel alive after this call returned.
-        std::shared_ptr<sender> sender_connection(new sender(io_service, l, this));
+        std::shared_ptr<sender> sender_connection(new sender(io_service, l, this,
+            operations_in_flight_, write_coalescing_delay_));
 
         // Connect to the target locality, retry if needed
         boost::system::error_code error = boost::asio::error::try_again;
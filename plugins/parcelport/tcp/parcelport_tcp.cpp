@@ -35,7 +35,12 @@ namespace hpx { namespace traits
         }
         static char const* call()
         {
-            return "";
+            return
+                "write_coalescing_delay = "
+                    "${HPX_PARCEL_TCP_WRITE_COALESCING_DELAY:0}\n"
+                "receive_buffer_pool_size = "
+                    "${HPX_PARCEL_TCP_RECEIVE_BUFFER_POOL_SIZE:67108864}\n"
+                ;
         }
     };
 }}
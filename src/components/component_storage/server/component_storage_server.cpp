@@ -5,9 +5,15 @@
 
 #include <hpx/config.hpp>
 #include <hpx/components/component_storage/server/component_storage.hpp>
+#include <hpx/components/component_storage/server/file_storage.hpp>
+#include <hpx/runtime/find_here.hpp>
 #include <hpx/runtime/find_localities.hpp>
+#include <hpx/runtime/threads/run_as_os_thread.hpp>
 
+#include <cstddef>
 #include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace hpx { namespace components { namespace server
@@ -16,14 +22,47 @@ namespace hpx { namespace components { namespace server
       : data_(container_layout(find_all_localities()))
     {}
 
+    // The (unused) in-memory map is kept local, all data goes to the file.
+    component_storage::component_storage(std::string const& filename)
+      : data_(container_layout(find_here()))
+    {
+        // opening an existing file replays its log, keep this off the
+        // HPX worker threads
+        file_ = threads::run_as_os_thread(
+            [](std::string const& filename)
+            {
+                return std::unique_ptr<file_storage>(
+                    new file_storage(filename));
+            },
+            filename).get();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
-    naming::gid_type component_storage::migrate_to_here(
-        std::vector<char> const& data, naming::id_type id,
-        naming::address const& current_lva)
+    void component_storage::store(naming::gid_type const& gid,
+        std::vector<char> const& data)
     {
-        naming::gid_type gid(naming::detail::get_stripped_gid(id.get_gid()));
-        data_[gid] = data;
+        if (!file_)
+        {
+            data_[gid] = data;
+            return;
+        }
+
+        std::vector<std::pair<naming::gid_type, std::vector<char> > > records;
+        records.emplace_back(gid, data);
 
+        // the calling HPX thread is suspended while the data is written
+        threads::run_as_os_thread(
+            [this](std::vector<std::pair<
+                naming::gid_type, std::vector<char> > > const& records)
+            {
+                file_->store(records);
+            },
+            std::move(records)).get();
+    }
+
+    void component_storage::bind(naming::gid_type const& gid,
+        naming::id_type const& id, naming::address const& current_lva)
+    {
         // rebind the object to this storage locality
         naming::address addr(current_lva);
         addr.address_ = 0;       // invalidate lva
@@ -36,8 +75,17 @@ namespace hpx { namespace components { namespace server
             HPX_THROW_EXCEPTION(duplicate_component_address,
                 "component_storage::migrate_to_here",
                 strm.str());
-            return naming::invalid_gid;
         }
+    }
+
+    naming::gid_type component_storage::migrate_to_here(
+        std::vector<char> const& data, naming::id_type id,
+        naming::address const& current_lva)
+    {
+        naming::gid_type gid(naming::detail::get_stripped_gid(id.get_gid()));
+
+        store(gid, data);
+        bind(gid, id, current_lva);
 
         id.make_unmanaged();            // we can now release the object
         return naming::invalid_gid;
@@ -46,9 +94,26 @@ namespace hpx { namespace components { namespace server
     std::vector<char> component_storage::migrate_from_here(
         naming::gid_type const& id)
     {
+        naming::gid_type gid(naming::detail::get_stripped_gid(id));
+
         // return the stored data and erase it from the map
-        return data_.get_value(launch::sync,
-            naming::detail::get_stripped_gid(id), true);
+        if (!file_)
+            return data_.get_value(launch::sync, gid, true);
+
+        // read the stored data and erase it from the file
+        return threads::run_as_os_thread(
+            [this](naming::gid_type const& gid)
+            {
+                return file_->load(gid, true);
+            },
+            gid).get();
+    }
+
+    std::size_t component_storage::size() const
+    {
+        if (!file_)
+            return data_.size();
+        return file_->size();
     }
 }}}
 
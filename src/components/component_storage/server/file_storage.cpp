@@ -0,0 +1,243 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/components/component_storage/server/file_storage.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace components { namespace server
+{
+    namespace detail
+    {
+        // the record header consists of the two halves of the global id and
+        // the size of the data following it
+        struct record_header
+        {
+            std::uint64_t msb_;
+            std::uint64_t lsb_;
+            std::uint64_t size_;
+        };
+
+        // marks a record erasing a previously stored component
+        std::uint64_t const tombstone = std::uint64_t(-1);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    file_storage::file_storage(std::string const& filename)
+      : filename_(filename), end_(0)
+    {
+        // make sure the file exists before opening it for reading and writing
+        {
+            std::ofstream create(filename_.c_str(),
+                std::ios::binary | std::ios::app);
+        }
+
+        open();
+
+        // cut off a partially written record at the end of the file
+        std::uint64_t file_size = recover();
+        if (end_ != file_size)
+        {
+            file_.close();
+
+            boost::system::error_code ec;
+            boost::filesystem::resize_file(filename_, end_, ec);
+            if (ec)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "file_storage::file_storage",
+                    "could not truncate storage file: " + filename_);
+                return;
+            }
+
+            open();
+        }
+    }
+
+    file_storage::~file_storage()
+    {
+        file_.close();
+    }
+
+    void file_storage::open()
+    {
+        file_.open(filename_.c_str(),
+            std::ios::binary | std::ios::in | std::ios::out);
+        if (!file_.is_open())
+        {
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "file_storage::open",
+                "could not open storage file: " + filename_);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // rebuild the index by replaying the log, returns the size of the file
+    std::uint64_t file_storage::recover()
+    {
+        file_.seekg(0, std::ios::end);
+        std::uint64_t const file_size =
+            static_cast<std::uint64_t>(file_.tellg());
+
+        std::uint64_t pos = 0;
+        while (pos + sizeof(detail::record_header) <= file_size)
+        {
+            detail::record_header header;
+            file_.seekg(static_cast<std::streamoff>(pos), std::ios::beg);
+            if (!file_.read(reinterpret_cast<char*>(&header), sizeof(header)))
+                break;
+
+            naming::gid_type gid(header.msb_, header.lsb_);
+            if (header.size_ == detail::tombstone)
+            {
+                index_.erase(gid);
+                pos += sizeof(header);
+                continue;
+            }
+
+            // stop at a partially written record at the end of the file
+            if (pos + sizeof(header) + header.size_ > file_size)
+                break;
+
+            pos += sizeof(header);
+            index_[gid] = std::make_pair(pos, header.size_);
+            pos += header.size_;
+        }
+
+        // new records are appended after the last complete one
+        end_ = pos;
+        file_.clear();
+
+        return file_size;
+    }
+
+    void file_storage::append_record(std::vector<char>& buffer,
+        naming::gid_type const& gid, std::uint64_t size, char const* data)
+    {
+        detail::record_header header = {
+            gid.get_msb(), gid.get_lsb(), size
+        };
+
+        char const* begin = reinterpret_cast<char const*>(&header);
+        buffer.insert(buffer.end(), begin, begin + sizeof(header));
+        if (size != detail::tombstone)
+            buffer.insert(buffer.end(), data, data + size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void file_storage::store(std::vector<std::pair<
+        naming::gid_type, std::vector<char> > > const& data)
+    {
+        // assemble all records in memory to write them with a single call
+        std::vector<char> buffer;
+        std::size_t total_size = 0;
+        for (auto const& d : data)
+            total_size += sizeof(detail::record_header) + d.second.size();
+        buffer.reserve(total_size);
+
+        for (auto const& d : data)
+        {
+            append_record(buffer, d.first, d.second.size(), d.second.data());
+        }
+
+        std::lock_guard<mutex_type> l(mtx_);
+
+        file_.seekp(static_cast<std::streamoff>(end_), std::ios::beg);
+        file_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file_.flush();
+
+        if (!file_)
+        {
+            file_.clear();
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "file_storage::store",
+                "could not write to storage file: " + filename_);
+            return;
+        }
+
+        // update the index only after the data was written successfully
+        std::uint64_t pos = end_;
+        for (auto const& d : data)
+        {
+            pos += sizeof(detail::record_header);
+            index_[d.first] = std::make_pair(pos, d.second.size());
+            pos += d.second.size();
+        }
+        end_ = pos;
+    }
+
+    std::vector<char> file_storage::load(naming::gid_type const& gid,
+        bool erase)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        auto it = index_.find(gid);
+        if (it == index_.end())
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "file_storage::load",
+                "the given component is not stored in: " + filename_);
+            return std::vector<char>();
+        }
+
+        std::vector<char> data(it->second.second);
+
+        file_.seekg(static_cast<std::streamoff>(it->second.first),
+            std::ios::beg);
+        file_.read(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file_)
+        {
+            file_.clear();
+            HPX_THROW_EXCEPTION(filesystem_error,
+                "file_storage::load",
+                "could not read from storage file: " + filename_);
+            return std::vector<char>();
+        }
+
+        if (erase)
+        {
+            std::vector<char> buffer;
+            append_record(buffer, gid, detail::tombstone, nullptr);
+
+            file_.seekp(static_cast<std::streamoff>(end_), std::ios::beg);
+            file_.write(buffer.data(),
+                static_cast<std::streamsize>(buffer.size()));
+            file_.flush();
+
+            if (!file_)
+            {
+                file_.clear();
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "file_storage::load",
+                    "could not write to storage file: " + filename_);
+                return std::vector<char>();
+            }
+
+            end_ += buffer.size();
+            index_.erase(it);
+        }
+
+        return data;
+    }
+
+    std::size_t file_storage::size() const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return index_.size();
+    }
+}}}
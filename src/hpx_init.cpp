@@ -1176,6 +1176,16 @@ namespace hpx
                             hpx::threads::policies::lockfree_lifo
                         >(std::move(startup), std::move(shutdown), cfg, blocking);
                 }
+                else if (0 == std::string("local-priority-chase-lev").find(cfg.queuing_))
+                {
+                    // local scheduler with priority queue (one work-stealing
+                    // deque for each OS thread plus separate dequeues for
+                    // low/high priority HPX-threads)
+                    cfg.queuing_ = "local-priority-chase-lev";
+                    result = run_priority_local<
+                            hpx::threads::policies::lockfree_chase_lev
+                        >(std::move(startup), std::move(shutdown), cfg, blocking);
+                }
                 else if (0 == std::string("static-priority").find(cfg.queuing_))
                 {
                     cfg.queuing_ = "static-priority";
@@ -1099,7 +1099,13 @@ namespace hpx { namespace threads
     std::ptrdiff_t get_stack_size(threads::thread_stacksize stacksize)
     {
         if (stacksize == threads::thread_stacksize_current)
-            return threads::get_self_stacksize();
+        {
+            // threads created by a stackless thread get a stack of their own
+            std::ptrdiff_t size = threads::get_self_stacksize();
+            if (size != threads::coroutines::detail::nostack_stack_size)
+                return size;
+            stacksize = threads::thread_stacksize_default;
+        }
 
         return get_runtime().get_config().get_stack_size(stacksize);
     }
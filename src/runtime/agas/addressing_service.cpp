@@ -124,13 +124,98 @@ struct addressing_service::gva_cache_key
     }
 }; // }}}
 
+addressing_service::gva_cache_shard::gva_cache_shard()
+  : cache_(new gva_cache_type)
+{}
+
+namespace detail
+{
+    // Consecutive blocks of ids are assigned to consecutive shards, the
+    // MSB only determines the shard the first block is assigned to.
+    inline std::size_t get_gva_cache_shard(std::uint64_t msb,
+        std::uint64_t block)
+    {
+        std::uint64_t const offset = (msb * 0x9e3779b97f4a7c15ull) >> 32;
+        return std::size_t((offset + block) %
+            addressing_service::gva_cache_num_shards);
+    }
+
+    // Return the shard the given (stripped) id is stored in.
+    inline addressing_service::gva_cache_shard& get_gva_cache_shard(
+        addressing_service::gva_cache_shard* shards,
+        naming::gid_type const& gid)
+    {
+        return shards[get_gva_cache_shard(gid.get_msb(),
+            gid.get_lsb() >> addressing_service::gva_cache_block_bits)];
+    }
+
+    // Return the shard a cached range of ids is stored in, ranges covering
+    // more than one block are stored in the range cache.
+    inline addressing_service::gva_cache_shard& get_gva_cache_shard(
+        addressing_service::gva_cache_shard* shards,
+        addressing_service::gva_cache_shard& range_cache,
+        naming::gid_type const& gid, std::uint64_t count)
+    {
+        naming::gid_type const last = gid + (count - 1);
+        if (gid.get_msb() != last.get_msb() ||
+            (gid.get_lsb() >> addressing_service::gva_cache_block_bits) !=
+                (last.get_lsb() >> addressing_service::gva_cache_block_bits))
+        {
+            return range_cache;
+        }
+        return get_gva_cache_shard(shards, gid);
+    }
+
+    // Return the given property of a single shard.
+    template <typename F>
+    std::uint64_t get_gva_cache_value(
+        addressing_service::gva_cache_shard& shard, F && f)
+    {
+        std::lock_guard<addressing_service::mutex_type> lock(shard.mtx_);
+        return f(*shard.cache_);
+    }
+
+    // Sum up the given property of all shards, not including the range
+    // cache.
+    template <typename F>
+    std::uint64_t accumulate_gva_cache_shards(
+        addressing_service::gva_cache_shard* shards, F && f)
+    {
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i != addressing_service::gva_cache_num_shards;
+             ++i)
+        {
+            result += get_gva_cache_value(shards[i], f);
+        }
+        return result;
+    }
+
+    // Sum up the given property of all shards and the range cache.
+    template <typename F>
+    std::uint64_t accumulate_gva_cache(
+        addressing_service::gva_cache_shard* shards,
+        addressing_service::gva_cache_shard& range_cache, F && f)
+    {
+        return accumulate_gva_cache_shards(shards, f) +
+            get_gva_cache_value(range_cache, f);
+    }
+
+    // Each shard holds an equal part of the configured cache size.
+    inline std::size_t get_gva_cache_shard_size(std::size_t cache_size)
+    {
+        std::size_t const num_shards = addressing_service::gva_cache_num_shards;
+        std::size_t size = cache_size / num_shards +
+            (cache_size % num_shards ? 1 : 0);
+        return size == 0 ? 1 : size;
+    }
+}
+
 addressing_service::addressing_service(
     parcelset::parcelhandler& ph
   , util::runtime_configuration const& ini_
   , runtime_mode runtime_type_
     )
-  : gva_cache_(new gva_cache_type)
-  , console_cache_(naming::invalid_locality_id)
+  : console_cache_(naming::invalid_locality_id)
   , max_refcnt_requests_(ini_.get_agas_max_pending_refcnt_requests())
   , refcnt_requests_count_(0)
   , enable_refcnt_caching_(true)
@@ -148,7 +233,13 @@ addressing_service::addressing_service(
     LPROGRESS_;
 
     if (caching_)
-        gva_cache_->reserve(ini_.get_agas_local_cache_size());
+    {
+        std::size_t const shard_size =
+            detail::get_gva_cache_shard_size(ini_.get_agas_local_cache_size());
+        for (gva_cache_shard& shard : gva_cache_)
+            shard.cache_->reserve(shard_size);
+        gva_range_cache_.cache_->reserve(shard_size);
+    }
 
 #if defined(HPX_HAVE_NETWORKING)
     std::shared_ptr<parcelset::parcelport> pp = ph.get_bootstrap_parcelport();
@@ -282,8 +373,20 @@ void addressing_service::adjust_local_cache_size(std::size_t cache_size)
     // create the hierarchy based on the topology
     if (caching_)
     {
-        std::size_t previous = gva_cache_->size();
-            gva_cache_->reserve(cache_size);
+        std::size_t previous = 0;
+        std::size_t const shard_size =
+            detail::get_gva_cache_shard_size(cache_size);
+        for (gva_cache_shard& shard : gva_cache_)
+        {
+            std::lock_guard<mutex_type> lock(shard.mtx_);
+            previous += shard.cache_->capacity();
+            shard.cache_->reserve(shard_size);
+        }
+        {
+            std::lock_guard<mutex_type> lock(gva_range_cache_.mtx_);
+            previous += gva_range_cache_.cache_->capacity();
+            gva_range_cache_.cache_->reserve(shard_size);
+        }
 
         LAGAS_(info) << (boost::format(
             "addressing_service::adjust_local_cache_size, previous size: %1%, "
@@ -1847,32 +1950,35 @@ void addressing_service::update_cache_entry(
 
         const gva_cache_key key(gid, count);
 
+        gva_cache_shard& shard = detail::get_gva_cache_shard(gva_cache_,
+            gva_range_cache_, gid, count);
+
+        std::unique_lock<mutex_type> lock(shard.mtx_);
+        if (!shard.cache_->update_if(key, g, check_for_collisions))
         {
-            std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-            if (!gva_cache_->update_if(key, g, check_for_collisions))
+            if (LAGAS_ENABLED(warning))
             {
-                if (LAGAS_ENABLED(warning))
-                {
-                    // Figure out who we collided with.
-                    addressing_service::gva_cache_key idbase;
-                    addressing_service::gva_cache_type::entry_type e;
+                // Figure out who we collided with.
+                addressing_service::gva_cache_key idbase;
+                addressing_service::gva_cache_type::entry_type e;
 
-                    if (!gva_cache_->get_entry(key, idbase, e))
-                    {
-                        // This is impossible under sane conditions.
-                        HPX_THROWS_IF(ec, invalid_data
-                          , "addressing_service::update_cache_entry"
-                          , "data corruption or lock error occurred in cache");
-                        return;
-                    }
-
-                    LAGAS_(warning) <<
-                        ( boost::format(
-                            "addressing_service::update_cache_entry, "
-                            "aborting update due to key collision in cache, "
-                            "new_gid(%1%), new_count(%2%), old_gid(%3%), old_count(%4%)"
-                        ) % gid % count % idbase.get_gid() % idbase.get_count());
+                if (!shard.cache_->get_entry(key, idbase, e))
+                {
+                    // This is impossible under sane conditions.
+                    lock.unlock();
+                    HPX_THROWS_IF(ec, invalid_data
+                      , "addressing_service::update_cache_entry"
+                      , "data corruption or lock error occurred in cache");
+                    return;
                 }
+
+                LAGAS_(warning) <<
+                    ( boost::format(
+                        "addressing_service::update_cache_entry, "
+                        "aborting update due to key collision in cache, "
+                        "new_gid(%1%), new_count(%2%), old_gid(%3%), "
+                        "old_count(%4%)"
+                    ) % gid % count % idbase.get_gid() % idbase.get_count());
             }
         }
 
@@ -1900,15 +2006,29 @@ bool addressing_service::get_cache_entry(
     gva_cache_key k(gid);
     gva_cache_key idbase_key;
 
-    std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-    if(gva_cache_->get_entry(k, idbase_key, gva))
+    gva_cache_shard& shard = detail::get_gva_cache_shard(gva_cache_,
+        naming::detail::get_stripped_gid(gid));
+
+    bool found = false;
+    {
+        std::lock_guard<mutex_type> lock(shard.mtx_);
+        found = shard.cache_->get_entry(k, idbase_key, gva);
+    }
+
+    // the id may belong to a range covering more than one block
+    if (!found)
+    {
+        std::lock_guard<mutex_type> lock(gva_range_cache_.mtx_);
+        found = gva_range_cache_.cache_->get_entry(k, idbase_key, gva);
+    }
+
+    if (found)
     {
         const std::uint64_t id_msb =
             naming::detail::strip_internal_bits_from_gid(gid.get_msb());
 
         if (HPX_UNLIKELY(id_msb != idbase_key.get_gid().get_msb()))
         {
-            lock.unlock();
             HPX_THROWS_IF(ec, internal_server_error
               , "addressing_service::get_cache_entry"
               , "bad entry in cache, MSBs of GID base and GID do not match");
@@ -1937,9 +2057,15 @@ void addressing_service::clear_cache(
     try {
         LAGAS_(warning) << "addressing_service::clear_cache, clearing cache";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
-        gva_cache_->clear();
+        for (gva_cache_shard& shard : gva_cache_)
+        {
+            std::lock_guard<mutex_type> lock(shard.mtx_);
+            shard.cache_->clear();
+        }
+        {
+            std::lock_guard<mutex_type> lock(gva_range_cache_.mtx_);
+            gva_range_cache_.cache_->clear();
+        }
 
         if (&ec != &throws)
             ec = make_success_code();
@@ -1984,13 +2110,23 @@ void addressing_service::remove_cache_entry(
     try {
         LAGAS_(warning) << "addressing_service::remove_cache_entry";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
-        gva_cache_->erase(
+        // the size of the entry is not known, it is either stored in the
+        // shard of its base id or in the range cache
+        auto matches_gid =
             [&gid](std::pair<gva_cache_key, gva> const& p)
             {
                 return gid == p.first.get_gid();
-            });
+            };
+
+        gva_cache_shard& shard = detail::get_gva_cache_shard(gva_cache_, gid);
+        {
+            std::lock_guard<mutex_type> lock(shard.mtx_);
+            shard.cache_->erase(matches_gid);
+        }
+        {
+            std::lock_guard<mutex_type> lock(gva_range_cache_.mtx_);
+            gva_range_cache_.cache_->erase(matches_gid);
+        }
 
         if (&ec != &throws)
             ec = make_success_code();
@@ -2135,81 +2271,126 @@ namespace detail
 // Helper functions to access the current cache statistics
 std::uint64_t addressing_service::get_cache_entries(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->size();
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.size();
+        });
 }
 
 std::uint64_t addressing_service::get_cache_hits(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().hits(reset);
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().hits(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_misses(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().misses(reset);
+    // every lookup which misses the shard of its id is passed on to the range
+    // cache, a miss there is a miss of the whole cache
+    return detail::get_gva_cache_value(gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().misses(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_evictions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().evictions(reset);
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().evictions(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_insertions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().insertions(reset);
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().insertions(reset);
+        });
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 std::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_count(reset);
+    // every lookup starts at the shard of its id, the lookups passed on to
+    // the range cache are not counted again
+    return detail::accumulate_gva_cache_shards(gva_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().get_get_entry_count(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_count(reset);
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().get_insert_entry_count(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_count(reset);
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().get_update_entry_count(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_count(reset);
+    // an entry is removed from the shard of its id and from the range cache,
+    // count this once
+    return detail::accumulate_gva_cache_shards(gva_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().get_erase_entry_count(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_time(reset);
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().get_get_entry_time(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_time(reset);
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().get_insert_entry_time(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_time(reset);
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().get_update_entry_time(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_time(reset);
+    return detail::accumulate_gva_cache(gva_cache_, gva_range_cache_,
+        [reset](gva_cache_type& cache) -> std::uint64_t
+        {
+            return cache.get_statistics().get_erase_entry_time(reset);
+        });
 }
 
 /// Install performance counter types exposing properties from the local cache.
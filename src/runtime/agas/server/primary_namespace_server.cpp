@@ -9,6 +9,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/async.hpp>
+#include <hpx/error_code.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
@@ -31,6 +32,7 @@
 #include <hpx/lcos/wait_all.hpp>
 
 #include <boost/atomic.hpp>
+#include <boost/exception_ptr.hpp>
 #include <boost/format.hpp>
 
 #include <cstddef>
@@ -620,33 +622,66 @@ std::vector<std::int64_t> primary_namespace::decrement_credit(
     std::vector<int64_t> res_credits;
     res_credits.reserve(requests.size());
 
-    for(auto& req: requests)
-    {
-        std::int64_t credits = hpx::util::get<0>(req);
-        naming::gid_type lower = hpx::util::get<1>(req);
-        naming::gid_type upper = hpx::util::get<1>(req);
+    // Apply all decrements of this batch first, this touches the reference
+    // count shards only. The objects whose credits dropped to zero are
+    // resolved using a single acquisition of the GVA table lock and are
+    // freed by waiting for all remote free operations at once.
+    std::vector<naming::gid_type> free_gids;
 
-        naming::detail::strip_internal_bits_from_gid(lower);
-        naming::detail::strip_internal_bits_from_gid(upper);
+    try {
+        for(auto& req: requests)
+        {
+            std::int64_t credits = hpx::util::get<0>(req);
+            naming::gid_type lower = hpx::util::get<1>(req);
+            naming::gid_type upper = hpx::util::get<1>(req);
 
-        if (lower == upper)
-            ++upper;
+            naming::detail::strip_internal_bits_from_gid(lower);
+            naming::detail::strip_internal_bits_from_gid(upper);
 
-        // Decrement.
-        if (credits < 0)
-        {
-            std::list<free_entry> free_list;
-            decrement_sweep(free_list, lower, upper, -credits, hpx::throws);
+            if (lower == upper)
+                ++upper;
 
-            free_components_sync(free_list, lower, upper, hpx::throws);
+            // Decrement.
+            if (credits < 0)
+            {
+                decrement_sweep(free_gids, lower, upper, -credits,
+                    hpx::throws);
+            }
+            else
+            {
+                HPX_THROW_EXCEPTION(bad_parameter
+                  , "primary_namespace::decrement_credit"
+                  , boost::str(boost::format("invalid credit count of %1%")
+                        % credits));
+            }
+            res_credits.push_back(credits);
         }
-        else
+    }
+    catch (...) {
+        // the objects collected so far have already been removed from the
+        // reference count table, they have to be freed nevertheless
+        if (!free_gids.empty())
         {
-            HPX_THROW_EXCEPTION(bad_parameter
-              , "primary_namespace::decrement_credit"
-              , boost::str(boost::format("invalid credit count of %1%") % credits));
+            error_code ec(lightweight);
+            std::list<free_entry> free_list;
+            resolve_free_list(free_gids, free_list, ec);
+            free_components_sync(free_list, ec);
         }
-        res_credits.push_back(credits);
+        throw;
+    }
+
+    if (!free_gids.empty())
+    {
+        // free all objects which could be resolved before reporting an error
+        // for any of the others
+        error_code ec;
+        std::list<free_entry> free_list;
+        resolve_free_list(free_gids, free_list, ec);
+
+        free_components_sync(free_list, hpx::throws);
+
+        if (ec)
+            boost::rethrow_exception(hpx::detail::access_exception(ec));
     }
 
     return res_credits;
@@ -663,17 +698,22 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
 
     std::uint64_t const real_count = (count) ? (count - 1) : (0);
 
+    std::unique_lock<mutex_type> l(allocate_mutex_);
+
     // Just return the prefix
     // REVIEW: Should this be an error?
     if (0 == count)
     {
+        naming::gid_type const id = next_id_;
+        l.unlock();
+
         LAGAS_(info) << (boost::format(
             "primary_namespace::allocate, count(%1%), "
             "lower(%1%), upper(%3%), prefix(%4%), response(repeated_request)")
-            % count % next_id_ % next_id_
-            % naming::get_locality_id_from_gid(next_id_));
+            % count % id % id
+            % naming::get_locality_id_from_gid(id));
 
-        return std::make_pair(next_id_, next_id_);
+        return std::make_pair(id, id);
     }
 
     // Compute the new allocation.
@@ -690,6 +730,8 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
                 naming::gid_type::virtual_memory_mask)
            )
         {
+            l.unlock();
+
             HPX_THROW_EXCEPTION(internal_server_error
                 , "locality_namespace::allocate"
                 , "primary namespace has been exhausted");
@@ -703,6 +745,8 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
     // Store the new upper bound.
     next_id_ = upper;
 
+    l.unlock();
+
     // Set the initial credit count.
     naming::detail::set_credit_for_gid(lower, std::int64_t(HPX_GLOBALCREDIT_INITIAL));
     naming::detail::set_credit_for_gid(upper, std::int64_t(HPX_GLOBALCREDIT_INITIAL));
@@ -717,37 +761,39 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void primary_namespace::dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         )
     { // dump_refcnt_matches implementation
-        HPX_ASSERT(l.owns_lock());
-
-        if (lower_it == refcnts_.end() && upper_it == refcnts_.end())
-            // We got nothing, bail - our caller is probably about to throw.
-            return;
-
         std::stringstream ss;
         ss << (boost::format(
               "%1%, dumping server-side refcnt table matches, lower(%2%), "
               "upper(%3%):")
               % func_name % lower % upper);
 
-        for (/**/; lower_it != upper_it; ++lower_it)
+        bool found = false;
+        for (naming::gid_type raw = lower; raw != upper; ++raw)
         {
+            refcnt_shard& shard = get_refcnt_shard(raw);
+            std::lock_guard<mutex_type> l(shard.mtx_);
+
+            refcnt_table_type::iterator it = shard.table_.find(raw);
+            if (it == shard.table_.end())
+                continue;
+
             // The [server] tag is in there to make it easier to filter
             // through the logs.
             ss << (boost::format(
                    "\n  [server] lower(%1%), credits(%2%)")
-                   % lower_it->first
-                   % lower_it->second);
+                   % it->first
+                   % it->second);
+            found = true;
         }
 
-        LAGAS_(debug) << ss.str();
+        // We got nothing, bail - our caller is probably about to throw.
+        if (found)
+            LAGAS_(debug) << ss.str();
     } // dump_refcnt_matches implementation
 #endif
 
@@ -759,28 +805,10 @@ void primary_namespace::increment(
   , error_code& ec
     )
 { // {{{ increment implementation
-    std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     if (LAGAS_ENABLED(debug))
     {
-        typedef refcnt_table_type::iterator iterator;
-
-        // Find the mappings that we're about to touch.
-        refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-        refcnt_table_type::iterator upper_it;
-        if (lower != upper)
-        {
-            upper_it = refcnts_.find(upper);
-        }
-        else
-        {
-            upper_it = lower_it;
-            ++upper_it;
-        }
-
-        dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-            "primary_namespace::increment");
+        dump_refcnt_matches(lower, upper, "primary_namespace::increment");
     }
 #endif
 
@@ -789,44 +817,28 @@ void primary_namespace::increment(
     // reference count is 2^64 - 2. The maximum number of credits a single GID
     // can hold, however, is limited to 2^32 - 1.
 
-    // The third parameter we pass here is the default data to use in case the
-    // key is not mapped. We don't insert GIDs into the refcnt table when we
-    // allocate/bind them, so if a GID is not in the refcnt table, we know that
-    // it's global reference count is the initial global reference count.
+    // We don't insert GIDs into the refcnt table when we allocate/bind them,
+    // so if a GID is not in the refcnt table, we know that it's global
+    // reference count is the initial global reference count.
 
     for (naming::gid_type raw = lower; raw != upper; ++raw)
     {
-        refcnt_table_type::iterator it = refcnts_.find(raw);
-        if (it == refcnts_.end())
+        std::int64_t count = 0;
+
         {
-            std::int64_t count =
-                std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
+            refcnt_shard& shard = get_refcnt_shard(raw);
+            std::lock_guard<mutex_type> l(shard.mtx_);
 
             std::pair<refcnt_table_type::iterator, bool> p =
-                refcnts_.insert(refcnt_table_type::value_type(raw, count));
-            if (!p.second)
-            {
-                l.unlock();
-
-                HPX_THROWS_IF(ec, invalid_data
-                    , "primary_namespace::increment"
-                    , boost::str(boost::format(
-                        "couldn't create entry in reference count table, "
-                        "raw(%1%), ref-count(%3%)")
-                        % raw % count));
-                return;
-            }
+                shard.table_.insert(refcnt_table_type::value_type(
+                    raw, std::int64_t(HPX_GLOBALCREDIT_INITIAL)));
 
-            it = p.first;
-        }
-        else
-        {
-            it->second += credits;
+            count = (p.first->second += credits);
         }
 
         LAGAS_(info) << (boost::format(
             "primary_namespace::increment, raw(%1%), refcnt(%2%)")
-            % lower % it->second);
+            % raw % count);
     }
 
     if (&ec != &throws)
@@ -835,46 +847,49 @@ void primary_namespace::increment(
 
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::resolve_free_list(
-    std::unique_lock<mutex_type>& l
-  , std::list<refcnt_table_type::iterator> const& free_list
+    std::vector<naming::gid_type> const& free_list
   , std::list<free_entry>& free_entry_list
-  , naming::gid_type const& lower
-  , naming::gid_type const& upper
   , error_code& ec
     )
 {
-    HPX_ASSERT_OWNS_LOCK(l);
-
     using hpx::util::get;
 
-    typedef refcnt_table_type::iterator iterator;
+    // A gid which can't be resolved is skipped, the remaining objects still
+    // have to be freed. The first error is reported once all gids have been
+    // handled.
+    error_code first_error;
 
-    for (iterator const& it : free_list)
-    {
-        typedef refcnt_table_type::key_type key_type;
+    std::unique_lock<mutex_type> l(mutex_);
 
-        // The mapping's key space.
-        key_type gid = it->first;
+    for (naming::gid_type const& gid : free_list)
+    {
+        error_code gid_ec;
 
         // wait for any migration to be completed
-        wait_for_migration_locked(l, gid, ec);
+        wait_for_migration_locked(l, gid, gid_ec);
 
         // Resolve the query GID.
-        resolved_type r = resolve_gid_locked(l, gid, ec);
-        if (ec) return;
+        resolved_type r = resolve_gid_locked(l, gid, gid_ec);
+        if (gid_ec)
+        {
+            if (!first_error)
+                first_error = gid_ec;
+            continue;
+        }
 
         naming::gid_type& raw = get<0>(r);
         if (raw == naming::invalid_gid)
         {
-            l.unlock();
-
-            HPX_THROWS_IF(ec, internal_server_error
-                , "primary_namespace::resolve_free_list"
-                , boost::str(boost::format(
-                    "primary_namespace::resolve_free_list, failed to resolve "
-                    "gid, gid(%1%)")
-                    % gid));
-            return;       // couldn't resolve this one
+            if (!first_error)
+            {
+                HPX_THROWS_IF(first_error, internal_server_error
+                    , "primary_namespace::resolve_free_list"
+                    , boost::str(boost::format(
+                        "primary_namespace::resolve_free_list, failed to "
+                        "resolve gid, gid(%1%)")
+                        % gid));
+            }
+            continue;       // couldn't resolve this one
         }
 
         // Make sure the GVA is valid.
@@ -883,27 +898,29 @@ void primary_namespace::resolve_free_list(
         // REVIEW: Should we do more to make sure the GVA is valid?
         if (HPX_UNLIKELY(components::component_invalid == g.type))
         {
-            l.unlock();
-
-            HPX_THROWS_IF(ec, internal_server_error
-                , "primary_namespace::resolve_free_list"
-                , boost::str(boost::format(
-                    "encountered a GVA with an invalid type while "
-                    "performing a decrement, gid(%1%), gva(%2%)")
-                    % gid % g));
-            return;
+            if (!first_error)
+            {
+                HPX_THROWS_IF(first_error, internal_server_error
+                    , "primary_namespace::resolve_free_list"
+                    , boost::str(boost::format(
+                        "encountered a GVA with an invalid type while "
+                        "performing a decrement, gid(%1%), gva(%2%)")
+                        % gid % g));
+            }
+            continue;
         }
         else if (HPX_UNLIKELY(0 == g.count))
         {
-            l.unlock();
-
-            HPX_THROWS_IF(ec, internal_server_error
-                , "primary_namespace::resolve_free_list"
-                , boost::str(boost::format(
-                    "encountered a GVA with a count of zero while "
-                    "performing a decrement, gid(%1%), gva(%2%)")
-                    % gid % g));
-            return;
+            if (!first_error)
+            {
+                HPX_THROWS_IF(first_error, internal_server_error
+                    , "primary_namespace::resolve_free_list"
+                    , boost::str(boost::format(
+                        "encountered a GVA with a count of zero while "
+                        "performing a decrement, gid(%1%), gva(%2%)")
+                        % gid % g));
+            }
+            continue;
         }
 
         LAGAS_(info) << (boost::format(
@@ -917,15 +934,25 @@ void primary_namespace::resolve_free_list(
         // Add the information needed to destroy these components to the
         // free list.
         free_entry_list.push_back(free_entry(resolved, gid, get<2>(r)));
+    }
 
-        // remove this entry from the refcnt table
-        refcnts_.erase(it);
+    l.unlock();
+
+    if (first_error)
+    {
+        if (&ec == &throws)
+            boost::rethrow_exception(hpx::detail::access_exception(first_error));
+        ec = first_error;
+        return;
     }
+
+    if (&ec != &throws)
+        ec = make_success_code();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::decrement_sweep(
-    std::list<free_entry>& free_entry_list
+    std::vector<naming::gid_type>& free_list
   , naming::gid_type const& lower
   , naming::gid_type const& upper
   , std::int64_t credits
@@ -937,111 +964,66 @@ void primary_namespace::decrement_sweep(
         "credits(%3%)")
         % lower % upper % credits);
 
-    free_entry_list.clear();
-
-    {
-        std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-        if (LAGAS_ENABLED(debug))
-        {
-            typedef refcnt_table_type::iterator iterator;
-
-            // Find the mappings that we just added or modified.
-            refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-            refcnt_table_type::iterator upper_it;
-            if (lower != upper)
-            {
-                upper_it = refcnts_.find(upper);
-            }
-            else
-            {
-                upper_it = lower_it;
-                ++upper_it;
-            }
-
-            dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-                "primary_namespace::decrement_sweep");
-        }
+    if (LAGAS_ENABLED(debug))
+    {
+        dump_refcnt_matches(lower, upper, "primary_namespace::decrement_sweep");
+    }
 #endif
 
-        ///////////////////////////////////////////////////////////////////////
-        // Apply the decrement across the entire key space (e.g. [lower, upper]).
-
-        // The third parameter we pass here is the default data to use in case
-        // the key is not mapped. We don't insert GIDs into the refcnt table
-        // when we allocate/bind them, so if a GID is not in the refcnt table,
-        // we know that it's global reference count is the initial global
-        // reference count.
-
-        std::list<refcnt_table_type::iterator> free_list;
-        for (naming::gid_type raw = lower; raw != upper; ++raw)
-        {
-            refcnt_table_type::iterator it = refcnts_.find(raw);
-            if (it == refcnts_.end())
-            {
-                if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
-                {
-                    l.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply the decrement across the entire key space (e.g. [lower, upper]).
 
-                    HPX_THROWS_IF(ec, invalid_data
-                      , "primary_namespace::decrement_sweep"
-                      , boost::str(boost::format(
-                            "negative entry in reference count table, raw(%1%), "
-                            "refcount(%2%)")
-                            % raw
-                            % (std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits)));
-                    return;
-                }
+    // We don't insert GIDs into the refcnt table when we allocate/bind them,
+    // so if a GID is not in the refcnt table, we know that it's global
+    // reference count is the initial global reference count.
 
-                std::int64_t count =
-                    std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
+    for (naming::gid_type raw = lower; raw != upper; ++raw)
+    {
+        refcnt_shard& shard = get_refcnt_shard(raw);
+        std::unique_lock<mutex_type> l(shard.mtx_);
 
-                std::pair<refcnt_table_type::iterator, bool> p =
-                    refcnts_.insert(refcnt_table_type::value_type(raw, count));
-                if (!p.second)
-                {
-                    l.unlock();
+        std::int64_t count = std::int64_t(HPX_GLOBALCREDIT_INITIAL);
 
-                    HPX_THROWS_IF(ec, invalid_data
-                      , "primary_namespace::decrement_sweep"
-                      , boost::str(boost::format(
-                            "couldn't create entry in reference count table, "
-                            "raw(%1%), ref-count(%3%)")
-                            % raw % count));
-                    return;
-                }
+        refcnt_table_type::iterator it = shard.table_.find(raw);
+        if (it != shard.table_.end())
+            count = it->second;
 
-                it = p.first;
-            }
-            else
-            {
-                it->second -= credits;
-            }
+        count -= credits;
 
-            // Sanity check.
-            if (it->second < 0)
-            {
-                l.unlock();
-
-                HPX_THROWS_IF(ec, invalid_data
-                  , "primary_namespace::decrement_sweep"
-                  , boost::str(boost::format(
-                        "negative entry in reference count table, raw(%1%), "
-                        "refcount(%2%)")
-                        % raw % it->second));
-                return;
-            }
+        // Sanity check.
+        if (count < 0)
+        {
+            l.unlock();
 
-            // this objects needs to be deleted
-            if (it->second == 0)
-                free_list.push_back(it);
+            HPX_THROWS_IF(ec, invalid_data
+              , "primary_namespace::decrement_sweep"
+              , boost::str(boost::format(
+                    "negative entry in reference count table, raw(%1%), "
+                    "refcount(%2%)")
+                    % raw % count));
+            return;
         }
 
-        // Resolve the objects which have to be deleted.
-        resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
-
-    } // Unlock the mutex.
+        // this object needs to be deleted, its entry is removed right away
+        // as no further credits can arrive for it
+        if (count == 0)
+        {
+            // record the object before erasing its entry, so that it can't
+            // get lost if the free list can't be extended
+            free_list.push_back(raw);
+            if (it != shard.table_.end())
+                shard.table_.erase(it);
+        }
+        else if (it != shard.table_.end())
+        {
+            it->second = count;
+        }
+        else
+        {
+            shard.table_.insert(refcnt_table_type::value_type(raw, count));
+        }
+    }
 
     if (&ec != &throws)
         ec = make_success_code();
@@ -1050,8 +1032,6 @@ void primary_namespace::decrement_sweep(
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::free_components_sync(
     std::list<free_entry>& free_list
-  , naming::gid_type const& lower
-  , naming::gid_type const& upper
   , error_code& ec
     )
 { // {{{ free_components_sync implementation
@@ -1071,19 +1051,15 @@ void primary_namespace::free_components_sync(
         {
             LAGAS_(info) << (boost::format(
                 "primary_namespace::free_components_sync, cancelling free "
-                "operation because the threadmanager is down, lower(%1%), "
-                "upper(%2%), base(%3%), gva(%4%), locality(%5%)")
-                % lower
-                % upper
+                "operation because the threadmanager is down, "
+                "base(%1%), gva(%2%), locality(%3%)")
                 % e.gid_ % e.gva_ % e.locality_);
             continue;
         }
 
         LAGAS_(info) << (boost::format(
             "primary_namespace::free_components_sync, freeing component, "
-            "lower(%1%), upper(%2%), base(%3%), gva(%4%), locality(%5%)")
-            % lower
-            % upper
+            "base(%1%), gva(%2%), locality(%3%)")
             % e.gid_ % e.gva_ % e.locality_);
 
         // Free the object directly, if local (this avoids creating another
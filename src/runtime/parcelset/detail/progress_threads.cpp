@@ -0,0 +1,204 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/runtime/parcelset/detail/progress_threads.hpp>
+#include <hpx/runtime/report_error.hpp>
+#include <hpx/runtime/threads/cpu_mask.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/logging.hpp>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    progress_threads::progress_threads(std::size_t num_threads,
+            std::int64_t spin_count, std::int64_t max_idle_time,
+            on_start_thread_type const& on_start_thread,
+            on_stop_thread_type const& on_stop_thread)
+      : on_start_thread_(on_start_thread),
+        on_stop_thread_(on_stop_thread),
+        spin_count_(spin_count < 0 ? 0 : spin_count),
+        max_idle_time_(max_idle_time < 1 ? 1 : max_idle_time),
+        running_(false),
+        reset_busy_time_(0),
+        reset_busy_rate_busy_time_(0),
+        reset_busy_rate_time_(util::high_resolution_clock::now())
+    {
+        data_.reserve(num_threads);
+        for (std::size_t i = 0; i != num_threads; ++i)
+            data_.emplace_back(new thread_data);
+    }
+
+    progress_threads::~progress_threads()
+    {
+        stop();
+    }
+
+    void progress_threads::run(work_function_type const& work,
+        threads::mask_cref_type used_processing_units)
+    {
+        HPX_ASSERT(threads_.empty());
+
+        work_ = work;
+        running_.store(true);
+
+        // bind the progress threads to the processing units which are not
+        // used by the worker threads, starting with the highest one
+        std::size_t num_pus = threads::hardware_concurrency();
+        std::size_t pu = num_pus;
+
+        threads_.reserve(data_.size());
+        for (std::size_t i = 0; i != data_.size(); ++i)
+        {
+            threads::mask_type mask = threads::mask_type();
+            threads::resize(mask, num_pus);
+
+            while (pu != 0)
+            {
+                --pu;
+                if (!threads::test(used_processing_units, pu))
+                {
+                    threads::set(mask, pu);
+                    break;
+                }
+            }
+
+            if (!threads::any(mask))
+            {
+                LPROGRESS_ << "progress thread " << i
+                           << " is not bound, no processing unit left";
+            }
+
+            threads_.emplace_back(util::bind(&progress_threads::thread_func,
+                this, i, std::move(mask)));
+        }
+    }
+
+    void progress_threads::stop()
+    {
+        running_.store(false);
+
+        for (boost::thread& t : threads_)
+        {
+            if (t.joinable())
+                t.join();
+        }
+        threads_.clear();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void progress_threads::thread_func(std::size_t num_thread,
+        threads::mask_type mask)
+    {
+        if (threads::any(mask))
+        {
+            error_code ec(lightweight);
+            threads::get_topology().set_thread_affinity_mask(mask, ec);
+            if (ec)
+            {
+                LPROGRESS_ << "progress thread " << num_thread
+                           << " could not be bound: " << ec.get_message();
+            }
+        }
+
+        if (on_start_thread_)
+            on_start_thread_(num_thread, "-progress");
+
+        thread_data& data = *data_[num_thread];
+
+        try
+        {
+            std::int64_t idle_loop_count = 0;
+            std::int64_t idle_time = 1;     // [us]
+
+            while (running_.load(boost::memory_order_relaxed))
+            {
+                std::uint64_t start = util::high_resolution_clock::now();
+                bool did_some_work = work_(num_thread);
+                std::uint64_t end = util::high_resolution_clock::now();
+
+                if (did_some_work)
+                {
+                    data.busy_time_.fetch_add(std::int64_t(end - start),
+                        boost::memory_order_relaxed);
+                    idle_loop_count = 0;
+                    idle_time = 1;
+                    continue;
+                }
+
+                // back off exponentially once we have been idle for a while
+                if (++idle_loop_count > spin_count_)
+                {
+                    std::this_thread::sleep_for(
+                        std::chrono::microseconds(idle_time));
+                    if (idle_time < max_idle_time_)
+                    {
+                        idle_time *= 2;
+                        if (idle_time > max_idle_time_)
+                            idle_time = max_idle_time_;
+                    }
+                }
+            }
+        }
+        catch (...) {
+            hpx::report_error(num_thread, boost::current_exception());
+        }
+
+        if (on_stop_thread_)
+            on_stop_thread_();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t progress_threads::accumulate_busy_time() const
+    {
+        std::int64_t busy_time = 0;
+        for (std::unique_ptr<thread_data> const& data : data_)
+            busy_time += data->busy_time_.load(boost::memory_order_relaxed);
+        return busy_time;
+    }
+
+    std::int64_t progress_threads::get_busy_time(bool reset)
+    {
+        std::int64_t busy_time = accumulate_busy_time();
+        std::int64_t result = busy_time - reset_busy_time_;
+        if (reset)
+            reset_busy_time_ = busy_time;
+        return result;
+    }
+
+    std::int64_t progress_threads::get_busy_rate(bool reset)
+    {
+        std::int64_t busy_time = accumulate_busy_time();
+        std::uint64_t now = util::high_resolution_clock::now();
+
+        std::int64_t busy = busy_time - reset_busy_rate_busy_time_;
+        double total = double(now - reset_busy_rate_time_) * data_.size();
+
+        if (reset)
+        {
+            reset_busy_rate_busy_time_ = busy_time;
+            reset_busy_rate_time_ = now;
+        }
+
+        if (total == 0.)
+            return 0;
+        return std::int64_t((double(busy) * 10000.) / total);
+    }
+}}}
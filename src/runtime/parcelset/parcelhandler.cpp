@@ -20,6 +20,7 @@
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/message_handler_fwd.hpp>
+#include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/message_handler_fwd.hpp>
 #include <hpx/runtime/parcelset/parcelhandler.hpp>
@@ -108,13 +109,30 @@ namespace hpx { namespace parcelset
             util::get_entry_as<int>(cfg, "hpx.parcel.message_handlers", "0") != 0
         ),
         count_routed_(0),
-        write_handler_(&default_write_handler)
+        write_handler_(&default_write_handler),
+        num_progress_threads_(0),
+        progress_gc_count_(0),
+        max_progress_gc_count_(util::get_entry_as<std::int64_t>(
+            cfg, "hpx.max_busy_loop_count", HPX_BUSY_LOOP_COUNT_MAX))
     {
         LPROGRESS_;
 
 #if defined(HPX_HAVE_NETWORKING)
         if (cfg.get_entry("hpx.parcel.enable", "1") != "0")
         {
+            num_progress_threads_ = util::get_entry_as<std::size_t>(
+                cfg, "hpx.parcel.progress_threads", "0");
+            if (num_progress_threads_ != 0)
+            {
+                progress_threads_.reset(new detail::progress_threads(
+                    num_progress_threads_,
+                    util::get_entry_as<std::int64_t>(
+                        cfg, "hpx.parcel.progress_spin_count", "1000"),
+                    util::get_entry_as<std::int64_t>(
+                        cfg, "hpx.parcel.progress_max_idle_time", "1000"),
+                    on_start_thread, on_stop_thread));
+            }
+
             for (plugins::parcelport_factory_base* factory :
                     get_parcelport_factories())
             {
@@ -290,6 +308,46 @@ namespace hpx { namespace parcelset
         return did_some_work;
     }
 
+    bool parcelhandler::do_progress_work(std::size_t num_thread)
+    {
+        bool did_some_work = do_background_work(num_thread);
+
+        // the worker threads don't do this anymore, trigger it as often as
+        // the scheduling loop of a busy worker thread would
+        if (0 == num_thread && ++progress_gc_count_ > max_progress_gc_count_)
+        {
+            progress_gc_count_ = 0;
+            agas::garbage_collect_non_blocking();
+        }
+
+        return did_some_work;
+    }
+
+    void parcelhandler::start_progress_threads()
+    {
+        if (!progress_threads_)
+            return;
+
+        LPROGRESS_ << "starting " << num_progress_threads_
+                   << " parcel layer progress thread(s)";
+
+        progress_threads_->run(
+            util::bind(&parcelhandler::do_progress_work, this,
+                util::placeholders::_1),
+            tm_->get_used_processing_units());
+    }
+
+    void parcelhandler::stop_progress_threads()
+    {
+        if (!progress_threads_)
+            return;
+
+        LPROGRESS_ << "stopping " << num_progress_threads_
+                   << " parcel layer progress thread(s)";
+
+        progress_threads_->stop();
+    }
+
     void parcelhandler::flush_parcels()
     {
         // now flush all parcel ports to be shut down
@@ -304,6 +362,10 @@ namespace hpx { namespace parcelset
 
     void parcelhandler::stop(bool blocking)
     {
+        // the progress threads must not touch the parcel ports anymore, they
+        // are normally stopped once the thread manager has drained already
+        stop_progress_threads();
+
         // now stop all parcel ports
         for (pports_type::value_type& pp : pports_)
         {
@@ -1093,6 +1155,56 @@ namespace hpx { namespace parcelset
         };
         performance_counters::install_counter_types(
             counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
+
+        if (progress_threads_)
+            register_progress_counter_types();
+    }
+
+    std::int64_t parcelhandler::get_progress_busy_time(bool reset)
+    {
+        return progress_threads_ ? progress_threads_->get_busy_time(reset) : 0;
+    }
+
+    std::int64_t parcelhandler::get_progress_busy_rate(bool reset)
+    {
+        return progress_threads_ ? progress_threads_->get_busy_rate(reset) : 0;
+    }
+
+    void parcelhandler::register_progress_counter_types()
+    {
+        using util::placeholders::_1;
+        using util::placeholders::_2;
+
+        util::function_nonser<std::int64_t(bool)> busy_time(
+            util::bind(&parcelhandler::get_progress_busy_time, this, _1));
+        util::function_nonser<std::int64_t(bool)> busy_rate(
+            util::bind(&parcelhandler::get_progress_busy_rate, this, _1));
+
+        performance_counters::generic_counter_type_data const counter_types[] =
+        {
+            { "/parcels/progress/time/busy",
+              performance_counters::counter_raw,
+              "returns the overall time the parcel layer progress threads "
+                  "spent doing work",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, busy_time, _2),
+              &performance_counters::locality_counter_discoverer,
+              "ns"
+            },
+            { "/parcels/progress/busy-rate",
+              performance_counters::counter_raw,
+              "returns the ratio of the time the parcel layer progress "
+                  "threads spent doing work to their overall run time",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, busy_rate, _2),
+              &performance_counters::locality_counter_discoverer,
+              "0.01%"
+            }
+        };
+        performance_counters::install_counter_types(
+            counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
     }
 
     void parcelhandler::register_counter_types(std::string const& pp_type)
@@ -1585,6 +1697,9 @@ namespace hpx { namespace parcelset
                 "$[hpx.parcel.array_optimization]}",
             "enable_security = ${HPX_PARCEL_ENABLE_SECURITY:0}",
             "async_serialization = ${HPX_PARCEL_ASYNC_SERIALIZATION:1}",
+            "progress_threads = ${HPX_PARCEL_PROGRESS_THREADS:0}",
+            "progress_spin_count = ${HPX_PARCEL_PROGRESS_SPIN_COUNT:1000}",
+            "progress_max_idle_time = ${HPX_PARCEL_PROGRESS_MAX_IDLE_TIME:1000}",
 #if defined(HPX_HAVE_PARCEL_COALESCING)
             "message_handlers = ${HPX_PARCEL_MESSAGE_HANDLERS:1}"
 #else
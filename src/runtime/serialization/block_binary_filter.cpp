@@ -0,0 +1,312 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/serialization/block_binary_filter.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace hpx { namespace serialization
+{
+    namespace detail
+    {
+        std::size_t const block_header_size = 2 * sizeof(std::uint32_t);
+
+        inline void write_uint32(char* dst, std::uint32_t value)
+        {
+            for (std::size_t i = 0; i != sizeof(std::uint32_t); ++i)
+                dst[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+
+        inline std::uint32_t read_uint32(char const* src)
+        {
+            std::uint32_t value = 0;
+            for (std::size_t i = 0; i != sizeof(std::uint32_t); ++i)
+            {
+                value |= std::uint32_t(static_cast<unsigned char>(src[i]))
+                    << (8 * i);
+            }
+            return value;
+        }
+
+        // blocks are compressed asynchronously only if there is more than
+        // one worker thread which could pick up the work
+        inline bool run_concurrently()
+        {
+            return threads::get_self_ptr() != nullptr &&
+                get_os_thread_count() > 1;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    block_binary_filter::block_binary_filter(bool compress,
+            std::size_t block_size)
+      : block_size_(block_size), compress_(compress),
+        compressed_blocks_(0), incompressible_blocks_(0), current_(0)
+    {
+        HPX_ASSERT(block_size_ != 0 && block_size_ <= std::uint32_t(-1));
+    }
+
+    block_binary_filter::~block_binary_filter()
+    {
+        // the pending compression tasks refer to this object
+        for (block& b : blocks_)
+        {
+            if (b.done_.valid())
+                b.done_.wait();
+        }
+    }
+
+    void block_binary_filter::set_max_length(std::size_t)
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Stop trying to compress the remaining blocks once the first blocks
+    // turned out to be incompressible.
+    bool block_binary_filter::skip_compression() const
+    {
+        return incompressible_blocks_ >= 2 && compressed_blocks_ == 0;
+    }
+
+    void block_binary_filter::compress(block& b)
+    {
+        std::size_t size = b.data_.size();
+        if (size < HPX_SERIALIZATION_FILTER_MIN_COMPRESS_SIZE ||
+            skip_compression())
+        {
+            return;
+        }
+
+        b.compressed_.resize(max_compressed_length(size));
+        std::size_t compressed_size = compress_block(b.data_.data(), size,
+            b.compressed_.data(), b.compressed_.size());
+
+        // store the block uncompressed if it doesn't save at least 1/8th
+        if (compressed_size == 0 || compressed_size >= size - size / 8)
+        {
+            b.compressed_.clear();
+            b.compressed_.shrink_to_fit();
+            ++incompressible_blocks_;
+            return;
+        }
+
+        b.compressed_.resize(compressed_size);
+        ++compressed_blocks_;
+    }
+
+    void block_binary_filter::submit_block()
+    {
+        HPX_ASSERT(!blocks_.empty());
+
+        block& b = blocks_.back();
+        b.submitted_ = true;
+
+        if (detail::run_concurrently())
+        {
+            b.done_ = hpx::async(hpx::launch::async,
+                &block_binary_filter::compress, this, std::ref(b));
+        }
+        else
+        {
+            compress(b);
+        }
+    }
+
+    void block_binary_filter::save(void const* src, std::size_t src_count)
+    {
+        HPX_ASSERT(compress_);
+
+        char const* src_begin = static_cast<char const*>(src);
+        while (src_count != 0)
+        {
+            if (blocks_.empty() || blocks_.back().data_.size() == block_size_)
+            {
+                blocks_.push_back(block());
+                blocks_.back().data_.reserve(block_size_);
+            }
+
+            std::vector<char>& data = blocks_.back().data_;
+            std::size_t count = (std::min)(src_count, block_size_ - data.size());
+            data.insert(data.end(), src_begin, src_begin + count);
+
+            src_begin += count;
+            src_count -= count;
+
+            // hand the block to the codec as soon as it is complete
+            if (data.size() == block_size_)
+                submit_block();
+        }
+    }
+
+    bool block_binary_filter::flush(void* dst, std::size_t dst_count,
+        std::size_t& written)
+    {
+        HPX_ASSERT(compress_);
+
+        // compress the last (partial) block, if any
+        if (!blocks_.empty() && !blocks_.back().submitted_)
+        {
+            blocks_.back().submitted_ = true;
+            compress(blocks_.back());
+        }
+
+        std::size_t needed = 0;
+        for (block& b : blocks_)
+        {
+            if (b.done_.valid())
+                b.done_.get();          // propagate errors
+
+            needed += detail::block_header_size + (b.compressed_.empty() ?
+                b.data_.size() : b.compressed_.size());
+        }
+
+        // the caller will provide a larger buffer
+        if (needed > dst_count)
+        {
+            written = 0;
+            return false;
+        }
+
+        char* dst_begin = static_cast<char*>(dst);
+        for (block const& b : blocks_)
+        {
+            std::vector<char> const& stored =
+                b.compressed_.empty() ? b.data_ : b.compressed_;
+
+            detail::write_uint32(dst_begin,
+                static_cast<std::uint32_t>(b.data_.size()));
+            detail::write_uint32(dst_begin + sizeof(std::uint32_t),
+                static_cast<std::uint32_t>(b.compressed_.size()));
+            dst_begin += detail::block_header_size;
+
+            std::memcpy(dst_begin, stored.data(), stored.size());
+            dst_begin += stored.size();
+        }
+
+        written = needed;
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t block_binary_filter::init_data(char const* buffer,
+        std::size_t size, std::size_t buffer_size)
+    {
+        HPX_ASSERT(!compress_);
+
+        struct block_info
+        {
+            char const* src_;
+            std::size_t size_;          // zero if stored uncompressed
+            std::size_t offset_;
+            std::size_t uncompressed_size_;
+        };
+
+        // collect the block headers
+        std::vector<block_info> blocks;
+        std::size_t total_size = 0;
+        for (std::size_t pos = 0; pos != size; /**/)
+        {
+            if (pos + detail::block_header_size > size)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "block_binary_filter::init_data",
+                    "archive data bstream is too short");
+                return 0;
+            }
+
+            block_info info;
+            info.uncompressed_size_ = detail::read_uint32(buffer + pos);
+            info.size_ = detail::read_uint32(
+                buffer + pos + sizeof(std::uint32_t));
+            info.offset_ = total_size;
+            pos += detail::block_header_size;
+            info.src_ = buffer + pos;
+
+            std::size_t stored_size =
+                info.size_ != 0 ? info.size_ : info.uncompressed_size_;
+            if (pos + stored_size > size)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "block_binary_filter::init_data",
+                    "archive data bstream is too short");
+                return 0;
+            }
+
+            pos += stored_size;
+            total_size += info.uncompressed_size_;
+            blocks.push_back(info);
+        }
+
+        if (total_size > buffer_size)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "block_binary_filter::init_data",
+                "decompression failure, decompressed data is too large");
+            return 0;
+        }
+
+        buffer_.resize(total_size);
+        current_ = 0;
+
+        // decompress all blocks, concurrently if possible
+        bool concurrently = blocks.size() > 1 && detail::run_concurrently();
+
+        std::vector<hpx::future<void> > decompressed;
+        for (std::size_t i = 0; i != blocks.size(); ++i)
+        {
+            block_info const& info = blocks[i];
+            char* dst = buffer_.data() + info.offset_;
+
+            if (info.size_ == 0)
+            {
+                std::memcpy(dst, info.src_, info.uncompressed_size_);
+            }
+            else if (concurrently)
+            {
+                decompressed.push_back(hpx::async(hpx::launch::async,
+                    &block_binary_filter::decompress_block, this,
+                    info.src_, info.size_, dst, info.uncompressed_size_));
+            }
+            else
+            {
+                decompress_block(info.src_, info.size_, dst,
+                    info.uncompressed_size_);
+            }
+        }
+
+        hpx::wait_all(decompressed);
+        for (hpx::future<void>& f : decompressed)
+            f.get();                    // propagate errors
+
+        return buffer_.size();
+    }
+
+    void block_binary_filter::load(void* dst, std::size_t dst_count)
+    {
+        if (current_ + dst_count > buffer_.size())
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "block_binary_filter::load",
+                "archive data bstream is too short");
+            return;
+        }
+
+        std::memcpy(dst, &buffer_[current_], dst_count);
+        current_ += dst_count;
+    }
+}}
@@ -8,6 +8,10 @@
 
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+
 namespace hpx { namespace serialization { namespace detail
 {
     polymorphic_nonintrusive_factory& polymorphic_nonintrusive_factory::instance()
@@ -15,5 +19,32 @@ namespace hpx { namespace serialization { namespace detail
         hpx::util::static_<polymorphic_nonintrusive_factory> factory;
         return factory.get();
     }
-}}}
 
+    polymorphic_nonintrusive_factory::serializer_entry const&
+    polymorphic_nonintrusive_factory::locate(std::type_info const& typeinfo) const
+    {
+        serializer_typeinfo_map_type::const_iterator it =
+            typeinfo_map_.find(typeinfo.name());
+        if (it == typeinfo_map_.end())
+        {
+            HPX_THROW_EXCEPTION(serialization_error
+              , "polymorphic_nonintrusive_factory::save"
+              , std::string("Unregistered polymorphic type: ") +
+                typeinfo.name());
+        }
+        return it->second;
+    }
+
+    function_bunch_type const&
+    polymorphic_nonintrusive_factory::locate(std::uint32_t id) const
+    {
+        serializer_map_type::const_iterator it = map_.find(id);
+        if (it == map_.end())
+        {
+            HPX_THROW_EXCEPTION(serialization_error
+              , "polymorphic_nonintrusive_factory::load"
+              , "Unknown type id " + std::to_string(id));
+        }
+        return it->second;
+    }
+}}}
@@ -0,0 +1,362 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_cache.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/spinlock.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail
+{
+    namespace
+    {
+        boost::atomic<std::int64_t> stack_allocation_count(0);
+        boost::atomic<std::int64_t> stack_deallocation_count(0);
+        boost::atomic<std::int64_t> stack_cache_hit_count(0);
+    }
+
+    std::int64_t get_stack_allocation_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_allocation_count, reset);
+    }
+
+    std::int64_t get_stack_deallocation_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_deallocation_count, reset);
+    }
+
+    std::int64_t get_stack_cache_hit_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_cache_hit_count, reset);
+    }
+
+#if defined(_POSIX_VERSION)
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t get_cache_magazine_size()
+        {
+            static std::size_t magazine_size =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.stacks.cache_magazine_size", "16"));
+            return magazine_size;
+        }
+
+        std::size_t get_cache_depot_size()
+        {
+            static std::size_t depot_size =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.stacks.cache_depot_size", "256"));
+            return depot_size;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void* allocate_new_stack(std::size_t size)
+        {
+            ++stack_allocation_count;
+            return posix::alloc_stack(size);
+        }
+
+        void free_stack(void* stack, std::size_t size)
+        {
+            ++stack_deallocation_count;
+            posix::free_stack(stack, size);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Cached stacks of one size. There are usually no more than four
+        // different stack sizes in use (small, medium, large, and huge).
+        struct stack_bins
+        {
+            enum { num_bins = 4 };
+
+            struct bin
+            {
+                bin() : size_(0) {}
+
+                std::size_t size_;
+                std::vector<void*> stacks_;
+            };
+
+            ~stack_bins()
+            {
+                for (bin& b : bins_)
+                {
+                    for (void* stack : b.stacks_)
+                        free_stack(stack, b.size_);
+                }
+            }
+
+            // returns nullptr if there is no bin for this size (and no bin
+            // could be created)
+            std::vector<void*>* get(std::size_t size, bool create = false)
+            {
+                for (bin& b : bins_)
+                {
+                    if (b.size_ == size)
+                        return &b.stacks_;
+                }
+
+                if (create)
+                {
+                    for (bin& b : bins_)
+                    {
+                        if (b.size_ == 0)
+                        {
+                            b.size_ = size;
+                            return &b.stacks_;
+                        }
+                    }
+                }
+                return nullptr;
+            }
+
+            bin bins_[num_bins];
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Shared between all worker threads of a NUMA domain.
+        struct stack_depot
+        {
+            typedef hpx::util::spinlock mutex_type;
+
+            // move up to count stacks from the depot to the given vector
+            std::size_t get(std::size_t size, std::vector<void*>& dest,
+                std::size_t count)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                std::vector<void*>* stacks = bins_.get(size);
+                if (stacks == nullptr)
+                    return 0;
+
+                std::size_t moved = 0;
+                while (moved != count && !stacks->empty())
+                {
+                    dest.push_back(stacks->back());
+                    stacks->pop_back();
+                    ++moved;
+                }
+                return moved;
+            }
+
+            // move up to count stacks from the given vector into the depot,
+            // stacks exceeding the high-water mark of the depot are freed
+            void put(std::size_t size, std::vector<void*>& src,
+                std::size_t count)
+            {
+                std::size_t depot_size = get_cache_depot_size();
+                std::vector<void*> excess;
+
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+
+                    std::vector<void*>* stacks = bins_.get(size, true);
+                    while (count-- != 0 && !src.empty())
+                    {
+                        if (stacks != nullptr && stacks->size() < depot_size)
+                            stacks->push_back(src.back());
+                        else
+                            excess.push_back(src.back());
+                        src.pop_back();
+                    }
+                }
+
+                // unmap the stacks outside of the lock
+                for (void* stack : excess)
+                    free_stack(stack, size);
+            }
+
+            mutex_type mtx_;
+            stack_bins bins_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // All depots, indexed by NUMA domain.
+        boost::atomic<bool> depots_alive(false);
+
+        struct stack_depots
+        {
+            typedef hpx::util::spinlock mutex_type;
+
+            stack_depots()
+            {
+                depots_alive.store(true);
+            }
+
+            ~stack_depots()
+            {
+                depots_alive.store(false);
+            }
+
+            stack_depot& get(std::size_t numa_domain)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                std::unique_ptr<stack_depot>& d = depots_[numa_domain];
+                if (!d)
+                    d.reset(new stack_depot);
+                return *d;
+            }
+
+            mutex_type mtx_;
+            std::map<std::size_t, std::unique_ptr<stack_depot> > depots_;
+        };
+
+        stack_depots& get_depots()
+        {
+            static stack_depots depots;
+            return depots;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Owned by exactly one OS thread, no synchronization is needed.
+        struct stack_magazine
+        {
+            explicit stack_magazine(stack_depot& depot)
+              : depot_(depot)
+            {}
+
+            ~stack_magazine()
+            {
+                // return all cached stacks to the depot
+                for (stack_bins::bin& b : bins_.bins_)
+                {
+                    if (b.size_ != 0)
+                        depot_.put(b.size_, b.stacks_, b.stacks_.size());
+                }
+            }
+
+            stack_depot& depot_;
+            stack_bins bins_;
+        };
+
+        HPX_NATIVE_TLS stack_magazine* this_magazine = nullptr;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* allocate_stack(std::size_t size)
+    {
+        std::size_t magazine_size = get_cache_magazine_size();
+        if (magazine_size == 0 || !depots_alive.load(boost::memory_order_relaxed))
+            return allocate_new_stack(size);
+
+        std::vector<void*>* stacks = nullptr;
+        if (this_magazine != nullptr)
+        {
+            stacks = this_magazine->bins_.get(size, true);
+            if (stacks != nullptr)
+            {
+                // refill half of the magazine from the depot, if needed
+                if (stacks->empty())
+                {
+                    this_magazine->depot_.get(size, *stacks,
+                        (magazine_size + 1) / 2);
+                }
+
+                if (!stacks->empty())
+                {
+                    ++stack_cache_hit_count;
+
+                    void* stack = stacks->back();
+                    stacks->pop_back();
+                    return stack;
+                }
+            }
+        }
+        else
+        {
+            std::vector<void*> dest;
+            if (get_depots().get(0).get(size, dest, 1) != 0)
+            {
+                ++stack_cache_hit_count;
+                return dest.back();
+            }
+        }
+
+        return allocate_new_stack(size);
+    }
+
+    void deallocate_stack(void* stack, std::size_t size)
+    {
+        std::size_t magazine_size = get_cache_magazine_size();
+        if (magazine_size == 0 || !depots_alive.load(boost::memory_order_relaxed))
+        {
+            free_stack(stack, size);
+            return;
+        }
+
+        if (this_magazine != nullptr)
+        {
+            std::vector<void*>* stacks = this_magazine->bins_.get(size, true);
+            if (stacks != nullptr)
+            {
+                // hand half of the stacks to the depot if the magazine is full
+                if (stacks->size() >= magazine_size)
+                {
+                    this_magazine->depot_.put(size, *stacks,
+                        (magazine_size + 1) / 2);
+                }
+
+                stacks->push_back(stack);
+                return;
+            }
+        }
+        else
+        {
+            std::vector<void*> src(1, stack);
+            get_depots().get(0).put(size, src, 1);
+            return;
+        }
+
+        free_stack(stack, size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    thread_stack_cache::thread_stack_cache(std::size_t numa_domain)
+      : owns_magazine_(false)
+    {
+        if (get_cache_magazine_size() != 0 && this_magazine == nullptr)
+        {
+            this_magazine = new stack_magazine(get_depots().get(numa_domain));
+            owns_magazine_ = true;
+        }
+    }
+
+    thread_stack_cache::~thread_stack_cache()
+    {
+        if (owns_magazine_)
+        {
+            delete this_magazine;
+            this_magazine = nullptr;
+        }
+    }
+
+#else
+
+    ///////////////////////////////////////////////////////////////////////////
+    thread_stack_cache::thread_stack_cache(std::size_t)
+      : owns_magazine_(false)
+    {
+    }
+
+    thread_stack_cache::~thread_stack_cache()
+    {
+    }
+#endif
+}}}}
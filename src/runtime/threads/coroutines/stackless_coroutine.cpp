@@ -0,0 +1,75 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/coroutines/detail/coroutine_self.hpp>
+#include <hpx/runtime/threads/coroutines/exception.hpp>
+#include <hpx/runtime/threads/coroutines/stackless_coroutine.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <utility>
+
+namespace hpx { namespace threads { namespace coroutines
+{
+    namespace
+    {
+        struct reset_self_on_exit
+        {
+            reset_self_on_exit(detail::coroutine_self* self,
+                    detail::coroutine_self* old_self)
+              : old_self_(old_self)
+            {
+                detail::coroutine_self::set_self(self);
+            }
+
+            ~reset_self_on_exit()
+            {
+                detail::coroutine_self::set_self(old_self_);
+            }
+
+            detail::coroutine_self* old_self_;
+        };
+    }
+
+    stackless_coroutine::result_type stackless_coroutine::operator()(
+        arg_type arg)
+    {
+        HPX_ASSERT(is_ready());
+        HPX_ASSERT(f_);
+
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+        ++phase_;
+#endif
+        running_ = true;
+
+        result_type result(terminated, nullptr);
+        try
+        {
+            detail::coroutine_self* old_self = detail::coroutine_self::get_self();
+            detail::coroutine_self self(this, old_self);
+            reset_self_on_exit on_exit(&self, old_self);
+
+            result = f_(arg);
+        }
+        catch (exit_exception const&) {
+            // the thread requested to exit, this is not an error
+            result = result_type(terminated, nullptr);
+        }
+        catch (...) {
+            running_ = false;
+            reset();
+            throw;
+        }
+
+        running_ = false;
+
+        // if this thread returned 'terminated' we need to reset the functor
+        if (result.first == terminated)
+            reset();
+
+        return result;
+    }
+}}}
@@ -10,7 +10,9 @@
 #include <hpx/state.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/lcos/local/no_mutex.hpp>
+#include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_cache.hpp>
 #include <hpx/runtime/threads/detail/create_thread.hpp>
 #include <hpx/runtime/threads/detail/create_work.hpp>
 #include <hpx/runtime/threads/detail/scheduling_loop.hpp>
@@ -23,6 +25,7 @@
 #include <hpx/util/logging.hpp>
 #include <hpx/util/hardware/timestamp.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
 #include <hpx/util/thread_specific_ptr.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
@@ -34,6 +37,7 @@
 #include <boost/thread/thread.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
@@ -286,6 +290,14 @@ namespace hpx { namespace threads { namespace detail
         return sched_.set_scheduler_mode(mode);
     }
 
+    template <typename Scheduler>
+    void thread_pool<Scheduler>::remove_scheduler_mode(
+        threads::policies::scheduler_mode mode)
+    {
+        mode_ = policies::scheduler_mode(mode_ & ~mode);
+        sched_.set_scheduler_mode(mode_);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Scheduler>
     bool thread_pool<Scheduler>::run(std::unique_lock<boost::mutex>& l,
@@ -387,6 +399,28 @@ namespace hpx { namespace threads { namespace detail
             << "thread_pool::run: " << pool_name_
             << " timestamp_scale: " << timestamp_scale_; //-V128
 
+        // park idle worker threads, if requested
+        if (hpx::util::safe_lexical_cast<int>(
+                hpx::get_config_entry("hpx.idle_parking", 0)) != 0)
+        {
+            std::int64_t spin_count =
+                hpx::util::safe_lexical_cast<std::int64_t>(
+                    hpx::get_config_entry("hpx.idle_parking_spin_count",
+                        HPX_IDLE_PARKING_SPIN_COUNT));
+            std::int64_t max_time =
+                hpx::util::safe_lexical_cast<std::int64_t>(
+                    hpx::get_config_entry("hpx.idle_parking_max_time",
+                        HPX_IDLE_PARKING_MAX_TIME));
+
+            sched_.Scheduler::enable_idle_parking(spin_count,
+                std::chrono::microseconds(max_time));
+
+            LTM_(info)
+                << "thread_pool::run: " << pool_name_
+                << " idle parking enabled, spin_count: " << spin_count
+                << ", max_time: " << max_time << "us"; //-V128
+        }
+
         try {
             HPX_ASSERT(startup_.get() == nullptr);
             startup_.reset(
@@ -497,6 +531,7 @@ namespace hpx { namespace threads { namespace detail
 
             // make sure we're not waiting
             sched_.Scheduler::do_some_work(std::size_t(-1));
+            sched_.Scheduler::unpark_all();
 
             if (blocking) {
                 for (std::size_t i = 0; i != threads_.size(); ++i)
@@ -507,6 +542,7 @@ namespace hpx { namespace threads { namespace detail
                         << " notify_all";
 
                     sched_.Scheduler::do_some_work(std::size_t(-1));
+                    sched_.Scheduler::unpark_all();
 
                     LTM_(info) //-V128
                         << "thread_pool::stop: " << pool_name_
@@ -607,6 +643,17 @@ namespace hpx { namespace threads { namespace detail
         // manage the number of this thread in its TSS
         init_tss_helper<Scheduler> tss_helper(*this, num_thread);
 
+        // cache coroutine stacks for this thread, stacks are exchanged with
+        // the other threads running in the same NUMA domain
+        std::size_t numa_domain = topology.get_numa_node_number(
+            sched_.Scheduler::get_pu_num(num_thread), ec);
+        if (ec)
+        {
+            numa_domain = 0;
+            ec = error_code(lightweight);
+        }
+        coroutines::detail::thread_stack_cache stack_cache(numa_domain);
+
         // wait for all threads to start up before before starting HPX work
         startup.wait();
 
@@ -1467,6 +1514,10 @@ template class HPX_EXPORT hpx::threads::detail::thread_pool<
     hpx::threads::policies::local_priority_queue_scheduler<
         boost::mutex, hpx::threads::policies::lockfree_lifo
     > >;
+template class HPX_EXPORT hpx::threads::detail::thread_pool<
+    hpx::threads::policies::local_priority_queue_scheduler<
+        boost::mutex, hpx::threads::policies::lockfree_chase_lev
+    > >;
 
 #if defined(HPX_HAVE_ABP_SCHEDULER)
 template class HPX_EXPORT hpx::threads::detail::thread_pool<
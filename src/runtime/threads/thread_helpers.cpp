@@ -9,9 +9,11 @@
 #include <hpx/error_code.hpp>
 #include <hpx/exception.hpp>
 #include <hpx/runtime.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/state.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/runtime/threads/detail/set_thread_state.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
 #include <hpx/runtime/threads/executors/current_executor.hpp>
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
@@ -376,6 +378,17 @@ namespace hpx { namespace threads
 
         return executors::current_executor(id->get_scheduler_base());
     }
+
+    std::int64_t get_local_queue_length()
+    {
+        thread_self* self = get_self_ptr();
+        if (HPX_UNLIKELY(self == nullptr))
+            return 0;
+
+        thread_id_type id = get_self_id();
+        return id->get_scheduler_base()->get_queue_length(
+            hpx::get_worker_thread_num());
+    }
 }}
 
 namespace hpx { namespace this_thread
@@ -454,6 +467,23 @@ namespace hpx { namespace this_thread
         threads::interruption_point(id, ec);
         if (ec) return threads::wait_unknown;
 
+        // stackless threads run to completion, they can't be suspended
+        if (HPX_UNLIKELY(self.is_stackless()))
+        {
+            if (state != threads::pending)
+            {
+                HPX_THROWS_IF(ec, invalid_status, "this_thread::suspend",
+                    "a thread running without a stack of its own "
+                    "(thread_stacksize_nostack) cannot be suspended");
+                return threads::wait_unknown;
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+
+            return threads::wait_signaled;
+        }
+
         threads::thread_state_ex_enum statex = threads::wait_unknown;
 
         {
@@ -498,7 +528,7 @@ namespace hpx { namespace this_thread
         threads::thread_id_type const& nextid,
         util::thread_description const& description, error_code& ec)
     {
-        // schedule a thread waking us up at_time
+        // arm a timer waking us up at_time
         threads::thread_self& self = threads::get_self();
         threads::thread_id_type id = threads::get_self_id();
 
@@ -506,6 +536,15 @@ namespace hpx { namespace this_thread
         threads::interruption_point(id, ec);
         if (ec) return threads::wait_unknown;
 
+        // stackless threads run to completion, they can't be suspended
+        if (HPX_UNLIKELY(self.is_stackless()))
+        {
+            HPX_THROWS_IF(ec, invalid_status, "this_thread::suspend",
+                "a thread running without a stack of its own "
+                "(thread_stacksize_nostack) cannot be suspended");
+            return threads::wait_unknown;
+        }
+
         // let the thread manager do other things while waiting
         threads::thread_state_ex_enum statex = threads::wait_unknown;
 
@@ -520,22 +559,21 @@ namespace hpx { namespace this_thread
 #ifdef HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION
             detail::reset_backtrace bt(id, ec);
 #endif
-            threads::thread_id_type timer_id = threads::set_thread_state(id,
-                abs_time, threads::pending, threads::wait_timeout,
-                threads::thread_priority_boost, ec);
-            if (ec) return threads::wait_unknown;
+            // the timer is expired by the scheduling loop of the worker
+            // thread we are running on
+            threads::detail::timer_wheel::entry timer;
+            threads::detail::timer_wheel& wheel =
+                id->get_scheduler_base()->get_timer_wheel(
+                    hpx::get_worker_thread_num());
+            wheel.arm(timer, id, abs_time.value());
 
             // suspend the HPX-thread
             statex = self.yield(
                 threads::thread_result_type(threads::suspended, nextid));
 
-            if (statex != threads::wait_timeout)
-            {
-                error_code ec1(lightweight);    // do not throw
-                threads::set_thread_state(timer_id,
-                    threads::pending, threads::wait_abort,
-                    threads::thread_priority_boost, ec1);
-            }
+            // the timer has to be removed from the wheel before it goes out
+            // of scope, even if we were woken up for another reason
+            wheel.cancel(timer);
         }
 
         // handle interruption, if needed
@@ -13,6 +13,7 @@
 #include <hpx/performance_counters/manage_counter_type.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/runtime/threads/threadmanager_impl.hpp>
+#include <hpx/runtime/threads/coroutines/detail/stack_cache.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
@@ -133,6 +134,11 @@ namespace hpx { namespace threads
     {
         if (size == thread_stacksize_unknown)
             return "unknown";
+        if (size == thread_stacksize_nostack ||
+            size == coroutines::detail::nostack_stack_size)
+        {
+            return "nostack";
+        }
 
         util::runtime_configuration const& rtcfg = hpx::get_config();
         if (rtcfg.get_stack_size(thread_stacksize_small) == size)
@@ -900,6 +906,21 @@ namespace hpx { namespace threads
               util::function_nonser<std::uint64_t(bool)>(), "", 0
             },
 #endif
+            // /threads{locality#%d/total}/count/stack-allocations
+            { "count/stack-allocations",
+              util::bind(&coroutines::detail::get_stack_allocation_count, _1),
+              util::function_nonser<std::uint64_t(bool)>(), "", 0
+            },
+            // /threads{locality#%d/total}/count/stack-deallocations
+            { "count/stack-deallocations",
+              util::bind(&coroutines::detail::get_stack_deallocation_count, _1),
+              util::function_nonser<std::uint64_t(bool)>(), "", 0
+            },
+            // /threads{locality#%d/total}/count/stack-cache-hits
+            { "count/stack-cache-hits",
+              util::bind(&coroutines::detail::get_stack_cache_hit_count, _1),
+              util::function_nonser<std::uint64_t(bool)>(), "", 0
+            },
             // /threads{locality#%d/total}/count/objects
             // /threads{locality#%d/allocator%d}/count/objects
             { "count/objects",
@@ -1164,6 +1185,27 @@ namespace hpx { namespace threads
               ""
             },
 #endif
+            { "/threads/count/stack-allocations", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stacks allocated from the "
+              "operating system (mmap) for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stack-deallocations", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stacks returned to the "
+              "operating system (munmap) for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stack-cache-hits", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stack allocations served "
+              "from the stack cache for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              ""
+            },
             { "/threads/count/objects", performance_counters::counter_raw,
               "returns the overall number of created HPX-thread objects for "
               "the referenced locality", HPX_PERFORMANCE_COUNTER_V1,
@@ -1429,6 +1471,10 @@ template class HPX_EXPORT hpx::threads::threadmanager_impl<
     hpx::threads::policies::local_priority_queue_scheduler<
         boost::mutex, hpx::threads::policies::lockfree_lifo
     > >;
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::local_priority_queue_scheduler<
+        boost::mutex, hpx::threads::policies::lockfree_chase_lev
+    > >;
 
 #if defined(HPX_HAVE_ABP_SCHEDULER)
 template class HPX_EXPORT hpx::threads::threadmanager_impl<
@@ -318,9 +318,20 @@ namespace hpx {
         lbt_ << "(1st stage) runtime_impl::start: started the application "
                       "I/O service pool";
 
+        // the background work is done by the parcel layer progress threads,
+        // if those are enabled
+        if (parcel_handler_.get_num_progress_threads() != 0)
+        {
+            thread_manager_->remove_scheduler_mode(
+                threads::policies::do_background_work);
+        }
+
         // start the thread manager
         thread_manager_->run(num_threads_);
         lbt_ << "(1st stage) runtime_impl::start: started threadmanager";
+
+        // start the parcel layer progress threads (if any)
+        parcel_handler_.start_progress_threads();
         // }}}
 
         // invoke the AGAS v2 notifications
@@ -482,6 +493,10 @@ namespace hpx {
             runtime_support_->stopped();         // re-activate shutdown HPX-thread
             thread_manager_->stop(blocking);     // wait for thread manager
 
+            // the parcel layer progress threads (if any) keep polling the
+            // parcel ports while the thread manager drains
+            parcel_handler_.stop_progress_threads();
+
             // this disables all logging from the main thread
             deinit_tss();
 
@@ -506,6 +521,10 @@ namespace hpx {
         runtime_support_->stopped();         // re-activate shutdown HPX-thread
         thread_manager_->stop(blocking);     // wait for thread manager
 
+        // the parcel layer progress threads (if any) keep polling the parcel
+        // ports while the thread manager drains
+        parcel_handler_.stop_progress_threads();
+
         // this disables all logging from the main thread
         deinit_tss();
 
@@ -876,6 +895,10 @@ template class HPX_EXPORT hpx::runtime_impl<
     hpx::threads::policies::local_priority_queue_scheduler<
         boost::mutex, hpx::threads::policies::lockfree_lifo
     > >;
+template class HPX_EXPORT hpx::runtime_impl<
+    hpx::threads::policies::local_priority_queue_scheduler<
+        boost::mutex, hpx::threads::policies::lockfree_chase_lev
+    > >;
 
 #if defined(HPX_HAVE_ABP_SCHEDULER)
 template class HPX_EXPORT hpx::runtime_impl<
@@ -0,0 +1,150 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/detail/thread_num_tss.hpp>
+#include <hpx/util/pooled_allocator.hpp>
+#include <hpx/util/spinlock.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace hpx { namespace util { namespace detail
+{
+    namespace
+    {
+        enum
+        {
+            num_caches = 64,                    // max. number of workers served
+            block_granularity = 16,             // sizes are rounded up to this
+            num_size_classes = 32,              // blocks up to 512 bytes
+            max_cached_bytes = 256 * 1024       // per size class and worker
+        };
+
+        struct free_block
+        {
+            free_block* next_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The cache is almost exclusively accessed by the worker thread it
+        // belongs to, the lock protects against the rare cases where OS
+        // threads share a cache.
+        struct block_cache
+        {
+            block_cache()
+            {
+                for (std::size_t i = 0; i != num_size_classes; ++i)
+                {
+                    free_lists_[i] = nullptr;
+                    counts_[i] = 0;
+                }
+            }
+
+            ~block_cache()
+            {
+                for (std::size_t i = 0; i != num_size_classes; ++i)
+                {
+                    while (free_block* b = free_lists_[i])
+                    {
+                        free_lists_[i] = b->next_;
+                        ::operator delete(b);
+                    }
+                    counts_[i] = 0;
+                }
+            }
+
+            void* allocate(std::size_t size_class)
+            {
+                {
+                    std::lock_guard<util::spinlock> l(mtx_);
+                    free_block* b = free_lists_[size_class];
+                    if (b != nullptr)
+                    {
+                        free_lists_[size_class] = b->next_;
+                        --counts_[size_class];
+                        return b;
+                    }
+                }
+                return ::operator new((size_class + 1) * block_granularity);
+            }
+
+            void deallocate(void* p, std::size_t size_class)
+            {
+                std::size_t const max_count =
+                    max_cached_bytes / ((size_class + 1) * block_granularity);
+
+                {
+                    std::lock_guard<util::spinlock> l(mtx_);
+                    if (counts_[size_class] < max_count)
+                    {
+                        free_block* b = static_cast<free_block*>(p);
+                        b->next_ = free_lists_[size_class];
+                        free_lists_[size_class] = b;
+                        ++counts_[size_class];
+                        return;
+                    }
+                }
+                ::operator delete(p);
+            }
+
+            util::spinlock mtx_;
+            free_block* free_lists_[num_size_classes];
+            std::size_t counts_[num_size_classes];
+
+            // place each cache on a separate cache line
+            char padding_[64];
+        };
+
+        block_cache* get_block_cache()
+        {
+            std::size_t num_thread =
+                threads::detail::thread_num_tss_.get_worker_thread_num();
+            if (num_thread == std::size_t(-1))
+                return nullptr;
+
+            static block_cache caches[num_caches];
+            return &caches[num_thread % num_caches];
+        }
+
+        std::size_t get_size_class(std::size_t size)
+        {
+            return size == 0 ? 0 : (size - 1) / block_granularity;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* pooled_allocate(std::size_t size)
+    {
+        std::size_t const size_class = get_size_class(size);
+        if (size_class < num_size_classes)
+        {
+            if (block_cache* cache = get_block_cache())
+                return cache->allocate(size_class);
+
+            // allocate the full block to allow for it to be cached later on
+            return ::operator new((size_class + 1) * block_granularity);
+        }
+        return ::operator new(size);
+    }
+
+    void pooled_deallocate(void* p, std::size_t size) HPX_NOEXCEPT
+    {
+        if (p == nullptr)
+            return;
+
+        std::size_t const size_class = get_size_class(size);
+        if (size_class < num_size_classes)
+        {
+            if (block_cache* cache = get_block_cache())
+            {
+                cache->deallocate(p, size_class);
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+}}}
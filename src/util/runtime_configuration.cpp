@@ -9,6 +9,7 @@
 #include <hpx/config/defaults.hpp>
 // TODO: move parcel ports into plugins
 #include <hpx/runtime/parcelset/parcelhandler.hpp>
+#include <hpx/runtime/threads/coroutines/stackless_coroutine.hpp>
 #include <hpx/util/filesystem_compatibility.hpp>
 #include <hpx/util/find_prefix.hpp>
 #include <hpx/util/init_ini_data.hpp>
@@ -193,6 +194,11 @@ namespace hpx { namespace util
                 BOOST_STRINGIZE(HPX_IDLE_LOOP_COUNT_MAX) "}",
             "max_busy_loop_count = ${HPX_MAX_BUSY_LOOP_COUNT:"
                 BOOST_STRINGIZE(HPX_BUSY_LOOP_COUNT_MAX) "}",
+            "idle_parking = ${HPX_IDLE_PARKING:0}",
+            "idle_parking_spin_count = ${HPX_IDLE_PARKING_SPIN_COUNT:"
+                BOOST_STRINGIZE(HPX_IDLE_PARKING_SPIN_COUNT) "}",
+            "idle_parking_max_time = ${HPX_IDLE_PARKING_MAX_TIME:"
+                BOOST_STRINGIZE(HPX_IDLE_PARKING_MAX_TIME) "}",
 
             // arity for collective operations implemented in a tree fashion
             "[hpx.lcos.collectives]",
@@ -221,6 +227,8 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
 #endif
+            "cache_magazine_size = ${HPX_STACKS_CACHE_MAGAZINE_SIZE:16}",
+            "cache_depot_size = ${HPX_STACKS_CACHE_DEPOT_SIZE:256}",
 
             "[hpx.threadpools]",
             "io_pool_size = ${HPX_NUM_IO_POOL_SIZE:"
@@ -238,6 +246,8 @@ namespace hpx { namespace util
             "min_add_new_count = ${HPX_THREAD_QUEUE_MIN_ADD_NEW_COUNT:10}",
             "max_add_new_count = ${HPX_THREAD_QUEUE_MAX_ADD_NEW_COUNT:10}",
             "max_delete_count = ${HPX_THREAD_QUEUE_MAX_DELETE_COUNT:1000}",
+            "max_thread_heap_count = "
+                "${HPX_THREAD_QUEUE_MAX_THREAD_HEAP_COUNT:1000}",
 
             "[hpx.commandline]",
             // enable aliasing
@@ -1021,6 +1031,9 @@ namespace hpx { namespace util
         case threads::thread_stacksize_huge:
             return huge_stacksize;
 
+        case threads::thread_stacksize_nostack:
+            return threads::coroutines::detail::nostack_stack_size;
+
         default:
         case threads::thread_stacksize_small:
             break;
@@ -21,8 +21,10 @@
 #include <boost/accumulators/accumulators.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <iomanip>
 #include <iostream>
 #include <map>
 #include <string>
@@ -214,6 +216,82 @@ void test_update(gva_cache_type& cache, hpx::naming::gid_type first_key)
     calculate_histogram("update", timings);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Resolve cached addresses through the AGAS client from the given number of
+// HPX threads, each thread walks the cached ids starting at a different
+// offset.
+void test_concurrent_resolve(std::vector<hpx::naming::gid_type> const& ids,
+    std::size_t num_threads, std::size_t num_lookups)
+{
+    hpx::naming::resolver_client& agas_client = hpx::naming::get_agas_client();
+
+    std::size_t const num_entries = ids.size();
+    std::atomic<std::size_t> misses(0);
+
+    std::vector<hpx::future<void> > threads;
+    threads.reserve(num_threads);
+
+    std::uint64_t t = hpx::util::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        threads.push_back(hpx::async(
+            [&, i]()
+            {
+                std::size_t local_misses = 0;
+                for (std::size_t j = 0; j != num_lookups; ++j)
+                {
+                    std::size_t n = (i * num_entries / num_threads + j) %
+                        num_entries;
+
+                    hpx::naming::address addr;
+                    if (!agas_client.resolve_cached(ids[n], addr))
+                        ++local_misses;
+                }
+                misses += local_misses;
+            }));
+    }
+    hpx::wait_all(threads);
+
+    std::uint64_t elapsed = hpx::util::high_resolution_clock::now() - t;
+
+    std::cout << std::setw(3) << num_threads << " threads: "
+        << std::setprecision(3)
+        << double(elapsed) / num_lookups << " ns/lookup, "
+        << double(num_threads * num_lookups) / (elapsed / 1e9)
+        << " lookups/s, " << misses << " misses" << std::endl;
+}
+
+void test_contention(std::size_t num_entries, std::size_t num_lookups)
+{
+    hpx::naming::resolver_client& agas_client = hpx::naming::get_agas_client();
+
+    // the cache is consulted only for ids managed by other localities
+    std::uint32_t const remote_locality_id = hpx::get_locality_id() + 1;
+    hpx::naming::gid_type const remote_locality =
+        hpx::naming::get_gid_from_locality_id(remote_locality_id);
+    std::uint32_t ct = hpx::components::component_invalid;
+
+    std::vector<hpx::naming::gid_type> ids;
+    ids.reserve(num_entries);
+    for (std::size_t i = 0; i != num_entries; ++i)
+    {
+        hpx::naming::gid_type id = hpx::naming::replace_locality_id(
+            hpx::detail::get_next_id(), remote_locality_id);
+        agas_client.update_cache_entry(id,
+            hpx::agas::gva(remote_locality, ct, 1, std::uint64_t(0), 0));
+        ids.push_back(id);
+    }
+
+    std::size_t const num_os_threads = hpx::get_os_thread_count();
+    for (std::size_t n = 1; n < num_os_threads; n *= 2)
+        test_concurrent_resolve(ids, n, num_lookups);
+    test_concurrent_resolve(ids, num_os_threads, num_lookups);
+
+    for (hpx::naming::gid_type const& id : ids)
+        agas_client.remove_cache_entry(id);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -225,6 +303,17 @@ int hpx_main(boost::program_options::variables_map& vm)
     if (vm.count("num_entries"))
         num_entries = vm["num_entries"].as<std::size_t>();
 
+    if (vm.count("contention"))
+    {
+        std::size_t num_lookups = 100000;
+        if (vm.count("num_lookups"))
+            num_lookups = vm["num_lookups"].as<std::size_t>();
+
+        test_contention(num_entries, num_lookups);
+
+        return hpx::finalize();
+    }
+
     gva_cache_type cache;
     cache.reserve(cache_size);
 
@@ -249,6 +338,12 @@ int main(int argc, char* argv[])
          BOOST_PP_STRINGIZE(HPX_AGAS_LOCAL_CACHE_SIZE_PER_THREAD) ")")
         ("num_entries,n", value<std::size_t>(),
          "number of items to insert into cache (default: 1000)")
+        ("contention",
+         "measure concurrent cached address resolutions through AGAS with an "
+         "increasing number of threads (the AGAS cache size is set by "
+         "hpx.agas.local_cache_size)")
+        ("num_lookups", value<std::size_t>(),
+         "number of lookups per thread for --contention (default: 100000)")
         ;
 
     // Initialize and run HPX
@@ -12,6 +12,7 @@
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
 
 #include <boost/format.hpp>
 
@@ -60,6 +61,11 @@ struct scratcher
     {
         global_scratch += r.get();
     }
+
+    void operator()(hpx::shared_future<double> r) const
+    {
+        global_scratch += r.get();
+    }
 };
 
 void measure_action_futures(std::uint64_t count, bool csv)
@@ -121,6 +127,47 @@ void measure_function_futures(std::uint64_t count, bool csv)
               << flush;
 }
 
+// attach many continuations to the same future before it becomes ready
+void measure_continuation_fanout(std::uint64_t count, std::uint64_t fanout,
+    bool csv)
+{
+    std::vector<future<void> > continuations;
+    continuations.reserve(fanout);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; i += fanout)
+    {
+        hpx::lcos::local::promise<double> p;
+        hpx::shared_future<double> f = p.get_future();
+
+        for (std::uint64_t j = 0; j < fanout; ++j)
+            continuations.push_back(f.then(hpx::launch::sync, scratcher()));
+
+        p.set_value(null_function());
+
+        hpx::wait_all(continuations);
+        continuations.clear();
+    }
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    if (csv)
+        cout << ( boost::format("%1%,%2%\n")
+                % count
+                % duration)
+              << flush;
+    else
+        cout << ( boost::format("attached %1% continuations (fan-out %2%) "
+                    "in %3% seconds\n")
+                % count
+                % fanout
+                % duration)
+              << flush;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map& vm
@@ -136,6 +183,13 @@ int hpx_main(
 
         measure_action_futures(count, vm.count("csv") != 0);
         measure_function_futures(count, vm.count("csv") != 0);
+
+        const std::uint64_t fanout = vm["continuations"].as<std::uint64_t>();
+        if (fanout != 0)
+        {
+            measure_continuation_fanout(count, fanout,
+                vm.count("csv") != 0);
+        }
     }
 
     finalize();
@@ -160,6 +214,11 @@ int main(
         , value<std::uint64_t>()->default_value(0)
         , "number of iterations in the delay loop")
 
+        ( "continuations"
+        , value<std::uint64_t>()->default_value(16)
+        , "number of continuations attached to each future in the fan-out "
+          "measurement (0 disables the measurement)")
+
         ( "csv"
         , "output results as csv (format: count,duration)")
         ;
@@ -0,0 +1,220 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the executor parameters controlling the scheduling
+// of parallel loops for loops with a skewed per-iteration cost: the first
+// skew_fraction of all iterations take skew_factor times longer than the
+// remaining ones.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/parallel_transform.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include "worker_timed.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <numeric>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t delay = 1000;
+std::uint64_t skew_factor = 10;
+std::size_t skewed_iterations = 0;
+int test_count = 100;
+std::size_t chunk_size = 0;
+bool csvoutput = false;
+
+inline std::uint64_t iteration_delay(std::size_t i)
+{
+    return i < skewed_iterations ? delay * skew_factor : delay;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+std::uint64_t average_out(F && f)
+{
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i != test_count; ++i)
+        f();
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
+template <typename Parameters>
+void measure(char const* name, Parameters params,
+    std::vector<std::size_t> const& data)
+{
+    using namespace hpx::parallel;
+
+    std::vector<std::size_t> dest(data.size());
+    auto policy = execution::par.with(params);
+
+    std::uint64_t for_each_time = average_out(
+        [&]()
+        {
+            for_each(policy, data.begin(), data.end(),
+                [](std::size_t i)
+                {
+                    worker_timed(iteration_delay(i));
+                });
+        });
+
+    std::uint64_t for_loop_time = average_out(
+        [&]()
+        {
+            for_loop(policy, std::size_t(0), data.size(),
+                [](std::size_t i)
+                {
+                    worker_timed(iteration_delay(i));
+                });
+        });
+
+    std::uint64_t transform_time = average_out(
+        [&]()
+        {
+            transform(policy, data.begin(), data.end(), dest.begin(),
+                [](std::size_t i) -> std::size_t
+                {
+                    worker_timed(iteration_delay(i));
+                    return i;
+                });
+        });
+
+    // the elements are the iteration indices, the cost of combining partial
+    // results is the one of a cheap iteration
+    std::uint64_t reduce_time = average_out(
+        [&]()
+        {
+            reduce(policy, data.begin(), data.end(), std::size_t(0),
+                [](std::size_t lhs, std::size_t rhs) -> std::size_t
+                {
+                    worker_timed(iteration_delay(rhs));
+                    return lhs + rhs;
+                });
+        });
+
+    if (csvoutput)
+    {
+        hpx::cout << name
+            << "," << for_each_time / 1e9
+            << "," << for_loop_time / 1e9
+            << "," << transform_time / 1e9
+            << "," << reduce_time / 1e9 << "\n" << hpx::flush;
+    }
+    else
+    {
+        hpx::cout << std::left << std::setw(12) << name << std::right
+            << std::setw(12) << for_each_time / 1e9
+            << std::setw(12) << for_loop_time / 1e9
+            << std::setw(12) << transform_time / 1e9
+            << std::setw(12) << reduce_time / 1e9 << "\n" << hpx::flush;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t vector_size = vm["vector_size"].as<std::size_t>();
+    double skew_fraction = vm["skew_fraction"].as<double>();
+    delay = vm["work_delay"].as<std::uint64_t>();
+    skew_factor = vm["skew_factor"].as<std::uint64_t>();
+    test_count = vm["test_count"].as<int>();
+    chunk_size = vm["chunk_size"].as<std::size_t>();
+    csvoutput = vm["csv_output"].as<int>() ? true : false;
+
+    if (test_count <= 0)
+    {
+        hpx::cout << "test_count cannot be zero or negative...\n"
+                  << hpx::flush;
+        return hpx::finalize();
+    }
+    if (skew_fraction < 0. || skew_fraction > 1.)
+    {
+        hpx::cout << "skew_fraction has to be in [0, 1]...\n" << hpx::flush;
+        return hpx::finalize();
+    }
+
+    skewed_iterations = std::size_t(skew_fraction * vector_size);
+
+    std::vector<std::size_t> data(vector_size);
+    std::iota(data.begin(), data.end(), std::size_t(0));
+
+    if (!csvoutput)
+    {
+        hpx::cout
+            << "Vector size: " << vector_size << "\n"
+            << "Delay per iteration (nanoseconds): " << delay << "\n"
+            << "Skewed iterations: " << skewed_iterations
+                << " (" << skew_factor << " times the delay)\n"
+            << "Average execution time (seconds):\n"
+            << std::left << std::setw(12) << "parameters" << std::right
+            << std::setw(12) << "for_each"
+            << std::setw(12) << "for_loop"
+            << std::setw(12) << "transform"
+            << std::setw(12) << "reduce" << "\n" << hpx::flush;
+    }
+
+    using namespace hpx::parallel;
+
+    measure("static", static_chunk_size(chunk_size), data);
+    measure("auto", auto_chunk_size(), data);
+    measure("dynamic", dynamic_chunk_size(chunk_size ? chunk_size : 1), data);
+    measure("guided", guided_chunk_size(chunk_size ? chunk_size : 1), data);
+    measure("lazy_split", lazy_split_chunk_size(chunk_size), data);
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "vector_size"
+        , boost::program_options::value<std::size_t>()->default_value(10000)
+        , "number of loop iterations")
+
+        ( "work_delay"
+        , boost::program_options::value<std::uint64_t>()->default_value(1000)
+        , "delay of a cheap iteration in nanoseconds")
+
+        ( "skew_fraction"
+        , boost::program_options::value<double>()->default_value(0.1)
+        , "fraction of expensive iterations (at the start of the loop)")
+
+        ( "skew_factor"
+        , boost::program_options::value<std::uint64_t>()->default_value(10)
+        , "ratio of the delays of an expensive and a cheap iteration")
+
+        ( "test_count"
+        , boost::program_options::value<int>()->default_value(10)
+        , "number of tests to be averaged")
+
+        ( "chunk_size"
+        , boost::program_options::value<std::size_t>()->default_value(0)
+        , "chunk size passed to the executor parameters (0: default)")
+
+        ( "csv_output"
+        , boost::program_options::value<int>()->default_value(0)
+        , "print results in csv format")
+        ;
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
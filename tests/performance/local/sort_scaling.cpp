@@ -0,0 +1,214 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/include/iostreams.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int test_count = 10;
+bool stable = false;
+bool custom_compare = false;
+
+std::vector<double> input;
+
+///////////////////////////////////////////////////////////////////////////////
+// the default comparison operator allows using radix sort, std::greater
+// forces a comparison based sort
+template <typename ExPolicy>
+std::uint64_t measure_sort(ExPolicy && policy)
+{
+    std::vector<double> data(input);
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    if (stable)
+    {
+        if (custom_compare)
+            hpx::parallel::stable_sort(policy, data.begin(), data.end(),
+                std::greater<double>());
+        else
+            hpx::parallel::stable_sort(policy, data.begin(), data.end());
+    }
+    else
+    {
+        if (custom_compare)
+            hpx::parallel::sort(policy, data.begin(), data.end(),
+                std::greater<double>());
+        else
+            hpx::parallel::sort(policy, data.begin(), data.end());
+    }
+
+    return hpx::util::high_resolution_clock::now() - start;
+}
+
+template <typename ExPolicy>
+std::uint64_t measure_sort_task(ExPolicy && policy)
+{
+    std::vector<double> data(input);
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    if (stable)
+    {
+        if (custom_compare)
+            hpx::parallel::stable_sort(policy, data.begin(), data.end(),
+                std::greater<double>()).wait();
+        else
+            hpx::parallel::stable_sort(policy, data.begin(), data.end())
+                .wait();
+    }
+    else
+    {
+        if (custom_compare)
+            hpx::parallel::sort(policy, data.begin(), data.end(),
+                std::greater<double>()).wait();
+        else
+            hpx::parallel::sort(policy, data.begin(), data.end()).wait();
+    }
+
+    return hpx::util::high_resolution_clock::now() - start;
+}
+
+std::uint64_t average_out_sequential()
+{
+    std::uint64_t time = 0;
+    for (auto i = 0; i < test_count; i++)
+        time += measure_sort(hpx::parallel::execution::seq);
+    return time / test_count;
+}
+
+std::uint64_t average_out_parallel()
+{
+    std::uint64_t time = 0;
+    for (auto i = 0; i < test_count; i++)
+        time += measure_sort(hpx::parallel::execution::par);
+    return time / test_count;
+}
+
+std::uint64_t average_out_task()
+{
+    using namespace hpx::parallel;
+
+    std::uint64_t time = 0;
+    for (auto i = 0; i < test_count; i++)
+        time += measure_sort_task(execution::par(execution::task));
+    return time / test_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    //pull values from cmd
+    std::size_t vector_size = vm["vector_size"].as<std::size_t>();
+    bool csvoutput = vm["csv_output"].as<int>() ? true : false;
+    test_count = vm["test_count"].as<int>();
+    stable = vm.count("stable") != 0;
+    custom_compare = vm.count("custom_compare") != 0;
+
+    unsigned int seed = vm["seed"].as<unsigned int>();
+    std::srand(seed);
+
+    //verify that input is within domain of program
+    if (test_count <= 0) {
+        hpx::cout << "test_count cannot be zero or negative...\n" << hpx::flush;
+    }
+    else {
+        input.resize(vector_size);
+        for (double& d : input)
+            d = double(std::rand()) - RAND_MAX / 2;
+
+        //results
+        std::uint64_t par_time = average_out_parallel();
+        std::uint64_t task_time = average_out_task();
+        std::uint64_t seq_time = average_out_sequential();
+
+        if (csvoutput) {
+            hpx::cout << "," << seq_time/1e9
+                      << "," << par_time/1e9
+                      << "," << task_time/1e9 << "\n" << hpx::flush;
+        }
+        else {
+            hpx::cout << std::left << "----------------Parameters-----------------\n"
+                << std::left << "Vector size: " << std::right
+                             << std::setw(30) << vector_size << "\n"
+                << std::left << "Number of tests" << std::right
+                             << std::setw(28) << test_count << "\n"
+                << std::left << "Algorithm" << std::right
+                             << std::setw(34)
+                             << (stable ? "stable_sort" : "sort") << "\n"
+                << std::left << "Comparison" << std::right
+                             << std::setw(33)
+                             << (custom_compare ? "std::greater" : "default")
+                             << "\n"
+                << std::left << "Display time in: "
+                << std::right << std::setw(27) << "Seconds\n" << hpx::flush;
+
+            hpx::cout << "------------------Average------------------\n"
+                << std::left << "Average parallel execution time  : "
+                             << std::right << std::setw(8) << par_time/1e9 << "\n"
+                << std::left << "Average task execution time      : "
+                             << std::right << std::setw(8) << task_time/1e9 << "\n"
+                << std::left << "Average sequential execution time: "
+                             << std::right << std::setw(8) << seq_time/1e9 << "\n"
+                             << hpx::flush;
+
+            hpx::cout << "---------Execution Time Difference---------\n"
+                << std::left << "Parallel Scale: " << std::right  << std::setw(27)
+                             << (double(seq_time) / par_time) << "\n"
+                << std::left << "Task Scale    : " << std::right  << std::setw(27)
+                             << (double(seq_time) / task_time) << "\n" << hpx::flush;
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    //initialize program
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "vector_size"
+        , boost::program_options::value<std::size_t>()->default_value(10000000)
+        , "size of vector")
+
+        ("test_count"
+        , boost::program_options::value<int>()->default_value(10)
+        , "number of tests to be averaged")
+
+        ("seed"
+        , boost::program_options::value<unsigned int>()->default_value(0)
+        , "the random number generator seed to use for this run")
+
+        ("stable", "measure stable_sort instead of sort")
+
+        ("custom_compare", "sort using std::greater instead of the default "
+            "comparison operator")
+
+        ("csv_output"
+        , boost::program_options::value<int>()->default_value(0)
+        ,"print results in csv format")
+        ;
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
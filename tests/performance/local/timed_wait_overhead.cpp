@@ -0,0 +1,131 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the overhead of suspending HPX threads with a
+// timeout. Each of the waits either expires (the thread sleeps for the given
+// delay) or is canceled (the thread is woken up by a promise long before its
+// timeout expires).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// all waits expire after the given delay
+double expired_waits(std::uint64_t num_waits, std::uint64_t delay)
+{
+    std::vector<hpx::future<void> > waits;
+    waits.reserve(num_waits);
+
+    hpx::util::high_resolution_timer t;
+    for (std::uint64_t i = 0; i != num_waits; ++i)
+    {
+        waits.push_back(hpx::async(
+            [delay]()
+            {
+                hpx::this_thread::sleep_for(
+                    std::chrono::microseconds(delay));
+            }));
+    }
+    hpx::wait_all(waits);
+    return t.elapsed();
+}
+
+// all waits are canceled as soon as all threads have started waiting
+double canceled_waits(std::uint64_t num_waits)
+{
+    hpx::lcos::local::promise<void> p;
+    hpx::shared_future<void> f = p.get_future();
+    std::atomic<std::uint64_t> arrived(0);
+
+    std::vector<hpx::future<void> > waits;
+    waits.reserve(num_waits);
+
+    hpx::util::high_resolution_timer t;
+    for (std::uint64_t i = 0; i != num_waits; ++i)
+    {
+        waits.push_back(hpx::async(
+            [&p, &arrived, f, num_waits]()
+            {
+                if (++arrived == num_waits)
+                    p.set_value();
+                f.wait_for(std::chrono::seconds(60));
+            }));
+    }
+    hpx::wait_all(waits);
+    return t.elapsed();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::uint64_t num_waits = vm["waits"].as<std::uint64_t>();
+    std::uint64_t delay = vm["delay"].as<std::uint64_t>();
+    bool header = vm.count("no-header") == 0;
+
+    if (num_waits == 0)
+        num_waits = 1;
+
+    double elapsed_expired = expired_waits(num_waits, delay);
+    double elapsed_canceled = canceled_waits(num_waits);
+
+    if (header)
+    {
+        hpx::cout
+            << "OS-threads,Waits,Delay[us],Kind,"
+               "Total Walltime[s],Walltime per Wait[s]"
+            << hpx::endl;
+    }
+
+    std::string const threads_str =
+        boost::str(boost::format("%lu") % hpx::get_os_thread_count());
+    std::string const waits_str = boost::str(boost::format("%lu") % num_waits);
+    std::string const delay_str = boost::str(boost::format("%lu") % delay);
+
+    hpx::cout
+        << (boost::format("%10s,%10s,%10s,%10s,%10.12s,%10.12s")
+            % threads_str % waits_str % delay_str % std::string("expired")
+            % elapsed_expired % (elapsed_expired / num_waits))
+        << hpx::endl;
+    hpx::cout
+        << (boost::format("%10s,%10s,%10s,%10s,%10.12s,%10.12s")
+            % threads_str % waits_str % delay_str % std::string("canceled")
+            % elapsed_canceled % (elapsed_canceled / num_waits))
+        << hpx::endl;
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    // Configure application-specific options.
+    po::options_description opts("usage: " HPX_APPLICATION_STRING " [options]");
+    opts.add_options()
+        ("waits,w", po::value<std::uint64_t>()->default_value(1000000),
+         "number of timed waits (default: 1000000)")
+        ("delay,d", po::value<std::uint64_t>()->default_value(100),
+         "timeout of the expiring waits in microseconds (default: 100)")
+        ("no-header,n",
+         "do not print out the csv header row")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(opts, argc, argv);
+}
@@ -0,0 +1,185 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark stresses the reference counting of AGAS's primary namespace.
+// Every locality concurrently creates components on all localities and
+// immediately releases them again, which causes a steady stream of credit
+// decrements and component deletions to be handled by the primary namespace
+// instances.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<std::int64_t> alive_objects(0);
+
+struct churn_server
+  : hpx::components::simple_component_base<churn_server>
+{
+    churn_server() { ++alive_objects; }
+    ~churn_server() { --alive_objects; }
+};
+
+typedef hpx::components::simple_component<churn_server> churn_server_type;
+HPX_REGISTER_COMPONENT(churn_server_type, churn_server);
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t get_alive_objects()
+{
+    return alive_objects.load();
+}
+HPX_PLAIN_ACTION(get_alive_objects, get_alive_objects_action);
+
+// Create num_objects components distributed over all localities in batches
+// of the given size, every batch is released before the next one is created.
+void churn(std::size_t num_objects, std::size_t batch_size,
+    std::size_t num_tasks)
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    std::size_t const per_task = num_objects / num_tasks;
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+
+    for (std::size_t t = 0; t != num_tasks; ++t)
+    {
+        tasks.push_back(hpx::async(
+            [&localities, per_task, batch_size, t]()
+            {
+                std::size_t target = t;
+                for (std::size_t i = 0; i < per_task; i += batch_size)
+                {
+                    std::size_t const count = (std::min)(
+                        batch_size, per_task - i);
+
+                    // the ids are released as soon as the vector goes out of
+                    // scope, which triggers the decrement of their credits
+                    std::vector<hpx::id_type> ids = hpx::new_<churn_server[]>(
+                        localities[target++ % localities.size()], count).get();
+                }
+            }));
+    }
+
+    hpx::wait_all(tasks);
+}
+HPX_PLAIN_ACTION(churn, churn_action);
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t count_alive_objects(std::vector<hpx::id_type> const& localities)
+{
+    std::vector<hpx::future<std::int64_t> > counts;
+    counts.reserve(localities.size());
+
+    for (hpx::id_type const& id : localities)
+        counts.push_back(hpx::async<get_alive_objects_action>(id));
+
+    std::int64_t result = 0;
+    for (hpx::future<std::int64_t>& f : counts)
+        result += f.get();
+    return result;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const num_objects = vm["num_objects"].as<std::size_t>();
+    std::size_t const batch_size = vm["batch_size"].as<std::size_t>();
+    std::size_t const num_tasks = vm["num_tasks"].as<std::size_t>();
+    int const test_count = vm["test_count"].as<int>();
+
+    if (num_tasks == 0 || batch_size == 0)
+    {
+        hpx::cout << "num_tasks and batch_size must be positive\n"
+            << hpx::flush;
+        return hpx::finalize();
+    }
+
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    hpx::cout
+        << "localities: " << localities.size()
+        << ", objects per locality: " << num_objects
+        << ", batch size: " << batch_size
+        << ", tasks per locality: " << num_tasks << "\n" << hpx::flush;
+
+    for (int i = 0; i != test_count; ++i)
+    {
+        std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+        std::vector<hpx::future<void> > churners;
+        churners.reserve(localities.size());
+        for (hpx::id_type const& id : localities)
+        {
+            churners.push_back(hpx::async<churn_action>(
+                id, num_objects, batch_size, num_tasks));
+        }
+        hpx::wait_all(churners);
+
+        std::uint64_t created = hpx::util::high_resolution_clock::now();
+
+        // wait for all components to be destroyed
+        hpx::agas::garbage_collect();
+        while (count_alive_objects(localities) != 0)
+            hpx::this_thread::yield();
+
+        std::uint64_t destroyed = hpx::util::high_resolution_clock::now();
+
+        double const total = double(num_objects * localities.size());
+        double const elapsed = (destroyed - start) / 1e9;
+
+        hpx::cout
+            << "create/release: " << (created - start) / 1e9 << " [s], "
+            << "drain: " << (destroyed - created) / 1e9 << " [s], "
+            << "throughput: " << total / elapsed << " [objects/s]\n"
+            << hpx::flush;
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("num_objects"
+        , boost::program_options::value<std::size_t>()->default_value(1000000)
+        , "number of components created by each locality")
+
+        ("batch_size"
+        , boost::program_options::value<std::size_t>()->default_value(100)
+        , "number of components created at once")
+
+        ("num_tasks"
+        , boost::program_options::value<std::size_t>()->default_value(16)
+        , "number of concurrent tasks creating components on each locality")
+
+        ("test_count"
+        , boost::program_options::value<int>()->default_value(3)
+        , "number of times the benchmark is repeated")
+        ;
+
+    // run on all available cores of every locality
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
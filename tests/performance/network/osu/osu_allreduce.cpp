@@ -0,0 +1,49 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// All-reduce network test
+
+#include "osu_collectives.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct plus_buffer
+{
+    osu_buffer_type operator()(osu_buffer_type lhs,
+        osu_buffer_type const& rhs) const
+    {
+        for (std::size_t i = 0; i != lhs.size(); ++i)
+            lhs[i] += rhs[i];
+        return lhs;
+    }
+};
+
+hpx::future<osu_buffer_type> allreduce(
+    hpx::lcos::communicator<osu_buffer_type> const& comm, std::size_t size)
+{
+    // all sites use the same buffer size
+    return hpx::lcos::all_reduce(comm, osu_buffer_type(size), plus_buffer(),
+        std::size_t(-1), size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    run_osu_collective(vm, "All-reduce", &allreduce);
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // This benchmark requires to run hpx_main on all localities
+    std::vector<std::string> const cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    return hpx::init(osu_collectives_desc(), argc, argv, cfg);
+}
@@ -0,0 +1,115 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Common infrastructure for the OSU style benchmarks of the communicator
+// based collective operations. The benchmark function runs on all
+// localities, each locality acts as one site of the communicator.
+
+#if !defined(HPX_OSU_COLLECTIVES_HPP)
+#define HPX_OSU_COLLECTIVES_HPP
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#define SKIP 200
+#define SKIP_LARGE 10
+#define LARGE_MESSAGE_SIZE 8192
+#define ITERATIONS_LARGE 100
+
+///////////////////////////////////////////////////////////////////////////////
+typedef std::vector<char> osu_buffer_type;
+
+HPX_REGISTER_COMMUNICATOR_DECLARATION(osu_buffer_type, osu_buffer);
+HPX_REGISTER_COMMUNICATOR(osu_buffer_type, osu_buffer);
+
+HPX_REGISTER_COMMUNICATOR_DECLARATION(double, osu_latency);
+HPX_REGISTER_COMMUNICATOR(double, osu_latency);
+
+///////////////////////////////////////////////////////////////////////////////
+boost::program_options::options_description osu_collectives_desc()
+{
+    boost::program_options::options_description
+        desc("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc.add_options()
+        ("max-msg-size",
+         boost::program_options::value<std::size_t>()->default_value(1048576),
+         "Set maximum message size in bytes.")
+        ("iter",
+         boost::program_options::value<std::size_t>()->default_value(1000),
+         "Set number of iterations per message size.")
+        ;
+
+    return desc;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Run the given collective operation for all message sizes, op(comm, size)
+// has to return a future which becomes ready once the operation has
+// completed on this site. Site 0 prints the latency averaged over all sites.
+template <typename F>
+void run_osu_collective(boost::program_options::variables_map& vm,
+    std::string const& benchmark, F && op)
+{
+    std::size_t const max_msg_size = vm["max-msg-size"].as<std::size_t>();
+
+    hpx::lcos::communicator<osu_buffer_type> comm =
+        hpx::lcos::create_communicator<osu_buffer_type>(
+            ("/osu/" + benchmark + "/buffer/").c_str()).get();
+    hpx::lcos::communicator<double> latency_comm =
+        hpx::lcos::create_communicator<double>(
+            ("/osu/" + benchmark + "/latency/").c_str()).get();
+
+    if (comm.this_site() == 0)
+    {
+        hpx::cout << "# OSU HPX " << benchmark << " Latency Test\n"
+                  << "# Size    Latency (microsec)"
+                  << hpx::endl << hpx::flush;
+    }
+
+    std::size_t skip = SKIP;
+    std::size_t iterations = vm["iter"].as<std::size_t>();
+
+    for (std::size_t size = 1; size <= max_msg_size; size *= 2)
+    {
+        if (size > LARGE_MESSAGE_SIZE)
+        {
+            skip = SKIP_LARGE;
+            iterations = ITERATIONS_LARGE;
+        }
+
+        hpx::util::high_resolution_timer t;
+        for (std::size_t i = 0; i != iterations + skip; ++i)
+        {
+            // do not measure warm up phase
+            if (i == skip)
+                t.restart();
+
+            op(comm, size).get();
+        }
+
+        double latency = (t.elapsed() * 1e6) / iterations;
+        double sum = hpx::lcos::all_reduce(latency_comm, latency,
+            std::plus<double>()).get();
+
+        if (comm.this_site() == 0)
+        {
+            hpx::cout << std::left << std::setw(10) << size
+                      << sum / comm.num_sites()
+                      << hpx::endl << hpx::flush;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,42 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Scatter (communicator based) network test
+
+#include "osu_collectives.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// site 0 distributes a message of the given size to every site
+hpx::future<osu_buffer_type> scatter(
+    hpx::lcos::communicator<osu_buffer_type> const& comm, std::size_t size)
+{
+    if (comm.this_site() == 0)
+    {
+        return hpx::lcos::scatter_to(comm,
+            std::vector<osu_buffer_type>(comm.num_sites(), osu_buffer_type(size)));
+    }
+    return hpx::lcos::scatter_from(comm);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    run_osu_collective(vm, "Scatter", &scatter);
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // This benchmark requires to run hpx_main on all localities
+    std::vector<std::string> const cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    return hpx::init(osu_collectives_desc(), argc, argv, cfg);
+}
@@ -11,7 +11,14 @@
 #include <hpx/include/serialization.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <hpx/components/component_storage/server/file_storage.hpp>
+
+#include <boost/filesystem.hpp>
+
 #include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 struct test_server
@@ -211,10 +218,64 @@ bool test_migrate_component_from_storage(hpx::id_type const& source,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_storage(hpx::id_type const& here, hpx::id_type const& there)
+bool test_migrate_components_to_storage(hpx::id_type const& source,
+    hpx::components::component_storage storage)
+{
+    std::size_t const count = 10;
+    std::vector<hpx::id_type> oldids;
+
+    {
+        std::vector<test_client> clients;
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            clients.push_back(test_client(source));
+            oldids.push_back(hpx::id_type(clients.back().get_id().get_gid(),
+                hpx::id_type::unmanaged));
+        }
+
+        try {
+            // migrate all objects to the target storage in one go
+            std::vector<test_client> migrated =
+                hpx::components::migrate_to_storage(clients, storage).get();
+            HPX_TEST_EQ(migrated.size(), count);
+        }
+        catch (hpx::exception const&) {
+            return false;
+        }
+
+        HPX_TEST_EQ(storage.size(hpx::launch::sync), count);
+    }
+
+    {
+        std::vector<hpx::id_type> ids =
+            hpx::components::migrate_from_storage<test_server>(oldids).get();
+        HPX_TEST(ids == oldids);
+
+        for (hpx::id_type const& id : ids)
+        {
+            test_client t1;
+            t1.reset(id);
+            HPX_TEST_EQ(t1.call(), source);
+        }
+
+        HPX_TEST_EQ(storage.size(hpx::launch::sync), std::size_t(0));
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string storage_filename(hpx::id_type const& locality)
+{
+    boost::filesystem::path p = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("hpx-storage-%%%%-%%%%-%%%%");
+    return p.string() + "-" +
+        std::to_string(hpx::naming::get_locality_id_from_id(locality));
+}
+
+void test_storage(hpx::id_type const& here, hpx::id_type const& there,
+    hpx::components::component_storage storage)
 {
-    // create a new storage instance
-    hpx::components::component_storage storage(here);
     HPX_TEST_NEQ(hpx::naming::invalid_id, storage.get_id());
 
     HPX_TEST(test_migrate_component_to_storage(here, storage,
@@ -228,10 +289,69 @@ void test_storage(hpx::id_type const& here, hpx::id_type const& there)
         hpx::id_type::managed));
 
 //     HPX_TEST(test_migrate_component_from_storage(here, storage));
+
+    HPX_TEST(test_migrate_components_to_storage(here, storage));
+}
+
+void test_storage(hpx::id_type const& here, hpx::id_type const& there)
+{
+    // create a new in-memory storage instance
+    test_storage(here, there, hpx::components::component_storage(here));
+
+    // create a new file backed storage instance
+    std::string filename = storage_filename(here);
+    test_storage(here, there,
+        hpx::components::component_storage(here, filename));
+
+    boost::system::error_code ec;
+    boost::filesystem::remove(filename, ec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the stored data has to be available after reopening the file
+void test_file_storage_recovery()
+{
+    using hpx::components::server::file_storage;
+    using hpx::naming::gid_type;
+
+    std::string filename = storage_filename(hpx::find_here());
+
+    std::vector<std::pair<gid_type, std::vector<char> > > data;
+    data.emplace_back(gid_type(1, 1), std::vector<char>(100, 'a'));
+    data.emplace_back(gid_type(1, 2), std::vector<char>(1000, 'b'));
+    data.emplace_back(gid_type(1, 3), std::vector<char>());
+
+    {
+        file_storage storage(filename);
+        storage.store(data);
+        HPX_TEST_EQ(storage.size(), std::size_t(3));
+
+        HPX_TEST(storage.load(gid_type(1, 1), true) == data[0].second);
+        HPX_TEST_EQ(storage.size(), std::size_t(2));
+    }
+
+    {
+        file_storage storage(filename);
+        HPX_TEST_EQ(storage.size(), std::size_t(2));
+
+        HPX_TEST(storage.load(gid_type(1, 2), false) == data[1].second);
+        HPX_TEST(storage.load(gid_type(1, 3), true) == data[2].second);
+        HPX_TEST_EQ(storage.size(), std::size_t(1));
+    }
+
+    {
+        file_storage storage(filename);
+        HPX_TEST_EQ(storage.size(), std::size_t(1));
+        HPX_TEST(storage.load(gid_type(1, 2), true) == data[1].second);
+    }
+
+    boost::filesystem::remove(filename);
 }
 
 int main()
 {
+    test_file_storage_recovery();
+
     test_storage(hpx::find_here(), hpx::find_here());
 
     for (hpx::id_type const& id: hpx::find_remote_localities())
@@ -0,0 +1,126 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_equal.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename T>
+void test_equal(ExPolicy && policy, hpx::partitioned_vector<T> const& v1,
+    hpx::partitioned_vector<T> const& v2, bool expected)
+{
+    HPX_TEST_EQ(
+        hpx::parallel::equal(policy, v1.begin(), v1.end(), v2.begin()),
+        expected);
+    HPX_TEST_EQ(
+        hpx::parallel::equal(policy, v1.begin(), v1.end(),
+            v2.begin(), v2.end()),
+        expected);
+
+    // sequences of different length never compare equal
+    HPX_TEST(!hpx::parallel::equal(policy, v1.begin(), v1.end(),
+        v2.begin(), v2.end() - 1));
+}
+
+template <typename ExPolicy, typename T>
+void test_equal_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& v1,
+    hpx::partitioned_vector<T> const& v2, bool expected)
+{
+    hpx::future<bool> f =
+        hpx::parallel::equal(policy, v1.begin(), v1.end(), v2.begin());
+    HPX_TEST_EQ(f.get(), expected);
+
+    f = hpx::parallel::equal(policy, v1.begin(), v1.end(),
+        v2.begin(), v2.end());
+    HPX_TEST_EQ(f.get(), expected);
+}
+
+template <typename T>
+void equal_tests(hpx::partitioned_vector<T> const& v1,
+    hpx::partitioned_vector<T> const& v2, bool expected)
+{
+    test_equal(hpx::parallel::execution::seq, v1, v2, expected);
+    test_equal(hpx::parallel::execution::par, v1, v2, expected);
+
+    test_equal_async(
+        hpx::parallel::execution::seq(hpx::parallel::execution::task),
+        v1, v2, expected);
+    test_equal_async(
+        hpx::parallel::execution::par(hpx::parallel::execution::task),
+        v1, v2, expected);
+}
+
+template <typename T>
+void equal_tests(hpx::partitioned_vector<T> const& v1,
+    hpx::partitioned_vector<T>& v2)
+{
+    equal_tests(v1, v2, true);
+
+    // modify a single element in the last partition
+    std::vector<std::size_t> positions = { v2.size() - 1 };
+    v2.set_values(positions, std::vector<T>(1, T(2))).get();
+
+    equal_tests(v1, v2, false);
+}
+
+template <typename T>
+void equal_tests()
+{
+    std::size_t const num = 10007;
+
+    {
+        hpx::partitioned_vector<T> v1(num, T(1));
+        hpx::partitioned_vector<T> v2(num, T(1));
+        equal_tests(v1, v2);
+    }
+
+    {
+        hpx::partitioned_vector<T> v1(num, T(1), hpx::container_layout(2));
+        hpx::partitioned_vector<T> v2(num, T(1), hpx::container_layout(2));
+        equal_tests(v1, v2);
+    }
+
+    // distribute the partitions over all localities
+    std::vector<hpx::id_type> const localities =
+        hpx::find_all_localities();
+
+    {
+        hpx::partitioned_vector<T> v1(num, T(1),
+            hpx::container_layout(localities));
+        hpx::partitioned_vector<T> v2(num, T(1),
+            hpx::container_layout(localities));
+        equal_tests(v1, v2);
+    }
+
+    {
+        hpx::partitioned_vector<T> v1(num, T(1),
+            hpx::container_layout(3, localities));
+        hpx::partitioned_vector<T> v2(num, T(1),
+            hpx::container_layout(3, localities));
+        equal_tests(v1, v2);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    equal_tests<int>();
+    equal_tests<double>();
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_find.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+struct is_equal
+{
+    T val_;
+
+    bool operator()(T const& t) const
+    {
+        return t == val_;
+    }
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned)
+    {
+        ar & val_;
+    }
+};
+
+template <typename T>
+struct is_not_equal
+{
+    T val_;
+
+    bool operator()(T const& t) const
+    {
+        return t != val_;
+    }
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned)
+    {
+        ar & val_;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename T>
+void test_find(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    std::size_t pos)
+{
+    typedef typename hpx::partitioned_vector<T>::iterator iterator;
+
+    iterator it = hpx::parallel::find(policy, v.begin(), v.end(), T(1));
+    HPX_TEST(it == v.begin() + pos);
+
+    it = hpx::parallel::find(policy, v.begin(), v.end(), T(2));
+    HPX_TEST(it == v.end());
+
+    it = hpx::parallel::find_if(policy, v.begin(), v.end(),
+        is_equal<T>{T(1)});
+    HPX_TEST(it == v.begin() + pos);
+
+    it = hpx::parallel::find_if_not(policy, v.begin(), v.end(),
+        is_not_equal<T>{T(1)});
+    HPX_TEST(it == v.begin() + pos);
+}
+
+template <typename ExPolicy, typename T>
+void test_find_async(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    std::size_t pos)
+{
+    typedef typename hpx::partitioned_vector<T>::iterator iterator;
+
+    hpx::future<iterator> f =
+        hpx::parallel::find(policy, v.begin(), v.end(), T(1));
+    HPX_TEST(f.get() == v.begin() + pos);
+
+    f = hpx::parallel::find(policy, v.begin(), v.end(), T(2));
+    HPX_TEST(f.get() == v.end());
+
+    f = hpx::parallel::find_if(policy, v.begin(), v.end(),
+        is_equal<T>{T(1)});
+    HPX_TEST(f.get() == v.begin() + pos);
+
+    f = hpx::parallel::find_if_not(policy, v.begin(), v.end(),
+        is_not_equal<T>{T(1)});
+    HPX_TEST(f.get() == v.begin() + pos);
+}
+
+template <typename T>
+void find_tests(hpx::partitioned_vector<T>& v)
+{
+    // place the value to find towards the end of the vector, with a second
+    // match right behind it
+    std::size_t pos = v.size() - 100;
+    std::vector<std::size_t> positions = { pos, pos + 1 };
+    v.set_values(positions, std::vector<T>(2, T(1))).get();
+
+    test_find(hpx::parallel::execution::seq, v, pos);
+    test_find(hpx::parallel::execution::par, v, pos);
+
+    test_find_async(
+        hpx::parallel::execution::seq(hpx::parallel::execution::task), v, pos);
+    test_find_async(
+        hpx::parallel::execution::par(hpx::parallel::execution::task), v, pos);
+}
+
+template <typename T>
+void find_tests()
+{
+    std::size_t const num = 10007;
+
+    {
+        hpx::partitioned_vector<T> v(num, T(0));
+        find_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, T(0), hpx::container_layout(2));
+        find_tests(v);
+    }
+
+    // distribute the partitions over all localities
+    std::vector<hpx::id_type> const localities =
+        hpx::find_all_localities();
+
+    {
+        hpx::partitioned_vector<T> v(num, T(0),
+            hpx::container_layout(localities));
+        find_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, T(0),
+            hpx::container_layout(3, localities));
+        find_tests(v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    find_tests<int>();
+    find_tests<double>();
+
+    return 0;
+}
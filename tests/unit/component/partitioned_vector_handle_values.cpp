@@ -103,6 +103,47 @@ void handle_values_tests_distributed_access(hpx::partitioned_vector<T>& v)
     compare_vectors(values2, result2);
 }
 
+template <typename T>
+void handle_range_tests(hpx::partitioned_vector<T>& v)
+{
+    fill_vector(v, T(42));
+
+    // write and read a range spanning all partitions, leaving out the
+    // first and the last element
+    std::vector<T> values(v.size() - 2);
+    fill_vector(values, T(48), T(3));
+
+    v.set_range(hpx::launch::sync, 1, values);
+    std::vector<T> result = v.get_range(hpx::launch::sync, 1, v.size() - 1);
+    compare_vectors(values, result);
+
+    HPX_TEST_EQ(v.get_value(hpx::launch::sync, 0), T(42));
+    HPX_TEST_EQ(v.get_value(hpx::launch::sync, v.size() - 1), T(42));
+
+    HPX_TEST(v.get_range(hpx::launch::sync, 3, 3).empty());
+}
+
+template <typename T>
+void handle_aggregated_values_tests(hpx::partitioned_vector<T>& v)
+{
+    fill_vector(v, T(42));
+
+    hpx::partitioned_vector_aggregator<T> aggregator(v, 4);
+
+    std::vector<hpx::future<void> > set_futures;
+    for (std::size_t i = 0; i != v.size(); ++i)
+        set_futures.push_back(aggregator.set_value(i, T(i)));
+    hpx::wait_all(set_futures);
+
+    std::vector<hpx::future<T> > get_futures;
+    for (std::size_t i = 0; i != v.size(); ++i)
+        get_futures.push_back(aggregator.get_value(i));
+    aggregator.flush();
+
+    for (std::size_t i = 0; i != v.size(); ++i)
+        HPX_TEST_EQ(get_futures[i].get(), T(i));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 template <typename T, typename DistPolicy>
@@ -118,6 +159,16 @@ void handle_values_tests_with_policy(std::size_t size, std::size_t localities,
         hpx::partitioned_vector<T> v(size, policy);
         handle_values_tests_distributed_access(v);
     }
+
+    {
+        hpx::partitioned_vector<T> v(size, policy);
+        handle_range_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(size, policy);
+        handle_aggregated_values_tests(v);
+    }
 }
 
 template <typename T>
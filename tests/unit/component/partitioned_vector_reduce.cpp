@@ -0,0 +1,106 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename T>
+T test_reduce(ExPolicy && policy, hpx::partitioned_vector<T> const& v)
+{
+    return hpx::parallel::reduce(policy, v.begin(), v.end(), T(1),
+        std::plus<T>());
+}
+
+template <typename ExPolicy, typename T>
+hpx::future<T>
+test_reduce_async(ExPolicy && policy, hpx::partitioned_vector<T> const& v)
+{
+    return hpx::parallel::reduce(policy, v.begin(), v.end(), T(1),
+        std::plus<T>());
+}
+
+template <typename T>
+void reduce_tests(std::size_t num, hpx::partitioned_vector<T> const& v)
+{
+    // the initial value has to be applied exactly once
+    HPX_TEST_EQ(test_reduce(hpx::parallel::execution::seq, v), T(num + 1));
+    HPX_TEST_EQ(test_reduce(hpx::parallel::execution::par, v), T(num + 1));
+
+    HPX_TEST_EQ(
+        test_reduce_async(
+            hpx::parallel::execution::seq(hpx::parallel::execution::task),
+            v).get(),
+        T(num + 1));
+    HPX_TEST_EQ(
+        test_reduce_async(
+            hpx::parallel::execution::par(hpx::parallel::execution::task),
+            v).get(),
+        T(num + 1));
+
+    // sub-ranges starting and ending in the middle of a partition
+    HPX_TEST_EQ(
+        hpx::parallel::reduce(hpx::parallel::execution::par,
+            v.begin() + 1, v.end() - 1, T(0), std::plus<T>()),
+        T(num - 2));
+    HPX_TEST_EQ(
+        hpx::parallel::reduce(hpx::parallel::execution::seq,
+            v.begin(), v.begin(), T(42), std::plus<T>()),
+        T(42));
+}
+
+template <typename T>
+void reduce_tests()
+{
+    std::size_t const num = 10007;
+
+    {
+        hpx::partitioned_vector<T> v(num, T(1));
+        reduce_tests(num, v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, T(1), hpx::container_layout(2));
+        reduce_tests(num, v);
+    }
+
+    // distribute the partitions over all localities
+    std::vector<hpx::id_type> const localities =
+        hpx::find_all_localities();
+
+    {
+        hpx::partitioned_vector<T> v(num, T(1),
+            hpx::container_layout(localities));
+        reduce_tests(num, v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, T(1),
+            hpx::container_layout(3, localities));
+        reduce_tests(num, v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    reduce_tests<int>();
+    reduce_tests<double>();
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+std::vector<T> fill_random(hpx::partitioned_vector<T>& v)
+{
+    std::vector<std::size_t> positions(v.size());
+    std::iota(positions.begin(), positions.end(), std::size_t(0));
+
+    std::vector<T> values(v.size());
+    for (T& t : values)
+        t = T(std::rand() % 1000);
+
+    v.set_values(positions, values).get();
+    return values;
+}
+
+template <typename T, typename Compare>
+void verify_sorted(hpx::partitioned_vector<T> const& v,
+    std::vector<T> expected, Compare comp)
+{
+    std::vector<std::size_t> positions(v.size());
+    std::iota(positions.begin(), positions.end(), std::size_t(0));
+
+    std::sort(expected.begin(), expected.end(), comp);
+    HPX_TEST(v.get_values(hpx::launch::sync, positions) == expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename T>
+void test_sort(ExPolicy && policy, hpx::partitioned_vector<T>& v)
+{
+    std::vector<T> values = fill_random(v);
+    HPX_TEST(hpx::parallel::sort(policy, v.begin(), v.end()) == v.end());
+    verify_sorted(v, values, std::less<T>());
+
+    values = fill_random(v);
+    HPX_TEST(hpx::parallel::sort(policy, v.begin(), v.end(),
+        std::greater<T>()) == v.end());
+    verify_sorted(v, values, std::greater<T>());
+}
+
+template <typename ExPolicy, typename T>
+void test_sort_async(ExPolicy && policy, hpx::partitioned_vector<T>& v)
+{
+    std::vector<T> values = fill_random(v);
+    hpx::future<typename hpx::partitioned_vector<T>::iterator> f =
+        hpx::parallel::sort(policy, v.begin(), v.end());
+    HPX_TEST(f.get() == v.end());
+    verify_sorted(v, values, std::less<T>());
+}
+
+template <typename T>
+void sort_tests(hpx::partitioned_vector<T>& v)
+{
+    test_sort(hpx::parallel::execution::seq, v);
+    test_sort(hpx::parallel::execution::par, v);
+
+    test_sort_async(
+        hpx::parallel::execution::seq(hpx::parallel::execution::task), v);
+    test_sort_async(
+        hpx::parallel::execution::par(hpx::parallel::execution::task), v);
+}
+
+template <typename T>
+void sort_tests()
+{
+    std::size_t const num = 10007;
+
+    {
+        hpx::partitioned_vector<T> v(num, T(0));
+        sort_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, T(0), hpx::container_layout(4));
+        sort_tests(v);
+    }
+
+    // distribute the partitions over all localities
+    std::vector<hpx::id_type> const localities =
+        hpx::find_all_localities();
+
+    {
+        hpx::partitioned_vector<T> v(num, T(0),
+            hpx::container_layout(localities));
+        sort_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, T(0),
+            hpx::container_layout(3, localities));
+        sort_tests(v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    sort_tests<int>();
+    sort_tests<double>();
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_transform.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+struct twice
+{
+    template <typename T>
+    T operator()(T const& t) const
+    {
+        return t + t;
+    }
+};
+
+template <typename T>
+void verify_values(hpx::partitioned_vector<T> const& v, T const& val)
+{
+    std::vector<std::size_t> positions(v.size());
+    std::iota(positions.begin(), positions.end(), std::size_t(0));
+
+    std::vector<T> values = v.get_values(hpx::launch::sync, positions);
+    for (T const& t : values)
+        HPX_TEST_EQ(t, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename T>
+void test_transform(ExPolicy && policy, hpx::partitioned_vector<T> const& in,
+    hpx::partitioned_vector<T>& out)
+{
+    auto result = hpx::parallel::transform(policy, in.begin(), in.end(),
+        out.begin(), twice());
+
+    HPX_TEST(hpx::util::get<0>(result) == in.end());
+    HPX_TEST(hpx::util::get<1>(result) == out.end());
+    verify_values(out, T(2));
+}
+
+template <typename ExPolicy, typename T>
+void test_transform_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& in, hpx::partitioned_vector<T>& out)
+{
+    auto f = hpx::parallel::transform(policy, in.begin(), in.end(),
+        out.begin(), twice());
+    auto result = f.get();
+
+    HPX_TEST(hpx::util::get<0>(result) == in.end());
+    HPX_TEST(hpx::util::get<1>(result) == out.end());
+    verify_values(out, T(2));
+}
+
+template <typename T>
+void transform_tests(hpx::partitioned_vector<T> const& in,
+    hpx::partitioned_vector<T>& out)
+{
+    test_transform(hpx::parallel::execution::seq, in, out);
+    test_transform(hpx::parallel::execution::par, in, out);
+
+    test_transform_async(
+        hpx::parallel::execution::seq(hpx::parallel::execution::task), in, out);
+    test_transform_async(
+        hpx::parallel::execution::par(hpx::parallel::execution::task), in, out);
+}
+
+template <typename T>
+void transform_tests()
+{
+    std::size_t const num = 10007;
+
+    {
+        hpx::partitioned_vector<T> in(num, T(1));
+        hpx::partitioned_vector<T> out(num, T(0));
+        transform_tests(in, out);
+    }
+
+    {
+        hpx::partitioned_vector<T> in(num, T(1), hpx::container_layout(2));
+        hpx::partitioned_vector<T> out(num, T(0), hpx::container_layout(2));
+        transform_tests(in, out);
+    }
+
+    // distribute the partitions over all localities
+    std::vector<hpx::id_type> const localities =
+        hpx::find_all_localities();
+
+    {
+        hpx::partitioned_vector<T> in(num, T(1),
+            hpx::container_layout(localities));
+        hpx::partitioned_vector<T> out(num, T(0),
+            hpx::container_layout(localities));
+        transform_tests(in, out);
+    }
+
+    {
+        hpx::partitioned_vector<T> in(num, T(1),
+            hpx::container_layout(3, localities));
+        hpx::partitioned_vector<T> out(num, T(0),
+            hpx::container_layout(3, localities));
+        transform_tests(in, out);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    transform_tests<int>();
+    transform_tests<double>();
+
+    return 0;
+}
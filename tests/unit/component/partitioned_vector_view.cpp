@@ -0,0 +1,84 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void view_tests(hpx::partitioned_vector<T>& v)
+{
+    hpx::partitioned_vector_view<T> view(v);
+
+    // modify all local elements through the view
+    std::size_t count = 0;
+    typedef typename hpx::partitioned_vector_view<T>::segment_iterator
+        segment_iterator;
+    for (segment_iterator it = view.segment_begin();
+         it != view.segment_end(); ++it)
+    {
+        std::size_t index = it->global_offset();
+        for (T& t : *it)
+            t = T(index++);
+        count += it->size();
+    }
+    HPX_TEST_EQ(count, view.size());
+
+    // the changes have to be visible through the vector
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        if (view.is_local(i))
+        {
+            HPX_TEST_EQ(view[i], T(i));
+            HPX_TEST_EQ(v.get_value(hpx::launch::sync, i), T(i));
+        }
+        else
+        {
+            HPX_TEST_EQ(v.get_value(hpx::launch::sync, i), T(0));
+        }
+    }
+}
+
+template <typename T>
+void view_tests()
+{
+    std::size_t const length = 117;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    {
+        hpx::partitioned_vector<T> v(length, T(0));
+        view_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(length, T(0), hpx::container_layout(3));
+        view_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(length, T(0),
+            hpx::container_layout(localities));
+        view_tests(v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    view_tests<double>();
+    view_tests<int>();
+
+    return 0;
+}
@@ -4,6 +4,7 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
 #include <hpx/include/traits.hpp>
 #include <hpx/include/unordered_map.hpp>
 #include <hpx/util/lightweight_test.hpp>
@@ -75,6 +76,75 @@ void fill_unordered_map(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m,
     HPX_TEST(m.size() == count);
 }
 
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void test_batched_values(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m,
+    std::size_t count)
+{
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        keys.push_back(std::to_string(i));
+        values.push_back(Value(i));
+    }
+
+    m.set_values(hpx::launch::sync, keys, values);
+    HPX_TEST_EQ(m.size(), count);
+
+    std::reverse(keys.begin(), keys.end());
+    std::reverse(values.begin(), values.end());
+
+    std::vector<Value> result = m.get_values(keys).get();
+    HPX_TEST(result == values);
+
+    // erased keys are not found anymore
+    HPX_TEST_EQ(m.erase(hpx::launch::sync, keys.front()), std::size_t(1));
+    HPX_TEST_EQ(m.erase(hpx::launch::sync, keys.front()), std::size_t(0));
+    HPX_TEST_EQ(m.size(), count - 1);
+
+    bool caught_exception = false;
+    try {
+        m.get_values(hpx::launch::sync, keys);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    // re-inserting an erased key works
+    m.set_value(hpx::launch::sync, keys.front(), values.front());
+    HPX_TEST_EQ(m.size(), count);
+    HPX_TEST(m.get_values(hpx::launch::sync, keys) == values);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void test_concurrent_access(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m,
+    std::size_t count)
+{
+    std::vector<hpx::future<void> > writers;
+    for (std::size_t t = 0; t != 4; ++t)
+    {
+        writers.push_back(hpx::async(
+            [&m, t, count]()
+            {
+                for (std::size_t i = t; i < count; i += 4)
+                {
+                    std::string idx = std::to_string(i);
+                    m.set_value(hpx::launch::sync, idx, Value(i));
+                    HPX_TEST_EQ(m.get_value(hpx::launch::sync, idx), Value(i));
+                }
+            }));
+    }
+    hpx::wait_all(writers);
+
+    HPX_TEST_EQ(m.size(), count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        HPX_TEST_EQ(m.get_value(hpx::launch::sync, std::to_string(i)),
+            Value(i));
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename Key, typename Value, typename DistPolicy>
 void trivial_tests(DistPolicy const& policy)
@@ -88,6 +158,16 @@ void trivial_tests(DistPolicy const& policy)
         test_global_iteration(m, Value(42));
     }
 
+    // batched and concurrent access
+    {
+        hpx::unordered_map<Key, Value> m(17, policy);
+        test_batched_values(m, 2000);
+    }
+    {
+        hpx::unordered_map<Key, Value> m(policy);
+        test_concurrent_access(m, 1000);
+    }
+
     // bucket_count, hash
     {
         hpx::unordered_map<Key, Value> m(17, std::hash<std::string>(),
@@ -120,6 +200,16 @@ void trivial_tests()
         test_global_iteration(m, Value(42));
     }
 
+    // batched and concurrent access
+    {
+        hpx::unordered_map<Key, Value> m;
+        test_batched_values(m, 2000);
+    }
+    {
+        hpx::unordered_map<Key, Value> m;
+        test_concurrent_access(m, 1000);
+    }
+
     // bucket_count
     {
         hpx::unordered_map<Key, Value> m(17);
@@ -0,0 +1,193 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef std::vector<std::uint32_t> block_type;
+
+HPX_REGISTER_COMMUNICATOR_DECLARATION(std::uint32_t, collectives_uint32);
+HPX_REGISTER_COMMUNICATOR(std::uint32_t, collectives_uint32);
+
+HPX_REGISTER_COMMUNICATOR_DECLARATION(block_type, collectives_block);
+HPX_REGISTER_COMMUNICATOR(block_type, collectives_block);
+
+// the blocks are large enough to select the bandwidth optimized algorithms,
+// the size of the values is passed explicitly as it can't be derived from the
+// type
+std::size_t const block_size =
+    HPX_COLLECTIVES_LARGE_MESSAGE_SIZE / sizeof(std::uint32_t) + 1;
+std::size_t const block_bytes = block_size * sizeof(std::uint32_t);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_small_values()
+{
+    using hpx::lcos::communicator;
+
+    communicator<std::uint32_t> comm =
+        hpx::lcos::create_communicator<std::uint32_t>(
+            "/test/collectives/small/").get();
+
+    std::uint32_t num_sites = std::uint32_t(comm.num_sites());
+    std::uint32_t this_site = std::uint32_t(comm.this_site());
+
+    HPX_TEST_EQ(num_sites, hpx::get_num_localities(hpx::launch::sync));
+    HPX_TEST_EQ(this_site, hpx::get_locality_id());
+
+    for (int i = 0; i != 10; ++i)
+    {
+        std::uint32_t sum = hpx::lcos::all_reduce(comm, this_site,
+            std::plus<std::uint32_t>()).get();
+        HPX_TEST_EQ(sum, num_sites * (num_sites - 1) / 2);
+
+        std::vector<std::uint32_t> gathered =
+            hpx::lcos::all_gather(comm, this_site).get();
+        HPX_TEST_EQ(gathered.size(), std::size_t(num_sites));
+        for (std::uint32_t j = 0; j != gathered.size(); ++j)
+            HPX_TEST_EQ(gathered[j], j);
+
+        std::vector<std::uint32_t> values(num_sites);
+        for (std::uint32_t j = 0; j != num_sites; ++j)
+            values[j] = this_site * num_sites + j;
+
+        std::vector<std::uint32_t> exchanged =
+            hpx::lcos::all_to_all(comm, values).get();
+        HPX_TEST_EQ(exchanged.size(), std::size_t(num_sites));
+        for (std::uint32_t j = 0; j != exchanged.size(); ++j)
+            HPX_TEST_EQ(exchanged[j], j * num_sites + this_site);
+
+        std::uint32_t scattered = 0;
+        if (this_site == 0)
+            scattered = hpx::lcos::scatter_to(comm, values).get();
+        else
+            scattered = hpx::lcos::scatter_from(comm).get();
+        HPX_TEST_EQ(scattered, this_site);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_large_values()
+{
+    using hpx::lcos::communicator;
+
+    communicator<block_type> comm =
+        hpx::lcos::create_communicator<block_type>(
+            "/test/collectives/large/").get();
+
+    std::uint32_t num_sites = std::uint32_t(comm.num_sites());
+    std::uint32_t this_site = std::uint32_t(comm.this_site());
+
+    for (int i = 0; i != 10; ++i)
+    {
+        block_type sum = hpx::lcos::all_reduce(comm,
+            block_type(block_size, this_site),
+            [](block_type lhs, block_type const& rhs) -> block_type
+            {
+                for (std::size_t j = 0; j != lhs.size(); ++j)
+                    lhs[j] += rhs[j];
+                return lhs;
+            },
+            std::size_t(-1), block_bytes).get();
+        HPX_TEST(sum == block_type(block_size, num_sites * (num_sites - 1) / 2));
+
+        std::vector<block_type> gathered = hpx::lcos::all_gather(comm,
+            block_type(block_size, this_site), std::size_t(-1),
+            block_bytes).get();
+        HPX_TEST_EQ(gathered.size(), std::size_t(num_sites));
+        for (std::uint32_t j = 0; j != gathered.size(); ++j)
+            HPX_TEST(gathered[j] == block_type(block_size, j));
+
+        std::vector<block_type> values;
+        for (std::uint32_t j = 0; j != num_sites; ++j)
+            values.push_back(block_type(block_size, this_site * num_sites + j));
+
+        std::vector<block_type> exchanged = hpx::lcos::all_to_all(comm,
+            values, std::size_t(-1), block_bytes).get();
+        HPX_TEST_EQ(exchanged.size(), std::size_t(num_sites));
+        for (std::uint32_t j = 0; j != exchanged.size(); ++j)
+        {
+            HPX_TEST(exchanged[j] ==
+                block_type(block_size, j * num_sites + this_site));
+        }
+
+        block_type scattered;
+        if (this_site == 0)
+            scattered = hpx::lcos::scatter_to(comm, values).get();
+        else
+            scattered = hpx::lcos::scatter_from(comm).get();
+        HPX_TEST(scattered == block_type(block_size, this_site));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The sites contribute values of different sizes, on both sides of the limit
+// for large messages. All sites have to select the same algorithm anyways.
+void test_mixed_values()
+{
+    using hpx::lcos::communicator;
+
+    communicator<block_type> comm =
+        hpx::lcos::create_communicator<block_type>(
+            "/test/collectives/mixed/").get();
+
+    std::uint32_t num_sites = std::uint32_t(comm.num_sites());
+    std::uint32_t this_site = std::uint32_t(comm.this_site());
+
+    for (int i = 0; i != 10; ++i)
+    {
+        std::vector<block_type> gathered = hpx::lcos::all_gather(comm,
+            block_type(this_site == 0 ? block_size : 1, this_site)).get();
+        HPX_TEST_EQ(gathered.size(), std::size_t(num_sites));
+        for (std::uint32_t j = 0; j != gathered.size(); ++j)
+            HPX_TEST(gathered[j] == block_type(j == 0 ? block_size : 1, j));
+
+        std::vector<block_type> values;
+        for (std::uint32_t j = 0; j != num_sites; ++j)
+        {
+            values.push_back(block_type(this_site == 0 ? block_size : 1,
+                this_site * num_sites + j));
+        }
+
+        std::vector<block_type> exchanged =
+            hpx::lcos::all_to_all(comm, values).get();
+        HPX_TEST_EQ(exchanged.size(), std::size_t(num_sites));
+        for (std::uint32_t j = 0; j != exchanged.size(); ++j)
+        {
+            HPX_TEST(exchanged[j] == block_type(j == 0 ? block_size : 1,
+                j * num_sites + this_site));
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_small_values();
+    test_large_values();
+    test_mixed_values();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // This test requires to run hpx_main on all localities
+    std::vector<std::string> const cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+    return hpx::util::report_errors();
+}
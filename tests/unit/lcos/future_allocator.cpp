@@ -0,0 +1,154 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/pooled_allocator.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<std::size_t> allocations(0);
+boost::atomic<std::size_t> deallocations(0);
+
+template <typename T>
+struct counting_allocator : std::allocator<T>
+{
+    template <typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator() {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const&) {}
+
+    T* allocate(std::size_t n)
+    {
+        ++allocations;
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        ++deallocations;
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+void reset_counts()
+{
+    allocations.store(0);
+    deallocations.store(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_promise()
+{
+    reset_counts();
+    {
+        hpx::lcos::local::promise<int> p(std::allocator_arg,
+            counting_allocator<int>());
+        hpx::future<int> f = p.get_future();
+
+        HPX_TEST_EQ(allocations.load(), std::size_t(1));
+
+        p.set_value(42);
+        HPX_TEST_EQ(f.get(), 42);
+    }
+    HPX_TEST_EQ(deallocations.load(), std::size_t(1));
+
+    reset_counts();
+    {
+        hpx::lcos::local::promise<void> p(std::allocator_arg,
+            counting_allocator<char>());
+        hpx::future<void> f = p.get_future();
+
+        p.set_value();
+        f.get();
+    }
+    HPX_TEST_EQ(allocations.load(), std::size_t(1));
+    HPX_TEST_EQ(deallocations.load(), std::size_t(1));
+}
+
+void test_packaged_task()
+{
+    reset_counts();
+    {
+        hpx::lcos::local::packaged_task<int(int)> pt(std::allocator_arg,
+            counting_allocator<int>(), [](int i) { return i + 1; });
+        hpx::future<int> f = pt.get_future();
+
+        pt(41);
+        HPX_TEST_EQ(f.get(), 42);
+    }
+    HPX_TEST_EQ(allocations.load(), std::size_t(1));
+    HPX_TEST_EQ(deallocations.load(), std::size_t(1));
+}
+
+void test_async()
+{
+    reset_counts();
+    {
+        hpx::future<int> f = hpx::async(std::allocator_arg,
+            counting_allocator<int>(), [](int i) { return i + 1; }, 41);
+        HPX_TEST_EQ(f.get(), 42);
+    }
+    HPX_TEST_EQ(allocations.load(), std::size_t(1));
+    HPX_TEST_EQ(deallocations.load(), std::size_t(1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_pooled_allocator()
+{
+    hpx::util::pooled_allocator<int> alloc;
+
+    std::vector<int*> blocks;
+    for (std::size_t i = 1; i != 256; ++i)
+    {
+        int* p = alloc.allocate(i);
+        for (std::size_t j = 0; j != i; ++j)
+            p[j] = int(j);
+        blocks.push_back(p);
+    }
+
+    for (std::size_t i = 1; i != 256; ++i)
+    {
+        int* p = blocks[i - 1];
+        for (std::size_t j = 0; j != i; ++j)
+            HPX_TEST_EQ(p[j], int(j));
+        alloc.deallocate(p, i);
+    }
+
+    // the default allocator is used for async, dataflow and continuations
+    std::vector<hpx::future<int> > futures;
+    for (int i = 0; i != 1000; ++i)
+    {
+        futures.push_back(hpx::async([i]() { return i; }).then(
+            [](hpx::future<int> f) { return f.get() + 1; }));
+    }
+
+    for (int i = 0; i != 1000; ++i)
+        HPX_TEST_EQ(futures[i].get(), i + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_promise();
+    test_packaged_task();
+    test_async();
+    test_pooled_allocator();
+
+    return hpx::util::report_errors();
+}
@@ -12,6 +12,8 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -137,6 +139,38 @@ void test_complex_then_chain_two()
     HPX_TEST(f2.get()==4);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void append_index(std::vector<int>& order, int i,
+    hpx::lcos::shared_future<int> f)
+{
+    HPX_TEST_EQ(f.get(), 42);
+    order.push_back(i);
+}
+
+void test_multiple_continuations()
+{
+    hpx::lcos::local::promise<int> p;
+    hpx::lcos::shared_future<int> f = p.get_future();
+
+    // continuations attached to the same future are run in the order they
+    // were attached
+    std::vector<int> order;
+    std::vector<hpx::lcos::future<void> > continuations;
+    for (int i = 0; i != 100; ++i)
+    {
+        continuations.push_back(f.then(hpx::launch::sync,
+            hpx::util::bind(&append_index, std::ref(order), i,
+                hpx::util::placeholders::_1)));
+    }
+
+    p.set_value(42);
+    hpx::wait_all(continuations);
+
+    HPX_TEST_EQ(order.size(), std::size_t(100));
+    for (int i = 0; i != 100; ++i)
+        HPX_TEST_EQ(order[i], i);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 using boost::program_options::variables_map;
 using boost::program_options::options_description;
@@ -152,6 +186,7 @@ int hpx_main(variables_map&)
         test_complex_then();
         test_complex_then_chain_one();
         test_complex_then_chain_two();
+        test_multiple_continuations();
     }
 
     hpx::finalize();
@@ -0,0 +1,356 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The parallel scans process their input in tiles, this test verifies the
+// scans for inputs spanning many tiles using an operation which is not
+// commutative, and checks that an exception thrown by the operation in one
+// of the tiles is reported without leaving any of the tasks waiting.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_scan.hpp>
+#include <hpx/include/parallel_transform_scan.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/range/functions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The affine map x -> a * x + b. Composing those maps is associative but not
+// commutative, any reordering of the elements by the scans changes the
+// results.
+struct affine
+{
+    affine()
+      : a_(1), b_(0), poison_(false)
+    {}
+
+    affine(std::uint64_t a, std::uint64_t b, bool poison = false)
+      : a_(a), b_(b), poison_(poison)
+    {}
+
+    std::uint64_t a_;
+    std::uint64_t b_;
+    bool poison_;
+};
+
+inline bool operator==(affine const& lhs, affine const& rhs)
+{
+    return lhs.a_ == rhs.a_ && lhs.b_ == rhs.b_;
+}
+
+// apply lhs first, then rhs
+struct compose
+{
+    affine operator()(affine const& lhs, affine const& rhs) const
+    {
+        if (lhs.poison_ || rhs.poison_)
+            throw std::runtime_error("test");
+
+        return affine(lhs.a_ * rhs.a_, rhs.a_ * lhs.b_ + rhs.b_);
+    }
+};
+
+struct make_affine
+{
+    affine operator()(std::uint64_t v) const
+    {
+        return affine(2 * v + 1, v);
+    }
+};
+
+std::vector<affine> make_input(std::size_t size)
+{
+    std::vector<affine> c;
+    c.reserve(size);
+    for (std::size_t i = 0; i != size; ++i)
+        c.push_back(affine(2 * std::uint64_t(std::rand()) + 1, std::rand()));
+    return c;
+}
+
+std::vector<std::uint64_t> make_values(std::size_t size)
+{
+    std::vector<std::uint64_t> c;
+    c.reserve(size);
+    for (std::size_t i = 0; i != size; ++i)
+        c.push_back(std::rand());
+    return c;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_inclusive_scan(ExPolicy && policy, std::size_t size)
+{
+    std::vector<affine> c = make_input(size);
+    std::vector<affine> d(c.size());
+    affine const init(3, 7);
+
+    hpx::parallel::inclusive_scan(policy, boost::begin(c), boost::end(c),
+        boost::begin(d), init, compose());
+
+    affine sum = init;
+    for (std::size_t i = 0; i != c.size(); ++i)
+    {
+        sum = compose()(sum, c[i]);
+        HPX_TEST(d[i] == sum);
+    }
+}
+
+template <typename ExPolicy>
+void test_exclusive_scan(ExPolicy && policy, std::size_t size)
+{
+    std::vector<affine> c = make_input(size);
+    std::vector<affine> d(c.size());
+    affine const init(3, 7);
+
+    hpx::parallel::exclusive_scan(policy, boost::begin(c), boost::end(c),
+        boost::begin(d), init, compose());
+
+    affine sum = init;
+    for (std::size_t i = 0; i != c.size(); ++i)
+    {
+        HPX_TEST(d[i] == sum);
+        sum = compose()(sum, c[i]);
+    }
+}
+
+template <typename ExPolicy>
+void test_transform_inclusive_scan(ExPolicy && policy, std::size_t size)
+{
+    std::vector<std::uint64_t> c = make_values(size);
+    std::vector<affine> d(c.size());
+    affine const init(3, 7);
+
+    hpx::parallel::transform_inclusive_scan(policy,
+        boost::begin(c), boost::end(c), boost::begin(d), init, compose(),
+        make_affine());
+
+    affine sum = init;
+    for (std::size_t i = 0; i != c.size(); ++i)
+    {
+        sum = compose()(sum, make_affine()(c[i]));
+        HPX_TEST(d[i] == sum);
+    }
+}
+
+template <typename ExPolicy>
+void test_transform_exclusive_scan(ExPolicy && policy, std::size_t size)
+{
+    std::vector<std::uint64_t> c = make_values(size);
+    std::vector<affine> d(c.size());
+    affine const init(3, 7);
+
+    hpx::parallel::transform_exclusive_scan(policy,
+        boost::begin(c), boost::end(c), boost::begin(d), init, compose(),
+        make_affine());
+
+    affine sum = init;
+    for (std::size_t i = 0; i != c.size(); ++i)
+    {
+        HPX_TEST(d[i] == sum);
+        sum = compose()(sum, make_affine()(c[i]));
+    }
+}
+
+template <typename ExPolicy>
+void test_inclusive_scan_async(ExPolicy && policy, std::size_t size)
+{
+    std::vector<affine> c = make_input(size);
+    std::vector<affine> d(c.size());
+    affine const init(3, 7);
+
+    hpx::future<void> f = hpx::parallel::inclusive_scan(policy,
+        boost::begin(c), boost::end(c), boost::begin(d), init, compose());
+    f.wait();
+
+    affine sum = init;
+    for (std::size_t i = 0; i != c.size(); ++i)
+    {
+        sum = compose()(sum, c[i]);
+        HPX_TEST(d[i] == sum);
+    }
+}
+
+template <typename ExPolicy>
+void test_scans(ExPolicy && policy, std::size_t size)
+{
+    test_inclusive_scan(policy, size);
+    test_exclusive_scan(policy, size);
+    test_transform_inclusive_scan(policy, size);
+    test_transform_exclusive_scan(policy, size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The element at position 'poison' makes the operation throw.
+template <typename ExPolicy>
+void test_scan_exception(ExPolicy && policy, std::size_t size,
+    std::size_t poison, bool exclusive)
+{
+    std::vector<affine> c = make_input(size);
+    std::vector<affine> d(c.size());
+    c[poison].poison_ = true;
+
+    bool caught_exception = false;
+    try {
+        if (exclusive)
+        {
+            hpx::parallel::exclusive_scan(policy,
+                boost::begin(c), boost::end(c), boost::begin(d), affine(),
+                compose());
+        }
+        else
+        {
+            hpx::parallel::inclusive_scan(policy,
+                boost::begin(c), boost::end(c), boost::begin(d), affine(),
+                compose());
+        }
+
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const& e) {
+        caught_exception = true;
+        HPX_TEST(e.size() != 0);
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+}
+
+// make_values never produces this value
+std::uint64_t const poison_value = std::uint64_t(-1);
+
+template <typename ExPolicy>
+void test_scan_exception_async(ExPolicy && policy, std::size_t size,
+    std::size_t poison)
+{
+    std::vector<std::uint64_t> c = make_values(size);
+    std::vector<affine> d(c.size());
+    c[poison] = poison_value;
+
+    bool caught_exception = false;
+    bool returned_from_algorithm = false;
+    try {
+        hpx::future<void> f = hpx::parallel::transform_inclusive_scan(policy,
+            boost::begin(c), boost::end(c), boost::begin(d), affine(),
+            compose(),
+            [](std::uint64_t v) -> affine
+            {
+                affine r = make_affine()(v);
+                r.poison_ = (v == poison_value);
+                return r;
+            });
+
+        returned_from_algorithm = true;
+        f.get();
+
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const& e) {
+        caught_exception = true;
+        HPX_TEST(e.size() != 0);
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+
+    HPX_TEST(caught_exception);
+    HPX_TEST(returned_from_algorithm);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void scan_tiles_test()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const sizes[] = { 1, 17, 4096, 4097, 100007 };
+    for (std::size_t size : sizes)
+    {
+        test_scans(execution::seq, size);
+        test_scans(execution::par, size);
+
+        // very small tiles, make sure there are many of them
+        test_scans(execution::par.with(static_chunk_size(7)), size);
+        test_scans(execution::par.with(static_chunk_size(1)), size);
+    }
+
+    test_inclusive_scan_async(execution::par(execution::task), 100007);
+    test_inclusive_scan_async(
+        execution::par(execution::task).with(static_chunk_size(7)), 100007);
+}
+
+void scan_tiles_exception_test()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const size = 100007;
+    std::size_t const poisons[] = { 0, 13, size / 2, size - 1 };
+    for (std::size_t poison : poisons)
+    {
+        test_scan_exception(execution::seq, size, poison, false);
+        test_scan_exception(execution::par, size, poison, false);
+        test_scan_exception(execution::par, size, poison, true);
+        test_scan_exception(execution::par.with(static_chunk_size(3)),
+            size, poison, false);
+        test_scan_exception(execution::par.with(static_chunk_size(3)),
+            size, poison, true);
+
+        test_scan_exception_async(execution::par(execution::task),
+            size, poison);
+        test_scan_exception_async(
+            execution::par(execution::task).with(static_chunk_size(3)),
+            size, poison);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    scan_tiles_test();
+    scan_tiles_exception_test();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
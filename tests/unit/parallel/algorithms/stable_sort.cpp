@@ -0,0 +1,183 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// use smaller array sizes for debug tests
+#if defined(HPX_DEBUG)
+#define HPX_STABLE_SORT_TEST_SIZE   100000
+#else
+#define HPX_STABLE_SORT_TEST_SIZE   1000000
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// the key has only few distinct values, the index is used to verify that the
+// order of equal keys was preserved
+typedef std::pair<int, std::size_t> element_type;
+
+struct compare_keys
+{
+    bool operator()(element_type const& lhs, element_type const& rhs) const
+    {
+        return lhs.first < rhs.first;
+    }
+};
+
+struct project_key
+{
+    int operator()(element_type const& e) const
+    {
+        return e.first;
+    }
+};
+
+std::vector<element_type> make_input(std::size_t size, int distinct_keys)
+{
+    std::vector<element_type> c(size);
+    for (std::size_t i = 0; i != size; ++i)
+        c[i] = element_type(std::rand() % distinct_keys, i);
+    return c;
+}
+
+bool is_stably_sorted(std::vector<element_type> const& c)
+{
+    for (std::size_t i = 1; i < c.size(); ++i)
+    {
+        if (c[i].first < c[i - 1].first)
+            return false;
+        if (c[i].first == c[i - 1].first && c[i].second < c[i - 1].second)
+            return false;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_stable_sort(ExPolicy && policy, std::size_t size, int distinct_keys)
+{
+    static_assert(
+        hpx::parallel::execution::is_execution_policy<ExPolicy>::value,
+        "hpx::parallel::execution::is_execution_policy<ExPolicy>::value");
+
+    std::vector<element_type> c = make_input(size, distinct_keys);
+
+    auto result = hpx::parallel::stable_sort(policy, c.begin(), c.end(),
+        compare_keys());
+    HPX_TEST(result == c.end());
+    HPX_TEST(is_stably_sorted(c));
+}
+
+template <typename ExPolicy>
+void test_stable_sort_proj(ExPolicy && policy, std::size_t size,
+    int distinct_keys)
+{
+    std::vector<element_type> c = make_input(size, distinct_keys);
+
+    hpx::parallel::stable_sort(policy, c.begin(), c.end(),
+        std::less<int>(), project_key());
+    HPX_TEST(is_stably_sorted(c));
+}
+
+template <typename ExPolicy>
+void test_stable_sort_async(ExPolicy && policy, std::size_t size,
+    int distinct_keys)
+{
+    std::vector<element_type> c = make_input(size, distinct_keys);
+
+    hpx::future<std::vector<element_type>::iterator> f =
+        hpx::parallel::stable_sort(policy, c.begin(), c.end(),
+            compare_keys());
+    HPX_TEST(f.get() == c.end());
+    HPX_TEST(is_stably_sorted(c));
+}
+
+template <typename ExPolicy>
+void test_stable_sort_strings(ExPolicy && policy, std::size_t size)
+{
+    std::vector<std::string> c(size);
+    for (std::size_t i = 0; i != size; ++i)
+        c[i] = std::to_string(std::rand());
+
+    std::vector<std::string> expected(c);
+    std::stable_sort(expected.begin(), expected.end());
+
+    hpx::parallel::stable_sort(policy, c.begin(), c.end());
+    HPX_TEST(c == expected);
+}
+
+void test_stable_sort()
+{
+    using namespace hpx::parallel;
+
+    std::size_t const sizes[] = { 0, 1, 1000, HPX_STABLE_SORT_TEST_SIZE };
+    for (std::size_t size : sizes)
+    {
+        test_stable_sort(execution::seq, size, 10);
+        test_stable_sort(execution::par, size, 10);
+        test_stable_sort(execution::par_unseq, size, 10);
+        test_stable_sort(execution::par, size, 1);
+
+        test_stable_sort_proj(execution::seq, size, 100);
+        test_stable_sort_proj(execution::par, size, 100);
+
+        test_stable_sort_async(execution::seq(execution::task), size, 10);
+        test_stable_sort_async(execution::par(execution::task), size, 10);
+    }
+
+    test_stable_sort_strings(execution::par, HPX_STABLE_SORT_TEST_SIZE / 10);
+    test_stable_sort_strings(execution::par(execution::task),
+        HPX_STABLE_SORT_TEST_SIZE / 10);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = (unsigned int)std::time(nullptr);
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    test_stable_sort();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -7,6 +7,9 @@
 #include <hpx/hpx.hpp>
 #include <hpx/include/parallel_executors.hpp>
 #include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/parallel_transform.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
 #include <boost/range/iterator_range.hpp>
@@ -14,10 +17,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <numeric>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -94,6 +99,186 @@ void test_guided_chunk_size()
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// The algorithms below use the lazy splitting partitioner for the given
+// policies. The input is large enough for the tasks to be split repeatedly.
+std::size_t const lazy_split_count = 10007;
+
+template <typename ExPolicy>
+void test_lazy_split_reduce(ExPolicy const& policy)
+{
+    std::vector<std::size_t> c(lazy_split_count);
+    std::iota(boost::begin(c), boost::end(c), std::size_t(0));
+
+    std::size_t result = hpx::parallel::reduce(policy,
+        boost::begin(c), boost::end(c), std::size_t(42));
+
+    HPX_TEST_EQ(result,
+        std::size_t(42) + lazy_split_count * (lazy_split_count - 1) / 2);
+}
+
+template <typename ExPolicy>
+void test_lazy_split_transform(ExPolicy const& policy)
+{
+    std::vector<std::size_t> c(lazy_split_count);
+    std::vector<std::size_t> d(c.size());
+    std::iota(boost::begin(c), boost::end(c), std::size_t(0));
+
+    hpx::parallel::transform(policy, boost::begin(c), boost::end(c),
+        boost::begin(d), [](std::size_t v) { return 2 * v + 1; });
+
+    for (std::size_t i = 0; i != d.size(); ++i)
+        HPX_TEST_EQ(d[i], 2 * i + 1);
+}
+
+// every index visited by the strided loop is executed exactly once
+template <typename ExPolicy>
+void test_lazy_split_for_loop_strided(ExPolicy const& policy, int stride)
+{
+    int const count = static_cast<int>(lazy_split_count);
+    std::vector<int> visited(count, 0);
+
+    if (stride > 0)
+    {
+        hpx::parallel::for_loop_strided(policy, 0, count, stride,
+            [&](int i) { ++visited[i]; });
+    }
+    else
+    {
+        hpx::parallel::for_loop_strided(policy, count - 1, -1, stride,
+            [&](int i) { ++visited[i]; });
+    }
+
+    int const first = stride > 0 ? 0 : count - 1;
+    for (int i = 0; i != count; ++i)
+    {
+        HPX_TEST_EQ(visited[i], (i - first) % stride == 0 ? 1 : 0);
+    }
+}
+
+// the function throws for one of the iterations only, the exception has to
+// be reported and all other tasks have to finish
+template <typename ExPolicy>
+void test_lazy_split_exceptions(ExPolicy const& policy)
+{
+    std::size_t const bad = lazy_split_count / 3;
+
+    std::vector<std::size_t> c(lazy_split_count);
+    std::vector<std::size_t> d(c.size());
+    std::iota(boost::begin(c), boost::end(c), std::size_t(0));
+
+    bool caught_exception = false;
+    try {
+        hpx::parallel::transform(policy, boost::begin(c), boost::end(c),
+            boost::begin(d),
+            [bad](std::size_t v) -> std::size_t
+            {
+                if (v == bad)
+                    throw std::runtime_error("test");
+                return v;
+            });
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const& e) {
+        caught_exception = true;
+        HPX_TEST_EQ(e.size(), std::size_t(1));
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try {
+        hpx::parallel::reduce(policy, boost::begin(c), boost::end(c),
+            std::size_t(0),
+            [bad](std::size_t lhs, std::size_t rhs) -> std::size_t
+            {
+                if (rhs == bad)
+                    throw std::runtime_error("test");
+                return lhs + rhs;
+            });
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const& e) {
+        caught_exception = true;
+        HPX_TEST(e.size() != 0);
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try {
+        hpx::parallel::for_loop_strided(policy, std::size_t(0),
+            lazy_split_count, 3,
+            [bad](std::size_t i)
+            {
+                if (i == (bad / 3) * 3)
+                    throw std::runtime_error("test");
+            });
+        HPX_TEST(false);
+    }
+    catch (hpx::exception_list const& e) {
+        caught_exception = true;
+        HPX_TEST_EQ(e.size(), std::size_t(1));
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+    HPX_TEST(caught_exception);
+}
+
+void lazy_split_algorithms_test(hpx::parallel::lazy_split_chunk_size lscs)
+{
+    using namespace hpx::parallel;
+
+    test_lazy_split_reduce(execution::par.with(lscs));
+    test_lazy_split_transform(execution::par.with(lscs));
+    test_lazy_split_exceptions(execution::par.with(lscs));
+
+    // strides dividing the split chunk size or not, this requires rounding
+    // the position a range is split at to a multiple of the stride
+    int const strides[] = { 1, 2, 3, 7, -1, -3 };
+    for (int stride : strides)
+    {
+        test_lazy_split_for_loop_strided(execution::par.with(lscs), stride);
+    }
+
+    // explicitly given executor
+    parallel_executor par_exec;
+    test_lazy_split_reduce(execution::par.on(par_exec).with(lscs));
+    test_lazy_split_transform(execution::par.on(par_exec).with(lscs));
+    test_lazy_split_for_loop_strided(execution::par.on(par_exec).with(lscs), 3);
+}
+
+void test_lazy_split_chunk_size()
+{
+    {
+        hpx::parallel::lazy_split_chunk_size lscs;
+        parameters_test(lscs);
+        lazy_split_algorithms_test(lscs);
+    }
+
+    {
+        hpx::parallel::lazy_split_chunk_size lscs(100);
+        parameters_test(lscs);
+        lazy_split_algorithms_test(lscs);
+    }
+
+    // split as often as possible
+    {
+        hpx::parallel::lazy_split_chunk_size lscs(1);
+        lazy_split_algorithms_test(lscs);
+    }
+
+    {
+        hpx::parallel::lazy_split_chunk_size lscs(5);
+        lazy_split_algorithms_test(lscs);
+    }
+}
+
 void test_auto_chunk_size()
 {
     {
@@ -168,6 +353,7 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_dynamic_chunk_size();
     test_static_chunk_size();
     test_guided_chunk_size();
+    test_lazy_split_chunk_size();
     test_auto_chunk_size();
     test_persistent_auto_chunk_size();
 
@@ -0,0 +1,172 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify the ring buffer used by the ipc parcelport: records wrapping around
+// the end of the buffer, the behavior if the buffer is full, and abandoning a
+// record while it is written.
+
+#include <hpx/config.hpp>
+#include <hpx/plugins/parcelport/ipc/ring_buffer.hpp>
+#include <hpx/plugins/parcelport/ipc/shared_memory.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using hpx::parcelset::policies::ipc::ring_buffer;
+
+std::size_t const capacity = 256;
+
+std::string consumer_name()
+{
+    return "/hpx.ipc.test." +
+        std::to_string(hpx::parcelset::policies::ipc::instance_id());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<char> make_record(std::size_t size, std::size_t seed)
+{
+    std::vector<char> data(size);
+    for (std::size_t i = 0; i != size; ++i)
+        data[i] = static_cast<char>(seed + i);
+    return data;
+}
+
+// write the record in two pieces, the second one may wrap around
+bool write_record(ring_buffer& producer, std::vector<char> const& data)
+{
+    if (!producer.try_begin_write(data.size()))
+        return false;
+
+    std::size_t const first = data.size() / 2;
+    producer.write(data.data(), first);
+    producer.write(data.data() + first, data.size() - first);
+    producer.end_write();
+    return true;
+}
+
+void read_record(ring_buffer& consumer, std::vector<char> const& expected)
+{
+    std::size_t size = consumer.begin_read();
+    HPX_TEST_EQ(size, expected.size());
+
+    std::vector<char> data(size);
+    consumer.read(data.data(), size);
+    consumer.end_read();
+
+    HPX_TEST(data == expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_wrap_around(ring_buffer& consumer, ring_buffer& producer)
+{
+    // the record sizes are not aligned, the records wrap around at
+    // different positions
+    for (std::size_t i = 0; i != 1000; ++i)
+    {
+        std::vector<char> data = make_record(i % 117 + 1, i);
+        HPX_TEST(write_record(producer, data));
+        read_record(consumer, data);
+    }
+
+    HPX_TEST_EQ(consumer.begin_read(), std::size_t(0));
+}
+
+void test_full(ring_buffer& consumer, ring_buffer& producer)
+{
+    std::vector<std::vector<char> > records;
+    for (std::size_t i = 0; /**/; ++i)
+    {
+        std::vector<char> data = make_record(41, i);
+        if (!write_record(producer, data))
+            break;
+        records.push_back(data);
+    }
+    HPX_TEST(!records.empty());
+
+    // the space of a record is available again once it has been read
+    read_record(consumer, records.front());
+    records.erase(records.begin());
+
+    std::vector<char> data = make_record(41, 4711);
+    HPX_TEST(write_record(producer, data));
+    records.push_back(data);
+
+    for (std::vector<char> const& r : records)
+        read_record(consumer, r);
+
+    HPX_TEST_EQ(consumer.begin_read(), std::size_t(0));
+
+    // a record which can never be stored
+    HPX_TEST(producer.fits(capacity - sizeof(std::uint64_t)));
+    HPX_TEST(!producer.fits(capacity - sizeof(std::uint64_t) + 1));
+}
+
+void test_abort_write(ring_buffer& consumer, ring_buffer& producer)
+{
+    std::vector<char> aborted = make_record(100, 1);
+    HPX_TEST(producer.try_begin_write(aborted.size()));
+    producer.write(aborted.data(), aborted.size() / 2);
+
+    // the buffer is locked while the record is written
+    ring_buffer other;
+    HPX_TEST(!other.open(consumer_name()));
+    HPX_TEST(!other.try_begin_write(8));
+
+    producer.abort_write();
+
+    // the aborted record is invisible and its space is reused
+    HPX_TEST_EQ(consumer.begin_read(), std::size_t(0));
+
+    std::vector<char> data = make_record(100, 2);
+    HPX_TEST(write_record(other, data));
+    read_record(consumer, data);
+
+    HPX_TEST_EQ(consumer.begin_read(), std::size_t(0));
+}
+
+void test_skip(ring_buffer& consumer, ring_buffer& producer)
+{
+    std::vector<char> data = make_record(200, 3);
+    HPX_TEST(write_record(producer, data));
+    HPX_TEST(write_record(producer, make_record(10, 4)));
+
+    HPX_TEST_EQ(consumer.begin_read(), data.size());
+
+    char c = 0;
+    consumer.skip(data.size() - 1);
+    consumer.read(&c, 1);
+    consumer.end_read();
+    HPX_TEST_EQ(c, data.back());
+
+    read_record(consumer, make_record(10, 4));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    ring_buffer consumer;
+    boost::system::error_code ec = consumer.create(consumer_name(), capacity);
+    HPX_TEST(!ec);
+    if (ec)
+        return hpx::util::report_errors();
+
+    ring_buffer producer;
+    HPX_TEST(!producer.open(consumer_name()));
+    HPX_TEST_EQ(producer.capacity(), capacity);
+
+    test_wrap_around(consumer, producer);
+    test_full(consumer, producer);
+    test_abort_write(consumer, producer);
+    test_skip(consumer, producer);
+
+    consumer.unlink();
+
+    return hpx::util::report_errors();
+}
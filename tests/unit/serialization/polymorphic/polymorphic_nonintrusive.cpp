@@ -13,6 +13,8 @@
 
 #include <hpx/util/lightweight_test.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -180,11 +182,30 @@ void test_member()
     }
 }
 
+void test_type_id()
+{
+    // the type of a polymorphic object is encoded as a fixed size id
+    std::size_t plain_size = 0;
+    {
+        std::vector<char> buffer;
+        hpx::serialization::output_archive oarchive(buffer);
+        oarchive << 8;
+        plain_size = oarchive.bytes_written();
+    }
+    {
+        std::vector<char> buffer;
+        hpx::serialization::output_archive oarchive(buffer);
+        oarchive << A();
+        HPX_TEST_EQ(oarchive.bytes_written(),
+            plain_size + sizeof(std::uint32_t));
+    }
+}
 
 int main()
 {
     test_basic();
     test_member();
+    test_type_id();
 
     return hpx::util::report_errors();
 }
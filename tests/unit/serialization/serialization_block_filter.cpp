@@ -0,0 +1,125 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/runtime/serialization/block_binary_filter.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// A simple run length encoding is sufficient to verify the block handling
+struct rle_filter : hpx::serialization::block_binary_filter
+{
+    rle_filter(bool compress = false)
+      : hpx::serialization::block_binary_filter(compress, 4096)
+    {}
+
+protected:
+    std::size_t max_compressed_length(std::size_t size) const
+    {
+        return 2 * size;
+    }
+
+    std::size_t compress_block(char const* src, std::size_t size,
+        char* dst, std::size_t dst_size) const
+    {
+        std::size_t written = 0;
+        for (std::size_t i = 0; i != size; /**/)
+        {
+            std::size_t count = 1;
+            while (i + count != size && count != 255 &&
+                src[i + count] == src[i])
+            {
+                ++count;
+            }
+
+            HPX_TEST(written + 2 <= dst_size);
+            dst[written++] = static_cast<char>(count);
+            dst[written++] = src[i];
+            i += count;
+        }
+        return written;
+    }
+
+    void decompress_block(char const* src, std::size_t size,
+        char* dst, std::size_t dst_size) const
+    {
+        std::size_t written = 0;
+        for (std::size_t i = 0; i + 1 < size; i += 2)
+        {
+            std::size_t count = static_cast<unsigned char>(src[i]);
+            HPX_TEST(written + count <= dst_size);
+            for (std::size_t j = 0; j != count; ++j)
+                dst[written++] = src[i + 1];
+        }
+        HPX_TEST_EQ(written, dst_size);
+    }
+
+private:
+    friend class hpx::serialization::access;
+
+    template <typename Archive>
+    void serialize(Archive& ar, const unsigned int) {}
+
+    HPX_SERIALIZATION_POLYMORPHIC(rle_filter);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t roundtrip(std::vector<char> const& os)
+{
+    std::vector<char> buffer;
+    rle_filter filter(true);
+
+    std::size_t bytes_written = 0;
+    {
+        hpx::serialization::output_archive oarchive(buffer,
+            hpx::serialization::enable_compression, nullptr, &filter);
+        oarchive << os;
+        oarchive.flush();
+        bytes_written = oarchive.bytes_written();
+    }
+
+    hpx::serialization::input_archive iarchive(buffer, bytes_written);
+    std::vector<char> is;
+    iarchive >> is;
+
+    HPX_TEST(os == is);
+    return buffer.size();
+}
+
+int main()
+{
+    // small data is stored uncompressed
+    {
+        std::vector<char> data(100, 'a');
+        HPX_TEST(roundtrip(data) > data.size());
+    }
+
+    // compressible data spanning many blocks
+    {
+        std::vector<char> data(100000, 'a');
+        for (std::size_t i = 0; i < data.size(); i += 1000)
+            data[i] = 'b';
+        HPX_TEST(roundtrip(data) < data.size() / 10);
+    }
+
+    // incompressible data is stored uncompressed
+    {
+        std::vector<char> data(100000);
+        for (char& c : data)
+            c = static_cast<char>(std::rand());
+        HPX_TEST(roundtrip(data) < data.size() + data.size() / 100);
+    }
+
+    return hpx::util::report_errors();
+}
@@ -11,6 +11,7 @@
 #include <hpx/util/lightweight_test.hpp>
 #include <hpx/runtime/serialization/serialize_buffer.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <vector>
@@ -128,6 +129,63 @@ void test_initialization_from_vector(std::size_t max_size)
     }
 }
 
+// A de-serialized buffer refers to the data of a zero-copy chunk directly if
+// the owner of the received chunks is known.
+template <typename T>
+void test_reference_received_chunks(std::size_t size)
+{
+    typedef hpx::serialization::serialize_buffer<T> buffer_type;
+
+    buffer_type send_buffer(size);
+    for (std::size_t i = 0; i != size; ++i)
+        send_buffer[i] = T(i);
+
+    std::vector<char> buffer;
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+    std::size_t inbound_data_size = 0;
+    {
+        hpx::serialization::output_archive oarchive(buffer, 0U, &chunks);
+        oarchive << send_buffer;
+        oarchive.flush();
+        inbound_data_size = oarchive.bytes_written();
+    }
+
+    bool zero_copy =
+        size * sizeof(T) >= HPX_ZERO_COPY_SERIALIZATION_THRESHOLD;
+
+    // the received data is copied if no owner was specified
+    {
+        buffer_type recv_buffer;
+        hpx::serialization::input_archive iarchive(buffer,
+            inbound_data_size, &chunks);
+        iarchive >> recv_buffer;
+
+        HPX_TEST_EQ(recv_buffer.size(), size);
+        HPX_TEST(recv_buffer.data() != send_buffer.data());
+        HPX_TEST(std::equal(send_buffer.begin(), send_buffer.end(),
+            recv_buffer.begin()));
+    }
+
+    // otherwise the chunk is referenced and kept alive
+    std::shared_ptr<int> owner = std::make_shared<int>(0);
+    {
+        buffer_type recv_buffer;
+        {
+            hpx::serialization::input_archive iarchive(buffer,
+                inbound_data_size, &chunks, owner);
+            iarchive >> recv_buffer;
+        }
+
+        HPX_TEST_EQ(recv_buffer.size(), size);
+        HPX_TEST(std::equal(send_buffer.begin(), send_buffer.end(),
+            recv_buffer.begin()));
+
+        HPX_TEST_EQ(recv_buffer.data() == send_buffer.data(), zero_copy);
+        HPX_TEST_EQ(owner.use_count(), zero_copy ? 2 : 1);
+    }
+    HPX_TEST_EQ(owner.use_count(), 1);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(int argc, char* argv[])
 {
@@ -153,6 +211,12 @@ int hpx_main(int argc, char* argv[])
         test_fixed_size_initialization_for_persistent_buffers<double>(size);
     }
 
+    for (std::size_t size = 1; size <= max_size; size *= 2)
+    {
+        test_reference_received_chunks<char>(size);
+        test_reference_received_chunks<double>(size);
+    }
+
     return hpx::finalize();
 }
 
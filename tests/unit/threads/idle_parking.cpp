@@ -0,0 +1,109 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that parked worker threads are woken up in time: work posted to a
+// parked worker thread and timers of threads suspended on a parked worker
+// thread have to complete long before the parking timeout expires.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threadmanager.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/executors/default_executor.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+// parked worker threads wake up after this time at the latest (10s)
+std::string const max_parking_time = "10000000";
+
+// anything taking longer than this was not woken up properly
+double const max_elapsed = 1.0;
+
+///////////////////////////////////////////////////////////////////////////////
+// give the other worker threads the time to go idle and to park
+void wait_for_parked_workers()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+void test_post_to_parked_worker()
+{
+    std::size_t num_threads = hpx::get_os_thread_count();
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        wait_for_parked_workers();
+
+        hpx::util::high_resolution_timer t;
+
+        hpx::threads::executors::default_executor exec(i);
+        hpx::async(exec, []() {}).get();
+
+        HPX_TEST_LT(t.elapsed(), max_elapsed);
+    }
+}
+
+void test_sleep_on_parked_worker()
+{
+    std::size_t num_threads = hpx::get_os_thread_count();
+
+    std::vector<hpx::future<void> > sleeping;
+    sleeping.reserve(num_threads);
+
+    wait_for_parked_workers();
+
+    hpx::util::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        hpx::threads::executors::default_executor exec(i);
+        sleeping.push_back(hpx::async(exec,
+            []()
+            {
+                for (int j = 0; j != 10; ++j)
+                {
+                    hpx::this_thread::sleep_for(
+                        std::chrono::milliseconds(10));
+                }
+            }));
+    }
+
+    hpx::wait_all(sleeping);
+
+    HPX_TEST_LT(t.elapsed(), max_elapsed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    HPX_TEST_EQ(hpx::get_config_entry("hpx.idle_parking", "0"),
+        std::string("1"));
+
+    test_post_to_parked_worker();
+    test_sleep_on_parked_worker();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // park the idle worker threads right away, a parked worker thread which
+    // is not woken up properly sleeps for the whole parking time
+    std::vector<std::string> const cfg = {
+        "hpx.idle_parking=1",
+        "hpx.idle_parking_spin_count=0",
+        "hpx.idle_parking_max_time=" + max_parking_time
+    };
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/config.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/program_options.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+typedef hpx::util::lockfree::chase_lev_deque<std::uint64_t> deque_type;
+
+deque_type* queue = nullptr;
+std::vector<boost::atomic<std::uint64_t>*> seen;
+boost::atomic<bool> done(false);
+
+std::uint64_t threads = 4;
+std::uint64_t items = 500000;
+
+void record(std::uint64_t item)
+{
+    BOOST_TEST(item < items);
+    ++*seen[item];
+}
+
+void thief_thread()
+{
+    std::uint64_t item = 0;
+    while (!done.load() || !queue->empty())
+    {
+        if (queue->steal_top(item))
+            record(item);
+    }
+}
+
+void owner_thread()
+{
+    std::uint64_t item = 0;
+
+    // interleave pushes and pops to exercise both the race for the last
+    // item and the growth of the buffer while thieves are active
+    for (std::uint64_t i = 0; i != items; ++i)
+    {
+        queue->push_bottom(i);
+        if (i % 3 == 0 && queue->pop_bottom(item))
+            record(item);
+    }
+
+    while (queue->pop_bottom(item))
+        record(item);
+
+    done.store(true);
+}
+
+int main(int argc, char** argv)
+{
+    using boost::program_options::variables_map;
+    using boost::program_options::options_description;
+    using boost::program_options::value;
+    using boost::program_options::store;
+    using boost::program_options::command_line_parser;
+    using boost::program_options::notify;
+
+    variables_map vm;
+
+    options_description
+        desc_cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_cmdline.add_options()
+        ("help,h", "print out program usage (this message)")
+        ("threads,t", value<std::uint64_t>(&threads)->default_value(4),
+         "the number of worker threads stealing from the deque")
+        ("items,i", value<std::uint64_t>(&items)->default_value(500000),
+         "the number of items pushed by the owning thread")
+    ;
+
+    store(
+        command_line_parser(argc,
+            argv).options(desc_cmdline).allow_unregistered().run(),vm);
+
+    notify(vm);
+
+    // print help screen
+    if (vm.count("help"))
+    {
+        std::cout << desc_cmdline;
+        return boost::report_errors();
+    }
+
+    // start with a tiny buffer to force it to grow
+    queue = new deque_type(2);
+
+    seen.reserve(items);
+    for (std::uint64_t i = 0; i != items; ++i)
+        seen.push_back(new boost::atomic<std::uint64_t>(0));
+
+    {
+        boost::thread_group tg;
+
+        tg.create_thread(&owner_thread);
+        for (std::uint64_t i = 0; i != threads; ++i)
+            tg.create_thread(&thief_thread);
+
+        tg.join_all();
+    }
+
+    BOOST_TEST(queue->empty());
+
+    // every item has to be received exactly once
+    for (std::uint64_t i = 0; i != items; ++i)
+    {
+        BOOST_TEST_EQ(seen[i]->load(), 1u);
+        delete seen[i];
+    }
+
+    delete queue;
+
+    return boost::report_errors();
+}
@@ -0,0 +1,76 @@
+//  Copyright (c) 2017 The STE||AR Group
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/executors/default_executor.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+int run_to_completion(int i)
+{
+    hpx::threads::thread_self* self = hpx::threads::get_self_ptr();
+    HPX_TEST(self != nullptr);
+    HPX_TEST(self->is_stackless());
+
+    hpx::threads::thread_id_type id = hpx::threads::get_self_id();
+    HPX_TEST(id != hpx::threads::invalid_thread_id);
+    HPX_TEST(id->is_stackless());
+
+    // yielding is allowed, but does not do anything
+    hpx::this_thread::yield();
+    HPX_TEST(hpx::threads::get_self_id() == id);
+
+    return i;
+}
+
+void try_to_suspend()
+{
+    bool caught_exception = false;
+    try {
+        hpx::this_thread::suspend(std::chrono::milliseconds(1));
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void current_stacksize()
+{
+    // threads created from a stackless thread get a stack of their own
+    HPX_TEST(hpx::threads::get_stack_size(
+            hpx::threads::thread_stacksize_current) ==
+        hpx::threads::get_stack_size(
+            hpx::threads::thread_stacksize_default));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    hpx::threads::executors::default_executor exec(
+        hpx::threads::thread_stacksize_nostack);
+
+    {
+        std::vector<hpx::future<int> > futures;
+        for (int i = 0; i != 100; ++i)
+            futures.push_back(hpx::async(exec, &run_to_completion, i));
+
+        for (std::size_t i = 0; i != futures.size(); ++i)
+            HPX_TEST_EQ(futures[i].get(), int(i));
+    }
+
+    hpx::async(exec, &try_to_suspend).get();
+
+    hpx::async(exec, &current_stacksize).get();
+
+    return hpx::util::report_errors();
+}